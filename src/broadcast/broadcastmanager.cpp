@@ -24,7 +24,8 @@ BroadcastManager::BroadcastManager(SettingsManager* pSettingsManager,
                                    SoundManager* pSoundManager)
         : m_pConfig(pSettingsManager->settings()),
           m_pBroadcastSettings(pSettingsManager->broadcastSettings()),
-          m_pNetworkStream(pSoundManager->getNetworkStream()) {
+          m_pNetworkStream(pSoundManager->getNetworkStream()),
+          m_pEncoderPool(SharedEncoderPoolPointer::create()) {
     const bool persist = true;
     m_pBroadcastEnabled = new ControlPushButton(
             ConfigKey(BROADCAST_PREF_KEY,"enabled"), persist);
@@ -160,7 +161,15 @@ bool BroadcastManager::addConnection(BroadcastProfilePtr profile) {
         return false;
     }
 
-    ShoutConnectionPtr connection(new ShoutConnection(profile, m_pConfig));
+    const int connectionIndex = m_pNetworkStream->nextOutputSlotAvailable();
+    if (connectionIndex < 0) {
+        kLogger.warning() << "addConnection: no free connection slot left for profile"
+                          << profile->getProfileName();
+        return false;
+    }
+
+    ShoutConnectionPtr connection(new ShoutConnection(
+            profile, m_pConfig, m_pEncoderPool, connectionIndex));
     m_pNetworkStream->addOutputWorker(connection);
 
     connect(profile.data(),
@@ -51,6 +51,8 @@ class BroadcastManager : public QObject {
     UserSettingsPointer m_pConfig;
     BroadcastSettingsPointer m_pBroadcastSettings;
     QSharedPointer<EngineNetworkStream> m_pNetworkStream;
+    // Shared by all connections, which may outlive the manager
+    SharedEncoderPoolPointer m_pEncoderPool;
 
     ControlPushButton* m_pBroadcastEnabled;
     ControlObject* m_pStatusCO;
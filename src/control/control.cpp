@@ -27,6 +27,9 @@ QHash<ConfigKey, ConfigKey> s_qCOAliasHash
 
 /// is used instead of a nullptr, helps to omit null checks everywhere
 QWeakPointer<ControlDoublePrivate> s_pDefaultCO;
+
+/// Observer of all set() calls, usually nullptr.
+QAtomicPointer<ControlDoublePrivate::SetObserver> s_pSetObserver;
 } // namespace
 
 ControlDoublePrivate::ControlDoublePrivate()
@@ -72,12 +75,12 @@ void ControlDoublePrivate::initialize(double defaultValue) {
     m_defaultValue.setValue(defaultValue);
     m_value.setValue(value);
 
-    //qDebug() << "Creating:" << m_trackKey << "at" << &m_value << sizeof(m_value);
+    //qDebug() << "Creating:" << m_key << "at" << &m_value << sizeof(m_value);
 
     if (m_bTrack) {
         // TODO(rryan): Make configurable.
-        m_trackKey = "control " + m_key.group + "," + m_key.item;
-        Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
+        m_trackTag = StatTag("control " + m_key.group + "," + m_key.item);
+        Stat::track(m_trackTag, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags),
                     m_value.getValue());
     }
@@ -104,6 +107,12 @@ void ControlDoublePrivate::setUserConfig(const UserSettingsPointer& pConfig) {
     s_pUserConfig = pConfig;
 }
 
+// static
+void ControlDoublePrivate::setSetObserver(SetObserver* pObserver) {
+    DEBUG_ASSERT(!pObserver || !s_pSetObserver.loadAcquire());
+    s_pSetObserver.storeRelease(pObserver);
+}
+
 // static
 void ControlDoublePrivate::insertAlias(const ConfigKey& alias, const ConfigKey& key) {
     MMutexLocker locker(&s_qCOHashMutex);
@@ -261,6 +270,10 @@ void ControlDoublePrivate::set(double value, QObject* pSender) {
     if (!pBehavior.isNull() && !pBehavior->setFilter(&value)) {
         return;
     }
+    SetObserver* pSetObserver = s_pSetObserver.loadAcquire();
+    if (pSetObserver) {
+        pSetObserver->controlSet(m_key, value);
+    }
     if (m_confirmRequired) {
         emit valueChangeRequest(value);
     } else {
@@ -280,7 +293,7 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
     emit valueChanged(value, pSender);
 
     if (m_bTrack) {
-        Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
+        Stat::track(m_trackTag, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags), value);
     }
 }
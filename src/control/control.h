@@ -10,6 +10,7 @@
 #include "control/controlvalue.h"
 #include "preferences/usersettings.h"
 #include "util/mutex.h"
+#include "util/stat.h"
 
 class ControlObject;
 
@@ -32,8 +33,24 @@ Q_DECLARE_OPERATORS_FOR_FLAGS(ControlFlags)
 class ControlDoublePrivate : public QObject {
     Q_OBJECT
   public:
+    // Receives the values of all set() calls, i.e. the changes requested by
+    // controllers, skins and scripts, e.g. for recording a replayable timeline
+    // of a mix. It is invoked synchronously from the calling thread, including
+    // the engine thread, where it must neither block nor allocate. Beware that
+    // QThread::currentThread() allocates when first called from a thread that
+    // has not been started by Qt, e.g. the PortAudio callback thread.
+    class SetObserver {
+      public:
+        virtual ~SetObserver() = default;
+        virtual void controlSet(const ConfigKey& key, double value) = 0;
+    };
+
     ~ControlDoublePrivate() override;
 
+    // Installs the single observer of all set() calls or removes it when
+    // passing nullptr.
+    static void setSetObserver(SetObserver* pObserver);
+
     // Used to implement control persistence. All controls that are marked
     // "persist in user config" get and set their value on creation/deletion
     // using this UserSettings.
@@ -187,7 +204,7 @@ class ControlDoublePrivate : public QObject {
 
     // Whether to track value changes with the stats framework.
     bool m_bTrack;
-    QString m_trackKey;
+    StatTag m_trackTag;
     int m_trackType;
     int m_trackFlags;
     bool m_confirmRequired;
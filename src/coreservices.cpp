@@ -4,6 +4,7 @@
 #include <QFileDialog>
 #include <QPushButton>
 #include <QStandardPaths>
+#include <QtConcurrentRun>
 
 #ifdef __BROADCAST__
 #include "broadcast/broadcastmanager.h"
@@ -212,13 +213,33 @@ void CoreServices::initialize(QApplication* pApp) {
 
     ScopedTimer t("CoreServices::initialize");
 
-    VERIFY_OR_DEBUG_ASSERT(SoundSourceProxy::registerProviders()) {
-        qCritical() << "Failed to register any SoundSource providers";
-        return;
-    }
+    UserSettingsPointer pConfig = m_pSettingsManager->settings();
+
+    QString resourcePath = pConfig->getResourcePath();
+
+    emit initializationProgressUpdate(0, tr("fonts"));
 
     VersionStore::logBuildDetails();
 
+    // Fonts and SoundSource providers are independent from everything
+    // that follows until the library and the skin are created. Register
+    // them on worker threads while the database is opened and migrated
+    // on the main thread.
+    QFuture<void> fontsFuture = QtConcurrent::run([resourcePath] {
+        ScopedTimer t("CoreServices::initialize %1", "fonts");
+        FontUtils::initializeFonts(resourcePath); // takes a long time
+    });
+    QFuture<bool> soundSourceProvidersFuture = QtConcurrent::run([] {
+        ScopedTimer t("CoreServices::initialize %1", "soundsources");
+        return SoundSourceProxy::registerProviders();
+    });
+    // The workers must not outlive a failed initialization
+    const auto exitAfterWorkers = [&fontsFuture, &soundSourceProvidersFuture] {
+        fontsFuture.waitForFinished();
+        soundSourceProvidersFuture.waitForFinished();
+        exit(-1);
+    };
+
 #if defined(Q_OS_LINUX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     // XESetWireToError will segfault if running as a Wayland client
     if (pApp->platformName() == QLatin1String("xcb")) {
@@ -230,25 +251,27 @@ void CoreServices::initialize(QApplication* pApp) {
     Q_UNUSED(pApp);
 #endif
 
-    UserSettingsPointer pConfig = m_pSettingsManager->settings();
-
     Sandbox::setPermissionsFilePath(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
 
-    QString resourcePath = pConfig->getResourcePath();
-
-    emit initializationProgressUpdate(0, tr("fonts"));
-
-    FontUtils::initializeFonts(resourcePath); // takes a long time
-
     emit initializationProgressUpdate(10, tr("database"));
-    m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
-    if (!m_pDbConnectionPool) {
-        exit(-1);
+    {
+        ScopedTimer t("CoreServices::initialize %1", "database");
+        m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
+        if (!m_pDbConnectionPool) {
+            exitAfterWorkers();
+        }
+        // Create a connection for the main thread
+        m_pDbConnectionPool->createThreadLocalConnection();
+        if (!initializeDatabase()) {
+            exitAfterWorkers();
+        }
     }
-    // Create a connection for the main thread
-    m_pDbConnectionPool->createThreadLocalConnection();
-    if (!initializeDatabase()) {
-        exit(-1);
+
+    // The effects backends and the decks may already open audio files
+    VERIFY_OR_DEBUG_ASSERT(soundSourceProvidersFuture.result()) {
+        qCritical() << "Failed to register any SoundSource providers";
+        fontsFuture.waitForFinished();
+        return;
     }
 
     m_pControlIndicatorTimer = std::make_shared<mixxx::ControlIndicatorTimer>(this);
@@ -256,7 +279,10 @@ void CoreServices::initialize(QApplication* pApp) {
     auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
 
     emit initializationProgressUpdate(20, tr("effects"));
-    m_pEffectsManager = std::make_shared<EffectsManager>(pConfig, pChannelHandleFactory);
+    {
+        ScopedTimer t("CoreServices::initialize %1", "effects");
+        m_pEffectsManager = std::make_shared<EffectsManager>(pConfig, pChannelHandleFactory);
+    }
 
     m_pEngine = std::make_shared<EngineMaster>(
             pConfig,
@@ -268,7 +294,10 @@ void CoreServices::initialize(QApplication* pApp) {
     emit initializationProgressUpdate(30, tr("audio interface"));
     // Although m_pSoundManager is created here, m_pSoundManager->setupDevices()
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
-    m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
+    {
+        ScopedTimer t("CoreServices::initialize %1", "soundmanager");
+        m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
+    }
     m_pEngine->registerNonEngineChannelSoundIO(m_pSoundManager.get());
 
     m_pRecordingManager = std::make_shared<RecordingManager>(pConfig, m_pEngine.get());
@@ -286,35 +315,38 @@ void CoreServices::initialize(QApplication* pApp) {
 #endif
 
     emit initializationProgressUpdate(40, tr("decks"));
-    // Create the player manager. (long)
-    m_pPlayerManager = std::make_shared<PlayerManager>(
-            pConfig,
-            m_pSoundManager.get(),
-            m_pEffectsManager.get(),
-            m_pEngine.get());
-    // TODO: connect input not configured error dialog slots
-    PlayerInfo::create();
-
-    for (int i = 0; i < kMicrophoneCount; ++i) {
-        m_pPlayerManager->addMicrophone();
-    }
+    {
+        ScopedTimer t("CoreServices::initialize %1", "decks");
+        // Create the player manager. (long)
+        m_pPlayerManager = std::make_shared<PlayerManager>(
+                pConfig,
+                m_pSoundManager.get(),
+                m_pEffectsManager.get(),
+                m_pEngine.get());
+        // TODO: connect input not configured error dialog slots
+        PlayerInfo::create();
+
+        for (int i = 0; i < kMicrophoneCount; ++i) {
+            m_pPlayerManager->addMicrophone();
+        }
 
-    for (int i = 0; i < kAuxiliaryCount; ++i) {
-        m_pPlayerManager->addAuxiliary();
-    }
+        for (int i = 0; i < kAuxiliaryCount; ++i) {
+            m_pPlayerManager->addAuxiliary();
+        }
 
-    m_pPlayerManager->addConfiguredDecks();
-    m_pPlayerManager->addSampler();
-    m_pPlayerManager->addSampler();
-    m_pPlayerManager->addSampler();
-    m_pPlayerManager->addSampler();
-    m_pPlayerManager->addPreviewDeck();
+        m_pPlayerManager->addConfiguredDecks();
+        m_pPlayerManager->addSampler();
+        m_pPlayerManager->addSampler();
+        m_pPlayerManager->addSampler();
+        m_pPlayerManager->addSampler();
+        m_pPlayerManager->addPreviewDeck();
 
-    m_pEffectsManager->setup();
+        m_pEffectsManager->setup();
 
 #ifdef __VINYLCONTROL__
-    m_pVCManager->init();
+        m_pVCManager->init();
 #endif
+    }
 
 #ifdef __MODPLUG__
     // Restore the configuration for the modplug library before trying to load a module.
@@ -331,20 +363,24 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
-
-    m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
-            this,
-            pConfig,
-            m_pDbConnectionPool);
+    CoverArtCache::createInstance()->openThumbnailStore(
+            QDir(pConfig->getSettingsPath()).filePath("cover_thumbnails"));
 
-    m_pLibrary = std::make_shared<Library>(
-            this,
-            pConfig,
-            m_pDbConnectionPool,
-            m_pTrackCollectionManager.get(),
-            m_pPlayerManager.get(),
-            m_pRecordingManager.get());
+    {
+        ScopedTimer t("CoreServices::initialize %1", "library");
+        m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
+                this,
+                pConfig,
+                m_pDbConnectionPool);
+
+        m_pLibrary = std::make_shared<Library>(
+                this,
+                pConfig,
+                m_pDbConnectionPool,
+                m_pTrackCollectionManager.get(),
+                m_pPlayerManager.get(),
+                m_pRecordingManager.get());
+    }
 
     // Binding the PlayManager to the Library may already trigger
     // loading of tracks which requires that the GlobalTrackCache has
@@ -378,7 +414,12 @@ void CoreServices::initialize(QApplication* pApp) {
     // but do not set up controllers until the end of the application startup
     // (long)
     qDebug() << "Creating ControllerManager";
-    m_pControllerManager = std::make_shared<ControllerManager>(pConfig);
+    {
+        ScopedTimer t("CoreServices::initialize %1", "controllers");
+        m_pControllerManager = std::make_shared<ControllerManager>(pConfig);
+    }
+    // The controller mappings run in their own thread
+    m_pRecordingManager->addControlTimelineSourceThread(m_pControllerManager->thread());
 
     // Wait until all other ControlObjects are set up before initializing
     // controllers
@@ -425,7 +466,9 @@ void CoreServices::initialize(QApplication* pApp) {
     // Scan the library directory. Do this after the skinloader has
     // loaded a skin, see Bug #1047435
     if (rescan || hasChanged_MusicDir || m_pSettingsManager->shouldRescanLibrary()) {
-        m_pTrackCollectionManager->startLibraryScan();
+        m_deferredInitializers.push_back([this] {
+            m_pTrackCollectionManager->startLibraryScan();
+        });
     }
 
     // This has to be done before m_pSoundManager->setupDevices()
@@ -471,9 +514,25 @@ void CoreServices::initialize(QApplication* pApp) {
         }
     }
 
+    // The skin needs all application fonts
+    fontsFuture.waitForFinished();
+
     m_isInitialized = true;
 }
 
+void CoreServices::initializeDeferred() {
+    VERIFY_OR_DEBUG_ASSERT(m_isInitialized) {
+        return;
+    }
+    ScopedTimer t("CoreServices::initializeDeferred");
+    // Move the pending initializers out first, they might add new ones
+    const auto deferredInitializers = std::move(m_deferredInitializers);
+    m_deferredInitializers.clear();
+    for (const auto& initializer : deferredInitializers) {
+        initializer();
+    }
+}
+
 void CoreServices::initializeKeyboard() {
     UserSettingsPointer pConfig = m_pSettingsManager->settings();
     QString resourcePath = pConfig->getResourcePath();
@@ -564,6 +623,9 @@ void CoreServices::finalize() {
     Timer t("CoreServices::~CoreServices");
     t.start();
 
+    // Drop initializers that have never been invoked after startup
+    m_deferredInitializers.clear();
+
     // Stop all pending library operations
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "stopping pending Library tasks";
     m_pTrackCollectionManager->stopLibraryScan();
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "control/controlpushbutton.h"
 #include "preferences/configobject.h"
@@ -43,6 +45,11 @@ class CoreServices : public QObject {
     /// The secondary long run which should be called after displaying the start up screen
     void initialize(QApplication* pApp);
 
+    /// Run the non-critical initialization steps that have been postponed
+    /// by `initialize()`, e.g. the library rescan. Should be called once
+    /// after the first frame of the GUI has been painted.
+    void initializeDeferred();
+
     std::shared_ptr<KeyboardEventFilter> getKeyboardEventFilter() const {
         return m_pKeyboardEventFilter;
     }
@@ -154,6 +161,8 @@ class CoreServices : public QObject {
     std::vector<std::unique_ptr<ControlPushButton>> m_uiControls;
     std::unique_ptr<ControlPushButton> m_pTouchShift;
 
+    std::vector<std::function<void()>> m_deferredInitializers;
+
     Timer m_runtime_timer;
     const CmdlineArgs& m_cmdlineArgs;
     bool m_isInitialized;
@@ -30,6 +30,21 @@ const QString kUserName = QStringLiteral("mixxx");
 
 const QString kPassword = QStringLiteral("mixxx");
 
+// Disabling the write-ahead log migrates the database file back
+// to a rollback journal, e.g. if the settings directory is located
+// on a network file system that does not support shared memory.
+const ConfigKey kWriteAheadLogConfigKey =
+        ConfigKey(QStringLiteral("[Library]"), QStringLiteral("DbWriteAheadLog"));
+
+// The page cache of each connection grows on demand up to this size.
+// The SQLite default of 2 MiB is too small to keep the indexes of
+// large libraries in memory.
+constexpr int kCacheSizeKiB = 16 * 1024;
+
+// Reading through memory-mapped I/O avoids copying pages into the
+// page cache. It only reserves address space.
+constexpr qint64 kMmapSizeBytes = 256 * 1024 * 1024;
+
 // The connection parameters for the main Mixxx DB
 mixxx::DbConnection::Params dbConnectionParams(
         const UserSettingsPointer& pConfig,
@@ -58,6 +73,11 @@ mixxx::DbConnection::Params dbConnectionParams(
     }
     params.userName = kUserName;
     params.password = kPassword;
+    // Shared in-memory databases do not support a write-ahead log
+    params.writeAheadLog = !inMemoryConnection &&
+            pConfig->getValue(kWriteAheadLogConfigKey, true);
+    params.cacheSizeKiB = kCacheSizeKiB;
+    params.mmapSizeBytes = kMmapSizeBytes;
     return params;
 }
 
@@ -1,6 +1,7 @@
 #include "dialog/dlgdevelopertools.h"
 
 #include <QDateTime>
+#include <QTextStream>
 
 #include "control/control.h"
 #include "moc_dlgdevelopertools.cpp"
@@ -46,6 +47,10 @@ DlgDeveloperTools::DlgDeveloperTools(QWidget* pParent,
             &QPushButton::clicked,
             this,
             &DlgDeveloperTools::slotControlDump);
+    connect(xrunDump,
+            &QPushButton::clicked,
+            this,
+            &DlgDeveloperTools::slotXrunDump);
 
     // Set up the log search box
     connect(logSearch,
@@ -98,7 +103,25 @@ void DlgDeveloperTools::timerEvent(QTimerEvent* pEvent) {
         if (pManager) {
             pManager->updateStats();
         }
+    } else if (toolTabWidget->currentWidget() == xrunTab) {
+        updateXrunSnapshot();
+    }
+}
+
+void DlgDeveloperTools::updateXrunSnapshot() {
+    auto& profiler = mixxx::AudioCallbackProfiler::instance();
+    if (!profiler.takeSnapshot(&m_xrunSnapshot)) {
+        return;
     }
+    xrunLabel->setText(tr("Last xrun at %1")
+                               .arg(QTime::currentTime().toString()));
+    xrunDump->setEnabled(true);
+
+    QString report;
+    QTextStream stream(&report);
+    profiler.writeReport(m_xrunSnapshot, &stream);
+    stream.flush();
+    xrunTextView->setPlainText(report);
 }
 
 void DlgDeveloperTools::slotControlSearch(const QString& search) {
@@ -132,6 +155,20 @@ void DlgDeveloperTools::slotControlDump() {
     }
 }
 
+void DlgDeveloperTools::slotXrunDump() {
+    QString timestamp = QDateTime::currentDateTime()
+            .toString("yyyy-MM-dd_hh'h'mm'm'ss's'");
+    QString dumpFileName = m_pConfig->getSettingsPath() +
+            "/xrun_dump_" + timestamp + ".txt";
+    QFile dumpFile(dumpFileName);
+    if (!dumpFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "open" << dumpFileName << "failed";
+        return;
+    }
+    QTextStream stream(&dumpFile);
+    mixxx::AudioCallbackProfiler::instance().writeReport(m_xrunSnapshot, &stream);
+}
+
 void DlgDeveloperTools::slotLogSearch() {
     QString textToFind = logSearch->text();
     m_logCursor = logTextView->document()->find(textToFind, m_logCursor);
@@ -8,6 +8,7 @@
 #include "control/controlobject.h"
 #include "control/controlsortfiltermodel.h"
 #include "dialog/ui_dlgdevelopertoolsdlg.h"
+#include "engine/audiocallbackprofiler.h"
 #include "preferences/usersettings.h"
 #include "util/statmodel.h"
 
@@ -23,8 +24,11 @@ class DlgDeveloperTools : public QDialog, public Ui::DlgDeveloperTools {
     void slotControlSearch(const QString& search);
     void slotLogSearch();
     void slotControlDump();
+    void slotXrunDump();
 
   private:
+    void updateXrunSnapshot();
+
     UserSettingsPointer m_pConfig;
     ControlSortFilterModel m_controlProxyModel;
 
@@ -33,4 +37,6 @@ class DlgDeveloperTools : public QDialog, public Ui::DlgDeveloperTools {
 
     QFile m_logFile;
     QTextCursor m_logCursor;
+
+    mixxx::AudioCallbackProfiler::Snapshot m_xrunSnapshot;
 };
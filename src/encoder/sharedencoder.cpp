@@ -0,0 +1,265 @@
+#include "encoder/sharedencoder.h"
+
+#include <algorithm>
+
+#include "engine/engine.h"
+#include "recording/defs_recording.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+#include "util/time.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SharedEncoder");
+
+// The CPU load is reported once per second of encoded audio
+constexpr int kLoadWindowSeconds = 1;
+
+// A subscriber that does not keep up may drop many packets per second
+const mixxx::Duration kDroppedPacketsWarningInterval = mixxx::Duration::fromSeconds(10);
+
+QString settingsKey(const EncoderSettings& settings, mixxx::audio::SampleRate sampleRate) {
+    return settings.getFormat() +
+            QChar('|') + QString::number(settings.getQuality()) +
+            QChar('|') + QString::number(settings.getCompression()) +
+            QChar('|') + QString::number(static_cast<int>(settings.getChannelMode())) +
+            QChar('|') + QString::number(sampleRate.value());
+}
+
+} // anonymous namespace
+
+SharedEncoder::SharedEncoder(QString key)
+        : m_key(std::move(key)),
+          m_pLeader(nullptr),
+          m_loadWindowSamples(0),
+          m_cpuLoad(0.0) {
+}
+
+SharedEncoder::~SharedEncoder() {
+    DEBUG_ASSERT(m_subscriptions.isEmpty());
+    // Deleting the encoder may flush remaining packets into write(),
+    // which exits early without subscribers.
+    m_pEncoder.reset();
+}
+
+SharedEncoder::Subscription* SharedEncoder::findSubscription(EncoderCallback* pSubscriber) {
+    for (auto& subscription : m_subscriptions) {
+        if (subscription.pSubscriber == pSubscriber) {
+            return &subscription;
+        }
+    }
+    return nullptr;
+}
+
+void SharedEncoder::subscribe(EncoderCallback* pSubscriber) {
+    const auto locker = lockMutex(&m_mutex);
+    VERIFY_OR_DEBUG_ASSERT(!findSubscription(pSubscriber)) {
+        return;
+    }
+    // A new subscriber joins the stream at the next encoded packet
+    m_subscriptions.append(Subscription{pSubscriber, 0, {}, 0, mixxx::Duration()});
+}
+
+void SharedEncoder::unsubscribe(EncoderCallback* pSubscriber) {
+    const auto locker = lockMutex(&m_mutex);
+    const auto it = std::find_if(m_subscriptions.begin(),
+            m_subscriptions.end(),
+            [pSubscriber](const Subscription& subscription) {
+                return subscription.pSubscriber == pSubscriber;
+            });
+    VERIFY_OR_DEBUG_ASSERT(it != m_subscriptions.end()) {
+        return;
+    }
+    m_subscriptions.erase(it);
+    if (m_pLeader == pSubscriber) {
+        // The next subscriber that passes audio takes over
+        m_pLeader = nullptr;
+    }
+}
+
+int SharedEncoder::numSubscribers() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_subscriptions.size();
+}
+
+void SharedEncoder::encodeBuffer(
+        EncoderCallback* pSubscriber, const CSAMPLE* pBuffer, int size) {
+    const auto locker = lockMutex(&m_mutex);
+    Subscription* pSubscription = findSubscription(pSubscriber);
+    VERIFY_OR_DEBUG_ASSERT(pSubscription) {
+        return;
+    }
+    if (!m_pLeader) {
+        m_pLeader = pSubscriber;
+    } else if (m_pLeader != pSubscriber) {
+        pSubscription->samplesWithoutLeader += size;
+        if (pSubscription->samplesWithoutLeader <
+                static_cast<qint64>(m_sampleRate.value()) *
+                        mixxx::kEngineChannelCount * kLeaderTimeoutSeconds) {
+            // The same audio is encoded from the FIFO of the leader
+            return;
+        }
+        kLogger.info()
+                << m_key << ": Taking over encoding from a subscriber"
+                << "that has stopped passing audio";
+        m_pLeader = pSubscriber;
+    }
+    for (auto& subscription : m_subscriptions) {
+        subscription.samplesWithoutLeader = 0;
+    }
+
+    PerformanceTimer timer;
+    timer.start();
+    // The encoder calls write() with the encoded packets
+    m_pEncoder->encodeBuffer(pBuffer, size);
+    m_loadWindowEncodeTime += timer.elapsed();
+
+    m_loadWindowSamples += size;
+    const qint64 loadWindowFrames = m_loadWindowSamples / mixxx::kEngineChannelCount;
+    if (loadWindowFrames >= m_sampleRate.value() * kLoadWindowSeconds) {
+        const double audioSeconds =
+                static_cast<double>(loadWindowFrames) / m_sampleRate.value();
+        m_cpuLoad.store(m_loadWindowEncodeTime.toDoubleSeconds() / audioSeconds,
+                std::memory_order_relaxed);
+        m_loadWindowEncodeTime = mixxx::Duration();
+        m_loadWindowSamples = 0;
+    }
+}
+
+void SharedEncoder::deliver(EncoderCallback* pSubscriber) {
+    QList<Packet> packets;
+    int droppedPackets = 0;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        Subscription* pSubscription = findSubscription(pSubscriber);
+        VERIFY_OR_DEBUG_ASSERT(pSubscription) {
+            return;
+        }
+        packets.swap(pSubscription->pendingPackets);
+        if (pSubscription->droppedPackets > 0) {
+            const mixxx::Duration now = mixxx::Time::elapsed();
+            if (pSubscription->droppedPacketsWarnedAt == mixxx::Duration() ||
+                    now - pSubscription->droppedPacketsWarnedAt >=
+                            kDroppedPacketsWarningInterval) {
+                droppedPackets = pSubscription->droppedPackets;
+                pSubscription->droppedPackets = 0;
+                pSubscription->droppedPacketsWarnedAt = now;
+            }
+        }
+    }
+    if (droppedPackets > 0) {
+        kLogger.warning()
+                << m_key << ": Dropped" << droppedPackets
+                << "packets of a subscriber that does not keep up";
+    }
+    // Sending may block, so this must not hold the mutex
+    for (const auto& packet : qAsConst(packets)) {
+        pSubscriber->write(
+                reinterpret_cast<const unsigned char*>(packet.header.constData()),
+                reinterpret_cast<const unsigned char*>(packet.body.constData()),
+                packet.header.size(),
+                packet.body.size());
+    }
+}
+
+void SharedEncoder::write(const unsigned char* header,
+        const unsigned char* body,
+        int headerLen,
+        int bodyLen) {
+    // Invoked by the encoder from encodeBuffer() while m_mutex is locked
+    if (m_subscriptions.isEmpty()) {
+        return;
+    }
+    Packet packet{
+            QByteArray(reinterpret_cast<const char*>(header), headerLen),
+            QByteArray(reinterpret_cast<const char*>(body), bodyLen)};
+    for (auto& subscription : m_subscriptions) {
+        if (subscription.pendingPackets.size() >= kMaxPendingPackets) {
+            // Counted and reported by deliver() outside of the mutex
+            subscription.pendingPackets.removeFirst();
+            ++subscription.droppedPackets;
+        }
+        // Implicitly shared, the data is not copied
+        subscription.pendingPackets.append(packet);
+    }
+}
+
+// These are not used for streaming, but the interface requires them
+int SharedEncoder::tell() {
+    return -1;
+}
+
+// These are not used for streaming, but the interface requires them
+void SharedEncoder::seek(int pos) {
+    Q_UNUSED(pos)
+}
+
+// These are not used for streaming, but the interface requires them
+int SharedEncoder::filelen() {
+    return 0;
+}
+
+// static
+bool SharedEncoderPool::isShareable(const QString& format) {
+    // Each packet of these streams can be decoded on its own, i.e. a
+    // listener can join at any packet.
+    return format == QStringLiteral(ENCODING_MP3) ||
+            format == QStringLiteral(ENCODING_AAC) ||
+            format == QStringLiteral(ENCODING_HEAAC) ||
+            format == QStringLiteral(ENCODING_HEAACV2);
+}
+
+SharedEncoderPool::SharedEncoderPool(CreateEncoderFunction createEncoder)
+        : m_createEncoder(createEncoder
+                          ? std::move(createEncoder)
+                          : [](const EncoderSettingsPointer& pSettings,
+                                    EncoderCallback* pCallback) {
+                                return EncoderFactory::getFactory().createEncoder(
+                                        pSettings, pCallback);
+                            }) {
+}
+
+SharedEncoderPointer SharedEncoderPool::acquire(
+        const EncoderSettingsPointer& pSettings,
+        mixxx::audio::SampleRate sampleRate,
+        EncoderCallback* pSubscriber,
+        QString* pUserErrorMessage) {
+    const QString key = settingsKey(*pSettings, sampleRate);
+    const bool shareable = isShareable(pSettings->getFormat());
+
+    const auto locker = lockMutex(&m_mutex);
+    // Forget the encoders that have been released by all subscribers
+    for (auto it = m_encoders.begin(); it != m_encoders.end();) {
+        if (it.value().expired()) {
+            it = m_encoders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (shareable) {
+        SharedEncoderPointer pSharedEncoder = m_encoders.value(key).lock();
+        if (pSharedEncoder) {
+            pSharedEncoder->subscribe(pSubscriber);
+            kLogger.debug()
+                    << "Sharing encoder" << key << "with"
+                    << pSharedEncoder->numSubscribers() << "subscribers";
+            return pSharedEncoder;
+        }
+    }
+
+    auto pSharedEncoder = std::make_shared<SharedEncoder>(key);
+    pSharedEncoder->m_pEncoder = m_createEncoder(pSettings, pSharedEncoder.get());
+    if (!pSharedEncoder->m_pEncoder ||
+            pSharedEncoder->m_pEncoder->initEncoder(sampleRate, pUserErrorMessage) < 0) {
+        pSharedEncoder->m_pEncoder.reset();
+        return SharedEncoderPointer();
+    }
+    pSharedEncoder->m_sampleRate = sampleRate;
+    pSharedEncoder->subscribe(pSubscriber);
+    if (shareable) {
+        m_encoders.insert(key, pSharedEncoder);
+    }
+    return pSharedEncoder;
+}
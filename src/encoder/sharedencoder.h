@@ -0,0 +1,148 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "audio/types.h"
+#include "encoder/encoder.h"
+#include "encoder/encodercallback.h"
+#include "util/duration.h"
+
+/// An encoder that is shared by all subscribers that stream the same audio
+/// with identical encoder settings, e.g. broadcast profiles that send the
+/// same MP3 stream to different servers.
+///
+/// Each subscriber passes the audio of its own FIFO to encodeBuffer() from
+/// its own thread. The FIFOs of the subscribers are neither aligned nor
+/// identical, because each connection is synchronized with the network
+/// clock on its own, loses samples when its FIFO overflows and compensates
+/// drift by skipping or duplicating frames. So only the audio of a single
+/// subscriber, the leader, is encoded and the audio of all others is
+/// ignored. If the leader stops passing audio, e.g. while reconnecting,
+/// another subscriber takes over.
+///
+/// The encoded packets are queued for all subscribers. Each subscriber
+/// receives its packets through its EncoderCallback::write() when calling
+/// deliver() from its own thread, so a stalled connection does not delay
+/// the others.
+class SharedEncoder : public EncoderCallback {
+  public:
+    explicit SharedEncoder(QString key);
+    ~SharedEncoder() override;
+
+    /// The pending packets of a subscriber that does not deliver them
+    /// are dropped beyond this limit.
+    static constexpr int kMaxPendingPackets = 1024;
+    /// A subscriber takes over encoding after it has passed this much audio
+    /// without the leader passing any. This exceeds the FIFO of a connection,
+    /// i.e. the leader has stopped processing its FIFO.
+    static constexpr int kLeaderTimeoutSeconds = 2;
+
+    void subscribe(EncoderCallback* pSubscriber);
+    void unsubscribe(EncoderCallback* pSubscriber);
+    int numSubscribers() const;
+
+    void encodeBuffer(EncoderCallback* pSubscriber, const CSAMPLE* pBuffer, int size);
+    /// Passes the packets that have been encoded for pSubscriber
+    /// to its write() callback.
+    void deliver(EncoderCallback* pSubscriber);
+
+    /// The share of a CPU core spent in the encoder during the last
+    /// second of encoded audio, i.e. 0.01 is 1 %.
+    double cpuLoad() const {
+        return m_cpuLoad.load(std::memory_order_relaxed);
+    }
+
+    const QString& key() const {
+        return m_key;
+    }
+
+    // EncoderCallback of the encoder, invoked while encoding
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override;
+    int tell() override;
+    void seek(int pos) override;
+    int filelen() override;
+
+  private:
+    friend class SharedEncoderPool;
+
+    struct Packet {
+        QByteArray header;
+        QByteArray body;
+    };
+
+    struct Subscription {
+        EncoderCallback* pSubscriber;
+        /// The number of samples that the subscriber has passed to
+        /// encodeBuffer() since the leader has passed any
+        qint64 samplesWithoutLeader;
+        QList<Packet> pendingPackets;
+        /// The packets that have been dropped since the last warning
+        int droppedPackets;
+        mixxx::Duration droppedPacketsWarnedAt;
+    };
+
+    Subscription* findSubscription(EncoderCallback* pSubscriber);
+
+    const QString m_key;
+    EncoderPointer m_pEncoder;
+    mixxx::audio::SampleRate m_sampleRate;
+
+    mutable QMutex m_mutex;
+    QList<Subscription> m_subscriptions;
+    /// The subscriber whose audio is encoded, if any
+    EncoderCallback* m_pLeader;
+
+    mixxx::Duration m_loadWindowEncodeTime;
+    qint64 m_loadWindowSamples;
+    std::atomic<double> m_cpuLoad;
+};
+
+typedef std::shared_ptr<SharedEncoder> SharedEncoderPointer;
+
+/// Hands out SharedEncoders keyed by their settings and the sample rate.
+///
+/// Only formats that can be joined at any packet are shared. Ogg streams
+/// start with header packets that each consumer has to receive, so each
+/// consumer gets its own encoder for them.
+class SharedEncoderPool {
+  public:
+    /// Creates an encoder for the given settings that passes the encoded
+    /// packets to pCallback.
+    typedef std::function<EncoderPointer(
+            const EncoderSettingsPointer& pSettings,
+            EncoderCallback* pCallback)>
+            CreateEncoderFunction;
+
+    /// Uses the EncoderFactory unless another function is given, e.g. by
+    /// tests.
+    explicit SharedEncoderPool(CreateEncoderFunction createEncoder = nullptr);
+
+    /// Returns an encoder for the given settings, to which pSubscriber has
+    /// been subscribed, or a null pointer if the encoder could not be
+    /// initialized. Releasing the last reference destroys the encoder.
+    SharedEncoderPointer acquire(
+            const EncoderSettingsPointer& pSettings,
+            mixxx::audio::SampleRate sampleRate,
+            EncoderCallback* pSubscriber,
+            QString* pUserErrorMessage);
+
+    static bool isShareable(const QString& format);
+
+  private:
+    const CreateEncoderFunction m_createEncoder;
+    QMutex m_mutex;
+    QHash<QString, std::weak_ptr<SharedEncoder>> m_encoders;
+};
+
+typedef QSharedPointer<SharedEncoderPool> SharedEncoderPoolPointer;
@@ -0,0 +1,212 @@
+#include "engine/audiocallbackprofiler.h"
+
+#include <QTextStream>
+#include <algorithm>
+#include <limits>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+quint32 clampToNanos32(qint64 nanos) {
+    return static_cast<quint32>(math_clamp<qint64>(
+            nanos, 0, std::numeric_limits<quint32>::max()));
+}
+
+int labelKey(AudioCallbackProfiler::Section section, int index) {
+    return (static_cast<int>(section) << 16) | (index & 0xFFFF);
+}
+
+const char* sectionName(AudioCallbackProfiler::Section section) {
+    switch (section) {
+    case AudioCallbackProfiler::Section::Input:
+        return "Input";
+    case AudioCallbackProfiler::Section::FifoRead:
+        return "FifoRead";
+    case AudioCallbackProfiler::Section::Channel:
+        return "Channel";
+    case AudioCallbackProfiler::Section::EffectChain:
+        return "EffectChain";
+    case AudioCallbackProfiler::Section::SideChain:
+        return "SideChain";
+    case AudioCallbackProfiler::Section::Output:
+        return "Output";
+    case AudioCallbackProfiler::Section::FifoWrite:
+        return "FifoWrite";
+    }
+    return "Unknown";
+}
+
+double toMicros(quint32 nanos) {
+    return nanos / 1000.0;
+}
+
+} // anonymous namespace
+
+AudioCallbackProfiler::AudioCallbackProfiler()
+        : m_nextCallback(0),
+          m_numCallbacks(0),
+          m_pCurrent(nullptr),
+          m_frozenState(kEmpty),
+          m_numFrozen(0),
+          m_numMissedXruns(0) {
+    m_numLabels.fill(0);
+}
+
+// static
+AudioCallbackProfiler& AudioCallbackProfiler::instance() {
+    static AudioCallbackProfiler s_instance;
+    return s_instance;
+}
+
+void AudioCallbackProfiler::beginCallback(Duration budget) {
+    Callback* pCallback = &m_history[m_nextCallback];
+    pCallback->startNanos = now();
+    pCallback->durationNanos = 0;
+    pCallback->budgetNanos = clampToNanos32(budget.toIntegerNanos());
+    pCallback->xrun = false;
+    pCallback->numSpans = 0;
+    pCallback->numDroppedSpans = 0;
+    m_pCurrent = pCallback;
+}
+
+void AudioCallbackProfiler::endCallback(bool xrun) {
+    Callback* pCallback = m_pCurrent;
+    if (!pCallback) {
+        return;
+    }
+    pCallback->durationNanos = clampToNanos32(now() - pCallback->startNanos);
+    pCallback->xrun = xrun;
+    m_pCurrent = nullptr;
+    m_nextCallback = (m_nextCallback + 1) % kHistorySize;
+    if (m_numCallbacks < kHistorySize) {
+        ++m_numCallbacks;
+    }
+    if (pCallback->xrun || pCallback->isOverrun()) {
+        freeze();
+    }
+}
+
+void AudioCallbackProfiler::addSpan(
+        Section section, int index, qint64 startNanos, qint64 endNanos) {
+    Callback* pCallback = m_pCurrent;
+    if (!pCallback) {
+        return;
+    }
+    if (pCallback->numSpans >= kMaxSpansPerCallback) {
+        ++pCallback->numDroppedSpans;
+        return;
+    }
+    Span* pSpan = &pCallback->spans[pCallback->numSpans++];
+    pSpan->section = section;
+    pSpan->index = static_cast<quint16>(index);
+    pSpan->startNanos = clampToNanos32(startNanos - pCallback->startNanos);
+    pSpan->durationNanos = clampToNanos32(endNanos - startNanos);
+}
+
+void AudioCallbackProfiler::freeze() {
+    // Keep the unread snapshot of a previous xrun. The reader might
+    // also be busy copying it, in which case we must not wait.
+    if (!m_frozenState.testAndSetAcquire(kEmpty, kWriting)) {
+        m_numMissedXruns.fetchAndAddRelaxed(1);
+        return;
+    }
+    // Copy the history in chronological order
+    const int first = (m_nextCallback - m_numCallbacks + kHistorySize) % kHistorySize;
+    for (int i = 0; i < m_numCallbacks; ++i) {
+        m_frozen[i] = m_history[(first + i) % kHistorySize];
+    }
+    m_numFrozen = m_numCallbacks;
+    m_frozenState.storeRelease(kReady);
+}
+
+bool AudioCallbackProfiler::takeSnapshot(Snapshot* pSnapshot) {
+    DEBUG_ASSERT(pSnapshot);
+    if (!m_frozenState.testAndSetAcquire(kReady, kReading)) {
+        return false;
+    }
+    pSnapshot->callbacks.assign(m_frozen.cbegin(), m_frozen.cbegin() + m_numFrozen);
+    pSnapshot->numMissedXruns = m_numMissedXruns.fetchAndStoreRelaxed(0);
+    m_frozenState.storeRelease(kEmpty);
+    return true;
+}
+
+int AudioCallbackProfiler::registerLabel(Section section, const QString& label) {
+    const auto locker = lockMutex(&m_labelsMutex);
+    const int index = m_numLabels[static_cast<int>(section)]++;
+    m_labels.insert(labelKey(section, index), label);
+    return index;
+}
+
+void AudioCallbackProfiler::setLabel(Section section, int index, const QString& label) {
+    const auto locker = lockMutex(&m_labelsMutex);
+    int& numLabels = m_numLabels[static_cast<int>(section)];
+    numLabels = std::max(numLabels, index + 1);
+    m_labels.insert(labelKey(section, index), label);
+}
+
+QString AudioCallbackProfiler::label(Section section, int index) const {
+    QString label;
+    {
+        const auto locker = lockMutex(&m_labelsMutex);
+        label = m_labels.value(labelKey(section, index));
+    }
+    if (label.isEmpty()) {
+        return QStringLiteral("%1 %2").arg(sectionName(section), QString::number(index));
+    }
+    return QStringLiteral("%1 %2").arg(sectionName(section), label);
+}
+
+void AudioCallbackProfiler::writeReport(
+        const Snapshot& snapshot, QTextStream* pStream) const {
+    QTextStream& stream = *pStream;
+    if (snapshot.callbacks.empty()) {
+        return;
+    }
+    const qint64 frozenAtNanos = snapshot.callbacks.back().startNanos;
+    stream << "Audio callbacks before the xrun at "
+           << QString::number(frozenAtNanos / 1e9, 'f', 3) << " s";
+    if (snapshot.numMissedXruns > 0) {
+        stream << " (" << snapshot.numMissedXruns
+               << " later xruns not recorded)";
+    }
+    stream << "\n\n";
+
+    std::array<Span, kMaxSpansPerCallback> sortedSpans;
+    for (const Callback& callback : snapshot.callbacks) {
+        stream << QString::number((callback.startNanos - frozenAtNanos) / 1e6, 'f', 3)
+               << " ms: " << QString::number(toMicros(callback.durationNanos), 'f', 1)
+               << " of " << QString::number(toMicros(callback.budgetNanos), 'f', 1)
+               << " us";
+        if (callback.xrun) {
+            stream << " XRUN";
+        }
+        if (callback.isOverrun()) {
+            stream << " OVERRUN";
+        }
+        if (callback.numDroppedSpans > 0) {
+            stream << " (" << callback.numDroppedSpans << " spans dropped)";
+        }
+        stream << "\n";
+
+        const auto spansEnd = std::copy(callback.spans,
+                callback.spans + callback.numSpans,
+                sortedSpans.begin());
+        std::stable_sort(sortedSpans.begin(),
+                spansEnd,
+                [](const Span& lhs, const Span& rhs) {
+                    return lhs.startNanos < rhs.startNanos;
+                });
+        for (auto it = sortedSpans.begin(); it != spansEnd; ++it) {
+            stream << "    +" << QString::number(toMicros(it->startNanos), 'f', 1)
+                   << " us  " << QString::number(toMicros(it->durationNanos), 'f', 1)
+                   << " us  " << label(it->section, it->index) << "\n";
+        }
+    }
+}
+
+} // namespace mixxx
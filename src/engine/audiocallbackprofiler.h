@@ -0,0 +1,178 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <array>
+#include <vector>
+
+#include "util/duration.h"
+#include "util/time.h"
+
+class QTextStream;
+
+namespace mixxx {
+
+/// Records where the time of each audio callback of the clock reference
+/// device is spent, so that an xrun can be attributed to its cause.
+///
+/// The profiler is always on. Each callback is stored in a ring buffer
+/// that holds the last kHistorySize callbacks. When the driver reports an
+/// xrun or a callback exceeds its deadline, the ring buffer is frozen into
+/// a snapshot that is kept until it has been taken by a reader, e.g. the
+/// developer tools. Further xruns are only counted until then, since the
+/// first xrun of a series is the one that tells the most about its cause.
+///
+/// Recording and freezing is wait-free and does not allocate. All recording
+/// functions must only be called from the audio callback thread. Spans
+/// that are recorded outside of a callback are ignored.
+class AudioCallbackProfiler {
+  public:
+    enum class Section : quint8 {
+        /// SoundDevice::composeInputBuffer of the clock reference device
+        Input,
+        /// SoundDevice::readProcess of a secondary device
+        FifoRead,
+        /// EngineChannel::process
+        Channel,
+        /// EngineEffectChain::process
+        EffectChain,
+        /// EngineSideChain::writeSamples
+        SideChain,
+        /// SoundDevice::composeOutputBuffer of the clock reference device
+        Output,
+        /// SoundDevice::writeProcess of a secondary device
+        FifoWrite,
+    };
+    static constexpr int kNumSections = 7;
+
+    struct Span {
+        Section section;
+        quint16 index;
+        /// Relative to the start of the callback
+        quint32 startNanos;
+        quint32 durationNanos;
+    };
+
+    static constexpr int kMaxSpansPerCallback = 96;
+    static constexpr int kHistorySize = 32;
+
+    struct Callback {
+        /// Since Mixxx has been started
+        qint64 startNanos;
+        quint32 durationNanos;
+        quint32 budgetNanos;
+        /// An underflow or overflow has been reported by the driver
+        bool xrun;
+        int numSpans;
+        int numDroppedSpans;
+        Span spans[kMaxSpansPerCallback];
+
+        bool isOverrun() const {
+            return durationNanos > budgetNanos;
+        }
+    };
+
+    struct Snapshot {
+        /// Ordered from the oldest to the newest callback. The newest
+        /// callback is the one that caused the snapshot to be frozen.
+        std::vector<Callback> callbacks;
+        /// The number of xruns that occurred since the previous
+        /// snapshot had been taken and that are not included
+        int numMissedXruns = 0;
+    };
+
+    AudioCallbackProfiler();
+    AudioCallbackProfiler(const AudioCallbackProfiler&) = delete;
+    AudioCallbackProfiler& operator=(const AudioCallbackProfiler&) = delete;
+
+    static AudioCallbackProfiler& instance();
+
+    static qint64 now() {
+        return Time::elapsed().toIntegerNanos();
+    }
+
+    // Audio callback thread
+
+    void beginCallback(Duration budget);
+    void endCallback(bool xrun);
+
+    bool isInCallback() const {
+        return m_pCurrent != nullptr;
+    }
+
+    void addSpan(Section section, int index, qint64 startNanos, qint64 endNanos);
+
+    // Any thread
+
+    /// Moves the frozen snapshot into pSnapshot. Returns false if no xrun
+    /// has occurred since the last snapshot has been taken.
+    bool takeSnapshot(Snapshot* pSnapshot);
+
+    /// Allocates the next index of the section and names it. Must not be
+    /// called from the audio callback thread.
+    int registerLabel(Section section, const QString& label);
+    void setLabel(Section section, int index, const QString& label);
+    QString label(Section section, int index) const;
+
+    /// Writes a human-readable report of the snapshot, listing the spans
+    /// of each callback in the order they started.
+    void writeReport(const Snapshot& snapshot, QTextStream* pStream) const;
+
+  private:
+    void freeze();
+
+    std::array<Callback, kHistorySize> m_history;
+    int m_nextCallback;
+    int m_numCallbacks;
+    Callback* m_pCurrent;
+
+    enum FrozenState {
+        kEmpty,
+        kWriting,
+        kReady,
+        kReading,
+    };
+    QAtomicInt m_frozenState;
+    std::array<Callback, kHistorySize> m_frozen;
+    int m_numFrozen;
+    QAtomicInt m_numMissedXruns;
+
+    mutable QMutex m_labelsMutex;
+    QHash<int, QString> m_labels;
+    std::array<int, kNumSections> m_numLabels;
+};
+
+/// Records the time spent in the enclosing scope of the audio callback.
+class ScopedAudioCallbackSpan {
+  public:
+    explicit ScopedAudioCallbackSpan(
+            AudioCallbackProfiler::Section section, int index = 0)
+            : m_pProfiler(&AudioCallbackProfiler::instance()),
+              m_section(section),
+              m_index(index),
+              m_startNanos(0) {
+        if (m_pProfiler->isInCallback()) {
+            m_startNanos = AudioCallbackProfiler::now();
+        } else {
+            m_pProfiler = nullptr;
+        }
+    }
+    ~ScopedAudioCallbackSpan() {
+        if (m_pProfiler) {
+            m_pProfiler->addSpan(m_section,
+                    m_index,
+                    m_startNanos,
+                    AudioCallbackProfiler::now());
+        }
+    }
+
+  private:
+    AudioCallbackProfiler* m_pProfiler;
+    const AudioCallbackProfiler::Section m_section;
+    const int m_index;
+    qint64 m_startNanos;
+};
+
+} // namespace mixxx
@@ -23,7 +23,7 @@ CachingReaderWorker::CachingReaderWorker(
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
         FIFO<ReaderStatusUpdate>* pReaderStatusFIFO)
         : m_group(group),
-          m_tag(QString("CachingReaderWorker %1").arg(m_group)),
+          m_tag(QStringLiteral("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO) {
 }
@@ -92,6 +92,8 @@ void CachingReaderWorker::run() {
 
     Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
+        // Must be set before taking a request from the FIFO, see isIdle()
+        m_busy.storeRelease(1);
         // Request is initialized by reading from FIFO
         CachingReaderChunkReadRequest request;
         if (m_newTrackAvailable.loadAcquire()) {
@@ -114,6 +116,7 @@ void CachingReaderWorker::run() {
             const ReaderStatusUpdate update(processReadRequest(request));
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
         } else {
+            m_busy.storeRelease(0);
             Event::end(m_tag);
             m_semaRun.acquire();
             Event::start(m_tag);
@@ -121,6 +124,15 @@ void CachingReaderWorker::run() {
     }
 }
 
+bool CachingReaderWorker::isIdle() const {
+    // The order of the checks matters: A request that is no longer
+    // in the FIFO is still reported as busy until its status update
+    // has been written.
+    return m_pChunkReadRequestFIFO->readAvailable() == 0 &&
+            !m_newTrackAvailable.loadAcquire() &&
+            !m_busy.loadAcquire();
+}
+
 void CachingReaderWorker::discardAllPendingRequests() {
     CachingReaderChunkReadRequest request;
     while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
@@ -11,6 +11,7 @@
 #include "sources/audiosource.h"
 #include "track/track_decl.h"
 #include "util/fifo.h"
+#include "util/stat.h"
 
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
@@ -108,6 +109,8 @@ class CachingReaderWorker : public EngineWorker {
     // thread pool via the EngineWorkerScheduler.
     void run() override;
 
+    bool isIdle() const override;
+
     void quitWait();
 
   signals:
@@ -118,7 +121,7 @@ class CachingReaderWorker : public EngineWorker {
 
   private:
     const QString m_group;
-    QString m_tag;
+    StatTag m_tag;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
@@ -155,4 +158,7 @@ class CachingReaderWorker : public EngineWorker {
     mixxx::SampleBuffer m_tempReadBuffer;
 
     QAtomicInt m_stop;
+
+    // Set while the worker is not waiting for new requests
+    QAtomicInt m_busy;
 };
@@ -1,5 +1,6 @@
 #include "engine/effects/engineeffectchain.h"
 
+#include "engine/audiocallbackprofiler.h"
 #include "engine/effects/engineeffect.h"
 #include "util/defs.h"
 #include "util/sample.h"
@@ -8,6 +9,8 @@ EngineEffectChain::EngineEffectChain(const QString& group,
         const QSet<ChannelHandleAndGroup>& registeredInputChannels,
         const QSet<ChannelHandleAndGroup>& registeredOutputChannels)
         : m_group(group),
+          m_profilerIndex(mixxx::AudioCallbackProfiler::instance().registerLabel(
+                  mixxx::AudioCallbackProfiler::Section::EffectChain, group)),
           m_enableState(EffectEnableState::Enabled),
           m_mixMode(EffectChainMixMode::DrySlashWet),
           m_dMix(0),
@@ -259,6 +262,9 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
 
     bool processingOccured = false;
     if (effectiveChainEnableState != EffectEnableState::Disabled) {
+        mixxx::ScopedAudioCallbackSpan span(
+                mixxx::AudioCallbackProfiler::Section::EffectChain,
+                m_profilerIndex);
         // Ramping code inside the effects need to access the original samples
         // after writing to the output buffer. This requires not to use the same buffer
         // for in and output: Also, ChannelMixer::applyEffectsAndMixChannels
@@ -74,6 +74,7 @@ class EngineEffectChain final : public EffectsRequestHandler {
             const ChannelHandle& outputHandle);
 
     QString m_group;
+    const int m_profilerIndex;
     EffectEnableState m_enableState;
     EffectChainMixMode::Type m_mixMode;
     CSAMPLE m_dMix;
@@ -8,6 +8,7 @@
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
 #include "effects/effectsmanager.h"
+#include "engine/audiocallbackprofiler.h"
 #include "engine/channelmixer.h"
 #include "engine/channels/enginechannel.h"
 #include "engine/channels/enginedeck.h"
@@ -253,6 +254,10 @@ EngineMaster::~EngineMaster() {
     }
 }
 
+void EngineMaster::waitForIdleWorkers() {
+    m_pWorkerScheduler->waitForIdleWorkers();
+}
+
 const CSAMPLE* EngineMaster::getMasterBuffer() const {
     return m_pMaster;
 }
@@ -357,7 +362,12 @@ void EngineMaster::processChannels(int iBufferSize) {
              i < m_activeChannels.size(); ++i) {
         ChannelInfo* pChannelInfo = m_activeChannels[i];
         EngineChannel* pChannel = pChannelInfo->m_pChannel;
-        pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+        {
+            mixxx::ScopedAudioCallbackSpan span(
+                    mixxx::AudioCallbackProfiler::Section::Channel,
+                    pChannelInfo->m_index);
+            pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+        }
 
         // Collect metadata for effects
         if (m_pEngineEffectsManager) {
@@ -817,6 +827,10 @@ void EngineMaster::addChannel(EngineChannel* pChannel) {
     pChannelInfo->m_pChannel = pChannel;
     const QString& group = pChannel->getGroup();
     pChannelInfo->m_handle = m_pChannelHandleFactory->getOrCreateHandle(group);
+    mixxx::AudioCallbackProfiler::instance().setLabel(
+            mixxx::AudioCallbackProfiler::Section::Channel,
+            pChannelInfo->m_index,
+            group);
     pChannelInfo->m_pVolumeControl = new ControlAudioTaperPot(
             ConfigKey(group, "volume"), -20, 0, 1);
     pChannelInfo->m_pVolumeControl->setDefaultValue(1.0);
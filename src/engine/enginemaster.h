@@ -106,6 +106,11 @@ class EngineMaster : public QObject, public AudioSource {
         return m_pEngineSideChain;
     }
 
+    // Blocks until the engine workers, e.g. the track readers, have finished
+    // all work that has been requested by the previous callbacks. Used for
+    // offline rendering, where the result must not depend on thread timing.
+    void waitForIdleWorkers();
+
     CSAMPLE_GAIN getMasterGain(int channelIndex) const;
 
     struct ChannelInfo {
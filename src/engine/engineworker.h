@@ -24,6 +24,12 @@ class EngineWorker : public QThread {
     void workReady();
     void wakeIfReady();
 
+    // Returns true if no work has been requested from this worker that is
+    // still pending or in progress. Only needed for offline processing.
+    virtual bool isIdle() const {
+        return true;
+    }
+
   protected:
     QSemaphore m_semaRun;
 
@@ -7,6 +7,12 @@
 #include "util/compatibility/qmutex.h"
 #include "util/event.h"
 
+namespace {
+
+constexpr unsigned long kIdleWorkersPollMicros = 100;
+
+} // anonymous namespace
+
 EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent)
         : m_bWakeScheduler(false),
           m_bQuit(false) {
@@ -39,8 +45,28 @@ void EngineWorkerScheduler::runWorkers() {
     }
 }
 
+void EngineWorkerScheduler::waitForIdleWorkers() {
+    // Don't rely on the scheduler thread, it might miss a wakeup
+    // if runWorkers() is called while it is still busy.
+    m_bWakeScheduler = false;
+    while (true) {
+        bool idle = true;
+        {
+            const auto locker = lockMutex(&m_mutex);
+            for (const auto& pWorker : m_workers) {
+                pWorker->wakeIfReady();
+                idle = idle && pWorker->isIdle();
+            }
+        }
+        if (idle) {
+            return;
+        }
+        QThread::usleep(kIdleWorkersPollMicros);
+    }
+}
+
 void EngineWorkerScheduler::run() {
-    static const QString tag("EngineWorkerScheduler");
+    static const StatTag tag(QStringLiteral("EngineWorkerScheduler"));
     while (!m_bQuit) {
         Event::start(tag);
         {
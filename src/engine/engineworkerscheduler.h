@@ -22,6 +22,11 @@ class EngineWorkerScheduler : public QThread {
     void runWorkers();
     void workerReady();
 
+    // Wakes all workers that have pending work and blocks until all of them
+    // are idle. Must be called from the thread that drives the engine and
+    // only when no sound device is running the engine callback.
+    void waitForIdleWorkers();
+
   protected:
     void run();
 
@@ -6,6 +6,7 @@
 #include "mixer/playerinfo.h"
 #include "moc_enginerecord.cpp"
 #include "preferences/usersettings.h"
+#include "recording/controltimelinerecorder.h"
 #include "recording/defs_recording.h"
 #include "track/track.h"
 #include "util/event.h"
@@ -18,7 +19,8 @@ EngineRecord::EngineRecord(UserSettingsPointer pConfig)
           m_recordedDuration(0),
           m_iMetaDataLife(0),
           m_cueTrack(0),
-          m_bCueIsEnabled(false) {
+          m_bCueIsEnabled(false),
+          m_pTimelineRecorder(nullptr) {
 
     m_pRecReady = new ControlProxy(RECORDING_PREF_KEY, "status", this);
     m_pSamplerate = new ControlProxy("[Master]", "samplerate", this);
@@ -112,7 +114,7 @@ bool EngineRecord::metaDataHasChanged()
 
 void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
     const auto recordingStatus = static_cast<int>(m_pRecReady->get());
-    static const QString tag("EngineRecord recording");
+    static const StatTag tag(QStringLiteral("EngineRecord recording"));
 
     if (recordingStatus == RECORD_OFF) {
         //qDebug("Setting record flag to: OFF");
@@ -214,6 +216,9 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
 
         // update frames counting and recorded duration (seconds)
         m_frames += iBufferSize / 2;
+        if (m_pTimelineRecorder) {
+            m_pTimelineRecorder->advance(iBufferSize / 2);
+        }
         unsigned long lastDuration = m_recordedDuration;
         m_recordedDuration = m_frames / m_sampleRate;
 
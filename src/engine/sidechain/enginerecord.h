@@ -12,6 +12,7 @@
 
 class ConfigKey;
 class ControlProxy;
+class ControlTimelineRecorder;
 
 class EngineRecord : public QObject, public EncoderCallback, public SideChainWorker {
     Q_OBJECT
@@ -40,6 +41,12 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     bool openCueFile();
     void closeCueFile();
 
+    // Advances the clock of the timeline recorder by the recorded frames.
+    // Must be set before the engine is started.
+    void setControlTimelineRecorder(ControlTimelineRecorder* pTimelineRecorder) {
+        m_pTimelineRecorder = pTimelineRecorder;
+    }
+
   signals:
     // emitted to notify RecordingManager
     void bytesRecorded(int bytes);
@@ -85,4 +92,6 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     QString m_cueFileName;
     quint64 m_cueTrack;
     bool m_bCueIsEnabled;
+
+    ControlTimelineRecorder* m_pTimelineRecorder;
 };
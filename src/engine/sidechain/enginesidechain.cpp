@@ -10,6 +10,7 @@
 
 #include <QtDebug>
 
+#include "engine/audiocallbackprofiler.h"
 #include "engine/engine.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "moc_enginesidechain.cpp"
@@ -76,7 +77,12 @@ void EngineSideChain::receiveBuffer(const AudioInput& input,
 }
 
 void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
-    Trace sidechain("EngineSideChain::writeSamples");
+    static const StatTag tag(QStringLiteral("EngineSideChain::writeSamples"));
+    static const StatTag durationTag(
+            QStringLiteral("EngineSideChain::writeSamples_duration"));
+    Trace sidechain(tag, durationTag);
+    mixxx::ScopedAudioCallbackSpan span(
+            mixxx::AudioCallbackProfiler::Section::SideChain);
     // TODO: remove assumption of stereo buffer
     constexpr int kChannels = 2;
     const int iSamples = iFrames * kChannels;
@@ -98,7 +104,7 @@ void EngineSideChain::run() {
     // factor this out somehow), -kousu 2/2009
     unsigned static id = 0;
     QThread::currentThread()->setObjectName(QString("EngineSideChain %1").arg(++id));
-    static const QString tag("EngineSideChain");
+    static const StatTag tag(QStringLiteral("EngineSideChain"));
     Event::start(tag);
     while (!m_bStopThread) {
         // Sleep until samples are available.
@@ -0,0 +1,140 @@
+#include "engine/sidechain/networksendqueue.h"
+
+#include "moc_networksendqueue.cpp"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/time.h"
+
+namespace {
+
+const mixxx::Logger kLogger("NetworkSendQueue");
+
+// Upper bound for the reaction time on stopSending()
+constexpr int kWaitMillis = 10;
+
+} // anonymous namespace
+
+NetworkSendQueue::NetworkSendQueue(Sink* pSink, int maxQueuedBytes)
+        : m_pSink(pSink),
+          m_maxQueuedBytes(maxQueuedBytes),
+          m_bytesInPackets(0),
+          m_stop(0),
+          m_failed(0),
+          m_queuedBytes(0),
+          m_droppedPackets(0),
+          m_sendLatencyNanos(0) {
+    DEBUG_ASSERT(m_pSink);
+    DEBUG_ASSERT(m_maxQueuedBytes > 0);
+}
+
+NetworkSendQueue::~NetworkSendQueue() {
+    stopSending();
+}
+
+void NetworkSendQueue::startSending() {
+    VERIFY_OR_DEBUG_ASSERT(!isRunning()) {
+        return;
+    }
+    clearPackets();
+    m_stop.storeRelease(0);
+    m_failed.storeRelease(0);
+    m_droppedPackets.storeRelease(0);
+    m_sendLatencyNanos.store(0, std::memory_order_release);
+    start(QThread::HighPriority);
+}
+
+void NetworkSendQueue::stopSending() {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_stop.storeRelease(1);
+        m_packetAvailable.wakeAll();
+    }
+    wait();
+    clearPackets();
+}
+
+void NetworkSendQueue::clearPackets() {
+    const auto locker = lockMutex(&m_mutex);
+    m_packets.clear();
+    m_bytesInPackets = 0;
+    m_queuedBytes.storeRelease(0);
+}
+
+bool NetworkSendQueue::enqueue(QByteArray packet) {
+    if (packet.isEmpty() || hasFailed()) {
+        return true;
+    }
+    bool dropped = false;
+    const auto locker = lockMutex(&m_mutex);
+    while (!m_packets.isEmpty() &&
+            m_bytesInPackets + packet.size() > m_maxQueuedBytes) {
+        const int droppedBytes = m_packets.dequeue().data.size();
+        m_bytesInPackets -= droppedBytes;
+        m_queuedBytes.fetchAndAddRelease(-droppedBytes);
+        m_droppedPackets.fetchAndAddRelease(1);
+        dropped = true;
+    }
+    m_bytesInPackets += packet.size();
+    m_queuedBytes.fetchAndAddRelease(packet.size());
+    m_packets.enqueue(Packet{std::move(packet), mixxx::Time::elapsed()});
+    m_packetAvailable.wakeOne();
+    if (dropped) {
+        kLogger.debug() << "Dropped packets, the server does not keep up";
+    }
+    return !dropped;
+}
+
+bool NetworkSendQueue::takePacket(Packet* pPacket) {
+    const auto locker = lockMutex(&m_mutex);
+    while (m_packets.isEmpty()) {
+        if (m_stop.loadAcquire()) {
+            return false;
+        }
+        m_packetAvailable.wait(&m_mutex);
+    }
+    if (m_stop.loadAcquire()) {
+        return false;
+    }
+    *pPacket = m_packets.dequeue();
+    m_bytesInPackets -= pPacket->data.size();
+    return true;
+}
+
+bool NetworkSendQueue::sendPacket(const Packet& packet) {
+    const char* pData = packet.data.constData();
+    qint64 remaining = packet.data.size();
+    while (remaining > 0) {
+        if (m_stop.loadAcquire()) {
+            return true;
+        }
+        const qint64 sent = m_pSink->sendNonBlocking(pData, remaining);
+        if (sent < 0) {
+            return false;
+        }
+        pData += sent;
+        remaining -= sent;
+        m_queuedBytes.fetchAndAddRelease(-static_cast<int>(sent));
+        if (remaining > 0) {
+            m_pSink->waitForWritable(kWaitMillis);
+        }
+    }
+    m_sendLatencyNanos.store(
+            (mixxx::Time::elapsed() - packet.enqueueTime).toIntegerNanos(),
+            std::memory_order_release);
+    return true;
+}
+
+void NetworkSendQueue::run() {
+    m_pSink->open();
+    Packet packet;
+    while (takePacket(&packet)) {
+        if (!sendPacket(packet)) {
+            kLogger.warning() << "Sending failed, discarding the queued packets";
+            m_failed.storeRelease(1);
+            clearPackets();
+            break;
+        }
+    }
+    m_pSink->close();
+}
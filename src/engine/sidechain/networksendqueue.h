@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+
+#include "util/duration.h"
+
+/// A bounded queue of encoded packets that are sent to a server by a
+/// dedicated thread. The thread that encodes the stream only enqueues the
+/// packets and never blocks on the network, so a slow server does not back
+/// up its FIFO.
+///
+/// If the server does not keep up the oldest packets that have not been
+/// started to be sent yet are dropped, which keeps the latency bounded.
+class NetworkSendQueue : public QThread {
+    Q_OBJECT
+  public:
+    /// The non-blocking end of a network connection. All functions are
+    /// invoked by the sending thread.
+    class Sink {
+      public:
+        virtual ~Sink() = default;
+
+        /// Invoked when the sending thread starts and stops
+        virtual void open() {
+        }
+        virtual void close() {
+        }
+
+        /// Sends as many bytes as possible without blocking. Returns the
+        /// number of bytes that have been accepted or -1 on an error.
+        virtual qint64 sendNonBlocking(const char* pData, qint64 size) = 0;
+        /// Waits at most timeoutMillis until sendNonBlocking() might
+        /// accept more bytes.
+        virtual void waitForWritable(int timeoutMillis) = 0;
+    };
+
+    NetworkSendQueue(Sink* pSink, int maxQueuedBytes);
+    ~NetworkSendQueue() override;
+
+    /// Starts the sending thread, discarding all packets of a previous run
+    void startSending();
+    /// Stops the sending thread, the queued packets are discarded
+    void stopSending();
+
+    /// Never blocks. Returns false if older packets had to be dropped to
+    /// make room for this one.
+    bool enqueue(QByteArray packet);
+
+    /// The number of bytes that have been enqueued but not sent yet
+    int queuedBytes() const {
+        return m_queuedBytes.loadAcquire();
+    }
+    /// The number of packets that have been dropped since startSending()
+    int droppedPackets() const {
+        return m_droppedPackets.loadAcquire();
+    }
+    /// The time between enqueueing and sending the last byte of the
+    /// most recently sent packet
+    mixxx::Duration sendLatency() const {
+        return mixxx::Duration::fromNanos(
+                m_sendLatencyNanos.load(std::memory_order_acquire));
+    }
+    /// The sink has reported an error. The sending thread stops and
+    /// discards all packets that are enqueued afterwards.
+    bool hasFailed() const {
+        return m_failed.loadAcquire() != 0;
+    }
+
+  protected:
+    void run() override;
+
+  private:
+    struct Packet {
+        QByteArray data;
+        mixxx::Duration enqueueTime;
+    };
+
+    bool takePacket(Packet* pPacket);
+    bool sendPacket(const Packet& packet);
+    void clearPackets();
+
+    Sink* const m_pSink;
+    const int m_maxQueuedBytes;
+
+    QMutex m_mutex;
+    QWaitCondition m_packetAvailable;
+    QQueue<Packet> m_packets;
+    // The queued bytes that have not been taken by the sending thread
+    int m_bytesInPackets;
+
+    QAtomicInt m_stop;
+    QAtomicInt m_failed;
+    QAtomicInt m_queuedBytes;
+    QAtomicInt m_droppedPackets;
+    std::atomic<qint64> m_sendLatencyNanos;
+};
@@ -29,12 +29,16 @@
 #include "recording/defs_recording.h"
 #include "track/track.h"
 #include "util/compatibility/qatomic.h"
+#include "util/compatibility/qmutex.h"
 #include "util/logger.h"
 
 namespace {
 
 constexpr int kConnectRetries = 30;
 constexpr int kMaxNetworkCache = 491520; // 10 s mp3 @ 192 kbit/s
+// libshout keeps the data that it could not send yet in its own queue,
+// which is kept small to leave dropping to the send queue.
+constexpr ssize_t kMaxShoutQueue = 16384;
 // Shoutcast default receive buffer 1048576 and autodumpsourcetime 30 s
 // http://wiki.shoutcast.com/wiki/SHOUTcast_DNAS_Server_2
 constexpr int kMaxShoutFailures = 3;
@@ -47,7 +51,9 @@ const mixxx::Logger kLogger("ShoutConnection");
 } // namespace
 
 ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
-        UserSettingsPointer pConfig)
+        UserSettingsPointer pConfig,
+        SharedEncoderPoolPointer pEncoderPool,
+        int connectionIndex)
         : m_pTextCodec(nullptr),
           m_pMetaData(),
           m_pShout(nullptr),
@@ -55,9 +61,14 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_iMetaDataLife(0),
           m_iShoutStatus(0),
           m_iShoutFailures(0),
+          m_sendFailures(0),
+          m_sendQueue(this, kMaxNetworkCache),
           m_pConfig(pConfig),
           m_pProfile(profile),
+          m_pEncoderPool(pEncoderPool),
           m_encoder(nullptr),
+          m_reportedEncoderCpuLoad(0.0),
+          m_reportedEncoderSubscribers(0),
           m_pMasterSamplerate(new ControlProxy("[Master]", "samplerate", this)),
           m_pBroadcastEnabled(new ControlProxy(BROADCAST_PREF_KEY, "enabled", this)),
           m_custom_metadata(false),
@@ -80,6 +91,17 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
     setStatus(BroadcastProfile::STATUS_UNCONNECTED);
     setState(NETWORKSTREAMWORKER_STATE_INIT);
 
+    const QString group = QStringLiteral("[ShoutcastConnection%1]").arg(connectionIndex + 1);
+    m_pSendQueueBytes = std::make_unique<ControlObject>(
+            ConfigKey(group, QStringLiteral("send_queue_bytes")));
+    m_pSendQueueBytes->setReadOnly();
+    m_pSendLatency = std::make_unique<ControlObject>(
+            ConfigKey(group, QStringLiteral("send_latency_ms")));
+    m_pSendLatency->setReadOnly();
+    m_pDroppedPackets = std::make_unique<ControlObject>(
+            ConfigKey(group, QStringLiteral("dropped_packets")));
+    m_pDroppedPackets->setReadOnly();
+
     // shout_init() should've already been called by now
     if (!(m_pShout = shout_new())) {
         errorDialog(tr("Mixxx encountered a problem"),
@@ -109,6 +131,7 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
 }
 
 ShoutConnection::~ShoutConnection() {
+    m_sendQueue.stopSending();
     delete m_pMasterSamplerate;
 
     if (m_pShoutMetaData) {
@@ -129,6 +152,7 @@ ShoutConnection::~ShoutConnection() {
        qWarning() << "ShoutOutput::~ShoutOutput(): Thread didn't die.\
        Ignored but file a bug report if problems rise!";
     }
+    releaseEncoder();
 }
 
 bool ShoutConnection::isConnected() {
@@ -189,10 +213,9 @@ void ShoutConnection::updateFromPreferences() {
 
     setState(NETWORKSTREAMWORKER_STATE_BUSY);
 
-    // Delete m_encoder if it has been initialized (with maybe) different bitrate.
-    // delete m_encoder calls write() check if it will be exit early
+    // Release m_encoder if it has been initialized (with maybe) different bitrate.
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    releaseEncoder();
 
     m_format_is_mp3 = false;
     m_format_is_ov = false;
@@ -456,24 +479,15 @@ void ShoutConnection::updateFromPreferences() {
         return;
     }
 
-    // Initialize m_encoder
+    // Initialize m_encoder, which is shared with the other connections
+    // that use the same encoder settings
     EncoderSettingsPointer pBroadcastSettings =
             std::make_shared<EncoderBroadcastSettings>(m_pProfile);
-    m_encoder = EncoderFactory::getFactory().createEncoder(
-                    pBroadcastSettings, this);
-
     QString userErrorMsg;
-    int ret = -1;
-    if (m_encoder) {
-        ret = m_encoder->initEncoder(masterSamplerate, &userErrorMsg);
-    }
-
-    // TODO(XXX): Use mixxx::audio::SampleRate instead of int in initEncoder
-    if (ret < 0) {
-        // delete m_encoder calls write() make sure it will be exit early
-        DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-        m_encoder.reset();
+    m_encoder = m_pEncoderPool->acquire(
+            pBroadcastSettings, masterSamplerate, this, &userErrorMsg);
 
+    if (!m_encoder) {
         setState(NETWORKSTREAMWORKER_STATE_ERROR);
 
         m_lastErrorStr = pBroadcastSettings->getFormat() + QChar(' ') +
@@ -603,6 +617,10 @@ bool ShoutConnection::processConnect() {
             }
             m_threadWaiting = true;
 
+            m_sendFailures = 0;
+            m_sendQueue.startSending();
+            updateSendControls();
+
             setStatus(BroadcastProfile::STATUS_CONNECTED);
             emit broadcastConnected();
 
@@ -623,9 +641,8 @@ bool ShoutConnection::processConnect() {
 
     // no connection, clean up
     shout_close(m_pShout);
-    // delete m_encoder calls write() check if it will be exit early
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    releaseEncoder();
     if (m_pProfile->getEnabled()) {
         setStatus(BroadcastProfile::STATUS_FAILURE);
     } else {
@@ -637,6 +654,8 @@ bool ShoutConnection::processConnect() {
 
 bool ShoutConnection::processDisconnect() {
     kLogger.debug() << "processDisconnect()";
+    // The sending thread must not access m_pShout anymore
+    m_sendQueue.stopSending();
     bool disconnected = false;
     if (isConnected()) {
     	m_threadWaiting = false;
@@ -648,12 +667,22 @@ bool ShoutConnection::processDisconnect() {
         emit broadcastDisconnected();
         disconnected = true;
     }
-    // delete m_encoder calls write() check if it will be exit early
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    releaseEncoder();
     return disconnected;
 }
 
+void ShoutConnection::releaseEncoder() {
+    if (!m_encoder) {
+        return;
+    }
+    m_encoder->unsubscribe(this);
+    m_encoder.reset();
+    m_reportedEncoderCpuLoad = 0.0;
+    m_reportedEncoderSubscribers = 0;
+    m_pProfile->setEncoderUsage(0.0, 0);
+}
+
 void ShoutConnection::write(const unsigned char* header, const unsigned char* body,
                             int headerLen, int bodyLen) {
     setFunctionCode(7);
@@ -663,26 +692,13 @@ void ShoutConnection::write(const unsigned char* header, const unsigned char* bo
         return;
     }
 
-    // Send header if there is one
-    if (headerLen > 0) {
-        if(!writeSingle(header, headerLen)) {
-            return;
-        }
-    }
-
-    if(!writeSingle(body, bodyLen)) {
-        return;
-    }
-
-    ssize_t queuelen = shout_queuelen(m_pShout);
-    if (queuelen > 0) {
-        kLogger.debug() << "shout_queuelen" << queuelen;
-        if (queuelen > kMaxNetworkCache) {
-            m_lastErrorStr = tr("Network cache overflow");
-            tryReconnect();
-        }
+    QByteArray packet(reinterpret_cast<const char*>(header), headerLen);
+    packet.append(reinterpret_cast<const char*>(body), bodyLen);
+    if (!m_sendQueue.enqueue(std::move(packet))) {
+        kLogger.debug() << "The send queue is full, dropped the oldest packets";
     }
 }
+
 // These are not used for streaming, but the interface requires them
 int ShoutConnection::tell() {
     if (!m_pShout) {
@@ -700,29 +716,41 @@ int ShoutConnection::filelen() {
     return 0;
 }
 
-bool ShoutConnection::writeSingle(const unsigned char* data, size_t len) {
-    setFunctionCode(8);
-    int ret = shout_send_raw(m_pShout, data, len);
-    if (ret == SHOUTERR_BUSY) {
-        // in case of busy, frames are queued
-        // try to flush queue after a short sleep
-        kLogger.warning() << "writeSingle() SHOUTERR_BUSY, trying again";
-        usleep(10000); // wait 10 ms until "busy" is over. TODO() tweak for an optimum.
-        // if this fails, the queue is transmitted after the next regular shout_send_raw()
-        (void)shout_send_raw(m_pShout, nullptr, 0);
-    } else if (ret < SHOUTERR_SUCCESS) {
-        m_lastErrorStr = shout_get_error(m_pShout);
-        kLogger.warning()
-                << "writeSingle() error:"
-                << ret << m_lastErrorStr;
-        if (++m_iShoutFailures > kMaxShoutFailures) {
-            tryReconnect();
-        }
-        return false;
+qint64 ShoutConnection::sendNonBlocking(const char* pData, qint64 size) {
+    const auto locker = lockMutex(&m_shoutMutex);
+    int ret;
+    if (shout_queuelen(m_pShout) > kMaxShoutQueue) {
+        // Only try to send the queue of libshout
+        ret = shout_send_raw(m_pShout, nullptr, 0);
+        size = 0;
     } else {
-        m_iShoutFailures = 0;
+        // In case of busy the data is queued by libshout
+        ret = shout_send_raw(m_pShout, reinterpret_cast<const unsigned char*>(pData), size);
+    }
+    if (ret == SHOUTERR_SUCCESS || ret == SHOUTERR_BUSY) {
+        m_sendFailures = 0;
+        return size;
+    }
+    m_sendErrorStr = shout_get_error(m_pShout);
+    kLogger.warning()
+            << "sendNonBlocking() error:"
+            << ret << m_sendErrorStr;
+    if (++m_sendFailures > kMaxShoutFailures) {
+        return -1;
     }
-    return true;
+    // Try again after waiting
+    return 0;
+}
+
+void ShoutConnection::waitForWritable(int timeoutMillis) {
+    // libshout does not expose its socket for waiting until it is writable
+    QThread::msleep(timeoutMillis);
+}
+
+void ShoutConnection::updateSendControls() {
+    m_pSendQueueBytes->forceSet(m_sendQueue.queuedBytes());
+    m_pSendLatency->forceSet(m_sendQueue.sendLatency().toDoubleMillis());
+    m_pDroppedPackets->forceSet(m_sendQueue.droppedPackets());
 }
 
 void ShoutConnection::process(const CSAMPLE* pBuffer, const int iBufferSize) {
@@ -741,13 +769,40 @@ void ShoutConnection::process(const CSAMPLE* pBuffer, const int iBufferSize) {
     // Save a copy of the smart pointer in a local variable
     // to prevent race conditions when resetting the member
     // pointer while disconnecting in the worker thread!
-    const EncoderPointer pEncoder = m_encoder;
+    const SharedEncoderPointer pEncoder = m_encoder;
 
     // If we are connected, encode the samples.
-    if (iBufferSize > 0 && pEncoder) {
+    if (pEncoder) {
         setFunctionCode(6);
-        pEncoder->encodeBuffer(pBuffer, iBufferSize);
+        if (iBufferSize > 0) {
+            // This is a no-op if another connection has already
+            // encoded the samples.
+            pEncoder->encodeBuffer(this, pBuffer, iBufferSize);
+        }
         // the encoded frames are received by the write() callback.
+        pEncoder->deliver(this);
+
+        // The load is updated once per second of audio by the encoder,
+        // the subscribers change whenever another connection joins or
+        // leaves the encoder
+        const double cpuLoad = pEncoder->cpuLoad();
+        const int numSubscribers = pEncoder->numSubscribers();
+        if (cpuLoad != m_reportedEncoderCpuLoad ||
+                numSubscribers != m_reportedEncoderSubscribers) {
+            m_reportedEncoderCpuLoad = cpuLoad;
+            m_reportedEncoderSubscribers = numSubscribers;
+            m_pProfile->setEncoderUsage(cpuLoad, numSubscribers);
+        }
+    }
+    updateSendControls();
+
+    if (m_sendQueue.hasFailed()) {
+        {
+            const auto locker = lockMutex(&m_shoutMutex);
+            m_lastErrorStr = m_sendErrorStr;
+        }
+        tryReconnect();
+        return;
     }
 
     // Check if track metadata has changed and if so, update.
@@ -867,6 +922,7 @@ void ShoutConnection::updateMetaData() {
                 insertMetaData("song",  baSong.constData());
             }
             setFunctionCode(11);
+            const auto locker = lockMutex(&m_shoutMutex);
             int ret = shout_set_metadata(m_pShout, m_pShoutMetaData);
             if (ret != SHOUTERR_SUCCESS) {
                 kLogger.warning() << "shout_set_metadata fails with error code" << ret;
@@ -888,6 +944,7 @@ void ShoutConnection::updateMetaData() {
             }
 
             setFunctionCode(13);
+            const auto locker = lockMutex(&m_shoutMutex);
             shout_set_metadata(m_pShout, m_pShoutMetaData);
             m_firstCall = true;
         }
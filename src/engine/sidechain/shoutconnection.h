@@ -1,6 +1,7 @@
 #pragma once
 
 #include <engine/sidechain/networkoutputstreamworker.h>
+#include <engine/sidechain/networksendqueue.h>
 
 #include <QMessageBox>
 #include <QMutex>
@@ -11,11 +12,13 @@
 #include <QThread>
 #include <QVector>
 #include <QWaitCondition>
+#include <memory>
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
 #include "encoder/encoder.h"
 #include "encoder/encodercallback.h"
+#include "encoder/sharedencoder.h"
 #include "errordialoghandler.h"
 #include "preferences/broadcastprofile.h"
 #include "preferences/usersettings.h"
@@ -30,10 +33,18 @@ struct _util_dict;
 typedef struct _util_dict shout_metadata_t;
 
 class ShoutConnection
-        : public QThread, public EncoderCallback, public NetworkOutputStreamWorker {
+        : public QThread,
+          public EncoderCallback,
+          public NetworkOutputStreamWorker,
+          public NetworkSendQueue::Sink {
     Q_OBJECT
   public:
-    ShoutConnection(BroadcastProfilePtr profile, UserSettingsPointer pConfig);
+    /// The statistics of the connection are published as controls in
+    /// the group [ShoutcastConnectionN], N = connectionIndex + 1.
+    ShoutConnection(BroadcastProfilePtr profile,
+            UserSettingsPointer pConfig,
+            SharedEncoderPoolPointer pEncoderPool,
+            int connectionIndex);
     ~ShoutConnection() override;
 
     // This is called by the Engine implementation for each sample. Encode and
@@ -43,8 +54,8 @@ class ShoutConnection
     void shutdown() override {
     }
 
-    // Called by the encoder in method 'encodebuffer()' to flush the stream to
-    // the server.
+    // Called by the shared encoder in method 'deliver()'. The data is
+    // enqueued for the sending thread.
     void write(const unsigned char* header, const unsigned char* body,
                int headerLen, int bodyLen) override;
     // gets stream position
@@ -54,6 +65,10 @@ class ShoutConnection
     // gets stream length
     int filelen() override;
 
+    // Invoked by the sending thread of m_sendQueue
+    qint64 sendNonBlocking(const char* pData, qint64 size) override;
+    void waitForWritable(int timeoutMillis) override;
+
     /** connects to server **/
     bool serverConnect();
     bool isConnected();
@@ -86,6 +101,8 @@ class ShoutConnection
 
     // Update the libshout struct with info from the current broadcast profile.
     void updateFromPreferences();
+    // Unsubscribes from the encoder, which is deleted with its last subscriber
+    void releaseEncoder();
     int getActiveTracks();
     // Check if the metadata has changed since the previous check.  We also
     // check when was the last check performed to avoid using too much CPU and
@@ -99,14 +116,11 @@ class ShoutConnection
     void errorDialog(const QString& text, const QString& detailedError);
     void infoDialog(const QString& text, const QString& detailedError);
 
-    void serverWrite(unsigned char *header, unsigned char *body,
-               int headerLen, int bodyLen);
-
 #ifndef __WINDOWS__
     void ignoreSigpipe();
 #endif
 
-    bool writeSingle(const unsigned char *data, size_t len);
+    void updateSendControls();
 
     QByteArray encodeString(const QString& string);
 
@@ -122,9 +136,23 @@ class ShoutConnection
     int m_iMetaDataLife;
     long m_iShoutStatus;
     long m_iShoutFailures;
+    // Serializes the access to m_pShout from the connection thread
+    // and the sending thread while connected
+    QMutex m_shoutMutex;
+    // Only accessed by the sending thread
+    int m_sendFailures;
+    // Guarded by m_shoutMutex
+    QString m_sendErrorStr;
+    NetworkSendQueue m_sendQueue;
+    std::unique_ptr<ControlObject> m_pSendQueueBytes;
+    std::unique_ptr<ControlObject> m_pSendLatency;
+    std::unique_ptr<ControlObject> m_pDroppedPackets;
     UserSettingsPointer m_pConfig;
     BroadcastProfilePtr m_pProfile;
-    EncoderPointer m_encoder;
+    SharedEncoderPoolPointer m_pEncoderPool;
+    SharedEncoderPointer m_encoder;
+    double m_reportedEncoderCpuLoad;
+    int m_reportedEncoderSubscribers;
     ControlProxy* m_pMasterSamplerate;
     ControlProxy* m_pBroadcastEnabled;
     // static metadata according to prefereneces
@@ -1,11 +1,18 @@
 #include "library/baseexternallibraryfeature.h"
 
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMenu>
 
 #include "library/basesqltablemodel.h"
+#include "library/dao/settingsdao.h"
 #include "library/library.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
+#include "library/treeitem.h"
 #include "moc_baseexternallibraryfeature.cpp"
 #include "util/logger.h"
 #include "widget/wlibrarysidebar.h"
@@ -14,6 +21,58 @@ namespace {
 
 const mixxx::Logger kLogger("BaseExternalLibraryFeature");
 
+const QString kTreeKeySuffix = QStringLiteral(".tree");
+
+QString importState(const QStringList& filePaths) {
+    QStringList fileStates;
+    for (const auto& filePath : filePaths) {
+        const QFileInfo fileInfo(filePath);
+        if (!fileInfo.exists()) {
+            // Optional files like the Rhythmbox playlists
+            fileStates.append(QString());
+            continue;
+        }
+        fileStates.append(QStringLiteral("%1|%2|%3")
+                        .arg(fileInfo.absoluteFilePath(),
+                                QString::number(fileInfo.size()),
+                                QString::number(fileInfo.lastModified()
+                                                        .toMSecsSinceEpoch())));
+    }
+    if (fileStates.isEmpty() || fileStates.first().isEmpty()) {
+        // The main library file is missing
+        return QString();
+    }
+    return fileStates.join(QChar('\n'));
+}
+
+QJsonArray childrenToJson(const TreeItem* pItem) {
+    QJsonArray children;
+    for (const TreeItem* pChild : pItem->children()) {
+        QJsonObject child;
+        child.insert(QStringLiteral("label"), pChild->getLabel());
+        if (pChild->getData().isValid()) {
+            child.insert(QStringLiteral("data"),
+                    QJsonValue::fromVariant(pChild->getData()));
+        }
+        if (pChild->hasChildren()) {
+            child.insert(QStringLiteral("children"), childrenToJson(pChild));
+        }
+        children.append(child);
+    }
+    return children;
+}
+
+void appendChildrenFromJson(TreeItem* pItem, const QJsonArray& children) {
+    for (const auto& value : children) {
+        const QJsonObject child = value.toObject();
+        TreeItem* pChild = pItem->appendChild(
+                child.value(QStringLiteral("label")).toString(),
+                child.value(QStringLiteral("data")).toVariant());
+        appendChildrenFromJson(pChild,
+                child.value(QStringLiteral("children")).toArray());
+    }
+}
+
 } // namespace
 
 BaseExternalLibraryFeature::BaseExternalLibraryFeature(
@@ -172,3 +231,44 @@ void BaseExternalLibraryFeature::appendTrackIdsFromRightClickIndex(
         trackIds->append(trackId);
     }
 }
+
+TreeItem* BaseExternalLibraryFeature::restoreUnchangedImport(
+        const QSqlDatabase& database,
+        const QString& settingsKey,
+        const QStringList& filePaths) {
+    const QString state = importState(filePaths);
+    if (state.isEmpty()) {
+        return nullptr;
+    }
+    SettingsDAO settings(database);
+    if (settings.getValue(settingsKey) != state) {
+        return nullptr;
+    }
+    const QJsonDocument tree = QJsonDocument::fromJson(
+            settings.getValue(settingsKey + kTreeKeySuffix).toUtf8());
+    if (!tree.isArray()) {
+        kLogger.warning() << "Discarding invalid sidebar tree of" << settingsKey;
+        return nullptr;
+    }
+    std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
+    appendChildrenFromJson(pRootItem.get(), tree.array());
+    return pRootItem.release();
+}
+
+// static
+void BaseExternalLibraryFeature::storeImport(
+        const QSqlDatabase& database,
+        const QString& settingsKey,
+        const QStringList& filePaths,
+        const TreeItem* pRootItem) {
+    SettingsDAO settings(database);
+    if (!pRootItem) {
+        settings.setValue(settingsKey, QString());
+        settings.setValue(settingsKey + kTreeKeySuffix, QString());
+        return;
+    }
+    const QJsonDocument tree(childrenToJson(pRootItem));
+    settings.setValue(settingsKey + kTreeKeySuffix,
+            QString::fromUtf8(tree.toJson(QJsonDocument::Compact)));
+    settings.setValue(settingsKey, importState(filePaths));
+}
@@ -3,6 +3,7 @@
 #include <QAction>
 #include <QModelIndex>
 #include <QPointer>
+#include <QSqlDatabase>
 
 #include "library/libraryfeature.h"
 #include "library/dao/playlistdao.h"
@@ -10,6 +11,7 @@
 
 class BaseSqlTableModel;
 class TrackCollection;
+class TreeItem;
 
 class BaseExternalLibraryFeature : public LibraryFeature {
     Q_OBJECT
@@ -34,6 +36,24 @@ class BaseExternalLibraryFeature : public LibraryFeature {
     // Must be implemented by external Libraries not copied to Mixxx DB
     virtual void appendTrackIdsFromRightClickIndex(QList<TrackId>* trackIds, QString* pPlaylist);
 
+    /// Parsing the whole collection of an external library takes a long
+    /// time. If none of the given files has been modified since the last
+    /// successful import, the tables of that import are reused and the
+    /// sidebar tree is restored as it was imported. Returns nullptr if the
+    /// files need to be imported again.
+    TreeItem* restoreUnchangedImport(
+            const QSqlDatabase& database,
+            const QString& settingsKey,
+            const QStringList& filePaths);
+    /// Remembers the size and modification time of the files together with
+    /// the sidebar tree after a successful import. Pass a nullptr to
+    /// invalidate the last import before its tables are modified.
+    static void storeImport(
+            const QSqlDatabase& database,
+            const QString& settingsKey,
+            const QStringList& filePaths,
+            const TreeItem* pRootItem);
+
   private slots:
     void slotAddToAutoDJ();
     void slotAddToAutoDJTop();
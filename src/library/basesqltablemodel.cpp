@@ -192,6 +192,65 @@ void BaseSqlTableModel::replaceRows(
     }
 }
 
+void BaseSqlTableModel::updateRowsInPlace(
+        const std::function<RowUpdate(TrackId trackId, QVector<QVariant>* pTableValues)>&
+                updateRow) {
+    QVector<bool> removedRows(m_rowInfo.size(), false);
+    int numRemovedRows = 0;
+    // Modified rows after removing all rows
+    int firstModifiedRow = -1;
+    int lastModifiedRow = -1;
+    for (int row = 0; row < m_rowInfo.size(); ++row) {
+        RowInfo& rowInfo = m_rowInfo[row];
+        switch (updateRow(rowInfo.trackId, &rowInfo.metadata)) {
+        case RowUpdate::None:
+            break;
+        case RowUpdate::Modified:
+            lastModifiedRow = row - numRemovedRows;
+            if (firstModifiedRow < 0) {
+                firstModifiedRow = lastModifiedRow;
+            }
+            break;
+        case RowUpdate::Removed:
+            removedRows[row] = true;
+            ++numRemovedRows;
+            break;
+        }
+    }
+
+    if (numRemovedRows > 0) {
+        // Remove ranges from back to front to keep the
+        // indices of the preceding ranges valid
+        int row = m_rowInfo.size() - 1;
+        while (row >= 0) {
+            if (!removedRows[row]) {
+                --row;
+                continue;
+            }
+            const int lastRow = row;
+            while (row > 0 && removedRows[row - 1]) {
+                --row;
+            }
+            beginRemoveRows(QModelIndex(), row, lastRow);
+            m_rowInfo.remove(row, lastRow - row + 1);
+            endRemoveRows();
+            --row;
+        }
+
+        TrackId2Rows trackIdToRows;
+        trackIdToRows.reserve(m_rowInfo.size());
+        for (int i = 0; i < m_rowInfo.size(); ++i) {
+            trackIdToRows[m_rowInfo[i].trackId].push_back(i);
+        }
+        m_trackIdToRows = std::move(trackIdToRows);
+    }
+
+    if (firstModifiedRow >= 0) {
+        emit dataChanged(index(firstModifiedRow, 0),
+                index(lastModifiedRow, columnCount() - 1));
+    }
+}
+
 void BaseSqlTableModel::select() {
     if (!m_bInitialized) {
         return;
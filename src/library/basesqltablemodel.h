@@ -2,6 +2,7 @@
 
 #include <QHash>
 #include <QtSql>
+#include <functional>
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackdao.h"
@@ -99,6 +100,20 @@ class BaseSqlTableModel : public BaseTrackTableModel {
   protected:
     QList<TrackRef> getTrackRefs(const QModelIndexList& indices) const;
 
+    enum class RowUpdate {
+        None,
+        Modified,
+        Removed,
+    };
+    /// Applies a modification of the underlying table to the cached rows
+    /// instead of selecting all rows again. The callback receives the
+    /// table column values of each row and may modify them. Rows are
+    /// removed in contiguous ranges and all modifications are announced
+    /// by a single dataChanged() signal.
+    void updateRowsInPlace(
+            const std::function<RowUpdate(TrackId trackId, QVector<QVariant>* pTableValues)>&
+                    updateRow);
+
     QSqlDatabase m_database;
     QString m_tableName;
 
@@ -223,8 +223,10 @@ bool BaseTrackCache::updateTrackInIndex(
         QVector<QVariant>& record = m_trackInfo[trackId];
         // preallocate memory for all columns at once
         record.resize(numColumns);
+        // Read all columns from a single, consistent snapshot
+        const auto pSnapshot = pTrack->getRecordSnapshot();
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            getTrackValueForColumn(pTrack, *pSnapshot, i, record[i]);
         }
         if (m_bIsCaching) {
             replaceRecentTrack(std::move(trackId), std::move(pTrack));
@@ -341,9 +343,10 @@ void BaseTrackCache::updateTracksInIndex(const QSet<TrackId>& trackIds) {
     emit tracksChanged(trackIds);
 }
 
-void BaseTrackCache::getTrackValueForColumn(TrackPointer pTrack,
-                                            int column,
-                                            QVariant& trackValue) const {
+void BaseTrackCache::getTrackValueForColumn(const TrackPointer& pTrack,
+        const mixxx::TrackRecord& record,
+        int column,
+        QVariant& trackValue) const {
     if (!pTrack || column < 0) {
         return;
     }
@@ -352,73 +355,78 @@ void BaseTrackCache::getTrackValueForColumn(TrackPointer pTrack,
         replaceRecentTrack(pTrack);
     }
 
+    const mixxx::TrackInfo& trackInfo = record.getMetadata().getTrackInfo();
+
     // TODO(XXX) Qt properties could really help here.
     // TODO(rryan) this is all TrackDAO specific. What about iTunes/RB/etc.?
     if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ARTIST) == column) {
-        trackValue.setValue(pTrack->getArtist());
+        trackValue.setValue(trackInfo.getArtist());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TITLE) == column) {
-        trackValue.setValue(pTrack->getTitle());
+        trackValue.setValue(trackInfo.getTitle());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ALBUM) == column) {
-        trackValue.setValue(pTrack->getAlbum());
+        trackValue.setValue(record.getMetadata().getAlbumInfo().getTitle());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST) == column) {
-        trackValue.setValue(pTrack->getAlbumArtist());
+        trackValue.setValue(record.getMetadata().getAlbumInfo().getArtist());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) == column) {
-        trackValue.setValue(pTrack->getYear());
+        trackValue.setValue(trackInfo.getYear());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DATETIMEADDED) == column) {
-        trackValue.setValue(pTrack->getDateAdded());
+        trackValue.setValue(record.getDateAdded());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_LAST_PLAYED_AT) == column) {
-        trackValue.setValue(pTrack->getLastPlayedAt());
+        trackValue.setValue(record.getPlayCounter().getLastPlayedAt());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_GENRE) == column) {
-        trackValue.setValue(pTrack->getGenre());
+        trackValue.setValue(trackInfo.getGenre());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER) == column) {
-        trackValue.setValue(pTrack->getComposer());
+        trackValue.setValue(trackInfo.getComposer());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_GROUPING) == column) {
-        trackValue.setValue(pTrack->getGrouping());
+        trackValue.setValue(trackInfo.getGrouping());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_FILETYPE) == column) {
-        trackValue.setValue(pTrack->getType());
+        trackValue.setValue(record.getFileType());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) == column) {
-        trackValue.setValue(pTrack->getTrackNumber());
+        trackValue.setValue(trackInfo.getTrackNumber());
     } else if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == column) {
         trackValue.setValue(QDir::toNativeSeparators(pTrack->getLocation()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COMMENT) == column) {
-        trackValue.setValue(pTrack->getComment());
+        trackValue.setValue(trackInfo.getComment());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) == column) {
-        trackValue.setValue(pTrack->getDuration());
+        trackValue.setValue(
+                record.getMetadata().getStreamInfo().getDuration().toDoubleSeconds());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) == column) {
-        trackValue.setValue(pTrack->getBitrate());
+        trackValue.setValue(
+                static_cast<int>(record.getMetadata().getStreamInfo().getBitrate()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) == column) {
-        trackValue.setValue(pTrack->getBpm());
+        const mixxx::Bpm bpm = trackInfo.getBpm();
+        trackValue.setValue(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined);
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) == column) {
-        trackValue.setValue(pTrack->getReplayGain().getRatio());
+        trackValue.setValue(trackInfo.getReplayGain().getRatio());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PLAYED) == column) {
-        trackValue.setValue(pTrack->getPlayCounter().isPlayed());
+        trackValue.setValue(record.getPlayCounter().isPlayed());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) == column) {
-        trackValue.setValue(pTrack->getPlayCounter().getTimesPlayed());
+        trackValue.setValue(record.getPlayCounter().getTimesPlayed());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) == column) {
-        trackValue.setValue(pTrack->getRating());
+        trackValue.setValue(record.getRating());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY) == column) {
-        trackValue.setValue(pTrack->getKeyText());
+        trackValue.setValue(record.getGlobalKeyText());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getKey()));
+        trackValue.setValue(static_cast<int>(record.getGlobalKey()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM_LOCK) == column) {
-        trackValue.setValue(pTrack->isBpmLocked());
+        trackValue.setValue(record.getBpmLocked());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COLOR) == column) {
-        trackValue.setValue(mixxx::RgbColor::toQVariant(pTrack->getColor()));
+        trackValue.setValue(mixxx::RgbColor::toQVariant(record.getColor()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) == column) {
-        trackValue.setValue(pTrack->getCoverInfo().coverLocation);
+        trackValue.setValue(record.getCoverInfo().coverLocation);
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH) == column ||
             fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART) == column) {
         // For sorting, we give COLUMN_LIBRARYTABLE_COVERART the same value as
         // the cover digest.
-        trackValue.setValue(pTrack->getCoverInfo().imageDigest());
+        trackValue.setValue(record.getCoverInfo().imageDigest());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_COLOR) == column) {
-        trackValue.setValue(mixxx::RgbColor::toQVariant(pTrack->getCoverInfo().color));
+        trackValue.setValue(mixxx::RgbColor::toQVariant(record.getCoverInfo().color));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_DIGEST) == column) {
-        trackValue.setValue(pTrack->getCoverInfo().imageDigest());
+        trackValue.setValue(record.getCoverInfo().imageDigest());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_SOURCE) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getCoverInfo().source));
+        trackValue.setValue(static_cast<int>(record.getCoverInfo().source));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_TYPE) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getCoverInfo().type));
+        trackValue.setValue(static_cast<int>(record.getCoverInfo().type));
     }
 }
 
@@ -433,7 +441,7 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     if (m_bIsCaching) {
         TrackPointer pTrack = getRecentTrack(trackId);
         if (pTrack) {
-            getTrackValueForColumn(pTrack, column, result);
+            getTrackValueForColumn(pTrack, *pTrack->getRecordSnapshot(), column, result);
         }
     }
 
@@ -621,9 +629,10 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
     if (sortColumns.isEmpty()) {
         return 0;
     }
+    const auto pSnapshot = pTrack->getRecordSnapshot();
     for (const auto& sc: sortColumns) {
         QVariant trackValue;
-        getTrackValueForColumn(pTrack, sc.m_column - columnOffset, trackValue);
+        getTrackValueForColumn(pTrack, *pSnapshot, sc.m_column - columnOffset, trackValue);
         trackValues.append(trackValue);
     }
 
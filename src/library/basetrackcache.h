@@ -19,6 +19,10 @@
 class SearchQueryParser;
 class TrackCollection;
 
+namespace mixxx {
+class TrackRecord;
+} // namespace mixxx
+
 class SortColumn {
   public:
     SortColumn(int column, Qt::SortOrder order)
@@ -96,8 +100,13 @@ class BaseTrackCache : public QObject {
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
-    void getTrackValueForColumn(TrackPointer pTrack, int column,
-                                QVariant& trackValue) const;
+    /// The record must be a snapshot of the track, see
+    /// Track::getRecordSnapshot(). Callers reading multiple columns
+    /// of the same track should take the snapshot only once.
+    void getTrackValueForColumn(const TrackPointer& pTrack,
+            const mixxx::TrackRecord& record,
+            int column,
+            QVariant& trackValue) const;
 
     int findSortInsertionPoint(TrackPointer pTrack,
                                const QList<SortColumn>& sortColumns,
@@ -1,6 +1,7 @@
 #include "library/browse/browsefeature.h"
 
 #include <QAction>
+#include <QDir>
 #include <QFileInfo>
 #include <QMenu>
 #include <QPushButton>
@@ -44,6 +45,10 @@ BrowseFeature::BrowseFeature(
             this,
             &LibraryFeature::restoreModelState);
 
+    // Remember the metadata of browsed files across sessions
+    BrowseThread::getInstanceRef()->openMetadataCache(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("browse_metadata.cache")));
+
     m_pAddQuickLinkAction = new QAction(tr("Add to Quick Links"),this);
     connect(m_pAddQuickLinkAction,
             &QAction::triggered,
@@ -0,0 +1,227 @@
+#include "library/browse/browsemetadatacache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("BrowseMetadataCache");
+
+constexpr quint32 kCacheFileMagic = 0x4D58424D; // "MXBM"
+constexpr quint32 kCacheFormatVersion = 1;
+
+void writeTrackMetadata(QDataStream* pStream, const mixxx::TrackMetadata& trackMetadata) {
+    const auto& trackInfo = trackMetadata.getTrackInfo();
+    const auto& albumInfo = trackMetadata.getAlbumInfo();
+    const auto& streamInfo = trackMetadata.getStreamInfo();
+    *pStream << trackInfo.getArtist()
+             << trackInfo.getTitle()
+             << albumInfo.getTitle()
+             << albumInfo.getArtist()
+             << trackInfo.getTrackNumber()
+             << trackInfo.getYear()
+             << trackInfo.getGenre()
+             << trackInfo.getComposer()
+             << trackInfo.getComment()
+             << trackInfo.getGrouping()
+             << trackInfo.getKey()
+             << trackInfo.getBpm().valueOr(mixxx::Bpm::kValueUndefined)
+             << trackInfo.getReplayGain().getRatio()
+             << streamInfo.getDuration().toDoubleSeconds()
+             << static_cast<quint32>(streamInfo.getBitrate().value());
+}
+
+mixxx::TrackMetadata readTrackMetadata(QDataStream* pStream) {
+    QString artist;
+    QString title;
+    QString album;
+    QString albumArtist;
+    QString trackNumber;
+    QString year;
+    QString genre;
+    QString composer;
+    QString comment;
+    QString grouping;
+    QString key;
+    double bpm;
+    double replayGainRatio;
+    double durationSeconds;
+    quint32 bitrate;
+    *pStream >> artist >> title >> album >> albumArtist >> trackNumber >> year >> genre >>
+            composer >> comment >> grouping >> key >> bpm >> replayGainRatio >>
+            durationSeconds >> bitrate;
+
+    mixxx::TrackMetadata trackMetadata;
+    auto& trackInfo = trackMetadata.refTrackInfo();
+    trackInfo.setArtist(artist);
+    trackInfo.setTitle(title);
+    trackInfo.setTrackNumber(trackNumber);
+    trackInfo.setYear(year);
+    trackInfo.setGenre(genre);
+    trackInfo.setComposer(composer);
+    trackInfo.setComment(comment);
+    trackInfo.setGrouping(grouping);
+    trackInfo.setKey(key);
+    trackInfo.setBpm(mixxx::Bpm(bpm));
+    mixxx::ReplayGain replayGain;
+    replayGain.setRatio(replayGainRatio);
+    trackInfo.setReplayGain(replayGain);
+    auto& albumInfo = trackMetadata.refAlbumInfo();
+    albumInfo.setTitle(album);
+    albumInfo.setArtist(albumArtist);
+    auto& streamInfo = trackMetadata.refStreamInfo();
+    streamInfo.setDuration(mixxx::Duration::fromSeconds(durationSeconds));
+    streamInfo.setBitrate(mixxx::audio::Bitrate(bitrate));
+    return trackMetadata;
+}
+
+qint64 lastModifiedMillis(const mixxx::FileInfo& fileInfo) {
+    return fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+} // anonymous namespace
+
+BrowseMetadataCache::BrowseMetadataCache(int maxEntries)
+        : m_maxEntries(maxEntries),
+          m_useCounter(0),
+          m_dirty(false) {
+}
+
+bool BrowseMetadataCache::load(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    quint32 magic;
+    quint32 version;
+    qint32 count;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kCacheFileMagic ||
+            version != kCacheFormatVersion ||
+            count < 0) {
+        kLogger.info() << "Ignoring incompatible cache file" << filePath;
+        return false;
+    }
+
+    QHash<QString, Entry> entries;
+    entries.reserve(count);
+    for (qint32 i = 0; i < count; ++i) {
+        QString location;
+        Entry entry;
+        stream >> location >> entry.fileSize >> entry.lastModifiedMillis;
+        entry.trackMetadata = readTrackMetadata(&stream);
+        if (stream.status() != QDataStream::Ok) {
+            kLogger.warning() << "Ignoring truncated cache file" << filePath;
+            return false;
+        }
+        // Entries are stored from least to most recently used
+        entry.lastUsed = static_cast<quint64>(i);
+        entries.insert(location, std::move(entry));
+    }
+
+    const auto locker = lockMutex(&m_mutex);
+    m_entries = std::move(entries);
+    m_useCounter = static_cast<quint64>(count);
+    m_dirty = false;
+    return true;
+}
+
+bool BrowseMetadataCache::save(const QString& filePath) {
+    std::vector<std::pair<quint64, QHash<QString, Entry>::const_iterator>> entries;
+    const auto locker = lockMutex(&m_mutex);
+    if (!m_dirty) {
+        return true;
+    }
+    entries.reserve(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        entries.emplace_back(it->lastUsed, it);
+    }
+    std::sort(entries.begin(),
+            entries.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            });
+    const auto first = entries.size() > static_cast<size_t>(m_maxEntries)
+            ? entries.end() - m_maxEntries
+            : entries.begin();
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to open cache file" << filePath;
+        return false;
+    }
+    QDataStream stream(&file);
+    stream << kCacheFileMagic
+           << kCacheFormatVersion
+           << static_cast<qint32>(entries.end() - first);
+    for (auto it = first; it != entries.end(); ++it) {
+        const auto& entry = it->second;
+        stream << entry.key() << entry->fileSize << entry->lastModifiedMillis;
+        writeTrackMetadata(&stream, entry->trackMetadata);
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning() << "Failed to write cache file" << filePath;
+        return false;
+    }
+    QStringList evictedLocations;
+    for (auto it = entries.begin(); it != first; ++it) {
+        evictedLocations.append(it->second.key());
+    }
+    for (const auto& location : evictedLocations) {
+        m_entries.remove(location);
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool BrowseMetadataCache::lookup(
+        const mixxx::FileInfo& fileInfo,
+        mixxx::TrackMetadata* pTrackMetadata) {
+    const QString location = fileInfo.location();
+    const qint64 fileSize = fileInfo.sizeInBytes();
+    const qint64 lastModified = lastModifiedMillis(fileInfo);
+    const auto locker = lockMutex(&m_mutex);
+    const auto it = m_entries.find(location);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    if (it->fileSize != fileSize || it->lastModifiedMillis != lastModified) {
+        m_entries.erase(it);
+        m_dirty = true;
+        return false;
+    }
+    // Updating the usage does not mark the cache as dirty,
+    // otherwise it would be rewritten after each lookup.
+    it->lastUsed = ++m_useCounter;
+    *pTrackMetadata = it->trackMetadata;
+    return true;
+}
+
+void BrowseMetadataCache::insert(
+        const mixxx::FileInfo& fileInfo,
+        const mixxx::TrackMetadata& trackMetadata) {
+    Entry entry;
+    entry.fileSize = fileInfo.sizeInBytes();
+    entry.lastModifiedMillis = lastModifiedMillis(fileInfo);
+    entry.trackMetadata = trackMetadata;
+    const QString location = fileInfo.location();
+    const auto locker = lockMutex(&m_mutex);
+    entry.lastUsed = ++m_useCounter;
+    m_entries.insert(location, std::move(entry));
+    m_dirty = true;
+}
+
+int BrowseMetadataCache::size() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_entries.size();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "track/trackmetadata.h"
+#include "util/fileinfo.h"
+
+/// Remembers the metadata of the files that have been listed in the
+/// browse view, so that revisiting a directory does not require to
+/// read the tags of all files again.
+///
+/// Only the properties that are displayed in the browse view are
+/// cached. An entry is valid as long as the size and the modification
+/// time of the file are unchanged. The least recently used entries are
+/// discarded when saving if the cache has grown beyond its limit.
+///
+/// All functions are thread-safe.
+class BrowseMetadataCache final {
+  public:
+    static constexpr int kDefaultMaxEntries = 50000;
+
+    explicit BrowseMetadataCache(int maxEntries = kDefaultMaxEntries);
+
+    /// Replaces all entries with the contents of the file.
+    bool load(const QString& filePath);
+    /// Writes all entries to the file if they have been modified
+    /// since the last time they have been loaded or saved.
+    bool save(const QString& filePath);
+
+    bool lookup(
+            const mixxx::FileInfo& fileInfo,
+            mixxx::TrackMetadata* pTrackMetadata);
+    void insert(
+            const mixxx::FileInfo& fileInfo,
+            const mixxx::TrackMetadata& trackMetadata);
+
+    int size() const;
+
+  private:
+    struct Entry {
+        qint64 fileSize;
+        qint64 lastModifiedMillis;
+        quint64 lastUsed;
+        mixxx::TrackMetadata trackMetadata;
+    };
+
+    mutable QMutex m_mutex;
+    const int m_maxEntries;
+    QHash<QString, Entry> m_entries;
+    quint64 m_useCounter;
+    bool m_dirty;
+};
@@ -2,6 +2,7 @@
 
 #include <QMessageBox>
 #include <QMetaType>
+#include <QSignalBlocker>
 #include <QStringList>
 #include <QTableView>
 #include <QUrl>
@@ -161,6 +162,7 @@ BrowseTableModel::BrowseTableModel(QObject* parent,
     // register the QList<T> as a metatype since we use QueuedConnection below
     qRegisterMetaType<QList<QList<QStandardItem*>>>(
             "QList< QList<QStandardItem*>>");
+    qRegisterMetaType<QList<QStandardItem*>>("QList<QStandardItem*>");
     qRegisterMetaType<BrowseTableModel*>("BrowseTableModel*");
 
     m_pBrowseThread = BrowseThread::getInstanceRef();
@@ -176,6 +178,12 @@ BrowseTableModel::BrowseTableModel(QObject* parent,
             &BrowseTableModel::slotInsert,
             Qt::QueuedConnection);
 
+    connect(m_pBrowseThread.data(),
+            &BrowseThread::rowMetadataRead,
+            this,
+            &BrowseTableModel::slotRowMetadataRead,
+            Qt::QueuedConnection);
+
     connect(&PlayerInfo::instance(),
             &PlayerInfo::trackChanged,
             this,
@@ -351,6 +359,7 @@ QMimeData* BrowseTableModel::mimeData(const QModelIndexList& indexes) const {
 void BrowseTableModel::slotClear(BrowseTableModel* caller_object) {
     if (caller_object == this) {
         removeRows(0, rowCount());
+        m_rowsByLocation.clear();
     }
 }
 
@@ -362,12 +371,49 @@ void BrowseTableModel::slotInsert(const QList<QList<QStandardItem*>>& rows,
     if (caller_object == this) {
         //qDebug() << "BrowseTableModel::slotInsert";
         for (int i = 0; i < rows.size(); ++i) {
+            const QString location =
+                    rows.at(i).at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString();
+            m_rowsByLocation.insert(location, rowCount());
             appendRow(rows.at(i));
         }
         emit restoreModelState();
     }
 }
 
+void BrowseTableModel::slotRowMetadataRead(const QList<QStandardItem*>& rowItems,
+        BrowseTableModel* caller_object) {
+    if (caller_object != this) {
+        return;
+    }
+    const QString location =
+            rowItems.at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString();
+    const int row = m_rowsByLocation.value(location, -1);
+    if (row < 0 ||
+            item(row, COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString() !=
+                    location) {
+        // Another directory has been selected in the meantime
+        qDeleteAll(rowItems);
+        return;
+    }
+    // Update the existing items and notify the views only once
+    // for the whole row. The preview state is kept.
+    {
+        const QSignalBlocker signalBlocker(this);
+        for (int column = 0; column < rowItems.size(); ++column) {
+            if (column == COLUMN_PREVIEW) {
+                continue;
+            }
+            QStandardItem* pItem = item(row, column);
+            const QStandardItem* pReadItem = rowItems.at(column);
+            pItem->setText(pReadItem->text());
+            pItem->setToolTip(pReadItem->toolTip());
+            pItem->setData(pReadItem->data(Qt::UserRole), Qt::UserRole);
+        }
+    }
+    qDeleteAll(rowItems);
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
 TrackModel::Capabilities BrowseTableModel::getCapabilities() const {
     return Capability::AddToTrackSet |
             Capability::AddToAutoDJ |
@@ -408,6 +454,16 @@ Qt::ItemFlags BrowseTableModel::flags(const QModelIndex& index) const {
     }
 }
 
+void BrowseTableModel::setVisibleTracks(const QModelIndexList& indices) {
+    // The pending metadata of the visible rows is read first
+    QStringList locations;
+    locations.reserve(indices.size());
+    for (const auto& index : indices) {
+        locations.append(getTrackLocation(index));
+    }
+    m_pBrowseThread->prioritizeMetadata(locations);
+}
+
 bool BrowseTableModel::setData(
         const QModelIndex& index,
         const QVariant& value,
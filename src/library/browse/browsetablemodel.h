@@ -1,7 +1,8 @@
 #pragma once
 
-#include <QStandardItemModel>
+#include <QHash>
 #include <QMimeData>
+#include <QStandardItemModel>
 
 #include "library/trackmodel.h"
 #include "recording/recordingmanager.h"
@@ -77,6 +78,7 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
     bool setData(const QModelIndex& index, const QVariant& value, int role=Qt::EditRole) override;
     QAbstractItemDelegate* delegateForColumn(const int i, QObject* pParent) override;
     bool isColumnSortable(int column) const override;
+    void setVisibleTracks(const QModelIndexList& indices) override;
     TrackModel::SortColumnId sortColumnIdFromColumnIndex(int index) const override;
     int columnIndexFromSortColumnId(TrackModel::SortColumnId sortColumn) const override;
     QString modelKey(bool noSearch) const override;
@@ -96,6 +98,7 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
   public slots:
     void slotClear(BrowseTableModel*);
     void slotInsert(const QList<QList<QStandardItem*>>&, BrowseTableModel*);
+    void slotRowMetadataRead(const QList<QStandardItem*>&, BrowseTableModel*);
     void trackChanged(const QString& group, TrackPointer pNewTrack, TrackPointer pOldTrack);
 
   private:
@@ -111,4 +114,6 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
     int m_columnIndexBySortColumnId[static_cast<int>(TrackModel::SortColumnId::IdMax)];
     QMap<int, TrackModel::SortColumnId> m_sortColumnIdByColumnIndex;
 
+    QHash<QString, int> m_rowsByLocation;
+
 };
@@ -2,6 +2,7 @@
 
 #include <QDateTime>
 #include <QDirIterator>
+#include <QRunnable>
 #include <QStringList>
 #include <QtDebug>
 
@@ -9,12 +10,45 @@
 #include "moc_browsethread.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/compatibility/qmutex.h"
 #include "util/datetime.h"
+#include "util/math.h"
+#include "util/time.h"
 #include "util/trace.h"
 
 QWeakPointer<BrowseThread> BrowseThread::m_weakInstanceRef;
 static QMutex s_Mutex;
 
+namespace {
+
+// Reading tags is mostly bound by I/O, particularly on network shares
+constexpr int kMaxMetadataReaders = 4;
+
+// Listing a directory is fast, so rows are appended in large batches
+constexpr int kRowsPerBatch = 100;
+
+// Saving rewrites the whole cache file, which is also saved on exit
+constexpr mixxx::Duration kMinMetadataCacheSaveInterval =
+        mixxx::Duration::fromSeconds(60);
+
+} // anonymous namespace
+
+class BrowseThread::MetadataReader : public QRunnable {
+  public:
+    MetadataReader(BrowseThread* pThread, int generation)
+            : m_pThread(pThread),
+              m_generation(generation) {
+    }
+
+    void run() override {
+        m_pThread->readPendingMetadata(m_generation);
+    }
+
+  private:
+    BrowseThread* const m_pThread;
+    const int m_generation;
+};
+
 /*
  * This class is a singleton and represents a thread
  * that is used to read ID3 metadata
@@ -27,9 +61,14 @@ static QMutex s_Mutex;
  * make sense to use this class in non-GUI threads
  */
 BrowseThread::BrowseThread(QObject *parent)
-        : QThread(parent) {
+        : QThread(parent),
+          m_generation(0),
+          m_numActiveReaders(0),
+          m_pendingModel(nullptr),
+          m_metadataCacheSavedAt(mixxx::Time::elapsed()) {
     m_bStopThread = false;
     m_model_observer = nullptr;
+    m_metadataPool.setMaxThreadCount(kMaxMetadataReaders);
     //start Thread
     start(QThread::LowPriority);
 
@@ -44,6 +83,14 @@ BrowseThread::~BrowseThread() {
     //terminate();
     wait();
     qDebug() << "Browser background thread terminated!";
+    {
+        const auto locker = lockMutex(&m_pending_mutex);
+        ++m_generation;
+    }
+    m_metadataPool.waitForDone();
+    if (!m_metadataCacheFile.isEmpty()) {
+        m_metadataCache.save(m_metadataCacheFile);
+    }
 }
 
 // static
@@ -69,6 +116,25 @@ void BrowseThread::executePopulation(mixxx::FileAccess path, BrowseTableModel* c
     m_locationUpdated.wakeAll();
 }
 
+void BrowseThread::openMetadataCache(const QString& filePath) {
+    DEBUG_ASSERT(m_metadataCacheFile.isEmpty());
+    m_metadataCacheFile = filePath;
+    if (m_metadataCache.load(filePath)) {
+        qDebug() << "Loaded" << m_metadataCache.size()
+                 << "cached browse entries from" << filePath;
+    }
+}
+
+void BrowseThread::prioritizeMetadata(const QStringList& locations) {
+    const auto locker = lockMutex(&m_pending_mutex);
+    m_prioritizedFiles.clear();
+    for (const auto& location : locations) {
+        if (m_pendingFiles.contains(location)) {
+            m_prioritizedFiles.enqueue(location);
+        }
+    }
+}
+
 void BrowseThread::run() {
     QThread::currentThread()->setObjectName("BrowseThread");
     m_mutex.lock();
@@ -108,6 +174,145 @@ public:
   }
 };
 
+// Creates the items of a row. If the metadata has not been read
+// yet only the file properties are filled in.
+QList<QStandardItem*> createRowItems(
+        const mixxx::FileAccess& fileAccess,
+        const mixxx::TrackMetadata& trackMetadata,
+        bool hasMetadata) {
+    QList<QStandardItem*> row_data;
+
+    QStandardItem* item = new QStandardItem("0");
+    item->setData("0", Qt::UserRole);
+    row_data.insert(COLUMN_PREVIEW, item);
+
+    item = new QStandardItem(fileAccess.info().fileName());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_FILENAME, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TITLE, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
+    item->setToolTip(item->text());
+    item->setData(item->text().toInt(), Qt::UserRole);
+    row_data.insert(COLUMN_TRACK_NUMBER, item);
+
+    const QString year(trackMetadata.getTrackInfo().getYear());
+    item = new YearItem(year);
+    item->setToolTip(year);
+    // The year column is sorted according to the numeric calendar year
+    item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
+    row_data.insert(COLUMN_YEAR, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GENRE, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMPOSER, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMMENT, item);
+
+    // Don't display a zero duration while the metadata is pending
+    QString duration = hasMetadata
+            ? trackMetadata.getDurationText(
+                      mixxx::Duration::Precision::SECONDS)
+            : QString();
+    item = new QStandardItem(duration);
+    item->setToolTip(item->text());
+    item->setData(trackMetadata.getStreamInfo()
+                          .getDuration()
+                          .toDoubleSeconds(),
+            Qt::UserRole);
+    row_data.insert(COLUMN_DURATION, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
+    item->setToolTip(item->text());
+    const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
+    item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
+    row_data.insert(COLUMN_BPM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_KEY, item);
+
+    item = new QStandardItem(fileAccess.info().suffix());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TYPE, item);
+
+    item = new QStandardItem(trackMetadata.getBitrateText());
+    item->setToolTip(item->text());
+    item->setData(
+            static_cast<qlonglong>(
+                    trackMetadata.getStreamInfo().getBitrate().value()),
+            Qt::UserRole);
+    row_data.insert(COLUMN_BITRATE, item);
+
+    QString location = fileAccess.info().location();
+    QString nativeLocation = QDir::toNativeSeparators(location);
+    item = new QStandardItem(nativeLocation);
+    item->setToolTip(nativeLocation);
+    item->setData(location, Qt::UserRole);
+    row_data.insert(COLUMN_NATIVELOCATION, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUMARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GROUPING, item);
+
+    const auto fileLastModified =
+            fileAccess.info().lastModified();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileLastModified));
+    item->setToolTip(item->text());
+    item->setData(fileLastModified, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
+
+    const auto fileCreated =
+            fileAccess.info().birthTime();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileCreated));
+    item->setToolTip(item->text());
+    item->setData(fileCreated, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_CREATION_TIME, item);
+
+    const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
+    item = new QStandardItem(
+            mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_REPLAYGAIN, item);
+
+    return row_data;
+}
+
 } // namespace
 
 void BrowseThread::populateModel() {
@@ -116,6 +321,17 @@ void BrowseThread::populateModel() {
     BrowseTableModel* thisModelObserver = m_model_observer;
     m_path_mutex.unlock();
 
+    // Stop reading the metadata of the previous directory
+    int generation;
+    {
+        const auto locker = lockMutex(&m_pending_mutex);
+        generation = ++m_generation;
+        m_pendingModel = thisModelObserver;
+        m_pendingFiles.clear();
+        m_pendingQueue.clear();
+        m_prioritizedFiles.clear();
+    }
+
     if (!thisPath.info().hasLocation()) {
         // Abort if the location is inaccessible or does not exist
         qWarning() << "Skipping" << thisPath.info();
@@ -136,7 +352,6 @@ void BrowseThread::populateModel() {
 
     QList<QList<QStandardItem*>> rows;
 
-    int row = 0;
     // Iterate over the files
     while (fileIt.hasNext()) {
         // If a user quickly jumps through the folders
@@ -151,158 +366,110 @@ void BrowseThread::populateModel() {
             return;
         }
 
-        QList<QStandardItem*> row_data;
-
-        QStandardItem* item = new QStandardItem("0");
-        item->setData("0", Qt::UserRole);
-        row_data.insert(COLUMN_PREVIEW, item);
-
         const auto fileAccess = mixxx::FileAccess(
                 mixxx::FileInfo(fileIt.next()),
                 thisPath.token());
-        {
-            mixxx::TrackMetadata trackMetadata;
-            SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
-                    fileAccess,
-                    &trackMetadata,
-                    nullptr);
-
-            item = new QStandardItem(fileAccess.info().fileName());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_FILENAME, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TITLE, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
-            item->setToolTip(item->text());
-            item->setData(item->text().toInt(), Qt::UserRole);
-            row_data.insert(COLUMN_TRACK_NUMBER, item);
-
-            const QString year(trackMetadata.getTrackInfo().getYear());
-            item = new YearItem(year);
-            item->setToolTip(year);
-            // The year column is sorted according to the numeric calendar year
-            item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
-            row_data.insert(COLUMN_YEAR, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GENRE, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMPOSER, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMMENT, item);
-
-            QString duration = trackMetadata.getDurationText(
-                    mixxx::Duration::Precision::SECONDS);
-            item = new QStandardItem(duration);
-            item->setToolTip(item->text());
-            item->setData(trackMetadata.getStreamInfo()
-                                  .getDuration()
-                                  .toDoubleSeconds(),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_DURATION, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
-            item->setToolTip(item->text());
-            const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
-            item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
-            row_data.insert(COLUMN_BPM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_KEY, item);
-
-            item = new QStandardItem(fileAccess.info().suffix());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TYPE, item);
-
-            item = new QStandardItem(trackMetadata.getBitrateText());
-            item->setToolTip(item->text());
-            item->setData(
-                    static_cast<qlonglong>(
-                            trackMetadata.getStreamInfo().getBitrate().value()),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_BITRATE, item);
-
-            QString location = fileAccess.info().location();
-            QString nativeLocation = QDir::toNativeSeparators(location);
-            item = new QStandardItem(nativeLocation);
-            item->setToolTip(nativeLocation);
-            item->setData(location, Qt::UserRole);
-            row_data.insert(COLUMN_NATIVELOCATION, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUMARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GROUPING, item);
-
-            const auto fileLastModified =
-                    fileAccess.info().lastModified();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileLastModified));
-            item->setToolTip(item->text());
-            item->setData(fileLastModified, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
-
-            const auto fileCreated =
-                    fileAccess.info().birthTime();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileCreated));
-            item->setToolTip(item->text());
-            item->setData(fileCreated, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_CREATION_TIME, item);
-
-            const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
-            item = new QStandardItem(
-                    mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_REPLAYGAIN, item);
+        mixxx::TrackMetadata trackMetadata;
+        if (m_metadataCache.lookup(fileAccess.info(), &trackMetadata)) {
+            rows.append(createRowItems(fileAccess, trackMetadata, true));
+        } else {
+            rows.append(createRowItems(fileAccess, trackMetadata, false));
+            const auto locker = lockMutex(&m_pending_mutex);
+            const QString location = fileAccess.info().location();
+            m_pendingFiles.insert(location, fileAccess);
+            m_pendingQueue.enqueue(location);
         }
 
-        rows.append(row_data);
-        ++row;
-        // If 10 tracks have been analyzed, send it to GUI
-        // Will limit GUI freezing
-        if (row % 10 == 0) {
+        if (rows.size() >= kRowsPerBatch) {
             // this is a blocking operation
             emit rowsAppended(rows, thisModelObserver);
             qDebug() << "Append" << rows.count() << "tracks from "
                      << thisPath.info().locationPath();
             rows.clear();
+            // The readers must not start before the rows
+            // they are going to replace have been appended.
+            startMetadataReaders(generation);
         }
-        // Sleep additionally for 20ms which prevents us from GUI freezes
-        msleep(20);
     }
     emit rowsAppended(rows, thisModelObserver);
     qDebug() << "Append last" << rows.count() << "tracks from" << thisPath.info().locationPath();
+    startMetadataReaders(generation);
+}
+
+void BrowseThread::startMetadataReaders(int generation) {
+    const auto locker = lockMutex(&m_pending_mutex);
+    if (generation != m_generation) {
+        return;
+    }
+    const int numReaders = math_min(
+            m_metadataPool.maxThreadCount() - m_numActiveReaders,
+            m_pendingQueue.size());
+    for (int i = 0; i < numReaders; ++i) {
+        ++m_numActiveReaders;
+        m_metadataPool.start(new MetadataReader(this, generation));
+    }
+}
+
+bool BrowseThread::takePendingFile(mixxx::FileAccess* pFileAccess) {
+    // Visible rows first from top to bottom, then in the order the
+    // files have been listed. Both queues may contain files whose
+    // metadata has already been read.
+    while (!m_prioritizedFiles.isEmpty()) {
+        const auto it = m_pendingFiles.find(m_prioritizedFiles.dequeue());
+        if (it != m_pendingFiles.end()) {
+            *pFileAccess = it.value();
+            m_pendingFiles.erase(it);
+            return true;
+        }
+    }
+    while (!m_pendingQueue.isEmpty()) {
+        const auto it = m_pendingFiles.find(m_pendingQueue.dequeue());
+        if (it != m_pendingFiles.end()) {
+            *pFileAccess = it.value();
+            m_pendingFiles.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void BrowseThread::readPendingMetadata(int generation) {
+    while (true) {
+        mixxx::FileAccess fileAccess;
+        BrowseTableModel* pModel;
+        {
+            const auto locker = lockMutex(&m_pending_mutex);
+            if (generation != m_generation || !takePendingFile(&fileAccess)) {
+                --m_numActiveReaders;
+                if (generation != m_generation || m_numActiveReaders > 0) {
+                    return;
+                }
+                // The last reader of the directory saves the cache
+                // unless it has been saved recently
+                const auto now = mixxx::Time::elapsed();
+                if (now - m_metadataCacheSavedAt < kMinMetadataCacheSaveInterval) {
+                    return;
+                }
+                m_metadataCacheSavedAt = now;
+                break;
+            }
+            pModel = m_pendingModel;
+        }
+        mixxx::TrackMetadata trackMetadata;
+        const auto importResult =
+                SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
+                        fileAccess,
+                        &trackMetadata,
+                        nullptr)
+                        .first;
+        if (importResult != mixxx::MetadataSource::ImportResult::Failed) {
+            m_metadataCache.insert(fileAccess.info(), trackMetadata);
+        }
+        emit rowMetadataRead(
+                createRowItems(fileAccess, trackMetadata, true),
+                pModel);
+    }
+    if (!m_metadataCacheFile.isEmpty()) {
+        m_metadataCache.save(m_metadataCacheFile);
+    }
 }
@@ -4,14 +4,20 @@
 
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QMutex>
+#include <QQueue>
 #include <QSharedPointer>
 #include <QStandardItem>
+#include <QStringList>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
 #include <QWeakPointer>
 
+#include "library/browse/browsemetadatacache.h"
+#include "util/duration.h"
 #include "util/fileaccess.h"
 
 // This class is a singleton and represents a thread
@@ -34,15 +40,35 @@ class BrowseThread : public QThread {
     void run();
     static BrowseThreadPointer getInstanceRef();
 
+    // Loads the metadata of previously browsed files. Should be
+    // called once before the first directory is populated.
+    void openMetadataCache(const QString& filePath);
+
+    // Reads the metadata of these files, in the given order, before
+    // the other pending files, e.g. because their rows are visible.
+    // Replaces the files of the previous invocation.
+    void prioritizeMetadata(const QStringList& locations);
+
   signals:
+    // The rows of a directory are appended immediately. Metadata that
+    // has not been cached is read in the background and then replaces
+    // the corresponding row.
     void rowsAppended(const QList<QList<QStandardItem*>>&, BrowseTableModel*);
+    void rowMetadataRead(const QList<QStandardItem*>&, BrowseTableModel*);
     void clearModel(BrowseTableModel*);
 
   private:
+    class MetadataReader;
+
     BrowseThread(QObject *parent = 0);
 
     void populateModel();
 
+    // Functions for reading the metadata of pending files
+    void startMetadataReaders(int generation);
+    void readPendingMetadata(int generation);
+    bool takePendingFile(mixxx::FileAccess* pFileAccess);
+
     QMutex m_mutex;
     QWaitCondition m_locationUpdated;
     volatile bool m_bStopThread;
@@ -52,5 +78,22 @@ class BrowseThread : public QThread {
     mixxx::FileAccess m_path;
     BrowseTableModel* m_model_observer;
 
+    // You must hold m_pending_mutex to touch any of the following
+    // members. The generation is incremented whenever a directory
+    // is populated, which stops the readers of the previous one.
+    QMutex m_pending_mutex;
+    int m_generation;
+    int m_numActiveReaders;
+    BrowseTableModel* m_pendingModel;
+    QHash<QString, mixxx::FileAccess> m_pendingFiles;
+    QQueue<QString> m_pendingQueue;
+    QQueue<QString> m_prioritizedFiles;
+
+    QThreadPool m_metadataPool;
+    BrowseMetadataCache m_metadataCache;
+    QString m_metadataCacheFile;
+    // Guarded by m_pending_mutex
+    mixxx::Duration m_metadataCacheSavedAt;
+
     static QWeakPointer<BrowseThread> m_weakInstanceRef;
 };
@@ -170,6 +170,7 @@ class CoverInfo : public CoverInfoRelative {
 
       private:
         friend class CoverArt;
+        friend class CoverArtCache;
         friend class CoverInfo;
         LoadedImage(Result result)
                 : result(result) {
@@ -1,14 +1,18 @@
 #include "library/coverartcache.h"
 
-#include <QFutureWatcher>
 #include <QPixmapCache>
-#include <QtConcurrentRun>
+#include <QRunnable>
+#include <QThread>
 #include <QtDebug>
+#include <functional>
 
+#include "library/coverartthumbnailstore.h"
 #include "library/coverartutils.h"
 #include "moc_coverartcache.cpp"
 #include "track/track.h"
+#include "util/compatibility/qmutex.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/thread_affinity.h"
 
 namespace {
@@ -24,6 +28,10 @@ mixxx::Logger kLogger("CoverArtCache");
 // in order to allow CoverCache handle more covers (performance gain).
 constexpr int kPixmapCacheLimit = 20480;
 
+// Decoding large images is memory intensive. Don't use more
+// threads than needed to keep up with scrolling.
+constexpr int kMaxLoaderThreads = 4;
+
 QString pixmapCacheKey(mixxx::cache_key_t hash, int width) {
     return QString("CoverArtCache_%1_%2")
             .arg(QString::number(hash), QString::number(width));
@@ -39,8 +47,72 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
 
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
+class CoverArtCache::LoadCoverTask : public QRunnable {
+  public:
+    LoadCoverTask(
+            CoverArtCache* pCache,
+            RequestId requestId,
+            std::function<void()> load)
+            : m_pCache(pCache),
+              m_requestId(requestId),
+              m_load(std::move(load)) {
+    }
+
+    void run() override {
+        {
+            const auto locker = lockMutex(&m_pCache->m_queuedTasksMutex);
+            m_pCache->m_queuedTasks.remove(m_requestId);
+        }
+        m_load();
+    }
+
+  private:
+    CoverArtCache* const m_pCache;
+    const RequestId m_requestId;
+    const std::function<void()> m_load;
+};
+
+CoverArtCache::CoverArtCache()
+        : m_nextPriority(0) {
     QPixmapCache::setCacheLimit(kPixmapCacheLimit);
+    m_loaderPool.setMaxThreadCount(
+            math_clamp(QThread::idealThreadCount(), 1, kMaxLoaderThreads));
+}
+
+CoverArtCache::~CoverArtCache() {
+    m_loaderPool.clear();
+    m_loaderPool.waitForDone();
+}
+
+void CoverArtCache::openThumbnailStore(const QString& directory) {
+    DEBUG_ASSERT(m_runningRequests.isEmpty());
+    m_pThumbnailStore = std::make_shared<CoverArtThumbnailStore>(directory);
+}
+
+QList<mixxx::cache_key_t> CoverArtCache::cancelRequests(const QObject* pRequestor) {
+    QList<mixxx::cache_key_t> canceledCacheKeys;
+    const auto locker = lockMutex(&m_queuedTasksMutex);
+    auto it = m_queuedTasks.begin();
+    while (it != m_queuedTasks.end()) {
+        // A task that could not be taken has just been started and
+        // removes itself as soon as it acquires the lock.
+        if (it.key().first != pRequestor || !m_loaderPool.tryTake(it.value())) {
+            ++it;
+            continue;
+        }
+        delete it.value();
+        m_runningRequests.remove(it.key());
+        canceledCacheKeys.append(it.key().second);
+        it = m_queuedTasks.erase(it);
+    }
+    if (kLogger.traceEnabled() && !canceledCacheKeys.isEmpty()) {
+        kLogger.trace()
+                << "Canceled"
+                << canceledCacheKeys.size()
+                << "requests of"
+                << pRequestor;
+    }
+    return canceledCacheKeys;
 }
 
 //static
@@ -101,7 +173,7 @@ QPixmap CoverArtCache::tryLoadCover(
 
     // keep a list of trackIds for which a future is currently running
     // to avoid loading the same picture again while we are loading it
-    QPair<const QObject*, mixxx::cache_key_t> requestId = qMakePair(pRequestor, requestedCacheKey);
+    const RequestId requestId = qMakePair(pRequestor, requestedCacheKey);
     if (m_runningRequests.contains(requestId)) {
         return QPixmap();
     }
@@ -140,20 +212,35 @@ QPixmap CoverArtCache::tryLoadCover(
                 << coverInfo;
     }
     m_runningRequests.insert(requestId);
-    // The watcher will be deleted in coverLoaded()
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
-            pRequestor,
-            pTrack,
-            coverInfo,
-            desiredWidth,
-            loading == Loading::Default);
-    connect(watcher,
-            &QFutureWatcher<FutureResult>::finished,
-            this,
-            &CoverArtCache::coverLoaded);
-    watcher->setFuture(future);
+    // The task is deleted by the pool after it has been run
+    auto* pTask = new LoadCoverTask(this,
+            requestId,
+            [this,
+                    pRequestor,
+                    pTrack,
+                    coverInfo,
+                    desiredWidth,
+                    signalWhenDone = loading == Loading::Default,
+                    pThumbnailStore = m_pThumbnailStore] {
+                FutureResult res = loadCover(
+                        pRequestor,
+                        pTrack,
+                        coverInfo,
+                        desiredWidth,
+                        signalWhenDone,
+                        pThumbnailStore.get());
+                QMetaObject::invokeMethod(
+                        this,
+                        [this, res = std::move(res)]() mutable {
+                            coverLoaded(std::move(res));
+                        },
+                        Qt::QueuedConnection);
+            });
+    {
+        const auto locker = lockMutex(&m_queuedTasksMutex);
+        m_queuedTasks.insert(requestId, pTask);
+    }
+    m_loaderPool.start(pTask, m_nextPriority++);
     return QPixmap();
 }
 
@@ -163,7 +250,8 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
         TrackPointer pTrack,
         CoverInfo coverInfo,
         int desiredWidth,
-        bool signalWhenDone) {
+        bool signalWhenDone,
+        CoverArtThumbnailStore* pThumbnailStore) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -180,6 +268,29 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             signalWhenDone);
     DEBUG_ASSERT(!res.coverInfoUpdated);
 
+    // Thumbnails are only keyed by the digest of the original image,
+    // legacy hashes are too short to avoid collisions.
+    const int tier = pThumbnailStore && desiredWidth > 0
+            ? CoverArtThumbnailStore::tierForWidth(desiredWidth)
+            : -1;
+    if (tier >= 0 && !coverInfo.imageDigest().isEmpty()) {
+        QImage thumbnail = pThumbnailStore->load(coverInfo.cacheKey(), tier);
+        if (!thumbnail.isNull()) {
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.location = coverInfo.type == CoverInfo::METADATA
+                    ? coverInfo.trackLocation
+                    : coverInfo.coverLocation;
+            loadedImage.image = thumbnail.width() > desiredWidth
+                    ? resizeImageWidth(thumbnail, desiredWidth)
+                    : std::move(thumbnail);
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
     auto loadedImage = coverInfo.loadImage(
             pTrack ? pTrack->getFileAccess().token() : SecurityTokenPointer());
     if (!loadedImage.image.isNull()) {
@@ -192,6 +303,10 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             pTrack->setCoverInfo(coverInfo);
         }
 
+        if (tier >= 0 && !coverInfo.imageDigest().isEmpty()) {
+            pThumbnailStore->store(coverInfo.cacheKey(), tier, loadedImage.image);
+        }
+
         // Resize image to requested size
         if (desiredWidth > 0) {
             // Adjust the cover size according to the request
@@ -207,19 +322,7 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     return res;
 }
 
-// watcher
-void CoverArtCache::coverLoaded() {
-    FutureResult res;
-    {
-        QFutureWatcher<FutureResult>* pFutureWatcher =
-                static_cast<QFutureWatcher<FutureResult>*>(sender());
-        VERIFY_OR_DEBUG_ASSERT(pFutureWatcher) {
-            return;
-        }
-        res = pFutureWatcher->result();
-        pFutureWatcher->deleteLater();
-    }
-
+void CoverArtCache::coverLoaded(FutureResult res) {
     if (kLogger.traceEnabled()) {
         kLogger.trace() << "coverLoaded" << res.coverArt;
     }
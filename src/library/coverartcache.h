@@ -1,15 +1,21 @@
 #pragma once
 
+#include <QHash>
+#include <QMutex>
 #include <QObject>
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
+#include <QThreadPool>
 #include <QtDebug>
+#include <memory>
 
 #include "library/coverart.h"
 #include "track/track_decl.h"
 #include "util/singleton.h"
 
+class CoverArtThumbnailStore;
+
 class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     Q_OBJECT
   public:
@@ -52,6 +58,17 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
                 loading);
     }
 
+    /// Stores pre-scaled thumbnails of loaded covers in the given
+    /// directory and loads small covers from there. Must be called
+    /// before the first cover is requested.
+    void openThumbnailStore(const QString& directory);
+
+    /// Cancels all requests of pRequestor that are still waiting for
+    /// a worker thread, e.g. for rows that have been scrolled out of
+    /// view. No signal is emitted for these requests. Returns the
+    /// requested cache keys of the canceled requests.
+    QList<mixxx::cache_key_t> cancelRequests(const QObject* pRequestor);
+
     // Only public for testing
     struct FutureResult {
         FutureResult()
@@ -84,11 +101,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             TrackPointer pTrack,
             CoverInfo coverInfo,
             int desiredWidth,
-            bool emitSignals);
-
-  private slots:
-    // Called when loadCover is complete in the main thread.
-    void coverLoaded();
+            bool emitSignals,
+            CoverArtThumbnailStore* pThumbnailStore = nullptr);
 
   signals:
     void coverFound(
@@ -100,10 +114,16 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
 
   protected:
     CoverArtCache();
-    ~CoverArtCache() override = default;
+    ~CoverArtCache() override;
     friend class Singleton<CoverArtCache>;
 
   private:
+    class LoadCoverTask;
+    typedef QPair<const QObject*, mixxx::cache_key_t> RequestId;
+
+    // Called when loadCover is complete in the main thread.
+    void coverLoaded(FutureResult res);
+
     static void requestCover(
             const QObject* pRequestor,
             const CoverInfo& coverInfo,
@@ -116,7 +136,20 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             int desiredWidth,
             Loading loading);
 
-    QSet<QPair<const QObject*, mixxx::cache_key_t>> m_runningRequests;
+    QSet<RequestId> m_runningRequests;
+
+    // Covers are loaded by a dedicated pool to leave the global
+    // pool for other tasks. The most recent request is served first,
+    // because it most likely belongs to a row that is still visible.
+    QThreadPool m_loaderPool;
+    int m_nextPriority;
+
+    // Requests that have not been picked up by a worker thread yet.
+    // Tasks remove themselves when they are started.
+    QMutex m_queuedTasksMutex;
+    QHash<RequestId, LoadCoverTask*> m_queuedTasks;
+
+    std::shared_ptr<CoverArtThumbnailStore> m_pThumbnailStore;
 };
 
 inline
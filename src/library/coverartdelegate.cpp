@@ -57,7 +57,20 @@ void CoverArtDelegate::emitRowsChanged(
 void CoverArtDelegate::slotInhibitLazyLoading(
         bool inhibitLazyLoading) {
     m_inhibitLazyLoading = inhibitLazyLoading;
-    if (m_inhibitLazyLoading || m_cacheMissRows.isEmpty()) {
+    if (m_inhibitLazyLoading) {
+        // While scrolling, most of the pending rows are already out
+        // of view. Drop their requests and treat them as cache misses
+        // that are requested again if still visible after scrolling.
+        if (m_pCache) {
+            const auto canceledCacheKeys = m_pCache->cancelRequests(this);
+            for (const auto cacheKey : canceledCacheKeys) {
+                m_cacheMissRows += m_pendingCacheRows.values(cacheKey);
+                m_pendingCacheRows.remove(cacheKey);
+            }
+        }
+        return;
+    }
+    if (m_cacheMissRows.isEmpty()) {
         return;
     }
     // If we can request non-cache covers now, request updates
@@ -0,0 +1,243 @@
+#include "library/coverartthumbnailstore.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QtEndian>
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CoverArtThumbnailStore");
+
+constexpr char kMagic[4] = {'M', 'X', 'C', 'T'};
+constexpr quint32 kVersion = 1;
+
+// Magic, version, tier width
+constexpr qint64 kFileHeaderSize = sizeof(kMagic) + 2 * sizeof(quint32);
+// Cache key, image size
+constexpr qint64 kRecordHeaderSize = sizeof(quint64) + sizeof(quint32);
+
+// Thumbnails are small and only displayed at their own size or
+// smaller, so a lossy format saves a lot of space without visible
+// artifacts. PNG is the fallback if no JPEG plugin is available.
+constexpr int kJpegQuality = 85;
+
+QString packFileName(int width) {
+    return QStringLiteral("thumbnails_%1.pack").arg(width);
+}
+
+QByteArray encodeImage(const QImage& image) {
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.hasAlphaChannel() && image.save(&buffer, "JPG", kJpegQuality)) {
+        return bytes;
+    }
+    buffer.seek(0);
+    bytes.clear();
+    if (image.save(&buffer, "PNG")) {
+        return bytes;
+    }
+    return QByteArray();
+}
+
+QByteArray fileHeader(int width) {
+    QByteArray header(kMagic, sizeof(kMagic));
+    header.resize(kFileHeaderSize);
+    qToLittleEndian<quint32>(kVersion, header.data() + sizeof(kMagic));
+    qToLittleEndian<quint32>(static_cast<quint32>(width),
+            header.data() + sizeof(kMagic) + sizeof(quint32));
+    return header;
+}
+
+} // anonymous namespace
+
+// static
+int CoverArtThumbnailStore::tierForWidth(int desiredWidth) {
+    for (int tier = 0; tier < kNumTiers; ++tier) {
+        if (desiredWidth <= kTierWidths[tier]) {
+            return tier;
+        }
+    }
+    return -1;
+}
+
+CoverArtThumbnailStore::CoverArtThumbnailStore(
+        const QString& directory,
+        qint64 maxPackFileSize)
+        : m_maxPackFileSize(maxPackFileSize) {
+    if (!QDir().mkpath(directory)) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << directory;
+    }
+    const QDir dir(directory);
+    for (int tier = 0; tier < kNumTiers; ++tier) {
+        PackFile* pPack = &m_packFiles[tier];
+        pPack->file.setFileName(dir.filePath(packFileName(kTierWidths[tier])));
+        if (!open(pPack, tier)) {
+            kLogger.warning()
+                    << "Thumbnails are not stored in"
+                    << pPack->file.fileName()
+                    << pPack->file.errorString();
+        }
+    }
+}
+
+CoverArtThumbnailStore::~CoverArtThumbnailStore() {
+    for (auto& pack : m_packFiles) {
+        unmap(&pack);
+    }
+}
+
+bool CoverArtThumbnailStore::open(PackFile* pPack, int tier) {
+    if (!pPack->file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    const qint64 fileSize = pPack->file.size();
+    if (fileSize < kFileHeaderSize ||
+            pPack->file.read(kFileHeaderSize) != fileHeader(kTierWidths[tier])) {
+        return reset(pPack, tier);
+    }
+    if (fileSize == kFileHeaderSize) {
+        return true;
+    }
+    pPack->pMapped = pPack->file.map(0, fileSize);
+    if (!pPack->pMapped) {
+        return reset(pPack, tier);
+    }
+    pPack->mappedSize = fileSize;
+    // Rebuild the index. A truncated record at the end is the
+    // remainder of an interrupted write and discarded.
+    qint64 offset = kFileHeaderSize;
+    while (offset + kRecordHeaderSize <= fileSize) {
+        const uchar* pRecord = pPack->pMapped + offset;
+        const auto cacheKey = qFromLittleEndian<quint64>(pRecord);
+        const auto size = qFromLittleEndian<quint32>(pRecord + sizeof(quint64));
+        if (offset + kRecordHeaderSize + size > fileSize) {
+            break;
+        }
+        pPack->index.insert(cacheKey, Record{offset + kRecordHeaderSize, size});
+        offset += kRecordHeaderSize + size;
+    }
+    if (offset < fileSize) {
+        kLogger.info()
+                << "Discarding"
+                << fileSize - offset
+                << "trailing bytes of"
+                << pPack->file.fileName();
+        unmap(pPack);
+        pPack->file.resize(offset);
+    }
+    return true;
+}
+
+bool CoverArtThumbnailStore::reset(PackFile* pPack, int tier) {
+    unmap(pPack);
+    pPack->index.clear();
+    if (!pPack->file.resize(0) || !pPack->file.seek(0)) {
+        return false;
+    }
+    return pPack->file.write(fileHeader(kTierWidths[tier])) == kFileHeaderSize;
+}
+
+void CoverArtThumbnailStore::unmap(PackFile* pPack) {
+    if (pPack->pMapped) {
+        pPack->file.unmap(pPack->pMapped);
+        pPack->pMapped = nullptr;
+        pPack->mappedSize = 0;
+    }
+}
+
+QImage CoverArtThumbnailStore::load(mixxx::cache_key_t cacheKey, int tier) {
+    VERIFY_OR_DEBUG_ASSERT(tier >= 0 && tier < kNumTiers) {
+        return QImage();
+    }
+    PackFile* pPack = &m_packFiles[tier];
+    QByteArray bytes;
+    {
+        const auto locker = lockMutex(&pPack->mutex);
+        const auto it = pPack->index.constFind(cacheKey);
+        if (it == pPack->index.constEnd()) {
+            return QImage();
+        }
+        const qint64 end = it->offset + it->size;
+        if (end > pPack->mappedSize) {
+            // The pack file has grown since it has been mapped
+            unmap(pPack);
+            const qint64 fileSize = pPack->file.size();
+            pPack->pMapped = pPack->file.map(0, fileSize);
+            if (!pPack->pMapped) {
+                return QImage();
+            }
+            pPack->mappedSize = fileSize;
+        }
+        DEBUG_ASSERT(end <= pPack->mappedSize);
+        // Copy the bytes and decode them without holding the lock
+        bytes = QByteArray(
+                reinterpret_cast<const char*>(pPack->pMapped + it->offset),
+                static_cast<int>(it->size));
+    }
+    return QImage::fromData(bytes);
+}
+
+bool CoverArtThumbnailStore::store(
+        mixxx::cache_key_t cacheKey, int tier, const QImage& image) {
+    VERIFY_OR_DEBUG_ASSERT(tier >= 0 && tier < kNumTiers) {
+        return false;
+    }
+    if (image.isNull()) {
+        return false;
+    }
+    const int width = kTierWidths[tier];
+    const QByteArray bytes = encodeImage(image.width() > width
+                    ? image.scaledToWidth(width, Qt::SmoothTransformation)
+                    : image);
+    if (bytes.isEmpty()) {
+        return false;
+    }
+
+    QByteArray record(kRecordHeaderSize, Qt::Uninitialized);
+    qToLittleEndian<quint64>(cacheKey, record.data());
+    qToLittleEndian<quint32>(static_cast<quint32>(bytes.size()),
+            record.data() + sizeof(quint64));
+    record.append(bytes);
+
+    PackFile* pPack = &m_packFiles[tier];
+    const auto locker = lockMutex(&pPack->mutex);
+    if (!pPack->file.isOpen()) {
+        return false;
+    }
+    if (pPack->index.contains(cacheKey)) {
+        return true;
+    }
+    qint64 offset = pPack->file.size();
+    if (offset + record.size() > m_maxPackFileSize) {
+        kLogger.info()
+                << "Emptying"
+                << pPack->file.fileName()
+                << "after it has reached its size limit";
+        if (!reset(pPack, tier)) {
+            return false;
+        }
+        offset = kFileHeaderSize;
+    }
+    if (!pPack->file.seek(offset) ||
+            pPack->file.write(record) != record.size() ||
+            !pPack->file.flush()) {
+        kLogger.warning()
+                << "Failed to write thumbnail to"
+                << pPack->file.fileName()
+                << pPack->file.errorString();
+        // Drop the partial record
+        unmap(pPack);
+        pPack->file.resize(offset);
+        return false;
+    }
+    pPack->index.insert(cacheKey, Record{offset + kRecordHeaderSize, static_cast<quint32>(bytes.size())});
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <array>
+
+#include "util/cache.h"
+
+/// A persistent store of pre-scaled cover art thumbnails.
+///
+/// Thumbnails are available in a few fixed size tiers. Each tier is
+/// stored in a separate pack file that is only appended to and memory
+/// mapped for reading. Thumbnails are keyed by the cache key of the
+/// original image, i.e. by its digest, so they never become stale and
+/// an index is rebuilt by scanning the pack file when it is opened. A
+/// pack file that exceeds its size limit is simply emptied.
+///
+/// All functions are thread-safe.
+class CoverArtThumbnailStore final {
+  public:
+    static constexpr int kNumTiers = 3;
+    static constexpr std::array<int, kNumTiers> kTierWidths = {32, 64, 128};
+    static constexpr qint64 kDefaultMaxPackFileSize = 64 * 1024 * 1024;
+
+    /// Returns the smallest tier whose thumbnails are at least as
+    /// wide as desiredWidth, or -1 if only the original image is
+    /// large enough.
+    static int tierForWidth(int desiredWidth);
+
+    explicit CoverArtThumbnailStore(
+            const QString& directory,
+            qint64 maxPackFileSize = kDefaultMaxPackFileSize);
+    ~CoverArtThumbnailStore();
+    CoverArtThumbnailStore(const CoverArtThumbnailStore&) = delete;
+    CoverArtThumbnailStore& operator=(const CoverArtThumbnailStore&) = delete;
+
+    /// Returns a null image if no thumbnail has been stored.
+    QImage load(mixxx::cache_key_t cacheKey, int tier);
+
+    /// Scales the image down to the width of the tier and stores it.
+    bool store(mixxx::cache_key_t cacheKey, int tier, const QImage& image);
+
+  private:
+    struct Record {
+        qint64 offset;
+        quint32 size;
+    };
+
+    struct PackFile {
+        QMutex mutex;
+        QFile file;
+        QHash<mixxx::cache_key_t, Record> index;
+        uchar* pMapped = nullptr;
+        qint64 mappedSize = 0;
+    };
+
+    bool open(PackFile* pPack, int tier);
+    bool reset(PackFile* pPack, int tier);
+    void unmap(PackFile* pPack);
+
+    const qint64 m_maxPackFileSize;
+    std::array<PackFile, kNumTiers> m_packFiles;
+};
@@ -253,13 +253,13 @@ void AutoDJCratesDAO::createAndConnectAutoDjCratesDatabase() {
     // Be notified when tracks are added/removed from playlists.
     // We only care about the auto-DJ playlist and the set-log playlists.
     connect(&m_pTrackCollectionManager->internalCollection()->getPlaylistDAO(),
-            &PlaylistDAO::trackAdded,
+            &PlaylistDAO::tracksAdded,
             this,
-            &AutoDJCratesDAO::slotPlaylistTrackAdded);
+            &AutoDJCratesDAO::slotPlaylistTracksAdded);
     connect(&m_pTrackCollectionManager->internalCollection()->getPlaylistDAO(),
-            &PlaylistDAO::trackRemoved,
+            &PlaylistDAO::tracksRemoved,
             this,
-            &AutoDJCratesDAO::slotPlaylistTrackRemoved);
+            &AutoDJCratesDAO::slotPlaylistTracksRemoved);
 
     // Be notified when tracks are loaded to, or unloaded from, a deck.
     // These count as auto-DJ references, i.e. prevent the track from being
@@ -1025,53 +1025,51 @@ void AutoDJCratesDAO::slotPlaylistDeleted(int playlistId) {
     }
 }
 
-// Signaled by the playlist DAO when a track is added to a playlist.
-void AutoDJCratesDAO::slotPlaylistTrackAdded(int playlistId, TrackId trackId,
-                                             int /* a_iPosition */) {
-    // Deal with changes to the auto-DJ playlist.
-    if (playlistId == m_iAutoDjPlaylistId) {
-        QSqlQuery oQuery(m_database);
-        // UPDATE temp_autodj_crates SET autodjrefs = autodjrefs + 1
-        // WHERE track_id = :track_id;
-        oQuery.prepare("UPDATE " AUTODJCRATES_TABLE " SET "
-            AUTODJCRATESTABLE_AUTODJREFS " = " AUTODJCRATESTABLE_AUTODJREFS
-            " + 1 WHERE " AUTODJCRATESTABLE_TRACKID " = :track_id");
-        oQuery.bindValue(":track_id", trackId.toVariant());
-        if (!oQuery.exec()) {
-            LOG_FAILED_QUERY(oQuery);
-            return;
-        }
-    } else if (m_lstSetLogPlaylistIds.contains(playlistId)) {
-        // Deal with changes to set-log playlists.
-        // If this query doesn't succeed, it'll log a message.
-        // Do nothing special otherwise -- any change it makes can be part of
-        // any current transaction.
-        updateLastPlayedDateTimeForTrack(trackId);
-    }
+// Signaled by the playlist DAO when tracks are added to a playlist.
+void AutoDJCratesDAO::slotPlaylistTracksAdded(int playlistId,
+                                              const QList<TrackId>& trackIds) {
+    updatePlaylistTracks(playlistId, trackIds, 1);
+}
+
+// Signaled by the playlist DAO when tracks are removed from a playlist.
+void AutoDJCratesDAO::slotPlaylistTracksRemoved(int playlistId,
+                                                const QList<TrackId>& trackIds) {
+    updatePlaylistTracks(playlistId, trackIds, -1);
 }
 
-// Signaled by the playlist DAO when a track is removed from a playlist.
-void AutoDJCratesDAO::slotPlaylistTrackRemoved(int playlistId,
-                                               TrackId trackId,
-                                               int /* a_iPosition */) {
+void AutoDJCratesDAO::updatePlaylistTracks(int playlistId,
+                                           const QList<TrackId>& trackIds,
+                                           int refsPerTrack) {
+    // Tracks may be contained multiple times
+    QHash<TrackId, int> occurrences;
+    for (const auto& trackId : trackIds) {
+        ++occurrences[trackId];
+    }
+
     // Deal with changes to the auto-DJ playlist.
     if (playlistId == m_iAutoDjPlaylistId) {
         QSqlQuery oQuery(m_database);
-        // UPDATE temp_autodj_crates SET autodjrefs = autodjrefs - 1 WHERE track_id = :track_id;
+        // UPDATE temp_autodj_crates SET autodjrefs = autodjrefs + :refs
+        // WHERE track_id = :track_id;
         oQuery.prepare("UPDATE " AUTODJCRATES_TABLE " SET "
             AUTODJCRATESTABLE_AUTODJREFS " = " AUTODJCRATESTABLE_AUTODJREFS
-            " - 1 WHERE " AUTODJCRATESTABLE_TRACKID " = :track_id");
-        oQuery.bindValue(":track_id", trackId.toVariant());
-        if (!oQuery.exec()) {
-            LOG_FAILED_QUERY(oQuery);
-            return;
+            " + :refs WHERE " AUTODJCRATESTABLE_TRACKID " = :track_id");
+        for (auto it = occurrences.constBegin(); it != occurrences.constEnd(); ++it) {
+            oQuery.bindValue(":refs", refsPerTrack * it.value());
+            oQuery.bindValue(":track_id", it.key().toVariant());
+            if (!oQuery.exec()) {
+                LOG_FAILED_QUERY(oQuery);
+                return;
+            }
         }
     } else if (m_lstSetLogPlaylistIds.contains(playlistId)) {
         // Deal with changes to set-log playlists.
         // If this query doesn't succeed, it'll log a message.
         // Do nothing special otherwise -- any change it makes can be part of
         // any current transaction.
-        updateLastPlayedDateTimeForTrack(trackId);
+        for (auto it = occurrences.constBegin(); it != occurrences.constEnd(); ++it) {
+            updateLastPlayedDateTimeForTrack(it.key());
+        }
     }
 }
 
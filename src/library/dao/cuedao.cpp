@@ -61,6 +61,28 @@ CuePointer cueFromRow(const QSqlRecord& row) {
     return pCue;
 }
 
+// Appends a cue to the list of cues of a track. Hot cues with
+// the same number replace each other, i.e. the last one wins.
+void appendCue(
+        QList<CuePointer>* pCues,
+        QMap<int, CuePointer>* pHotCuesByNumber,
+        const CuePointer& pCue) {
+    int hotCueNumber = pCue->getHotCue();
+    if (hotCueNumber != Cue::kNoHotCue) {
+        const auto pDuplicateCue = pHotCuesByNumber->take(hotCueNumber);
+        if (pDuplicateCue) {
+            kLogger.warning()
+                    << "Dropping hot cue"
+                    << pDuplicateCue->getId()
+                    << "with duplicate number"
+                    << hotCueNumber;
+            pCues->removeOne(pDuplicateCue);
+        }
+        pHotCuesByNumber->insert(hotCueNumber, pCue);
+    }
+    pCues->push_back(pCue);
+}
+
 } // namespace
 
 QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
@@ -86,24 +108,45 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         VERIFY_OR_DEBUG_ASSERT(pCue) {
             continue;
         }
-        int hotCueNumber = pCue->getHotCue();
-        if (hotCueNumber != Cue::kNoHotCue) {
-            const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
-            if (pDuplicateCue) {
-                kLogger.warning()
-                        << "Dropping hot cue"
-                        << pDuplicateCue->getId()
-                        << "with duplicate number"
-                        << hotCueNumber;
-                cues.removeOne(pDuplicateCue);
-            }
-            hotCuesByNumber.insert(hotCueNumber, pCue);
-        }
-        cues.push_back(pCue);
+        appendCue(&cues, &hotCuesByNumber, pCue);
     }
     return cues;
 }
 
+QHash<TrackId, QList<CuePointer>> CueDAO::getCuesForTracks(
+        const QSet<TrackId>& trackIds) const {
+    QHash<TrackId, QList<CuePointer>> cuesByTrack;
+    if (trackIds.isEmpty()) {
+        return cuesByTrack;
+    }
+
+    QStringList idList;
+    idList.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        idList << trackId.toString();
+    }
+
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    VERIFY_OR_DEBUG_ASSERT(query.exec(
+            QStringLiteral("SELECT * FROM " CUE_TABLE " WHERE track_id IN (%1)")
+                    .arg(idList.join(",")))) {
+        LOG_FAILED_QUERY(query);
+        return cuesByTrack;
+    }
+    QHash<TrackId, QMap<int, CuePointer>> hotCuesByTrack;
+    while (query.next()) {
+        const QSqlRecord record = query.record();
+        CuePointer pCue = cueFromRow(record);
+        VERIFY_OR_DEBUG_ASSERT(pCue) {
+            continue;
+        }
+        const TrackId trackId(record.value(record.indexOf("track_id")));
+        appendCue(&cuesByTrack[trackId], &hotCuesByTrack[trackId], pCue);
+    }
+    return cuesByTrack;
+}
+
 bool CueDAO::deleteCuesForTrack(TrackId trackId) const {
     qDebug() << "CueDAO::deleteCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
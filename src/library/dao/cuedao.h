@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QHash>
+#include <QSet>
 #include <QSqlDatabase>
 
 #include "library/dao/dao.h"
@@ -15,6 +17,10 @@ class CueDAO : public DAO {
     ~CueDAO() override = default;
 
     QList<CuePointer> getCuesForTrack(TrackId trackId) const;
+    // Loads the cues of multiple tracks with a single query. Tracks
+    // without any cues are omitted from the result.
+    QHash<TrackId, QList<CuePointer>> getCuesForTracks(
+            const QSet<TrackId>& trackIds) const;
 
     void saveTrackCues(TrackId trackId, const QList<CuePointer>& cueList) const;
     bool deleteCuesForTrack(TrackId trackId) const;
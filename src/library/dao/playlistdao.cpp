@@ -5,12 +5,15 @@
 #include <QRandomGenerator>
 #include <QtDebug>
 #include <QtSql>
+#include <algorithm>
+#include <limits>
 
 #include "library/autodj/autodjprocessor.h"
 #include "library/queryutil.h"
 #include "library/trackcollection.h"
 #include "track/track.h"
 #include "util/db/fwdsqlquery.h"
+#include "util/db/sqlstringformatter.h"
 #include "util/math.h"
 
 PlaylistDAO::PlaylistDAO()
@@ -371,12 +374,10 @@ bool PlaylistDAO::appendTracksToPlaylist(const QList<TrackId>& trackIds, const i
     // Commit the transaction
     transaction.commit();
 
-    insertPosition = position;
     for (const auto& trackId : trackIds) {
         m_playlistsTrackIsIn.insert(trackId, playlistId);
-        // TODO(XXX) don't emit if the track didn't add successfully.
-        emit trackAdded(playlistId, trackId, insertPosition++);
     }
+    emit tracksAdded(playlistId, trackIds);
     emit tracksChanged(QSet<int>{playlistId});
     return true;
 }
@@ -480,23 +481,41 @@ void PlaylistDAO::removeHiddenTracks(const int playlistId) {
         return;
     }
 
+    QList<int> positions;
     while (query.next()) {
-        int position = query.value(query.record().indexOf("position")).toInt();
-        removeTracksFromPlaylistInner(playlistId, position);
+        positions.append(query.value(query.record().indexOf("position")).toInt());
+    }
+    if (positions.isEmpty()) {
+        return;
     }
 
+    QList<TrackId> removedTrackIds;
+    QList<int> removedPositions;
+    if (!removeTracksFromPlaylistInner(
+                playlistId, positions, &removedTrackIds, &removedPositions)) {
+        return;
+    }
     transaction.commit();
+    emitTracksRemoved(playlistId, removedTrackIds, removedPositions);
     emit tracksChanged(QSet<int>{playlistId});
 }
 
 void PlaylistDAO::removeTracksFromPlaylistById(int playlistId, TrackId trackId) {
     ScopedTransaction transaction(m_database);
-    removeTracksFromPlaylistByIdInner(playlistId, trackId);
+    QList<TrackId> removedTrackIds;
+    QList<int> removedPositions;
+    if (!removeTracksFromPlaylistInner(playlistId,
+                getTrackPositions(playlistId, trackId),
+                &removedTrackIds,
+                &removedPositions)) {
+        return;
+    }
     transaction.commit();
+    emitTracksRemoved(playlistId, removedTrackIds, removedPositions);
     emit tracksChanged(QSet<int>{playlistId});
 }
 
-void PlaylistDAO::removeTracksFromPlaylistByIdInner(int playlistId, TrackId trackId) {
+QList<int> PlaylistDAO::getTrackPositions(int playlistId, TrackId trackId) const {
     QSqlQuery query(m_database);
     query.prepare(QStringLiteral(
             "SELECT position FROM PlaylistTracks "
@@ -505,88 +524,148 @@ void PlaylistDAO::removeTracksFromPlaylistByIdInner(int playlistId, TrackId trac
     query.bindValue(":track_id", trackId.toVariant());
 
     query.setForwardOnly(true);
+    QList<int> positions;
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
-        return;
+        return positions;
     }
 
     while (query.next()) {
-        int position = query.value(query.record().indexOf("position")).toInt();
-        removeTracksFromPlaylistInner(playlistId, position);
+        positions.append(query.value(query.record().indexOf("position")).toInt());
     }
+    return positions;
 }
 
 void PlaylistDAO::removeTrackFromPlaylist(int playlistId, int position) {
     // qDebug() << "PlaylistDAO::removeTrackFromPlaylist"
     //          << QThread::currentThread() << m_database.connectionName();
-    ScopedTransaction transaction(m_database);
-    removeTracksFromPlaylistInner(playlistId, position);
-    transaction.commit();
-    emit tracksChanged(QSet<int>{playlistId});
+    removeTracksFromPlaylist(playlistId, QList<int>{position});
 }
 
 void PlaylistDAO::removeTracksFromPlaylist(int playlistId, const QList<int>& positions) {
-    // get positions in reversed order
-    auto sortedPositons = positions;
-    std::sort(sortedPositons.begin(), sortedPositons.end(), std::greater<int>());
-
     //qDebug() << "PlaylistDAO::removeTrackFromPlaylist"
     //         << QThread::currentThread() << m_database.connectionName();
     ScopedTransaction transaction(m_database);
-    for (const auto position : qAsConst(sortedPositons)) {
-        removeTracksFromPlaylistInner(playlistId, position);
+    QList<TrackId> removedTrackIds;
+    QList<int> removedPositions;
+    if (!removeTracksFromPlaylistInner(
+                playlistId, positions, &removedTrackIds, &removedPositions)) {
+        return;
     }
     transaction.commit();
+    emitTracksRemoved(playlistId, removedTrackIds, removedPositions);
     emit tracksChanged(QSet<int>{playlistId});
 }
 
-void PlaylistDAO::removeTracksFromPlaylistInner(int playlistId, int position) {
-    QSqlQuery query(m_database);
-    query.prepare(QStringLiteral(
-            "SELECT track_id FROM PlaylistTracks "
-            "WHERE playlist_id=:id AND position=:position"));
-    query.bindValue(":id", playlistId);
-    query.bindValue(":position", position);
+bool PlaylistDAO::removeTracksFromPlaylistInner(int playlistId,
+        QList<int> positions,
+        QList<TrackId>* pRemovedTrackIds,
+        QList<int>* pRemovedPositions) {
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-        return;
+    // Look up and delete the tracks in chunks of positions instead
+    // of one-by-one
+    QStringList positionStrings;
+    positionStrings.reserve(positions.size());
+    for (const int position : std::as_const(positions)) {
+        positionStrings.append(QString::number(position));
     }
+    QSqlQuery query(m_database);
+    const bool success = SqlStringFormatter::joinListChunks(
+            positionStrings,
+            [&](const QString& positionList) {
+                query.prepare(QStringLiteral(
+                        "SELECT track_id, position FROM PlaylistTracks "
+                        "WHERE playlist_id=:id AND position IN (%1) "
+                        "ORDER BY position")
+                                      .arg(positionList));
+                query.bindValue(":id", playlistId);
+                if (!query.exec()) {
+                    LOG_FAILED_QUERY(query);
+                    return false;
+                }
+                while (query.next()) {
+                    const int position = query.value(1).toInt();
+                    pRemovedTrackIds->append(TrackId(query.value(0)));
+                    if (pRemovedPositions->isEmpty() ||
+                            pRemovedPositions->last() != position) {
+                        pRemovedPositions->append(position);
+                    }
+                }
 
-    if (!query.next()) {
-        qDebug() << "removeTrackFromPlaylist no track exists at position:"
-                 << position << "in playlist:" << playlistId;
-        return;
+                query.prepare(QStringLiteral(
+                        "DELETE FROM PlaylistTracks "
+                        "WHERE playlist_id=:id AND position IN (%1)")
+                                      .arg(positionList));
+                query.bindValue(":id", playlistId);
+                if (!query.exec()) {
+                    LOG_FAILED_QUERY(query);
+                    return false;
+                }
+                return true;
+            });
+    if (!success) {
+        return false;
     }
-    TrackId trackId(query.value(query.record().indexOf("track_id")));
-
-    // Delete the track from the playlist.
-    query.prepare(QStringLiteral(
-            "DELETE FROM PlaylistTracks "
-            "WHERE playlist_id=:id AND position=:position"));
-    query.bindValue(":id", playlistId);
-    query.bindValue(":position", position);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-        return;
+    if (pRemovedPositions->size() < positions.size()) {
+        qDebug() << "removeTracksFromPlaylist"
+                 << positions.size() - pRemovedPositions->size()
+                 << "of" << positions.size()
+                 << "positions do not exist in playlist:" << playlistId;
     }
 
+    // Close the gaps: The tracks between the i-th and the (i+1)-th
+    // removed position move up by i+1. Each track is updated only
+    // once, independent of the number of removed tracks before it.
     query.prepare(QStringLiteral(
-            "UPDATE PlaylistTracks SET position=position-1 "
-            "WHERE position>=:position AND playlist_id=:id"));
+            "UPDATE PlaylistTracks SET position=position-:shift "
+            "WHERE playlist_id=:id AND position>:lower AND position<:upper"));
     query.bindValue(":id", playlistId);
-    query.bindValue(":position", position);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    const QList<int>& removedPositions = *pRemovedPositions;
+    for (int i = 0; i < removedPositions.size(); ++i) {
+        const int lower = removedPositions[i];
+        const int upper = i + 1 < removedPositions.size()
+                ? removedPositions[i + 1]
+                : std::numeric_limits<int>::max();
+        if (upper - lower <= 1) {
+            // No tracks in between
+            continue;
+        }
+        query.bindValue(":shift", i + 1);
+        query.bindValue(":lower", lower);
+        query.bindValue(":upper", upper);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            return false;
+        }
     }
 
-    m_playlistsTrackIsIn.remove(trackId, playlistId);
+    for (const auto& trackId : qAsConst(*pRemovedTrackIds)) {
+        // Only remove a single entry, the track might still be
+        // contained in the playlist at a different position
+        const auto it = m_playlistsTrackIsIn.find(trackId, playlistId);
+        if (it != m_playlistsTrackIsIn.end()) {
+            m_playlistsTrackIsIn.erase(it);
+        }
+    }
+    return true;
+}
 
-    emit trackRemoved(playlistId, trackId, position);
+void PlaylistDAO::emitTracksRemoved(int playlistId,
+        const QList<TrackId>& trackIds,
+        const QList<int>& positions) {
+    if (trackIds.isEmpty()) {
+        return;
+    }
+    emit tracksRemoved(playlistId, trackIds, positions);
     if (getHiddenType(playlistId) == PLHT_SET_LOG) {
-        emit tracksRemovedFromPlayedHistory({trackId});
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        emit tracksRemovedFromPlayedHistory(
+                QSet<TrackId>(trackIds.constBegin(), trackIds.constEnd()));
+#else
+        emit tracksRemovedFromPlayedHistory(QSet<TrackId>::fromList(trackIds));
+#endif
     }
 }
 
@@ -631,7 +710,7 @@ bool PlaylistDAO::insertTrackIntoPlaylist(TrackId trackId, const int playlistId,
     transaction.commit();
 
     m_playlistsTrackIsIn.insert(trackId, playlistId);
-    emit trackAdded(playlistId, trackId, position);
+    emit tracksAdded(playlistId, QList<TrackId>{trackId});
     emit tracksChanged(QSet<int>{playlistId});
     return true;
 }
@@ -643,7 +722,17 @@ int PlaylistDAO::insertTracksIntoPlaylist(const QList<TrackId>& trackIds,
         return 0;
     }
 
-    int tracksAdded = 0;
+    QList<TrackId> validTrackIds;
+    validTrackIds.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        if (trackId.isValid()) {
+            validTrackIds.append(trackId);
+        }
+    }
+    if (validTrackIds.isEmpty()) {
+        return 0;
+    }
+
     ScopedTransaction transaction(m_database);
 
     int max_position = getMaxPosition(playlistId) + 1;
@@ -652,54 +741,43 @@ int PlaylistDAO::insertTracksIntoPlaylist(const QList<TrackId>& trackIds,
         position = max_position;
     }
 
-    QSqlQuery insertQuery(m_database);
-    insertQuery.prepare(QStringLiteral(
-            "INSERT INTO PlaylistTracks (playlist_id, track_id, position)"
-            "VALUES (:playlist_id, :track_id, :position)"));
+    // Make room for all tracks at once
     QSqlQuery query(m_database);
-    int insertPositon = position;
-    for (const auto& trackId : trackIds) {
-        if (!trackId.isValid()) {
-            continue;
-        }
-        // Move all tracks in playlist up by 1.
-        // TODO(XXX) We could do this in one query before the for loop.
-        query.prepare(QStringLiteral(
-                "UPDATE PlaylistTracks SET position=position+1 "
-                "WHERE position>=:position AND "
-                "playlist_id=:id"));
-        query.bindValue(":id", playlistId);
-        query.bindValue(":position", insertPositon);
+    query.prepare(QStringLiteral(
+            "UPDATE PlaylistTracks SET position=position+:count "
+            "WHERE position>=:position AND "
+            "playlist_id=:id"));
+    query.bindValue(":id", playlistId);
+    query.bindValue(":position", position);
+    query.bindValue(":count", validTrackIds.size());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return 0;
+    }
 
+    query.prepare(QStringLiteral(
+            "INSERT INTO PlaylistTracks (playlist_id, track_id, position)"
+            "VALUES (:playlist_id, :track_id, :position)"));
+    query.bindValue(":playlist_id", playlistId);
+    int insertPosition = position;
+    for (const auto& trackId : qAsConst(validTrackIds)) {
+        query.bindValue(":track_id", trackId.toVariant());
+        query.bindValue(":position", insertPosition++);
         if (!query.exec()) {
+            // Leaving a gap would corrupt the playlist, roll back
             LOG_FAILED_QUERY(query);
-            continue;
-        }
-
-        // Insert the track at the given position
-        insertQuery.bindValue(":playlist_id", playlistId);
-        insertQuery.bindValue(":track_id", trackId.toVariant());
-        insertQuery.bindValue(":position", insertPositon);
-        if (!insertQuery.exec()) {
-            LOG_FAILED_QUERY(insertQuery);
-            continue;
+            return 0;
         }
-
-        // Increment the insert position for the track.
-        ++insertPositon;
-        ++tracksAdded;
     }
 
     transaction.commit();
 
-    insertPositon = position;
-    for (const auto& trackId : trackIds) {
+    for (const auto& trackId : qAsConst(validTrackIds)) {
         m_playlistsTrackIsIn.insert(trackId, playlistId);
-        // TODO(XXX) The position is wrong if any track failed to insert.
-        emit trackAdded(playlistId, trackId, insertPositon++);
     }
+    emit tracksAdded(playlistId, validTrackIds);
     emit tracksChanged(QSet<int>{playlistId});
-    return tracksAdded;
+    return validTrackIds.size();
 }
 
 void PlaylistDAO::addPlaylistToAutoDJQueue(const int playlistId, AutoDJSendLoc loc) {
@@ -800,12 +878,15 @@ bool PlaylistDAO::copyPlaylistTracks(const int sourcePlaylistID, const int targe
     // Commit the transaction
     transaction.commit();
 
-    // Let subscribers know about each added track.
+    // Let subscribers know about all added tracks at once.
+    QList<TrackId> copiedTrackIds;
     while (query.next()) {
         TrackId copiedTrackId(query.value(0));
-        int copiedPosition = query.value(1).toInt();
         m_playlistsTrackIsIn.insert(copiedTrackId, targetPlaylistID);
-        emit trackAdded(targetPlaylistID, copiedTrackId, copiedPosition);
+        copiedTrackIds.append(copiedTrackId);
+    }
+    if (!copiedTrackIds.isEmpty()) {
+        emit tracksAdded(targetPlaylistID, copiedTrackIds);
     }
     emit tracksChanged(QSet<int>{targetPlaylistID});
     return true;
@@ -832,28 +913,49 @@ int PlaylistDAO::getMaxPosition(const int playlistId) const {
 }
 
 void PlaylistDAO::removeTracksFromPlaylists(const QList<TrackId>& trackIds) {
-    // copy the hash, because there is no guarantee that "it" is valid after remove
-    QMultiHash<TrackId, int> playlistsTrackIsInCopy = m_playlistsTrackIsIn;
-    QSet<int> playlistIds;
+    // Collect the positions of all tracks per playlist first, then
+    // remove them from each playlist at once
+    QHash<int, QList<int>> positionsByPlaylist;
+    for (const auto& trackId : trackIds) {
+        const QList<int> trackPlaylistIds = m_playlistsTrackIsIn.values(trackId);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        const auto uniquePlaylistIds =
+                QSet<int>(trackPlaylistIds.begin(), trackPlaylistIds.end());
+#else
+        const auto uniquePlaylistIds = QSet<int>::fromList(trackPlaylistIds);
+#endif
+        for (const auto playlistId : uniquePlaylistIds) {
+            positionsByPlaylist[playlistId].append(getTrackPositions(playlistId, trackId));
+        }
+    }
 
+    QSet<int> playlistIds;
+    QHash<int, QPair<QList<TrackId>, QList<int>>> removedTracksByPlaylist;
     ScopedTransaction transaction(m_database);
-    for (const auto& trackId : trackIds) {
-        for (auto it = playlistsTrackIsInCopy.constBegin();
-                it != playlistsTrackIsInCopy.constEnd();
-                ++it) {
-            if (it.key() == trackId) {
-                const auto playlistId = it.value();
-                // keep tracks in history playlists
-                if (getHiddenType(playlistId) == PlaylistDAO::PLHT_SET_LOG) {
-                    continue;
-                }
-                removeTracksFromPlaylistByIdInner(playlistId, trackId);
-                playlistIds.insert(playlistId);
-            }
+    for (auto it = positionsByPlaylist.constBegin();
+            it != positionsByPlaylist.constEnd();
+            ++it) {
+        const auto playlistId = it.key();
+        // keep tracks in history playlists
+        if (getHiddenType(playlistId) == PlaylistDAO::PLHT_SET_LOG) {
+            continue;
         }
+        auto& removedTracks = removedTracksByPlaylist[playlistId];
+        if (!removeTracksFromPlaylistInner(playlistId,
+                    it.value(),
+                    &removedTracks.first,
+                    &removedTracks.second)) {
+            return;
+        }
+        playlistIds.insert(playlistId);
     }
     transaction.commit();
 
+    for (auto it = removedTracksByPlaylist.constBegin();
+            it != removedTracksByPlaylist.constEnd();
+            ++it) {
+        emitTracksRemoved(it.key(), it.value().first, it.value().second);
+    }
     emit tracksChanged(playlistIds);
 }
 
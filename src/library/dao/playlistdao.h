@@ -126,15 +126,28 @@ class PlaylistDAO : public QObject, public virtual DAO {
     void deleted(int playlistId);
     void renamed(int playlistId, const QString& newName);
     void lockChanged(int playlistId);
-    void trackAdded(int playlistId, TrackId trackId, int position);
-    void trackRemoved(int playlistId, TrackId trackId, int position);
+    /// Emitted once per modification with all tracks that have been added.
+    void tracksAdded(int playlistId, const QList<TrackId>& trackIds);
+    /// Emitted once per modification with all tracks that have been removed
+    /// and their distinct former positions in ascending order. The remaining
+    /// tracks have been moved up to close the gaps. Always followed by
+    /// tracksChanged() for the same playlist.
+    void tracksRemoved(int playlistId,
+            const QList<TrackId>& trackIds,
+            const QList<int>& positions);
     void tracksChanged(const QSet<int>& playlistIds); // added/removed/reordered
     void tracksRemovedFromPlayedHistory(const QSet<TrackId>& playedTrackIds);
 
   private:
     bool removeTracksFromPlaylist(int playlistId, int startIndex);
-    void removeTracksFromPlaylistInner(int playlistId, int position);
-    void removeTracksFromPlaylistByIdInner(int playlistId, TrackId trackId);
+    bool removeTracksFromPlaylistInner(int playlistId,
+            QList<int> positions,
+            QList<TrackId>* pRemovedTrackIds,
+            QList<int>* pRemovedPositions);
+    QList<int> getTrackPositions(int playlistId, TrackId trackId) const;
+    void emitTracksRemoved(int playlistId,
+            const QList<TrackId>& trackIds,
+            const QList<int>& positions);
     void searchForDuplicateTrack(const int fromPosition,
                                  const int toPosition,
                                  TrackId trackID,
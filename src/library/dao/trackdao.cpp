@@ -1323,6 +1323,88 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
+constexpr ColumnPopulator kTrackColumns[] = {
+        // Location must be first and is populated manually!
+        {"track_locations.location", nullptr},
+        {"artist", setTrackArtist},
+        {"title", setTrackTitle},
+        {"album", setTrackAlbum},
+        {"album_artist", setTrackAlbumArtist},
+        {"year", setTrackYear},
+        {"genre", setTrackGenre},
+        {"composer", setTrackComposer},
+        {"grouping", setTrackGrouping},
+        {"tracknumber", setTrackNumber},
+        {"tracktotal", setTrackTotal},
+        {"filetype", setTrackFiletype},
+        {"rating", setTrackRating},
+        {"color", setTrackColor},
+        {"comment", setTrackComment},
+        {"url", setTrackUrl},
+        {"cuepoint", setTrackCuePoint},
+        {"replaygain", setTrackReplayGainRatio},
+        {"replaygain_peak", setTrackReplayGainPeak},
+        {"timesplayed", setTrackTimesPlayed},
+        {"last_played_at", setTrackLastPlayedAt},
+        {"played", setTrackPlayed},
+        {"datetime_added", setTrackDateAdded},
+        {"header_parsed", setTrackHeaderParsed},
+        {"source_synchronized_ms", setTrackSourceSynchronizedAt},
+
+        // Audio properties are set together at once. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"channels", setTrackAudioProperties},
+        {"samplerate", nullptr},
+        {"bitrate", nullptr},
+        {"duration", nullptr},
+
+        // Beat detection columns are handled by setTrackBeats. Do not change
+        // the ordering of these columns or put other columns in between them!
+        {"bpm", setTrackBeats},
+        {"beats_version", nullptr},
+        {"beats_sub_version", nullptr},
+        {"beats", nullptr},
+        {"bpm_lock", nullptr},
+
+        // Beat detection columns are handled by setTrackKey. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"key", setTrackKey},
+        {"keys_version", nullptr},
+        {"keys_sub_version", nullptr},
+        {"keys", nullptr},
+
+        // Cover art columns are handled by setTrackCoverInfo. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"coverart_source", setTrackCoverInfo},
+        {"coverart_type", nullptr},
+        {"coverart_location", nullptr},
+        {"coverart_color", nullptr},
+        {"coverart_digest", nullptr},
+        {"coverart_hash", nullptr},
+
+        // The id must be last and is only needed to assign the
+        // rows of batch queries to their tracks.
+        {"library.id", nullptr},
+};
+constexpr int kTrackColumnsCount = std::size(kTrackColumns);
+constexpr int kTrackIdColumn = kTrackColumnsCount - 1;
+
+QString trackColumnsString() {
+    QString columnsStr;
+    int columnsSize = 0;
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        columnsSize += qstrlen(kTrackColumns[i].name) + 1;
+    }
+    columnsStr.reserve(columnsSize);
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        if (i > 0) {
+            columnsStr.append(QChar(','));
+        }
+        columnsStr.append(kTrackColumns[i].name);
+    }
+    return columnsStr;
+}
+
 }  // namespace
 
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
@@ -1336,67 +1418,6 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return pTrack;
     }
 
-    constexpr ColumnPopulator columns[] = {
-            // Location must be first and is populated manually!
-            {"track_locations.location", nullptr},
-            {"artist", setTrackArtist},
-            {"title", setTrackTitle},
-            {"album", setTrackAlbum},
-            {"album_artist", setTrackAlbumArtist},
-            {"year", setTrackYear},
-            {"genre", setTrackGenre},
-            {"composer", setTrackComposer},
-            {"grouping", setTrackGrouping},
-            {"tracknumber", setTrackNumber},
-            {"tracktotal", setTrackTotal},
-            {"filetype", setTrackFiletype},
-            {"rating", setTrackRating},
-            {"color", setTrackColor},
-            {"comment", setTrackComment},
-            {"url", setTrackUrl},
-            {"cuepoint", setTrackCuePoint},
-            {"replaygain", setTrackReplayGainRatio},
-            {"replaygain_peak", setTrackReplayGainPeak},
-            {"timesplayed", setTrackTimesPlayed},
-            {"last_played_at", setTrackLastPlayedAt},
-            {"played", setTrackPlayed},
-            {"datetime_added", setTrackDateAdded},
-            {"header_parsed", setTrackHeaderParsed},
-            {"source_synchronized_ms", setTrackSourceSynchronizedAt},
-
-            // Audio properties are set together at once. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"channels", setTrackAudioProperties},
-            {"samplerate", nullptr},
-            {"bitrate", nullptr},
-            {"duration", nullptr},
-
-            // Beat detection columns are handled by setTrackBeats. Do not change
-            // the ordering of these columns or put other columns in between them!
-            {"bpm", setTrackBeats},
-            {"beats_version", nullptr},
-            {"beats_sub_version", nullptr},
-            {"beats", nullptr},
-            {"bpm_lock", nullptr},
-
-            // Beat detection columns are handled by setTrackKey. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"key", setTrackKey},
-            {"keys_version", nullptr},
-            {"keys_sub_version", nullptr},
-            {"keys", nullptr},
-
-            // Cover art columns are handled by setTrackCoverInfo. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"coverart_source", setTrackCoverInfo},
-            {"coverart_type", nullptr},
-            {"coverart_location", nullptr},
-            {"coverart_color", nullptr},
-            {"coverart_digest", nullptr},
-            {"coverart_hash", nullptr},
-    };
-    constexpr int columnsCount = std::size(columns);
-
     // Accessing the database is a time consuming operation that should not
     // be executed with a lock on the GlobalTrackCache. The GlobalTrackCache
     // will be locked again after the query has been executed (see below)
@@ -1405,25 +1426,12 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
 
     QSqlRecord queryRecord;
     {
-        QString columnsStr;
-        int columnsSize = 0;
-        for (int i = 0; i < columnsCount; ++i) {
-            columnsSize += qstrlen(columns[i].name) + 1;
-        }
-        columnsStr.reserve(columnsSize);
-        for (int i = 0; i < columnsCount; ++i) {
-            if (i > 0) {
-                columnsStr.append(QChar(','));
-            }
-            columnsStr.append(columns[i].name);
-        }
-
         QSqlQuery query(m_database);
         query.prepare(QString(
                 "SELECT %1 FROM Library "
                 "INNER JOIN track_locations ON library.location = track_locations.id "
                 "WHERE library.id = %2")
-                              .arg(columnsStr, trackId.toString()));
+                              .arg(trackColumnsString(), trackId.toString()));
         VERIFY_OR_DEBUG_ASSERT(query.exec()) {
             LOG_FAILED_QUERY(query)
                     << QString("getTrack(%1)").arg(trackId.toString());
@@ -1439,6 +1447,104 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         DEBUG_ASSERT(!query.next());
     }
 
+    return resolveTrackFromRecord(trackId, queryRecord, nullptr);
+}
+
+TrackPointerList TrackDAO::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    TrackPointerList tracks;
+    tracks.reserve(trackIds.size());
+    QSet<TrackId> uncachedTrackIds;
+    {
+        // Lookup all cached tracks at once with a single lock
+        const GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid()) {
+                tracks.append(nullptr);
+                continue;
+            }
+            const auto pTrack = cacheLocker.lookupTrackById(trackId);
+            if (!pTrack) {
+                uncachedTrackIds.insert(trackId);
+            }
+            tracks.append(pTrack);
+        }
+    }
+    if (uncachedTrackIds.isEmpty()) {
+        return tracks;
+    }
+
+    ScopedTimer t("TrackDAO::getTracksByIds");
+
+    QHash<TrackId, QSqlRecord> queryRecords;
+    QHash<TrackId, QList<CuePointer>> cues;
+    {
+        // Read all rows within a single transaction to obtain a consistent
+        // snapshot of the library and cues tables. Not possible while
+        // adding tracks that uses its own, long running transaction.
+        std::unique_ptr<SqlTransaction> pTransaction;
+        if (!m_pTransaction) {
+            pTransaction = std::make_unique<SqlTransaction>(m_database);
+        }
+
+        QSqlQuery query(m_database);
+        query.setForwardOnly(true);
+        query.prepare(QString(
+                "SELECT %1 FROM Library "
+                "INNER JOIN track_locations ON library.location = track_locations.id "
+                "WHERE library.id IN (%2)")
+                              .arg(trackColumnsString(),
+                                      joinTrackIdList(uncachedTrackIds)));
+        VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+            LOG_FAILED_QUERY(query)
+                    << "getTracksByIds" << uncachedTrackIds.size();
+            return tracks;
+        }
+        queryRecords.reserve(uncachedTrackIds.size());
+        while (query.next()) {
+            const auto trackId = TrackId(query.value(kTrackIdColumn));
+            queryRecords.insert(trackId, query.record());
+        }
+
+        cues = m_cueDao.getCuesForTracks(uncachedTrackIds);
+
+        if (pTransaction && *pTransaction) {
+            pTransaction->commit();
+        }
+    }
+
+    // The same id might be requested multiple times
+    QHash<TrackId, TrackPointer> loadedTracks;
+    loadedTracks.reserve(queryRecords.size());
+    for (int i = 0; i < trackIds.size(); ++i) {
+        if (tracks[i]) {
+            continue;
+        }
+        const TrackId trackId = trackIds[i];
+        const auto recordIter = queryRecords.constFind(trackId);
+        if (recordIter == queryRecords.constEnd()) {
+            if (trackId.isValid()) {
+                qDebug() << "Track with id =" << trackId << "not found";
+            }
+            continue;
+        }
+        const auto loadedIter = loadedTracks.constFind(trackId);
+        if (loadedIter != loadedTracks.constEnd()) {
+            tracks[i] = *loadedIter;
+            continue;
+        }
+        const QList<CuePointer> trackCues = cues.value(trackId);
+        tracks[i] = resolveTrackFromRecord(trackId, *recordIter, &trackCues);
+        loadedTracks.insert(trackId, tracks[i]);
+    }
+    return tracks;
+}
+
+TrackPointer TrackDAO::resolveTrackFromRecord(
+        TrackId trackId,
+        const QSqlRecord& queryRecord,
+        const QList<CuePointer>* pCues) const {
+    TrackPointer pTrack;
     {
         // Location is the first column.
         DEBUG_ASSERT(queryRecord.count() > 0);
@@ -1501,11 +1607,11 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     bool shouldDirty = false;
     {
         int recordCount = queryRecord.count();
-        VERIFY_OR_DEBUG_ASSERT(recordCount == columnsCount) {
-            recordCount = math_min(recordCount, columnsCount);
+        VERIFY_OR_DEBUG_ASSERT(recordCount == kTrackColumnsCount) {
+            recordCount = math_min(recordCount, kTrackColumnsCount);
         }
         for (int i = 0; i < recordCount; ++i) {
-            TrackPopulatorFn populator = columns[i].populator;
+            TrackPopulatorFn populator = kTrackColumns[i].populator;
             if (populator && (*populator)(queryRecord, i, pTrack.get())) {
                 // If any populator says the track should be dirty then we dirty it.
                 shouldDirty = true;
@@ -1513,8 +1619,9 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         }
     }
 
-    // Populate track cues from the cues table.
-    pTrack->setCuePoints(m_cueDao.getCuesForTrack(trackId));
+    // Populate track cues from the cues table unless they have
+    // already been loaded in advance.
+    pTrack->setCuePoints(pCues ? *pCues : m_cueDao.getCuesForTrack(trackId));
 
     // Normally we will set the track as clean but sometimes when loading from
     // the database we need to perform upkeep that ought to be written back to
@@ -14,7 +14,9 @@
 #include "util/class.h"
 #include "util/memory.h"
 
+class CuePointer;
 class FwdSqlQuery;
+class QSqlRecord;
 class SqlTransaction;
 class PlaylistDAO;
 class AnalysisDao;
@@ -137,6 +139,12 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    // Loads multiple tracks at once with a constant number of queries
+    // instead of multiple queries per track. The returned list has the
+    // same size and order as the given ids. Tracks that are not found
+    // or could not be loaded are returned as nullptr.
+    TrackPointerList getTracksByIds(
+            const QList<TrackId>& trackIds) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
@@ -195,6 +203,14 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     void detectCoverArtForTracksWithoutCover(volatile const bool* pCancel,
                                         QSet<TrackId>* pTracksChanged);
 
+    // Resolves a track from the cache or populates a new track object
+    // from a row of the library table. Cues are loaded separately if
+    // they have not been loaded in advance.
+    TrackPointer resolveTrackFromRecord(
+            TrackId trackId,
+            const QSqlRecord& queryRecord,
+            const QList<CuePointer>* pCues) const;
+
     // Callback for GlobalTrackCache
     mixxx::FileAccess relocateCachedTrack(
             TrackId trackId,
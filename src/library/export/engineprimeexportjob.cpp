@@ -1,8 +1,11 @@
 #include "library/export/engineprimeexportjob.h"
 
+#include <QFuture>
 #include <QHash>
 #include <QMetaMethod>
 #include <QStringList>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <QtGlobal>
 #include <array>
 #include <chrono>
@@ -14,6 +17,7 @@
 #include "library/trackcollection.h"
 #include "library/trackset/crate/crate.h"
 #include "track/track.h"
+#include "util/file.h"
 #include "util/optional.h"
 #include "util/thread_affinity.h"
 #include "waveform/waveformfactory.h"
@@ -28,6 +32,15 @@ const std::string kMixxxRootCrateName = "Mixxx";
 
 constexpr int kMaxHotCues = 8;
 
+// Tracks are loaded in batches to reduce the number of database queries
+// and round trips to the main thread while keeping the number of loaded
+// tracks and waveforms in memory bounded.
+constexpr int kLoadTracksBatchSize = 64;
+
+// Music files are usually exported to a slow external drive, which does
+// not benefit from more concurrent copies than this.
+constexpr int kMaxConcurrentConversions = 4;
+
 constexpr uint8_t kDefaultWaveformOpacity = 127;
 
 const QStringList kSupportedFileTypes = {
@@ -99,7 +112,12 @@ QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
     if (!QFile::exists(dstPath) ||
             srcFileInfo.lastModified() > QFileInfo{dstPath}.lastModified()) {
         const auto srcPath = srcFileInfo.location();
-        QFile::copy(srcPath, dstPath);
+        QFile::remove(dstPath);
+        QString errorString;
+        if (!copyFileContents(srcPath, dstPath, &errorString)) {
+            qWarning() << "Failed to copy" << srcPath << "to" << dstPath
+                       << ":" << errorString;
+        }
     }
 
     return pRequest->engineLibraryDbDir.relativeFilePath(dstPath);
@@ -168,10 +186,55 @@ bool tryGetBeatgrid(BeatsPointer pBeats,
     return true;
 }
 
+std::vector<djinterop::waveform_entry> convertWaveform(
+        const TrackPointer& pTrack, const Waveform& waveform) {
+    // Frames used interchangeably with "samples" here.
+    const auto frameCount = static_cast<int64_t>(pTrack->getDuration() * pTrack->getSampleRate());
+    int64_t samplesPerEntry =
+            el::required_waveform_samples_per_entry(pTrack->getSampleRate());
+    int64_t externalWaveformSize = (frameCount + samplesPerEntry - 1) / samplesPerEntry;
+    std::vector<djinterop::waveform_entry> externalWaveform;
+    externalWaveform.reserve(externalWaveformSize);
+    for (int64_t i = 0; i < externalWaveformSize; ++i) {
+        int64_t j = waveform.getDataSize() * i / externalWaveformSize;
+        externalWaveform.push_back({{waveform.getLow(j), kDefaultWaveformOpacity},
+                {waveform.getMid(j), kDefaultWaveformOpacity},
+                {waveform.getHigh(j), kDefaultWaveformOpacity}});
+    }
+    return externalWaveform;
+}
+
+/// The part of exporting a track that does not access the database and
+/// can be done concurrently for multiple tracks.
+struct ConvertedTrack {
+    QString relativePath;
+    std::optional<std::vector<djinterop::waveform_entry>> waveform;
+    QString errorMessage;
+};
+
+ConvertedTrack convertTrack(
+        const QSharedPointer<EnginePrimeExportRequest> pRequest,
+        const TrackPointer pTrack,
+        const Waveform* pWaveform) {
+    ConvertedTrack convertedTrack;
+    try {
+        // Copy the file, if required.
+        convertedTrack.relativePath = exportFile(pRequest, pTrack);
+    } catch (std::exception& e) {
+        // Exceptions are not propagated through QFuture
+        convertedTrack.errorMessage = QString::fromStdString(e.what());
+        return convertedTrack;
+    }
+    if (pWaveform) {
+        convertedTrack.waveform = convertWaveform(pTrack, *pWaveform);
+    }
+    return convertedTrack;
+}
+
 void exportMetadata(djinterop::database* pDatabase,
         QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
         TrackPointer pTrack,
-        const Waveform* pWaveform,
+        std::optional<std::vector<djinterop::waveform_entry>> externalWaveform,
         const QString& relativePath) {
     // Attempt to load the track in the database, using the relative path to
     // the music file.  If it exists already, take a snapshot of the track and
@@ -305,19 +368,8 @@ void exportMetadata(djinterop::database* pDatabase,
     // Write waveform.
     // Note that writing a single waveform will automatically calculate an
     // overview waveform too.
-    if (pWaveform) {
-        int64_t samplesPerEntry =
-                el::required_waveform_samples_per_entry(pTrack->getSampleRate());
-        int64_t externalWaveformSize = (frameCount + samplesPerEntry - 1) / samplesPerEntry;
-        std::vector<djinterop::waveform_entry> externalWaveform;
-        externalWaveform.reserve(externalWaveformSize);
-        for (int64_t i = 0; i < externalWaveformSize; ++i) {
-            int64_t j = pWaveform->getDataSize() * i / externalWaveformSize;
-            externalWaveform.push_back({{pWaveform->getLow(j), kDefaultWaveformOpacity},
-                    {pWaveform->getMid(j), kDefaultWaveformOpacity},
-                    {pWaveform->getHigh(j), kDefaultWaveformOpacity}});
-        }
-        snapshot.waveform = std::move(externalWaveform);
+    if (externalWaveform) {
+        snapshot.waveform = std::move(*externalWaveform);
     } else {
         qInfo() << "No waveform data found for track" << pTrack->getId()
                 << "(" << pTrack->getFileInfo().fileName() << ")";
@@ -336,29 +388,8 @@ void exportMetadata(djinterop::database* pDatabase,
     pMixxxToEnginePrimeTrackIdMap->insert(pTrack->getId(), externalTrackId);
 }
 
-void exportTrack(
-        const QSharedPointer<EnginePrimeExportRequest> pRequest,
-        djinterop::database* pDatabase,
-        QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
-        const TrackPointer pTrack,
-        const Waveform* pWaveform) {
-    // Only export supported file types.
-    if (!kSupportedFileTypes.contains(pTrack->getType())) {
-        qInfo() << "Skipping file" << pTrack->getFileInfo().fileName()
-                << "(id" << pTrack->getId() << ") as its file type"
-                << pTrack->getType() << "is not supported";
-        return;
-    }
-
-    // Copy the file, if required.
-    const auto musicFileRelativePath = exportFile(pRequest, pTrack);
-
-    // Export meta-data.
-    exportMetadata(pDatabase,
-            pMixxxToEnginePrimeTrackIdMap,
-            pTrack,
-            pWaveform,
-            musicFileRelativePath);
+bool isSupportedFileType(const TrackPointer& pTrack) {
+    return kSupportedFileTypes.contains(pTrack->getType());
 }
 
 void exportCrate(
@@ -462,22 +493,44 @@ void EnginePrimeExportJob::loadIds(const QSet<CrateId>& crateIds) {
     }
 }
 
-void EnginePrimeExportJob::loadTrack(const TrackRef& trackRef) {
+void EnginePrimeExportJob::loadTracks(int firstIndex, int count) {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(m_pTrackCollectionManager);
 
-    // Load the track.
-    m_pLastLoadedTrack = m_pTrackCollectionManager->getOrAddTrack(trackRef);
+    const QList<TrackRef> trackRefs = m_trackRefs.mid(firstIndex, count);
+
+    // Load all tracks of the batch at once.
+    QList<TrackId> trackIds;
+    trackIds.reserve(trackRefs.size());
+    for (const auto& trackRef : trackRefs) {
+        trackIds.append(trackRef.getId());
+    }
+    m_lastLoadedTracks = m_pTrackCollectionManager->getTracksByIds(trackIds);
+    DEBUG_ASSERT(m_lastLoadedTracks.size() == trackRefs.size());
+    for (int i = 0; i < trackRefs.size(); ++i) {
+        if (!m_lastLoadedTracks[i]) {
+            // Tracks without an id need to be added to the library first.
+            m_lastLoadedTracks[i] = m_pTrackCollectionManager->getOrAddTrack(trackRefs[i]);
+        }
+    }
 
-    // Load high-resolution waveform from analysis info.
+    // Load high-resolution waveforms from analysis info.
     auto& analysisDao = m_pTrackCollectionManager->internalCollection()->getAnalysisDAO();
-    const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
-            m_pLastLoadedTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
-    if (!waveformAnalyses.isEmpty()) {
-        const auto& waveformAnalysis = waveformAnalyses.first();
-        m_pLastLoadedWaveform.reset(
-                WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
-    } else {
-        m_pLastLoadedWaveform.reset();
+    m_lastLoadedWaveforms.clear();
+    m_lastLoadedWaveforms.reserve(m_lastLoadedTracks.size());
+    for (const auto& pTrack : qAsConst(m_lastLoadedTracks)) {
+        if (!pTrack) {
+            m_lastLoadedWaveforms.push_back(nullptr);
+            continue;
+        }
+        const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
+                pTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
+        if (!waveformAnalyses.isEmpty()) {
+            const auto& waveformAnalysis = waveformAnalyses.first();
+            m_lastLoadedWaveforms.emplace_back(
+                    WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
+        } else {
+            m_lastLoadedWaveforms.push_back(nullptr);
+        }
     }
 }
 
@@ -539,44 +592,99 @@ void EnginePrimeExportJob::run() {
     // We will build up a map from Mixxx track id to EL track id during export.
     QHash<TrackId, int64_t> mixxxToEnginePrimeTrackIdMap;
 
-    for (const auto& trackRef : qAsConst(m_trackRefs)) {
-        // Load each track.
+    // Music files are copied and waveforms are converted concurrently,
+    // while only this thread writes to the database in the order of the
+    // tracks. Pending conversions are abandoned when returning early.
+    QThreadPool conversionPool;
+    conversionPool.setMaxThreadCount(kMaxConcurrentConversions);
+
+    for (int firstIndex = 0; firstIndex < m_trackRefs.size();
+            firstIndex += kLoadTracksBatchSize) {
+        // Load the next batch of tracks.
         // Note that loading must happen on the same thread as the track collection
         // manager, which is not the same as this method's worker thread.
         QMetaObject::invokeMethod(
                 this,
-                "loadTrack",
+                "loadTracks",
                 Qt::BlockingQueuedConnection,
-                Q_ARG(TrackRef, trackRef));
-
-        if (m_cancellationRequested.loadAcquire() != 0) {
-            qInfo() << "Cancelling export";
-            return;
+                Q_ARG(int, firstIndex),
+                Q_ARG(int, kLoadTracksBatchSize));
+
+        std::vector<QFuture<ConvertedTrack>> convertedTracks;
+        convertedTracks.reserve(m_lastLoadedTracks.size());
+        for (int i = 0; i < m_lastLoadedTracks.size(); ++i) {
+            const TrackPointer pTrack = m_lastLoadedTracks[i];
+            if (!pTrack || !isSupportedFileType(pTrack)) {
+                convertedTracks.emplace_back();
+                continue;
+            }
+            const Waveform* pWaveform = m_lastLoadedWaveforms[i].get();
+            convertedTracks.push_back(QtConcurrent::run(&conversionPool,
+                    [pRequest = m_pRequest, pTrack, pWaveform] {
+                        return convertTrack(pRequest, pTrack, pWaveform);
+                    }));
         }
 
-        DEBUG_ASSERT(m_pLastLoadedTrack != nullptr);
+        for (int i = 0; i < m_lastLoadedTracks.size(); ++i) {
+            if (m_cancellationRequested.loadAcquire() != 0) {
+                qInfo() << "Cancelling export";
+                conversionPool.clear();
+                return;
+            }
+
+            const TrackPointer pTrack = m_lastLoadedTracks[i];
+            if (!pTrack) {
+                qWarning() << "Failed to load track"
+                           << m_trackRefs[firstIndex + i];
+                ++currProgress;
+                emit jobProgress(currProgress);
+                continue;
+            }
 
-        qInfo() << "Exporting track" << m_pLastLoadedTrack->getId().value()
-                << "at" << m_pLastLoadedTrack->getFileInfo().location() << "...";
-        try {
-            exportTrack(m_pRequest,
-                    pDb.get(),
-                    &mixxxToEnginePrimeTrackIdMap,
-                    m_pLastLoadedTrack,
-                    m_pLastLoadedWaveform.get());
-        } catch (std::exception& e) {
-            qWarning() << "Failed to export track"
-                       << m_pLastLoadedTrack->getId().value() << ":"
-                       << e.what();
-            m_lastErrorMessage = e.what();
-            emit failed(m_lastErrorMessage);
-            return;
-        }
+            // Only export supported file types.
+            if (!isSupportedFileType(pTrack)) {
+                qInfo() << "Skipping file" << pTrack->getFileInfo().fileName()
+                        << "(id" << pTrack->getId() << ") as its file type"
+                        << pTrack->getType() << "is not supported";
+                ++currProgress;
+                emit jobProgress(currProgress);
+                continue;
+            }
 
-        m_pLastLoadedTrack.reset();
+            qInfo() << "Exporting track" << pTrack->getId().value()
+                    << "at" << pTrack->getFileInfo().location() << "...";
+            ConvertedTrack convertedTrack = convertedTracks[i].result();
+            if (!convertedTrack.errorMessage.isEmpty()) {
+                qWarning() << "Failed to export track"
+                           << pTrack->getId().value() << ":"
+                           << convertedTrack.errorMessage;
+                m_lastErrorMessage = convertedTrack.errorMessage;
+                emit failed(m_lastErrorMessage);
+                conversionPool.clear();
+                return;
+            }
+            try {
+                exportMetadata(pDb.get(),
+                        &mixxxToEnginePrimeTrackIdMap,
+                        pTrack,
+                        std::move(convertedTrack.waveform),
+                        convertedTrack.relativePath);
+            } catch (std::exception& e) {
+                qWarning() << "Failed to export track"
+                           << pTrack->getId().value() << ":"
+                           << e.what();
+                m_lastErrorMessage = e.what();
+                emit failed(m_lastErrorMessage);
+                conversionPool.clear();
+                return;
+            }
 
-        ++currProgress;
-        emit jobProgress(currProgress);
+            ++currProgress;
+            emit jobProgress(currProgress);
+        }
+
+        m_lastLoadedTracks.clear();
+        m_lastLoadedWaveforms.clear();
     }
 
     // We will ensure that there is a special top-level crate representing the
@@ -8,6 +8,7 @@
 #include <QThread>
 #include <QWaitCondition>
 #include <memory>
+#include <vector>
 
 #include "library/export/engineprimeexportrequest.h"
 #include "library/trackcollectionmanager.h"
@@ -56,14 +57,14 @@ class EnginePrimeExportJob : public QThread {
     // thread of the application, which will be different to the worker thread
     // used by an instance of this class.
     void loadIds(const QSet<CrateId>& crateIdsToExport);
-    void loadTrack(const TrackRef& trackRef);
+    void loadTracks(int firstIndex, int count);
     void loadCrate(const CrateId& crateId);
 
   private:
     QList<TrackRef> m_trackRefs;
     QList<CrateId> m_crateIds;
-    TrackPointer m_pLastLoadedTrack;
-    std::unique_ptr<Waveform> m_pLastLoadedWaveform;
+    TrackPointerList m_lastLoadedTracks;
+    std::vector<std::unique_ptr<Waveform>> m_lastLoadedWaveforms;
     Crate m_lastLoadedCrate;
     QList<TrackId> m_lastLoadedCrateTrackIds;
 
@@ -28,6 +28,10 @@ TrackExportDlg::TrackExportDlg(QWidget *parent,
             &TrackExportWorker::progress,
             this,
             &TrackExportDlg::slotProgress);
+    connect(m_worker,
+            &TrackExportWorker::throughput,
+            this,
+            &TrackExportDlg::slotThroughput);
     connect(m_worker,
             &TrackExportWorker::askOverwriteMode,
             this,
@@ -55,13 +59,23 @@ void TrackExportDlg::slotProgress(const QString& filename, int progress, int cou
         statusLabel->setText(tr("Export finished"));
         finish();
     } else {
-        statusLabel->setText(tr("Exporting %1").arg(filename));
+        if (m_throughputText.isEmpty()) {
+            statusLabel->setText(tr("Exporting %1").arg(filename));
+        } else {
+            statusLabel->setText(tr("Exporting %1 (%2)").arg(filename, m_throughputText));
+        }
     }
     exportProgress->setMinimum(0);
     exportProgress->setMaximum(count);
     exportProgress->setValue(progress);
 }
 
+void TrackExportDlg::slotThroughput(double bytesPerSecond, double tracksPerSecond) {
+    m_throughputText = tr("%1 MB/s, %2 tracks/s")
+                               .arg(QString::number(bytesPerSecond / (1024 * 1024), 'f', 1),
+                                       QString::number(tracksPerSecond, 'f', 1));
+}
+
 void TrackExportDlg::slotAskOverwriteMode(
         const QString& filename,
         std::promise<TrackExportWorker::OverwriteAnswer>* promise) {
@@ -2,13 +2,35 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QFuture>
 #include <QMessageBox>
+#include <QQueue>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 
 #include "moc_trackexportworker.cpp"
 #include "track/track.h"
+#include "util/file.h"
+#include "util/performancetimer.h"
 
 namespace {
 
+// Exports are usually bound by the write bandwidth of the destination
+// drive. A few concurrent copies are enough to keep it busy while the
+// next files are read, more would only cause seeking on spinning disks.
+constexpr int kMaxConcurrentCopies = 4;
+
+struct CopyResult {
+    bool copied = false;
+    qint64 bytesCopied = 0;
+    QString errorMessage;
+};
+
+struct PendingCopy {
+    QString filename;
+    QFuture<CopyResult> result;
+};
+
 QString rewriteFilename(const mixxx::FileInfo& fileinfo, int index) {
     // We don't have total control over the inputs, so definitely
     // don't use .arg().arg().arg().
@@ -69,29 +91,109 @@ QMap<QString, mixxx::FileInfo> createCopylist(const TrackPointerList& tracks) {
 }  // namespace
 
 void TrackExportWorker::run() {
-    int i = 0;
-    QMap<QString, mixxx::FileInfo> copy_list = createCopylist(m_tracks);
+    const QMap<QString, mixxx::FileInfo> copy_list = createCopylist(m_tracks);
+    const int count = copy_list.size();
+    int done = 0;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(kMaxConcurrentCopies);
+    QQueue<PendingCopy> pendingCopies;
+
+    PerformanceTimer timer;
+    timer.start();
+    qint64 bytesCopied = 0;
+    int tracksCopied = 0;
+
+    // Copies finish in the order they have been started, so that the
+    // progress is reported in the same order as before.
+    const auto finishNextCopy = [&]() {
+        const PendingCopy copy = pendingCopies.dequeue();
+        const CopyResult result = copy.result.result();
+        if (!result.errorMessage.isEmpty()) {
+            qWarning() << result.errorMessage;
+            if (m_errorMessage.isEmpty()) {
+                m_errorMessage = result.errorMessage;
+            }
+            stop();
+            return;
+        }
+        if (!result.copied) {
+            // Stopped before the copy has been started
+            return;
+        }
+        bytesCopied += result.bytesCopied;
+        ++tracksCopied;
+        const double seconds = timer.elapsed().toDoubleSeconds();
+        if (seconds > 0) {
+            emit throughput(bytesCopied / seconds, tracksCopied / seconds);
+        }
+        ++done;
+        emit progress(copy.filename, done, count);
+    };
+
     for (auto it = copy_list.constBegin(); it != copy_list.constEnd(); ++it) {
-        // We emit progress twice per loop, which may seem excessive, but it
+        if (m_bStop.loadAcquire()) {
+            break;
+        }
+        // We emit progress twice per file, which may seem excessive, but it
         // guarantees that we emit a sane progress before we start and after
         // we end.  In between, each filename will get its own visible tick
         // on the bar, which looks really nice.
-        emit progress(it->fileName(), i, copy_list.size());
-        copyFile(*it, it.key());
+        emit progress(it->fileName(), done, count);
+        const QString dest_path = QDir(m_destDir).filePath(it.key());
+        if (!prepareDestination(*it, dest_path)) {
+            if (m_bStop.loadAcquire()) {
+                break;
+            }
+            ++done;
+            emit progress(it->fileName(), done, count);
+            continue;
+        }
+
+        // Don't read too far ahead of the destination drive.
+        while (pendingCopies.size() >= kMaxConcurrentCopies) {
+            finishNextCopy();
+        }
         if (m_bStop.loadAcquire()) {
-            emit canceled();
-            return;
+            break;
         }
-        ++i;
-        emit progress(it->fileName(), i, copy_list.size());
+
+        const QString source_path = it->canonicalLocation();
+        qDebug() << "Copying" << source_path << "to" << dest_path;
+        pendingCopies.enqueue({it->fileName(),
+                QtConcurrent::run(&pool, [this, source_path, dest_path] {
+                    CopyResult result;
+                    if (m_bStop.loadAcquire()) {
+                        return result;
+                    }
+                    QString error_string;
+                    if (!copyFileContents(source_path, dest_path, &error_string)) {
+                        result.errorMessage = tr(
+                                "Error exporting track %1 to %2: %3. Stopping.")
+                                                      .arg(source_path,
+                                                              dest_path,
+                                                              error_string);
+                        return result;
+                    }
+                    result.copied = true;
+                    result.bytesCopied = QFileInfo(dest_path).size();
+                    return result;
+                })});
+    }
+    while (!pendingCopies.isEmpty()) {
+        finishNextCopy();
+    }
+
+    // The last progress might already have caused the export to be stopped.
+    if (done < count && m_bStop.loadAcquire()) {
+        emit canceled();
     }
 }
 
-void TrackExportWorker::copyFile(
+bool TrackExportWorker::prepareDestination(
         const mixxx::FileInfo& source_fileinfo,
-        const QString& dest_filename) {
+        const QString& dest_path) {
     QString sourceFilename = source_fileinfo.canonicalLocation();
-    const QString dest_path = QDir(m_destDir).filePath(dest_filename);
     QFileInfo dest_fileinfo(dest_path);
 
     if (dest_fileinfo.exists()) {
@@ -102,19 +204,19 @@ void TrackExportWorker::copyFile(
             case OverwriteAnswer::SKIP:
             case OverwriteAnswer::SKIP_ALL:
                 qDebug() << "skipping" << sourceFilename;
-                return;
+                return false;
             case OverwriteAnswer::OVERWRITE:
             case OverwriteAnswer::OVERWRITE_ALL:
                 break;
             case OverwriteAnswer::CANCEL:
                 m_errorMessage = tr("Export process was canceled");
                 stop();
-                return;
+                return false;
             }
             break;
         case OverwriteMode::SKIP_ALL:
             qDebug() << "skipping" << sourceFilename;
-            return;
+            return false;
         case OverwriteMode::OVERWRITE_ALL:;
         }
 
@@ -128,21 +230,10 @@ void TrackExportWorker::copyFile(
             qWarning() << error_message;
             m_errorMessage = error_message;
             stop();
-            return;
+            return false;
         }
     }
-
-    qDebug() << "Copying" << sourceFilename << "to" << dest_path;
-    QFile source_file(sourceFilename);
-    if (!source_file.copy(dest_path)) {
-        const QString error_message = tr(
-                "Error exporting track %1 to %2: %3. Stopping.").arg(
-                sourceFilename, dest_path, source_file.errorString());
-        qWarning() << error_message;
-        m_errorMessage = error_message;
-        stop();
-        return;
-    }
+    return true;
 }
 
 TrackExportWorker::OverwriteAnswer TrackExportWorker::makeOverwriteRequest(
@@ -191,6 +282,6 @@ TrackExportWorker::OverwriteAnswer TrackExportWorker::makeOverwriteRequest(
 }
 
 void TrackExportWorker::stop() {
-    // We'll wait for the current file to finish copying, then stop.
+    // We'll wait for the files that are currently copied to finish, then stop.
     m_bStop = true;
 }
@@ -10,8 +10,9 @@
 #include "util/fileinfo.h"
 
 // A QThread class for copying a list of files to a single destination directory.
-// Currently does not preserve subdirectory relationships.  This class performs
-// all copies in a blocking style within its own thread.  May be canceled from
+// Currently does not preserve subdirectory relationships.  Questions about
+// existing files are asked in order from within its own thread, while a small
+// pool of threads copies the files in the background.  May be canceled from
 // another thread.
 class TrackExportWorker : public QThread {
     Q_OBJECT
@@ -48,7 +49,7 @@ class TrackExportWorker : public QThread {
         return m_errorMessage;
     }
 
-    // Cancels the export after the current copy operation.
+    // Cancels the export after the current copy operations.
     // May be called from another thread.
     void stop();
 
@@ -62,16 +63,19 @@ class TrackExportWorker : public QThread {
             const QString& filename,
             std::promise<TrackExportWorker::OverwriteAnswer>* promise);
     void progress(const QString& filename, int progress, int count);
+    // Emitted after each copied file with the average rates since the
+    // export has been started.
+    void throughput(double bytesPerSecond, double tracksPerSecond);
     void canceled();
 
   private:
-    // Copies the file at source_fileinfo to the destination directory with the
-    // name given by dest_filename (not a full path).  If the destination file
-    // exists, will emit an overwrite request signal to ask how to proceed.
-    // On unrecoverable error, sets the error message and stops the export
-    // process entirely.
-    void copyFile(const mixxx::FileInfo& source_fileinfo,
-            const QString& dest_filename);
+    // Prepares copying the file at source_fileinfo to dest_path.  If the
+    // destination file exists, will emit an overwrite request signal to ask
+    // how to proceed and removes it if it should be overwritten.  Returns
+    // false if the file should not be copied.  On unrecoverable error, sets
+    // the error message and stops the export process entirely.
+    bool prepareDestination(const mixxx::FileInfo& source_fileinfo,
+            const QString& dest_path);
 
     // Emit a signal requesting overwrite mode, and block until we get an
     // answer.  Updates m_overwriteMode appropriately.
@@ -30,6 +30,7 @@
 namespace {
 
 const QString ITDB_PATH_KEY = "mixxx.itunesfeature.itdbpath";
+const QString kImportedLibraryKey = QStringLiteral("mixxx.itunesfeature.imported");
 
 const QString kDict = "dict";
 const QString kKey = "key";
@@ -166,14 +167,6 @@ void ITunesFeature::activate() {
 void ITunesFeature::activate(bool forceReload) {
     //qDebug("ITunesFeature::activate()");
     if (!m_isActivated || forceReload) {
-
-        //Delete all table entries of iTunes feature
-        ScopedTransaction transaction(m_database);
-        clearTable("itunes_playlist_tracks");
-        clearTable("itunes_library");
-        clearTable("itunes_playlists");
-        transaction.commit();
-
         emit showTrackModel(m_pITunesTrackModel);
 
         SettingsDAO settings(m_pTrackCollection->database());
@@ -213,9 +206,9 @@ void ITunesFeature::activate(bool forceReload) {
         m_isActivated =  true;
         // Let a worker thread do the XML parsing
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        m_future = QtConcurrent::run(&ITunesFeature::importLibrary, this);
+        m_future = QtConcurrent::run(&ITunesFeature::importLibrary, this, forceReload);
 #else
-        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary);
+        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary, forceReload);
 #endif
         m_future_watcher.setFuture(m_future);
         m_title = tr("(loading) iTunes");
@@ -372,7 +365,7 @@ void ITunesFeature::guessMusicLibraryMountpoint(QXmlStreamReader& xml) {
 
 // This method is executed in a separate thread
 // via QtConcurrent::run
-TreeItem* ITunesFeature::importLibrary() {
+TreeItem* ITunesFeature::importLibrary(bool forceReload) {
     bool isTracksParsed=false;
     bool isMusicFolderLocatedAfterTracks=false;
 
@@ -382,8 +375,22 @@ TreeItem* ITunesFeature::importLibrary() {
 
     qDebug() << "ITunesFeature::importLibrary() ";
 
+    if (!forceReload) {
+        TreeItem* pRootItem = restoreUnchangedImport(
+                m_database, kImportedLibraryKey, QStringList{m_dbfile});
+        if (pRootItem) {
+            qDebug() << "iTunes library is unchanged since the last import";
+            return pRootItem;
+        }
+    }
+
     ScopedTransaction transaction(m_database);
 
+    //Delete all table entries of iTunes feature
+    clearTable("itunes_playlist_tracks");
+    clearTable("itunes_library");
+    clearTable("itunes_playlists");
+
     // By default set m_mixxxItunesRoot and m_dbItunesRoot to strip out
     // file://localhost/ from the URL. When we load the user's iTunes XML
     // configuration we may replace this with something based on the detected
@@ -441,6 +448,13 @@ TreeItem* ITunesFeature::importLibrary() {
         }
     }
 
+    // Only a complete import could be reused later.
+    const bool isImported = isTracksParsed && !xml.hasError() && !m_cancelImport;
+    storeImport(m_database,
+            kImportedLibraryKey,
+            QStringList{m_dbfile},
+            isImported ? playlist_root : nullptr);
+
     // Even if an error occurred, commit the transaction. The file may have been
     // half-parsed.
     transaction.commit();
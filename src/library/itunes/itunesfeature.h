@@ -40,7 +40,7 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
     static QString getiTunesMusicPath();
     // returns the invisible rootItem for the sidebar model
-    TreeItem* importLibrary();
+    TreeItem* importLibrary(bool forceReload);
     void guessMusicLibraryMountpoint(QXmlStreamReader& xml);
     void parseTracks(QXmlStreamReader& xml);
     void parseTrack(QXmlStreamReader& xml, QSqlQuery& query);
@@ -1,11 +1,14 @@
 #include "library/playlisttablemodel.h"
 
+#include <algorithm>
+
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "moc_playlisttablemodel.cpp"
+#include "util/assert.h"
 
 namespace {
 
@@ -19,7 +22,12 @@ PlaylistTableModel::PlaylistTableModel(QObject* parent,
         bool keepDeletedTracks)
         : TrackSetTableModel(parent, pTrackCollectionManager, settingsNamespace),
           m_iPlaylistId(-1),
-          m_keepDeletedTracks(keepDeletedTracks) {
+          m_keepDeletedTracks(keepDeletedTracks),
+          m_tracksRemovedInPlace(false) {
+    connect(&m_pTrackCollectionManager->internalCollection()->getPlaylistDAO(),
+            &PlaylistDAO::tracksRemoved,
+            this,
+            &PlaylistTableModel::playlistTracksRemoved);
     connect(&m_pTrackCollectionManager->internalCollection()->getPlaylistDAO(),
             &PlaylistDAO::tracksChanged,
             this,
@@ -125,16 +133,18 @@ void PlaylistTableModel::setTableModel(int playlistId) {
         return;
     }
 
-    m_iPlaylistId = playlistId;
-
     if (!m_keepDeletedTracks) {
         // From Mixxx 2.1 we drop tracks that have been explicitly deleted
         // in the library (mixxx_deleted = 0) from playlists.
         // These invisible tracks, consuming a playlist position number were
         // a source user of confusion in the past.
-        m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().removeHiddenTracks(m_iPlaylistId);
+        // NOTE: This must happen before switching to the new playlist,
+        // the current rows still belong to the previous one.
+        m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().removeHiddenTracks(playlistId);
     }
 
+    m_iPlaylistId = playlistId;
+
     QString playlistTableName = "playlist_" + QString::number(m_iPlaylistId);
     QSqlQuery query(m_database);
     FieldEscaper escaper(m_database);
@@ -364,8 +374,45 @@ QString PlaylistTableModel::modelKey(bool noSearch) const {
             currentSearch();
 }
 
+void PlaylistTableModel::playlistTracksRemoved(int playlistId,
+        const QList<TrackId>& trackIds,
+        const QList<int>& positions) {
+    Q_UNUSED(trackIds);
+    if (playlistId != m_iPlaylistId || !initialized() || rowCount() == 0) {
+        // Nothing to update, the rows will be selected
+        return;
+    }
+    DEBUG_ASSERT(std::is_sorted(positions.begin(), positions.end()));
+    // Drop the rows of the removed tracks and renumber the remaining
+    // rows like the DAO did, instead of selecting all rows again.
+    const int positionColumn = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+    VERIFY_OR_DEBUG_ASSERT(positionColumn >= 0) {
+        return;
+    }
+    updateRowsInPlace([&positions, positionColumn](TrackId, QVector<QVariant>* pTableValues) {
+        QVariant& value = (*pTableValues)[positionColumn];
+        const int position = value.toInt();
+        const auto it = std::lower_bound(positions.begin(), positions.end(), position);
+        if (it != positions.end() && *it == position) {
+            return RowUpdate::Removed;
+        }
+        const int numRemovedBefore = static_cast<int>(it - positions.begin());
+        if (numRemovedBefore == 0) {
+            return RowUpdate::None;
+        }
+        value = position - numRemovedBefore;
+        return RowUpdate::Modified;
+    });
+    m_tracksRemovedInPlace = true;
+}
+
 void PlaylistTableModel::playlistsChanged(const QSet<int>& playlistIds) {
     if (playlistIds.contains(m_iPlaylistId)) {
+        if (m_tracksRemovedInPlace) {
+            // Already up to date, see playlistTracksRemoved()
+            m_tracksRemovedInPlace = false;
+            return;
+        }
         select(); // Repopulate the data model.
     }
 }
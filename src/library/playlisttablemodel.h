@@ -33,6 +33,9 @@ class PlaylistTableModel final : public TrackSetTableModel {
     QString modelKey(bool noSearch) const override;
 
   private slots:
+    void playlistTracksRemoved(int playlistId,
+            const QList<TrackId>& trackIds,
+            const QList<int>& positions);
     void playlistsChanged(const QSet<int>& playlistIds);
 
   private:
@@ -40,4 +43,5 @@ class PlaylistTableModel final : public TrackSetTableModel {
 
     int m_iPlaylistId;
     bool m_keepDeletedTracks;
+    bool m_tracksRemovedInPlace;
 };
@@ -183,6 +183,18 @@ bool ProxyTrackModel::setModelSetting(const QString& name, const QVariant& value
     return m_pTrackModel->setModelSetting(name, value);
 }
 
+void ProxyTrackModel::setVisibleTracks(const QModelIndexList& indices) {
+    if (m_pTrackModel == nullptr) {
+        return;
+    }
+    QModelIndexList sourceIndices;
+    sourceIndices.reserve(indices.size());
+    for (const auto& index : indices) {
+        sourceIndices.append(mapToSource(index));
+    }
+    m_pTrackModel->setVisibleTracks(sourceIndices);
+}
+
 void ProxyTrackModel::sort(int column, Qt::SortOrder order) {
     if (m_pTrackModel->isColumnSortable(column)) {
         QSortFilterProxyModel::sort(column, order);
@@ -40,6 +40,7 @@ class ProxyTrackModel : public QSortFilterProxyModel, public TrackModel {
     QAbstractItemDelegate* delegateForColumn(const int i, QObject* pParent) final;
     QString getModelSetting(const QString& name) final;
     bool setModelSetting(const QString& name, const QVariant& value) final;
+    void setVisibleTracks(const QModelIndexList& indices) final;
     TrackModel::SortColumnId sortColumnIdFromColumnIndex(int index) const override;
     int columnIndexFromSortColumnId(TrackModel::SortColumnId sortColumn) const override;
     bool updateTrackGenre(
@@ -4,6 +4,7 @@
 
 #include <QMap>
 #include <QMessageBox>
+#include <QSet>
 #include <QSettings>
 #include <QTextCodec>
 #include <QtDebug>
@@ -13,8 +14,8 @@
 #include "library/library.h"
 #include "library/queryutil.h"
 #include "library/rekordbox/rekordbox_anlz.h"
-#include "library/rekordbox/rekordbox_pdb.h"
 #include "library/rekordbox/rekordboxconstants.h"
+#include "library/rekordbox/rekordboxpdbreader.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/treeitem.h"
@@ -249,45 +250,12 @@ QList<TreeItem*> findRekordboxDevices() {
     return foundDevices;
 }
 
-template<typename Base, typename T>
-inline bool instanceof (const T* ptr) {
-    return dynamic_cast<const Base*>(ptr) != nullptr;
-}
-
 QString toUnicode(const std::string& toConvert) {
     return QTextCodec::codecForName("UTF-16BE")
             ->toUnicode(toConvert.data(), static_cast<int>(toConvert.length()));
 }
 
-// Functions getText and parseDeviceDB are roughly based on the following Java file:
-// https://github.com/Deep-Symmetry/crate-digger/commit/f09fa9fc097a2a428c43245ddd542ac1370c1adc
-// getText is needed because the strings in the PDB file "have a variety of obscure representations".
-
-QString getText(rekordbox_pdb_t::device_sql_string_t* deviceString) {
-    QString text;
-
-    if (instanceof <rekordbox_pdb_t::device_sql_short_ascii_t>(deviceString->body())) {
-        rekordbox_pdb_t::device_sql_short_ascii_t* shortAsciiString =
-                static_cast<rekordbox_pdb_t::device_sql_short_ascii_t*>(deviceString->body());
-        text = QString::fromStdString(shortAsciiString->text());
-    } else if (instanceof <rekordbox_pdb_t::device_sql_long_ascii_t>(deviceString->body())) {
-        rekordbox_pdb_t::device_sql_long_ascii_t* longAsciiString =
-                static_cast<rekordbox_pdb_t::device_sql_long_ascii_t*>(deviceString->body());
-        text = QString::fromStdString(longAsciiString->text());
-    } else if (instanceof <rekordbox_pdb_t::device_sql_long_utf16be_t>(deviceString->body())) {
-        rekordbox_pdb_t::device_sql_long_utf16be_t* longUtf16beString =
-                static_cast<rekordbox_pdb_t::device_sql_long_utf16be_t*>(deviceString->body());
-        text = toUnicode(longUtf16beString->text());
-    }
-
-    // Some strings read from Rekordbox *.PDB files contain random null characters
-    // which if not removed cause Mixxx to crash when attempting to read file paths
-    return text.remove(QChar('\x0'));
-}
-
 int createDevicePlaylist(QSqlDatabase& database, const QString& devicePath) {
-    int playlistID = -1;
-
     QSqlQuery queryInsertIntoDevicePlaylist(database);
     queryInsertIntoDevicePlaylist.prepare(
             "INSERT INTO " + kRekordboxPlaylistsTable +
@@ -299,24 +267,10 @@ int createDevicePlaylist(QSqlDatabase& database, const QString& devicePath) {
     if (!queryInsertIntoDevicePlaylist.exec()) {
         LOG_FAILED_QUERY(queryInsertIntoDevicePlaylist)
                 << "devicePath: " << devicePath;
-        return playlistID;
+        return -1;
     }
 
-    QSqlQuery idQuery(database);
-    idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-    idQuery.bindValue(":path", devicePath);
-
-    if (!idQuery.exec()) {
-        LOG_FAILED_QUERY(idQuery)
-                << "devicePath: " << devicePath;
-        return playlistID;
-    }
-
-    while (idQuery.next()) {
-        playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-    }
-
-    return playlistID;
+    return queryInsertIntoDevicePlaylist.lastInsertId().toInt();
 }
 
 mixxx::RgbColor colorFromID(int colorID) {
@@ -341,33 +295,33 @@ mixxx::RgbColor colorFromID(int colorID) {
     return kColorForIDNoColor;
 }
 
-void insertTrack(
-        QSqlDatabase& database,
-        rekordbox_pdb_t::track_row_t* track,
+// Returns the id of the inserted track or -1 on failure
+int insertTrack(
+        const mixxx::rekordboxpdb::TrackRow& track,
         QSqlQuery& query,
         QSqlQuery& queryInsertIntoDevicePlaylistTracks,
-        QMap<uint32_t, QString>& artistsMap,
-        QMap<uint32_t, QString>& albumsMap,
-        QMap<uint32_t, QString>& genresMap,
-        QMap<uint32_t, QString>& keysMap,
+        const QHash<quint32, QString>& artistsMap,
+        const QHash<quint32, QString>& albumsMap,
+        const QHash<quint32, QString>& genresMap,
+        const QHash<quint32, QString>& keysMap,
         const QString& devicePath,
         const QString& device,
         int audioFilesCount) {
-    int rbID = static_cast<int>(track->id());
-    QString title = getText(track->title());
-    QString artist = artistsMap[track->artist_id()];
-    QString album = albumsMap[track->album_id()];
-    QString year = QString::number(track->year());
-    QString genre = genresMap[track->genre_id()];
-    QString location = devicePath + getText(track->file_path());
-    float bpm = static_cast<float>(track->tempo() / 100.0);
-    int bitrate = static_cast<int>(track->bitrate());
-    QString key = keysMap[track->key_id()];
-    int playtime = static_cast<int>(track->duration());
-    int rating = static_cast<int>(track->rating());
-    QString comment = getText(track->comment());
-    QString tracknumber = QString::number(track->track_number());
-    QString anlzPath = devicePath + getText(track->analyze_path());
+    int rbID = static_cast<int>(track.id());
+    QString title = track.title();
+    QString artist = artistsMap.value(track.artistId());
+    QString album = albumsMap.value(track.albumId());
+    QString year = QString::number(track.year());
+    QString genre = genresMap.value(track.genreId());
+    QString location = devicePath + track.filePath();
+    float bpm = static_cast<float>(track.tempo() / 100.0);
+    int bitrate = static_cast<int>(track.bitrate());
+    QString key = keysMap.value(track.keyId());
+    int playtime = static_cast<int>(track.duration());
+    int rating = static_cast<int>(track.rating());
+    QString comment = track.comment();
+    QString tracknumber = QString::number(track.trackNumber());
+    QString anlzPath = devicePath + track.analyzePath();
 
     query.bindValue(":rb_id", rbID);
     query.bindValue(":artist", artist);
@@ -387,26 +341,13 @@ void insertTrack(
     query.bindValue(":device", device);
     query.bindValue(":color",
             mixxx::RgbColor::toQVariant(
-                    colorFromID(static_cast<int>(track->color_id()))));
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
+                    colorFromID(static_cast<int>(track.colorId()))));
 
     int trackID = -1;
-    QSqlQuery finderQuery(database);
-    finderQuery.prepare("select id from " + kRekordboxLibraryTable +
-            " where rb_id=:rb_id and device=:device");
-    finderQuery.bindValue(":rb_id", rbID);
-    finderQuery.bindValue(":device", device);
-
-    if (!finderQuery.exec()) {
-        LOG_FAILED_QUERY(finderQuery)
-                << "rbID:" << rbID;
-    }
-
-    if (finderQuery.next()) {
-        trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
+    if (query.exec()) {
+        trackID = query.lastInsertId().toInt();
+    } else {
+        LOG_FAILED_QUERY(query);
     }
 
     // Insert into device all tracks playlist
@@ -418,29 +359,98 @@ void insertTrack(
                 << "trackID:" << trackID
                 << "position:" << audioFilesCount;
     }
+    return trackID;
 }
 
+struct PlaylistTreeNode {
+    QString name;
+    bool isFolder;
+};
+
 void buildPlaylistTree(
-        QSqlDatabase& database,
         TreeItem* parent,
-        uint32_t parentID,
-        QMap<uint32_t, QString>& playlistNameMap,
-        QMap<uint32_t, bool>& playlistIsFolderMap,
-        QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
-        QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
+        quint32 parentID,
+        const QHash<quint32, PlaylistTreeNode>& playlistNodes,
+        const QHash<quint32, QMap<quint32, quint32>>& playlistTreeMap,
+        const QHash<quint32, QMap<quint32, quint32>>& playlistTrackMap,
+        const QHash<quint32, int>& trackIDs,
         const QString& playlistPath,
-        const QString& device);
+        QSet<quint32>* pVisitedIDs,
+        QHash<QString, QVector<int>>* pPendingPlaylists) {
+    // The children are ordered by their sort order
+    const QMap<quint32, quint32> childIDs = playlistTreeMap.value(parentID);
+    for (const quint32 childID : childIDs) {
+        // A corrupt database might contain cycles or nodes with
+        // multiple parents, each node is only added once.
+        if (pVisitedIDs->contains(childID)) {
+            qWarning() << "Skipping Rekordbox playlist node" << childID
+                       << "that has already been added";
+            continue;
+        }
+        pVisitedIDs->insert(childID);
+
+        const PlaylistTreeNode node = playlistNodes.value(childID);
+
+        QString currentPath = playlistPath + kPLaylistPathDelimiter + node.name;
+
+        QList<QString> data;
+
+        data << currentPath;
+        data << IS_NOT_RECORDBOX_DEVICE;
+
+        TreeItem* child = parent->appendChild(node.name, QVariant(data));
+
+        // The playlist is only inserted into the database when it
+        // is accessed, ordered by the index of its entries. The tracks
+        // are resolved here to keep that insertion cheap.
+        const QMap<quint32, quint32> entries = playlistTrackMap.value(childID);
+        QVector<int> playlistTrackIDs;
+        playlistTrackIDs.reserve(entries.size());
+        for (const quint32 rbTrackID : entries) {
+            playlistTrackIDs.append(trackIDs.value(rbTrackID, -1));
+        }
+        pPendingPlaylists->insert(currentPath, playlistTrackIDs);
+
+        // If this child is a folder (playlists are only leaf nodes), build playlist tree for it
+        if (node.isFolder) {
+            buildPlaylistTree(child,
+                    childID,
+                    playlistNodes,
+                    playlistTreeMap,
+                    playlistTrackMap,
+                    trackIDs,
+                    currentPath,
+                    pVisitedIDs,
+                    pPendingPlaylists);
+        }
+    }
+}
 
-QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* deviceItem) {
+// Function parseDeviceDB is roughly based on the following Java file:
+// https://github.com/Deep-Symmetry/crate-digger/commit/f09fa9fc097a2a428c43245ddd542ac1370c1adc
+RekordboxDeviceContents parseDeviceDB(
+        mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* deviceItem) {
+    RekordboxDeviceContents contents;
     QString device = deviceItem->getLabel();
     QString devicePath = deviceItem->getData().toList()[0].toString();
+    contents.device = device;
 
     qDebug() << "parseDeviceDB device: " << device << " devicePath: " << devicePath;
 
     QString dbPath = devicePath + QStringLiteral("/") + kPdbPath;
 
     if (!QFile(dbPath).exists()) {
-        return devicePath;
+        contents.devicePlaylist = devicePath;
+        return contents;
+    }
+
+    mixxx::FileInfo fileInfo(dbPath);
+    if (!Sandbox::askForAccess(&fileInfo)) {
+        return contents;
+    }
+    mixxx::rekordboxpdb::Reader reader;
+    if (!reader.open(dbPath)) {
+        return contents;
     }
 
     // The pooler limits the lifetime all thread-local connections,
@@ -452,7 +462,7 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     VERIFY_OR_DEBUG_ASSERT(database.isOpen()) {
         qDebug() << "Failed to open database for Rekordbox parser."
                  << database.lastError();
-        return QString();
+        return contents;
     }
 
     //Give thread a low priority
@@ -483,15 +493,6 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
 
     queryInsertIntoDevicePlaylistTracks.bindValue(":playlist_id", playlistID);
 
-    mixxx::FileInfo fileInfo(dbPath);
-    if (!Sandbox::askForAccess(&fileInfo)) {
-        return QString();
-    }
-    std::ifstream ifs(dbPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
-
-    rekordbox_pdb_t reckordboxDB = rekordbox_pdb_t(&ks);
-
     // There are other types of tables (eg. COLOR), these are the only ones we are
     // interested at the moment. Perhaps when/if
     // https://bugs.launchpad.net/mixxx/+bug/1100882
@@ -499,291 +500,144 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     // Attempt was made to also recover HISTORY
     // playlists (which are found on removable Rekordbox devices), however
     // they didn't appear to contain valid row_ref_t structures.
-    constexpr int totalTables = 8;
-
-    rekordbox_pdb_t::page_type_t tableOrder[totalTables] = {
-            rekordbox_pdb_t::PAGE_TYPE_KEYS,
-            rekordbox_pdb_t::PAGE_TYPE_GENRES,
-            rekordbox_pdb_t::PAGE_TYPE_ARTISTS,
-            rekordbox_pdb_t::PAGE_TYPE_ALBUMS,
-            rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES,
-            rekordbox_pdb_t::PAGE_TYPE_TRACKS,
-            rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE,
-            rekordbox_pdb_t::PAGE_TYPE_HISTORY};
-
-    QMap<uint32_t, QString> keysMap;
-    QMap<uint32_t, QString> genresMap;
-    QMap<uint32_t, QString> artistsMap;
-    QMap<uint32_t, QString> albumsMap;
-    QMap<uint32_t, QString> playlistNameMap;
-    QMap<uint32_t, bool> playlistIsFolderMap;
-    QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTreeMap;
-    QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTrackMap;
-
-    bool folderOrPlaylistFound = false;
-
-    for (int tableOrderIndex = 0; tableOrderIndex < totalTables; tableOrderIndex++) {
-        for (std::vector<rekordbox_pdb_t::table_t*>::iterator table =
-                        reckordboxDB.tables()->begin();
-                table != reckordboxDB.tables()->end();
-                ++table) {
-            if ((*table)->type() == tableOrder[tableOrderIndex]) {
-                uint16_t lastIndex = (*table)->last_page()->index();
-                rekordbox_pdb_t::page_ref_t* currentRef = (*table)->first_page();
-
-                while (true) {
-                    rekordbox_pdb_t::page_t* page = currentRef->body();
-
-                    if (page->is_data_page()) {
-                        for (std::vector<rekordbox_pdb_t::row_group_t*>::
-                                        iterator rowGroup =
-                                                page->row_groups()->begin();
-                                rowGroup != page->row_groups()->end();
-                                ++rowGroup) {
-                            for (std::vector<rekordbox_pdb_t::row_ref_t*>::
-                                            iterator rowRef = (*rowGroup)
-                                                                      ->rows()
-                                                                      ->begin();
-                                    rowRef != (*rowGroup)->rows()->end();
-                                    ++rowRef) {
-                                if ((*rowRef)->present()) {
-                                    switch (tableOrder[tableOrderIndex]) {
-                                    case rekordbox_pdb_t::PAGE_TYPE_KEYS: {
-                                        // Key found, update map
-                                        rekordbox_pdb_t::key_row_t* key =
-                                                static_cast<rekordbox_pdb_t::
-                                                                key_row_t*>(
-                                                        (*rowRef)->body());
-                                        keysMap[key->id()] = getText(key->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_GENRES: {
-                                        // Genre found, update map
-                                        rekordbox_pdb_t::genre_row_t* genre =
-                                                static_cast<rekordbox_pdb_t::
-                                                                genre_row_t*>(
-                                                        (*rowRef)->body());
-                                        genresMap[genre->id()] = getText(genre->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ARTISTS: {
-                                        // Artist found, update map
-                                        rekordbox_pdb_t::artist_row_t* artist =
-                                                static_cast<rekordbox_pdb_t::
-                                                                artist_row_t*>(
-                                                        (*rowRef)->body());
-                                        artistsMap[artist->id()] = getText(artist->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ALBUMS: {
-                                        // Album found, update map
-                                        rekordbox_pdb_t::album_row_t* album =
-                                                static_cast<rekordbox_pdb_t::
-                                                                album_row_t*>(
-                                                        (*rowRef)->body());
-                                        albumsMap[album->id()] = getText(album->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES: {
-                                        // Playlist to track mapping found, update map
-                                        rekordbox_pdb_t::playlist_entry_row_t*
-                                                playlistEntry = static_cast<
-                                                        rekordbox_pdb_t::
-                                                                playlist_entry_row_t*>(
-                                                        (*rowRef)->body());
-                                        playlistTrackMap
-                                                [playlistEntry->playlist_id()]
-                                                [playlistEntry->entry_index()] =
-                                                        playlistEntry
-                                                                ->track_id();
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_TRACKS: {
-                                        // Track found, insert into database
-                                        insertTrack(database,
-                                                static_cast<rekordbox_pdb_t::
-                                                                track_row_t*>(
-                                                        (*rowRef)->body()),
-                                                query,
-                                                queryInsertIntoDevicePlaylistTracks,
-                                                artistsMap,
-                                                albumsMap,
-                                                genresMap,
-                                                keysMap,
-                                                devicePath,
-                                                device,
-                                                audioFilesCount);
-
-                                        audioFilesCount++;
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE: {
-                                        // Playlist tree node found, update map
-                                        rekordbox_pdb_t::playlist_tree_row_t*
-                                                playlistTree = static_cast<
-                                                        rekordbox_pdb_t::
-                                                                playlist_tree_row_t*>(
-                                                        (*rowRef)->body());
-
-                                        playlistNameMap[playlistTree->id()] =
-                                                getText(playlistTree->name());
-                                        playlistIsFolderMap[playlistTree
-                                                                    ->id()] =
-                                                playlistTree->is_folder();
-                                        playlistTreeMap
-                                                [playlistTree->parent_id()]
-                                                [playlistTree->sort_order()] =
-                                                        playlistTree->id();
-
-                                        folderOrPlaylistFound = true;
-                                    } break;
-                                    default:
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    if (currentRef->index() == lastIndex) {
-                        break;
-                    } else {
-                        currentRef = page->next_page();
-                    }
-                }
-            }
-        }
+    // The lookup tables are read before the tracks that reference them.
+    using mixxx::rekordboxpdb::TableType;
+
+    QHash<quint32, QString> keysMap;
+    QHash<quint32, QString> genresMap;
+    QHash<quint32, QString> artistsMap;
+    QHash<quint32, QString> albumsMap;
+    QHash<quint32, PlaylistTreeNode> playlistNodes;
+    QHash<quint32, QMap<quint32, quint32>> playlistTreeMap;
+    QHash<quint32, QMap<quint32, quint32>> playlistTrackMap;
+    // Maps the Rekordbox ids of the tracks to their ids in the database
+    QHash<quint32, int> trackIDs;
+
+    bool success = reader.forEachRow(TableType::Keys,
+            [&keysMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::KeyRow key(row);
+                keysMap.insert(key.id(), key.name());
+            });
+    success &= reader.forEachRow(TableType::Genres,
+            [&genresMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::GenreRow genre(row);
+                genresMap.insert(genre.id(), genre.name());
+            });
+    success &= reader.forEachRow(TableType::Artists,
+            [&artistsMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::ArtistRow artist(row);
+                artistsMap.insert(artist.id(), artist.name());
+            });
+    success &= reader.forEachRow(TableType::Albums,
+            [&albumsMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::AlbumRow album(row);
+                albumsMap.insert(album.id(), album.name());
+            });
+    success &= reader.forEachRow(TableType::PlaylistEntries,
+            [&playlistTrackMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::PlaylistEntryRow playlistEntry(row);
+                playlistTrackMap[playlistEntry.playlistId()].insert(
+                        playlistEntry.entryIndex(), playlistEntry.trackId());
+            });
+    success &= reader.forEachRow(TableType::Tracks,
+            [&](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::TrackRow track(row);
+                const int trackID = insertTrack(track,
+                        query,
+                        queryInsertIntoDevicePlaylistTracks,
+                        artistsMap,
+                        albumsMap,
+                        genresMap,
+                        keysMap,
+                        devicePath,
+                        device,
+                        audioFilesCount);
+                trackIDs.insert(track.id(), trackID);
+                audioFilesCount++;
+            });
+    success &= reader.forEachRow(TableType::PlaylistTree,
+            [&playlistNodes, &playlistTreeMap](const mixxx::rekordboxpdb::Row& row) {
+                const mixxx::rekordboxpdb::PlaylistTreeRow playlistTree(row);
+                playlistNodes.insert(playlistTree.id(),
+                        PlaylistTreeNode{playlistTree.name(), playlistTree.isFolder()});
+                playlistTreeMap[playlistTree.parentId()].insert(
+                        playlistTree.sortOrder(), playlistTree.id());
+            });
+    if (!success) {
+        qWarning() << "Rekordbox database is corrupt, some rows might be missing:"
+                   << dbPath;
     }
 
-    if (audioFilesCount > 0 || folderOrPlaylistFound) {
+    if (audioFilesCount > 0 || !playlistNodes.isEmpty()) {
         // If we have found anything, recursively build playlist/folder TreeItem children
         // for the original device TreeItem
-        buildPlaylistTree(database,
-                deviceItem,
+        QSet<quint32> visitedIDs{0};
+        buildPlaylistTree(deviceItem,
                 0,
-                playlistNameMap,
-                playlistIsFolderMap,
+                playlistNodes,
                 playlistTreeMap,
                 playlistTrackMap,
+                trackIDs,
                 devicePath,
-                device);
+                &visitedIDs,
+                &contents.pendingPlaylists);
     }
 
     qDebug() << "Found: " << audioFilesCount << " audio files in Rekordbox device " << device;
 
     transaction.commit();
 
-    return devicePath;
+    contents.devicePlaylist = devicePath;
+    return contents;
 }
 
-void buildPlaylistTree(
+bool createPlaylist(
         QSqlDatabase& database,
-        TreeItem* parent,
-        uint32_t parentID,
-        QMap<uint32_t, QString>& playlistNameMap,
-        QMap<uint32_t, bool>& playlistIsFolderMap,
-        QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
-        QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
         const QString& playlistPath,
-        const QString& device) {
-    for (uint32_t childIndex = 0;
-            childIndex < (uint32_t)playlistTreeMap[parentID].size();
-            childIndex++) {
-        uint32_t childID = playlistTreeMap[parentID][childIndex];
-        QString playlistItemName = playlistNameMap[childID];
-
-        QString currentPath = playlistPath + kPLaylistPathDelimiter + playlistItemName;
-
-        QList<QString> data;
-
-        data << currentPath;
-        data << IS_NOT_RECORDBOX_DEVICE;
-
-        TreeItem* child = parent->appendChild(playlistItemName, QVariant(data));
-
-        // Create a playlist for this child
-        QSqlQuery queryInsertIntoPlaylist(database);
-        queryInsertIntoPlaylist.prepare(
-                "INSERT INTO " + kRekordboxPlaylistsTable +
-                " (name) "
-                "VALUES (:name)");
-
-        queryInsertIntoPlaylist.bindValue(":name", currentPath);
-
-        if (!queryInsertIntoPlaylist.exec()) {
-            LOG_FAILED_QUERY(queryInsertIntoPlaylist)
-                    << "currentPath" << currentPath;
-            return;
-        }
+        const QVector<int>& trackIDs) {
+    ScopedTransaction transaction(database);
 
-        QSqlQuery idQuery(database);
-        idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-        idQuery.bindValue(":path", currentPath);
+    QSqlQuery queryInsertIntoPlaylist(database);
+    queryInsertIntoPlaylist.prepare(
+            "INSERT INTO " + kRekordboxPlaylistsTable +
+            " (name) "
+            "VALUES (:name)");
 
-        if (!idQuery.exec()) {
-            LOG_FAILED_QUERY(idQuery)
-                    << "currentPath" << currentPath;
-            return;
-        }
+    queryInsertIntoPlaylist.bindValue(":name", playlistPath);
 
-        int playlistID = -1;
-        while (idQuery.next()) {
-            playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-        }
+    if (!queryInsertIntoPlaylist.exec()) {
+        LOG_FAILED_QUERY(queryInsertIntoPlaylist)
+                << "playlistPath" << playlistPath;
+        return false;
+    }
 
-        QSqlQuery queryInsertIntoPlaylistTracks(database);
-        queryInsertIntoPlaylistTracks.prepare(
-                "INSERT INTO " + kRekordboxPlaylistTracksTable +
-                " (playlist_id, track_id, position) "
-                "VALUES (:playlist_id, :track_id, :position)");
-
-        if (playlistTrackMap.count(childID)) {
-            // Add playlist tracks for children
-            for (uint32_t trackIndex = 1; trackIndex <=
-                    static_cast<uint32_t>(playlistTrackMap[childID].size());
-                    trackIndex++) {
-                uint32_t rbTrackID = playlistTrackMap[childID][trackIndex];
-
-                int trackID = -1;
-                QSqlQuery finderQuery(database);
-                finderQuery.prepare("select id from " + kRekordboxLibraryTable +
-                        " where rb_id=:rb_id and device=:device");
-                finderQuery.bindValue(":rb_id", rbTrackID);
-                finderQuery.bindValue(":device", device);
-
-                if (!finderQuery.exec()) {
-                    LOG_FAILED_QUERY(finderQuery)
-                            << "rbTrackID:" << rbTrackID
-                            << "device:" << device;
-                    return;
-                }
+    const int playlistID = queryInsertIntoPlaylist.lastInsertId().toInt();
 
-                if (finderQuery.next()) {
-                    trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
-                }
+    QSqlQuery queryInsertIntoPlaylistTracks(database);
+    queryInsertIntoPlaylistTracks.prepare(
+            "INSERT INTO " + kRekordboxPlaylistTracksTable +
+            " (playlist_id, track_id, position) "
+            "VALUES (:playlist_id, :track_id, :position)");
 
-                queryInsertIntoPlaylistTracks.bindValue(":playlist_id", playlistID);
-                queryInsertIntoPlaylistTracks.bindValue(":track_id", trackID);
-                queryInsertIntoPlaylistTracks.bindValue(":position", static_cast<int>(trackIndex));
+    for (int trackIndex = 0; trackIndex < trackIDs.size(); trackIndex++) {
+        const int trackID = trackIDs[trackIndex];
 
-                if (!queryInsertIntoPlaylistTracks.exec()) {
-                    LOG_FAILED_QUERY(queryInsertIntoPlaylistTracks)
-                            << "playlistID:" << playlistID
-                            << "trackID:" << trackID
-                            << "trackIndex:" << trackIndex;
+        queryInsertIntoPlaylistTracks.bindValue(":playlist_id", playlistID);
+        queryInsertIntoPlaylistTracks.bindValue(":track_id", trackID);
+        queryInsertIntoPlaylistTracks.bindValue(":position", trackIndex + 1);
 
-                    return;
-                }
-            }
-        }
+        if (!queryInsertIntoPlaylistTracks.exec()) {
+            LOG_FAILED_QUERY(queryInsertIntoPlaylistTracks)
+                    << "playlistID:" << playlistID
+                    << "trackID:" << trackID
+                    << "trackIndex:" << trackIndex;
 
-        if (playlistIsFolderMap[childID]) {
-            // If this child is a folder (playlists are only leaf nodes), build playlist tree for it
-            buildPlaylistTree(database,
-                    child,
-                    childID,
-                    playlistNameMap,
-                    playlistIsFolderMap,
-                    playlistTreeMap,
-                    playlistTrackMap,
-                    currentPath,
-                    device);
+            return false;
         }
     }
+
+    transaction.commit();
+    return true;
 }
 
 void clearDeviceTables(QSqlDatabase& database, TreeItem* child) {
@@ -1390,7 +1244,7 @@ RekordboxFeature::RekordboxFeature(
             this,
             &RekordboxFeature::onRekordboxDevicesFound);
     connect(&m_tracksFutureWatcher,
-            &QFutureWatcher<QString>::finished,
+            &QFutureWatcher<RekordboxDeviceContents>::finished,
             this,
             &RekordboxFeature::onTracksFound);
     // initialize the model
@@ -1431,12 +1285,26 @@ void RekordboxFeature::htmlLinkClicked(const QUrl& link) {
 }
 
 BaseSqlTableModel* RekordboxFeature::getPlaylistModelForPlaylist(const QString& playlist) {
+    createPendingPlaylist(playlist);
     RekordboxPlaylistModel* model = new RekordboxPlaylistModel(
             this, m_pLibrary->trackCollectionManager(), m_trackSource);
     model->setPlaylist(playlist);
     return model;
 }
 
+void RekordboxFeature::createPendingPlaylist(const QString& playlist) {
+    for (auto it = m_pendingPlaylists.begin(); it != m_pendingPlaylists.end(); ++it) {
+        const auto pendingPlaylist = it.value().constFind(playlist);
+        if (pendingPlaylist == it.value().constEnd()) {
+            continue;
+        }
+        QSqlDatabase database = m_pTrackCollection->database();
+        createPlaylist(database, playlist, pendingPlaylist.value());
+        it.value().erase(pendingPlaylist);
+        return;
+    }
+}
+
 QVariant RekordboxFeature::title() {
     return m_title;
 }
@@ -1546,6 +1414,7 @@ void RekordboxFeature::activateChild(const QModelIndex& index) {
         item->setData(QVariant(data));
     } else {
         qDebug() << "Activate Rekordbox Playlist: " << playlist;
+        createPendingPlaylist(playlist);
         m_pRekordboxPlaylistModel->setPlaylist(playlist);
         emit showTrackModel(m_pRekordboxPlaylistModel);
     }
@@ -1571,6 +1440,7 @@ void RekordboxFeature::onRekordboxDevicesFound() {
         createPlaylistTracksTable(database, kRekordboxPlaylistTracksTable);
 
         transaction.commit();
+        m_pendingPlaylists.clear();
 
         if (root->childRows() > 0) {
             // Devices have since been unmounted
@@ -1593,6 +1463,7 @@ void RekordboxFeature::onRekordboxDevicesFound() {
             if (removeChild) {
                 // Device has since been unmounted, cleanup DB
                 clearDeviceTables(database, child);
+                m_pendingPlaylists.remove(child->getLabel());
 
                 m_pSidebarModel->removeRows(deviceIndex, 1);
             }
@@ -1632,13 +1503,15 @@ void RekordboxFeature::onTracksFound() {
     qDebug() << "onTracksFound";
     m_pSidebarModel->triggerRepaint();
 
-    QString devicePlaylist;
+    RekordboxDeviceContents contents;
     try {
-        devicePlaylist = m_tracksFuture.result();
+        contents = m_tracksFuture.result();
     } catch (const std::exception& e) {
         qWarning() << "Failed to load Rekordbox database:" << e.what();
         return;
     }
+    m_pendingPlaylists.insert(contents.device, contents.pendingPlaylists);
+    const QString& devicePlaylist = contents.devicePlaylist;
 
     qDebug() << "Show Rekordbox Device Playlist: " << devicePlaylist;
 
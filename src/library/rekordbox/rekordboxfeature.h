@@ -7,26 +7,39 @@
 
 //      https://github.com/Deep-Symmetry/crate-digger
 
-// And uses the C++ Kaitai Struct binary parsing libraries:
+// The *.PDB files are read in place from memory by:
+
+//      rekordboxpdbreader.h
+//      rekordboxpdbreader.cpp
+
+// According to the following structure definition file:
+
+//      https://github.com/Deep-Symmetry/crate-digger/blob/master/src/main/kaitai/rekordbox_pdb.ksy
+
+// The *.DAT analysis files are parsed with the C++ Kaitai Struct binary
+// parsing libraries:
 
 //      http://kaitai.io
 //      https://github.com/kaitai-io/kaitai_struct
 //      https://github.com/kaitai-io/kaitai_struct_cpp_stl_runtime
 
-// The *.PDB C++ files:
+// The C++ files for the *.PDB (only used for comparison in tests) and
+// *.DAT files:
 
 //      rekordbox_pdb.h
 //      rekordbox_pdb.cpp
+//      rekordbox_anlz.h
+//      rekordbox_anlz.cpp
 
-// Were generated from the following structure definition file:
-
-//      https://github.com/Deep-Symmetry/crate-digger/blob/master/src/main/kaitai/rekordbox_pdb.ksy
+// Were generated from the corresponding *.ksy files.
 
 #pragma once
 
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QHash>
 #include <QStringListModel>
+#include <QVector>
 #include <QtConcurrentRun>
 #include <fstream>
 
@@ -39,6 +52,18 @@
 class TrackCollectionManager;
 class BaseExternalPlaylistModel;
 
+/// The result of parsing the database of a device.
+///
+/// Only the playlist of all tracks is inserted into the database while
+/// parsing. All other playlists and folders are inserted when they are
+/// accessed for the first time.
+struct RekordboxDeviceContents {
+    QString device;
+    QString devicePlaylist;
+    // Maps playlist paths to the ids of their tracks
+    QHash<QString, QVector<int>> pendingPlaylists;
+};
+
 class RekordboxPlaylistModel : public BaseExternalPlaylistModel {
     Q_OBJECT
   public:
@@ -79,15 +104,20 @@ class RekordboxFeature : public BaseExternalLibraryFeature {
   private:
     QString formatRootViewHtml() const;
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
+    // Inserts the playlist into the database if it has not been accessed yet
+    void createPendingPlaylist(const QString& playlist);
 
     parented_ptr<TreeItemModel> m_pSidebarModel;
     RekordboxPlaylistModel* m_pRekordboxPlaylistModel;
 
     QFutureWatcher<QList<TreeItem*>> m_devicesFutureWatcher;
     QFuture<QList<TreeItem*>> m_devicesFuture;
-    QFutureWatcher<QString> m_tracksFutureWatcher;
-    QFuture<QString> m_tracksFuture;
+    QFutureWatcher<RekordboxDeviceContents> m_tracksFutureWatcher;
+    QFuture<RekordboxDeviceContents> m_tracksFuture;
     QString m_title;
 
+    // The pending playlists of all devices, mapped by device
+    QHash<QString, QHash<QString, QVector<int>>> m_pendingPlaylists;
+
     QSharedPointer<BaseTrackCache> m_trackSource;
 };
@@ -0,0 +1,227 @@
+#include "library/rekordbox/rekordboxpdbreader.h"
+
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace rekordboxpdb {
+
+namespace {
+
+const Logger kLogger("RekordboxPdbReader");
+
+// File header
+constexpr qint64 kFileHeaderPageSizeOffset = 0x04;
+constexpr qint64 kFileHeaderNumTablesOffset = 0x08;
+constexpr qint64 kFileHeaderSize = 0x1C;
+constexpr qint64 kTableSize = 0x10;
+constexpr qint64 kTableTypeOffset = 0x00;
+constexpr qint64 kTableFirstPageOffset = 0x08;
+constexpr qint64 kTableLastPageOffset = 0x0C;
+
+// Page header
+constexpr int kPageNextPageOffset = 0x0C;
+constexpr int kPageNumRowsSmallOffset = 0x18;
+constexpr int kPageFlagsOffset = 0x1B;
+constexpr int kPageNumRowsLargeOffset = 0x22;
+constexpr int kPageHeaderSize = 0x28;
+constexpr quint8 kPageFlagsNonDataPage = 0x40;
+
+// Row index, built backwards from the end of the page
+constexpr int kRowGroupSize = 0x24;
+constexpr int kRowsPerGroup = 16;
+constexpr int kRowGroupFlagsOffset = 4;
+constexpr int kRowGroupOffsetsOffset = 6;
+
+// Strings
+constexpr quint8 kStringKindLongAscii = 0x40;
+constexpr quint8 kStringKindLongUtf16be = 0x90;
+constexpr int kLongStringHeaderSize = 3;
+// The length of UTF-16BE strings includes 4 bytes of the header
+// and terminator that are not part of the text.
+constexpr int kLongUtf16beLengthExcess = 4;
+
+} // anonymous namespace
+
+QString Row::readString(int offset) const {
+    const int pos = m_rowOffset + offset;
+    if (pos < 0 || pos >= m_pageSize) {
+        return QString();
+    }
+    const quint8 lengthAndKind = m_pPage[pos];
+    int textPos;
+    int textLength;
+    if (lengthAndKind == kStringKindLongAscii ||
+            lengthAndKind == kStringKindLongUtf16be) {
+        textPos = pos + kLongStringHeaderSize;
+        textLength = readU16(offset + 1);
+        if (lengthAndKind == kStringKindLongUtf16be) {
+            textLength -= kLongUtf16beLengthExcess;
+        }
+    } else {
+        // The length of short ASCII strings is mangled into the kind:
+        // incremented, doubled, and incremented again.
+        if (lengthAndKind % 2 == 0) {
+            return QString();
+        }
+        textPos = pos + 1;
+        textLength = ((lengthAndKind - 1) / 2) - 1;
+    }
+    if (textLength <= 0 || textPos + textLength > m_pageSize) {
+        return QString();
+    }
+
+    const uchar* pText = m_pPage + textPos;
+    QString text;
+    if (lengthAndKind == kStringKindLongUtf16be) {
+        const int numChars = textLength / 2;
+        text.resize(numChars);
+        QChar* pChars = text.data();
+        for (int i = 0; i < numChars; ++i) {
+            pChars[i] = QChar(qFromBigEndian<quint16>(pText + 2 * i));
+        }
+    } else {
+        text = QString::fromUtf8(reinterpret_cast<const char*>(pText), textLength);
+    }
+    // Some strings read from Rekordbox *.PDB files contain random null characters
+    // which if not removed cause Mixxx to crash when attempting to read file paths
+    return text.remove(QChar('\x0'));
+}
+
+bool Reader::open(const QString& filePath) {
+    close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        kLogger.warning()
+                << "Failed to open file"
+                << filePath
+                << m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    // NOTE: Accessing the mapped memory of a file on a removable device
+    // that disappears unexpectedly might terminate Mixxx with SIGBUS.
+    // The same applies to the decoding of mapped MP3 files.
+    m_pData = m_file.map(0, m_size);
+    if (!m_pData) {
+        kLogger.debug()
+                << "Failed to map file into memory, reading it instead"
+                << filePath;
+        m_fileData = m_file.readAll();
+        m_size = m_fileData.size();
+        m_pData = reinterpret_cast<const uchar*>(m_fileData.constData());
+    }
+    if (m_size < kFileHeaderSize) {
+        kLogger.warning() << "File is too short" << filePath;
+        close();
+        return false;
+    }
+    const quint32 pageSize = readU32(kFileHeaderPageSizeOffset);
+    const quint32 numTables = readU32(kFileHeaderNumTablesOffset);
+    if (pageSize < static_cast<quint32>(kPageHeaderSize + kRowGroupSize) ||
+            pageSize > static_cast<quint32>(m_size) ||
+            kFileHeaderSize + numTables * kTableSize > m_size) {
+        kLogger.warning() << "Invalid file header" << filePath;
+        close();
+        return false;
+    }
+    m_pageSize = static_cast<int>(pageSize);
+    return true;
+}
+
+void Reader::close() {
+    // Closing the file also unmaps it
+    m_file.close();
+    m_fileData.clear();
+    m_pData = nullptr;
+    m_size = 0;
+    m_pageSize = 0;
+}
+
+bool Reader::forEachRow(TableType type, const RowVisitor& visitor) const {
+    if (!isOpen()) {
+        return false;
+    }
+    const quint32 numTables = readU32(kFileHeaderNumTablesOffset);
+    for (quint32 i = 0; i < numTables; ++i) {
+        const qint64 tablePos = kFileHeaderSize + i * kTableSize;
+        if (readU32(tablePos + kTableTypeOffset) != static_cast<quint32>(type)) {
+            continue;
+        }
+        if (!visitTable(readU32(tablePos + kTableFirstPageOffset),
+                    readU32(tablePos + kTableLastPageOffset),
+                    visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Reader::visitTable(
+        quint32 firstPageIndex,
+        quint32 lastPageIndex,
+        const RowVisitor& visitor) const {
+    // The pages of a table are a linked list. Stop following the links
+    // after visiting as many pages as the file contains to break cycles.
+    const qint64 numPages = m_size / m_pageSize;
+    quint32 pageIndex = firstPageIndex;
+    for (qint64 visitedPages = 0; visitedPages < numPages; ++visitedPages) {
+        if (pageIndex >= numPages) {
+            kLogger.warning() << "Invalid page index" << pageIndex;
+            return false;
+        }
+        const uchar* pPage = m_pData + static_cast<qint64>(pageIndex) * m_pageSize;
+        if ((pPage[kPageFlagsOffset] & kPageFlagsNonDataPage) == 0) {
+            visitPage(pPage, visitor);
+        }
+        if (pageIndex == lastPageIndex) {
+            return true;
+        }
+        pageIndex = qFromLittleEndian<quint32>(pPage + kPageNextPageOffset);
+    }
+    kLogger.warning() << "Cyclic page links";
+    return false;
+}
+
+void Reader::visitPage(const uchar* pPage, const RowVisitor& visitor) const {
+    // The large row count is used if it exceeds the small one, unless it
+    // holds the special value 0x1fff.
+    const int numRowsSmall = pPage[kPageNumRowsSmallOffset];
+    const int numRowsLarge = qFromLittleEndian<quint16>(pPage + kPageNumRowsLargeOffset);
+    const int numRows = (numRowsLarge > numRowsSmall && numRowsLarge != 0x1fff)
+            ? numRowsLarge
+            : numRowsSmall;
+    if (numRows <= 0) {
+        return;
+    }
+    const int numGroups = (numRows - 1) / kRowsPerGroup + 1;
+    if (numGroups * kRowGroupSize > m_pageSize - kPageHeaderSize) {
+        kLogger.warning() << "Invalid number of rows" << numRows;
+        return;
+    }
+    for (int groupIndex = 0; groupIndex < numGroups; ++groupIndex) {
+        const int base = m_pageSize - groupIndex * kRowGroupSize;
+        const quint16 presentFlags = qFromLittleEndian<quint16>(
+                pPage + base - kRowGroupFlagsOffset);
+        const int numGroupRows = groupIndex < numGroups - 1
+                ? kRowsPerGroup
+                : (numRows - 1) % kRowsPerGroup + 1;
+        for (int rowIndex = 0; rowIndex < numGroupRows; ++rowIndex) {
+            if (((presentFlags >> rowIndex) & 1) == 0) {
+                // Deleted rows may contain garbage
+                continue;
+            }
+            const int rowOffset = kPageHeaderSize +
+                    qFromLittleEndian<quint16>(pPage + base -
+                            (kRowGroupOffsetsOffset + 2 * rowIndex));
+            if (rowOffset >= m_pageSize) {
+                continue;
+            }
+            visitor(Row(pPage, m_pageSize, rowOffset));
+        }
+    }
+}
+
+} // namespace rekordboxpdb
+
+} // namespace mixxx
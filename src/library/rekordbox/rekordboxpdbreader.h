@@ -0,0 +1,292 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QtEndian>
+#include <functional>
+
+namespace mixxx {
+
+namespace rekordboxpdb {
+
+/// The types of the tables in a DeviceSQL database, see
+/// the enum page_type in rekordbox_pdb.ksy.
+enum class TableType : quint32 {
+    Tracks = 0,
+    Genres = 1,
+    Artists = 2,
+    Albums = 3,
+    Labels = 4,
+    Keys = 5,
+    Colors = 6,
+    PlaylistTree = 7,
+    PlaylistEntries = 8,
+    History = 19,
+};
+
+/// A view of a single row within a table page.
+///
+/// All offsets are relative to the start of the row and all reads are
+/// checked against the bounds of the page. Reading outside of the page
+/// returns 0 or an empty string instead of failing.
+class Row {
+  public:
+    Row(const uchar* pPage, int pageSize, int rowOffset)
+            : m_pPage(pPage),
+              m_pageSize(pageSize),
+              m_rowOffset(rowOffset) {
+    }
+
+    quint8 readU8(int offset) const {
+        const int pos = m_rowOffset + offset;
+        if (pos < 0 || pos + 1 > m_pageSize) {
+            return 0;
+        }
+        return m_pPage[pos];
+    }
+    quint16 readU16(int offset) const {
+        const int pos = m_rowOffset + offset;
+        if (pos < 0 || pos + 2 > m_pageSize) {
+            return 0;
+        }
+        return qFromLittleEndian<quint16>(m_pPage + pos);
+    }
+    quint32 readU32(int offset) const {
+        const int pos = m_rowOffset + offset;
+        if (pos < 0 || pos + 4 > m_pageSize) {
+            return 0;
+        }
+        return qFromLittleEndian<quint32>(m_pPage + pos);
+    }
+
+    /// Decodes the DeviceSQL string at the given offset. Null characters
+    /// that are contained in some strings are removed.
+    QString readString(int offset) const;
+
+  private:
+    const uchar* m_pPage;
+    int m_pageSize;
+    int m_rowOffset;
+};
+
+// The typed rows only decode the fields that are accessed. The offsets
+// of the fields are documented in rekordbox_pdb.ksy.
+
+class TrackRow : public Row {
+  public:
+    explicit TrackRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 keyId() const {
+        return readU32(0x20);
+    }
+    quint32 bitrate() const {
+        return readU32(0x30);
+    }
+    quint32 trackNumber() const {
+        return readU32(0x34);
+    }
+    /// The tempo in beats per minute multiplied by 100
+    quint32 tempo() const {
+        return readU32(0x38);
+    }
+    quint32 genreId() const {
+        return readU32(0x3C);
+    }
+    quint32 albumId() const {
+        return readU32(0x40);
+    }
+    quint32 artistId() const {
+        return readU32(0x44);
+    }
+    quint32 id() const {
+        return readU32(0x48);
+    }
+    quint16 year() const {
+        return readU16(0x50);
+    }
+    /// The duration in seconds
+    quint16 duration() const {
+        return readU16(0x54);
+    }
+    quint8 colorId() const {
+        return readU8(0x58);
+    }
+    quint8 rating() const {
+        return readU8(0x59);
+    }
+
+    QString analyzePath() const {
+        return readTrackString(14);
+    }
+    QString comment() const {
+        return readTrackString(16);
+    }
+    QString title() const {
+        return readTrackString(17);
+    }
+    QString filePath() const {
+        return readTrackString(20);
+    }
+
+  private:
+    // The offsets of the strings are stored in an array at the end of
+    // the fixed-size part of the row.
+    QString readTrackString(int index) const {
+        return readString(readU16(0x5E + 2 * index));
+    }
+};
+
+class KeyRow : public Row {
+  public:
+    explicit KeyRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 id() const {
+        return readU32(0x00);
+    }
+    QString name() const {
+        return readString(0x08);
+    }
+};
+
+class GenreRow : public Row {
+  public:
+    explicit GenreRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 id() const {
+        return readU32(0x00);
+    }
+    QString name() const {
+        return readString(0x04);
+    }
+};
+
+class ArtistRow : public Row {
+  public:
+    explicit ArtistRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 id() const {
+        return readU32(0x04);
+    }
+    QString name() const {
+        // Names that are too far from the start of the row are located
+        // by a 2-byte offset that is signaled by the subtype.
+        constexpr quint16 kSubtypeFarName = 0x64;
+        if (readU16(0x00) == kSubtypeFarName) {
+            return readString(readU16(0x0A));
+        }
+        return readString(readU8(0x09));
+    }
+};
+
+class AlbumRow : public Row {
+  public:
+    explicit AlbumRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 id() const {
+        return readU32(0x0C);
+    }
+    QString name() const {
+        return readString(readU8(0x15));
+    }
+};
+
+class PlaylistTreeRow : public Row {
+  public:
+    explicit PlaylistTreeRow(const Row& row)
+            : Row(row) {
+    }
+
+    /// The id of the parent folder or 0 for the root level
+    quint32 parentId() const {
+        return readU32(0x00);
+    }
+    quint32 sortOrder() const {
+        return readU32(0x08);
+    }
+    quint32 id() const {
+        return readU32(0x0C);
+    }
+    bool isFolder() const {
+        return readU32(0x10) != 0;
+    }
+    QString name() const {
+        return readString(0x14);
+    }
+};
+
+class PlaylistEntryRow : public Row {
+  public:
+    explicit PlaylistEntryRow(const Row& row)
+            : Row(row) {
+    }
+
+    quint32 entryIndex() const {
+        return readU32(0x00);
+    }
+    quint32 trackId() const {
+        return readU32(0x04);
+    }
+    quint32 playlistId() const {
+        return readU32(0x08);
+    }
+};
+
+/// Reads a DeviceSQL database (export.pdb) that has been exported by
+/// Rekordbox onto a removable device.
+///
+/// The file is mapped into memory and the pages and rows of a table are
+/// walked in place. Rows are only decoded on demand through the typed
+/// row views, i.e. only the tables and fields that are actually needed
+/// are read and no intermediate objects are allocated.
+class Reader {
+  public:
+    typedef std::function<void(const Row&)> RowVisitor;
+
+    Reader() = default;
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool open(const QString& filePath);
+    void close();
+
+    bool isOpen() const {
+        return m_pData != nullptr;
+    }
+
+    /// Invokes the visitor for all rows of the given table type that are
+    /// present, i.e. not deleted. Returns false if the file is corrupt.
+    bool forEachRow(TableType type, const RowVisitor& visitor) const;
+
+  private:
+    bool visitTable(
+            quint32 firstPageIndex,
+            quint32 lastPageIndex,
+            const RowVisitor& visitor) const;
+    void visitPage(const uchar* pPage, const RowVisitor& visitor) const;
+
+    quint32 readU32(qint64 pos) const {
+        return qFromLittleEndian<quint32>(m_pData + pos);
+    }
+
+    QFile m_file;
+    // Only used if the file could not be mapped into memory
+    QByteArray m_fileData;
+    const uchar* m_pData = nullptr;
+    qint64 m_size = 0;
+    int m_pageSize = 0;
+};
+
+} // namespace rekordboxpdb
+
+} // namespace mixxx
@@ -14,6 +14,27 @@
 #include "library/treeitem.h"
 #include "moc_rhythmboxfeature.cpp"
 
+namespace {
+
+const QString kImportedLibraryKey = QStringLiteral("mixxx.rhythmboxfeature.imported");
+
+// Returns the path of a file in the Rhythmbox data directory or an empty
+// string if it does not exist. An API call which tells us where the files
+// are would be nice.
+QString findRhythmboxFile(const QString& fileName) {
+    QString filePath = QDir::homePath() + "/.gnome2/rhythmbox/" + fileName;
+    if (QFile::exists(filePath)) {
+        return filePath;
+    }
+    filePath = QDir::homePath() + "/.local/share/rhythmbox/" + fileName;
+    if (QFile::exists(filePath)) {
+        return filePath;
+    }
+    return QString();
+}
+
+} // namespace
+
 RhythmboxFeature::RhythmboxFeature(Library* pLibrary, UserSettingsPointer pConfig)
         : BaseExternalLibraryFeature(pLibrary, pConfig, QStringLiteral("rhythmbox")),
           m_pSidebarModel(make_parented<TreeItemModel>(this)),
@@ -144,15 +165,12 @@ void RhythmboxFeature::activateChild(const QModelIndex& index) {
 
 TreeItem* RhythmboxFeature::importMusicCollection() {
     qDebug() << "importMusicCollection Thread Id: " << QThread::currentThread();
-     // Try and open the Rhythmbox DB. An API call which tells us where
-     // the file is would be nice.
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/rhythmdb.xml");
-    if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/rhythmdb.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+    // Try and open the Rhythmbox DB
+    const QString dbFilePath = findRhythmboxFile(QStringLiteral("rhythmdb.xml"));
+    if (dbFilePath.isEmpty()) {
+        return nullptr;
     }
+    QFile db(dbFilePath);
 
     mixxx::FileInfo fileInfo(db);
     if (!Sandbox::askForAccess(&fileInfo) ||
@@ -160,13 +178,26 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
         return nullptr;
     }
 
-    //Delete all table entries of Traktor feature
+    const QStringList importedFilePaths{dbFilePath,
+            findRhythmboxFile(QStringLiteral("playlists.xml"))};
+    TreeItem* pRestoredRootItem = restoreUnchangedImport(
+            m_database, kImportedLibraryKey, importedFilePaths);
+    if (pRestoredRootItem) {
+        qDebug() << "Rhythmbox music collection is unchanged since the last import";
+        return pRestoredRootItem;
+    }
+
+    //Delete all table entries of Rhythmbox feature
     ScopedTransaction transaction(m_database);
     clearTable("rhythmbox_playlist_tracks");
     clearTable("rhythmbox_library");
     clearTable("rhythmbox_playlists");
+    storeImport(m_database, kImportedLibraryKey, importedFilePaths, nullptr);
     transaction.commit();
 
+    // Resolves the playlist entries without querying the database
+    m_trackIdsByLocation.clear();
+
     transaction.transaction();
     QSqlQuery query(m_database);
     query.prepare("INSERT INTO rhythmbox_library (artist, title, album, year, "
@@ -198,19 +229,23 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
 
     db.close();
     if (m_cancelImport) {
+        m_trackIdsByLocation.clear();
         return nullptr;
     }
-    return importPlaylists();
+    TreeItem* pRootItem = importPlaylists();
+    m_trackIdsByLocation.clear();
+    if (pRootItem && !m_cancelImport) {
+        storeImport(m_database, kImportedLibraryKey, importedFilePaths, pRootItem);
+    }
+    return pRootItem;
 }
 
 TreeItem* RhythmboxFeature::importPlaylists() {
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/playlists.xml");
-    if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/playlists.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+    const QString dbFilePath = findRhythmboxFile(QStringLiteral("playlists.xml"));
+    if (dbFilePath.isEmpty()) {
+        return nullptr;
     }
+    QFile db(dbFilePath);
     //Open file
     if (!db.open(QIODevice::ReadOnly)) {
         return nullptr;
@@ -365,6 +400,8 @@ void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
                  << " " << query.lastError();
         return;
     }
+    // The last entry wins if a location occurs more than once
+    m_trackIdsByLocation.insert(location, query.lastInsertId().toInt());
 }
 
 // reads all playlist entries and executes a SQL statement
@@ -379,26 +416,12 @@ void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
             const auto fileInfo = mixxx::FileInfo::fromQUrl(xml.readElementText());
 
             //get the ID of the file in the rhythmbox_library table
-            int track_id = -1;
-            QSqlQuery finder_query(m_database);
-            finder_query.prepare("select id from rhythmbox_library where location=:path");
-            finder_query.bindValue(":path", fileInfo.location());
-            bool success = finder_query.exec();
-
-            if (success) {
-                const int idColumn = finder_query.record().indexOf("id");
-                while (finder_query.next()) {
-                    track_id = finder_query.value(idColumn).toInt();
-                }
-             } else {
-                qDebug() << "SQL Error in RhythmboxFeature.cpp: line"
-                         << __LINE__ << " " << finder_query.lastError();
-            }
+            const int track_id = m_trackIdsByLocation.value(fileInfo.location(), -1);
 
             query_insert_to_playlist_tracks.bindValue(":playlist_id", playlist_id);
             query_insert_to_playlist_tracks.bindValue(":track_id", track_id);
             query_insert_to_playlist_tracks.bindValue(":position", playlist_position++);
-            success = query_insert_to_playlist_tracks.exec();
+            bool success = query_insert_to_playlist_tracks.exec();
 
             if (!success) {
                 qDebug() << "SQL Error in RhythmboxFeature.cpp: line" << __LINE__ << " "
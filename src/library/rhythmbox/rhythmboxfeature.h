@@ -58,4 +58,7 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     bool m_cancelImport;
 
     QSharedPointer<BaseTrackCache>  m_trackSource;
+
+    // Only accessed by the worker thread while parsing
+    QHash<QString, int> m_trackIdsByLocation;
 };
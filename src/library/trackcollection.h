@@ -139,6 +139,8 @@ class TrackCollection : public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    TrackPointerList getTracksByIds(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
 
@@ -147,6 +149,7 @@ class TrackCollection : public QObject,
             bool* pAlreadyInLibrary = nullptr);
     FRIEND_TEST(DirectoryDAOTest, relocateDirectory);
     FRIEND_TEST(TrackDAOTest, detectMovedTracks);
+    FRIEND_TEST(TrackDAOTest, getTracksByIds);
     TrackId addTrack(
             const TrackPointer& pTrack,
             bool unremove);
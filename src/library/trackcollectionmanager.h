@@ -49,6 +49,8 @@ class TrackCollectionManager: public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    TrackPointerList getTracksByIds(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
     QList<TrackId> resolveTrackIdsFromUrls(
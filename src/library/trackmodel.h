@@ -213,6 +213,13 @@ class TrackModel {
     virtual void select() {
     }
 
+    /// Informs the model about the rows that are visible in the view
+    /// after scrolling, resizing or sorting, e.g. to load their data
+    /// before the data of other rows.
+    virtual void setVisibleTracks(const QModelIndexList& indices) {
+        Q_UNUSED(indices);
+    }
+
     /// @brief modelKey returns a unique identifier for the model
     /// @param noSearch don't include the current search in the key
     /// @param baseOnly return only a identifier for the whole subsystem
@@ -1,11 +1,14 @@
 #include "library/trackset/crate/cratestorage.h"
 
+#include <algorithm>
+
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/trackset/crate/crateschema.h"
 #include "util/db/dbconnection.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/db/sqllikewildcards.h"
+#include "util/db/sqlstringformatter.h"
 #include "util/logger.h"
 
 namespace {
@@ -19,6 +22,15 @@ const QString CRATE_SUMMARY_VIEW = "crate_summary";
 const QString CRATESUMMARY_TRACK_COUNT = "track_count";
 const QString CRATESUMMARY_TRACK_DURATION = "track_duration";
 
+QStringList trackIdsToStrings(const QList<TrackId>& trackIds) {
+    QStringList trackIdStrings;
+    trackIdStrings.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        trackIdStrings.append(trackId.toString());
+    }
+    return trackIdStrings;
+}
+
 const QString kCrateTracksJoin =
         QStringLiteral("LEFT JOIN %3 ON %3.%4=%1.%2")
                 .arg(CRATE_TABLE, CRATETABLE_ID, CRATE_TRACKS_TABLE, CRATETRACKSTABLE_CRATEID);
@@ -726,34 +738,40 @@ bool CrateStorage::onAddingCrateTracks(
 bool CrateStorage::onRemovingCrateTracks(
         CrateId crateId,
         const QList<TrackId>& trackIds) {
-    // NOTE(uklotzde): We remove tracks in a loop
-    // analogously to adding tracks (see above).
-    FwdSqlQuery query(m_database,
-            QStringLiteral(
-                    "DELETE FROM %1 "
-                    "WHERE %2=:crateId AND %3=:trackId")
-                    .arg(
-                            CRATE_TRACKS_TABLE,
-                            CRATETRACKSTABLE_CRATEID,
-                            CRATETRACKSTABLE_TRACKID));
-    if (!query.isPrepared()) {
+    // Delete the tracks in chunks instead of one-by-one
+    int numRemovedTracks = 0;
+    const bool success = SqlStringFormatter::joinListChunks(
+            trackIdsToStrings(trackIds),
+            [&](const QString& trackIdList) {
+                FwdSqlQuery query(m_database,
+                        QStringLiteral(
+                                "DELETE FROM %1 "
+                                "WHERE %2=:crateId AND %3 IN (%4)")
+                                .arg(
+                                        CRATE_TRACKS_TABLE,
+                                        CRATETRACKSTABLE_CRATEID,
+                                        CRATETRACKSTABLE_TRACKID,
+                                        trackIdList));
+                if (!query.isPrepared()) {
+                    return false;
+                }
+                query.bindValue(":crateId", crateId);
+                if (!query.execPrepared()) {
+                    return false;
+                }
+                numRemovedTracks += query.numRowsAffected();
+                return true;
+            });
+    if (!success) {
         return false;
     }
-    query.bindValue(":crateId", crateId);
-    for (const auto& trackId : trackIds) {
-        query.bindValue(":trackId", trackId);
-        if (!query.execPrepared()) {
-            return false;
-        }
-        if (query.numRowsAffected() == 0) {
-            // track not found in crate
-            if (kLogger.debugEnabled()) {
-                kLogger.debug()
-                        << "Track" << trackId
-                        << "not removed from crate" << crateId;
-            }
-        } else {
-            DEBUG_ASSERT(query.numRowsAffected() == 1);
+    if (numRemovedTracks < trackIds.size()) {
+        // some tracks were not found in crate
+        if (kLogger.debugEnabled()) {
+            kLogger.debug()
+                    << trackIds.size() - numRemovedTracks
+                    << "of" << trackIds.size()
+                    << "tracks not removed from crate" << crateId;
         }
     }
     return true;
@@ -761,20 +779,18 @@ bool CrateStorage::onRemovingCrateTracks(
 
 bool CrateStorage::onPurgingTracks(
         const QList<TrackId>& trackIds) {
-    // NOTE(uklotzde): Remove tracks from crates one-by-one.
-    // This might be optimized by deleting multiple track ids
-    // at once in chunks with a maximum size.
-    FwdSqlQuery query(m_database,
-            QStringLiteral("DELETE FROM %1 WHERE %2=:trackId")
-                    .arg(CRATE_TRACKS_TABLE, CRATETRACKSTABLE_TRACKID));
-    if (!query.isPrepared()) {
-        return false;
-    }
-    for (const auto& trackId : trackIds) {
-        query.bindValue(":trackId", trackId);
-        if (!query.execPrepared()) {
-            return false;
-        }
-    }
-    return true;
+    // Remove the tracks from all crates in chunks
+    return SqlStringFormatter::joinListChunks(
+            trackIdsToStrings(trackIds),
+            [this](const QString& trackIdList) {
+                FwdSqlQuery query(m_database,
+                        QStringLiteral("DELETE FROM %1 WHERE %2 IN (%3)")
+                                .arg(CRATE_TRACKS_TABLE,
+                                        CRATETRACKSTABLE_TRACKID,
+                                        trackIdList));
+                if (!query.isPrepared()) {
+                    return false;
+                }
+                return query.execPrepared();
+            });
 }
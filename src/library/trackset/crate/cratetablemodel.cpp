@@ -187,7 +187,15 @@ void CrateTableModel::removeTracks(const QModelIndexList& indices) {
         return;
     }
 
-    select();
+    // Drop the rows instead of selecting all remaining rows again
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    const QSet<TrackId> removedTrackIds(trackIds.constBegin(), trackIds.constEnd());
+#else
+    const QSet<TrackId> removedTrackIds = QSet<TrackId>::fromList(trackIds);
+#endif
+    updateRowsInPlace([&removedTrackIds](TrackId trackId, QVector<QVariant>*) {
+        return removedTrackIds.contains(trackId) ? RowUpdate::Removed : RowUpdate::None;
+    });
 }
 
 QString CrateTableModel::modelKey(bool noSearch) const {
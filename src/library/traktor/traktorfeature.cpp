@@ -22,6 +22,11 @@
 
 namespace {
 
+const QString kImportedLibraryKey = QStringLiteral("mixxx.traktorfeature.imported");
+
+// Separates the components of the playlist paths
+const QString kPlaylistPathDelimiter = QStringLiteral("-->");
+
 QString fromTraktorSeparators(QString path) {
     // Traktor uses /: instead of just / as delimiting character for some reasons
     return path.replace("/:", "/");
@@ -199,6 +204,12 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     //Give thread a low priority
     QThread* thisThread = QThread::currentThread();
     thisThread->setPriority(QThread::LowPriority);
+    TreeItem* pRestoredRootItem = restoreUnchangedImport(
+            m_database, kImportedLibraryKey, QStringList{file});
+    if (pRestoredRootItem) {
+        qDebug() << "Traktor music collection is unchanged since the last import";
+        return pRestoredRootItem;
+    }
     //Invisible root item of Traktor's child model
     TreeItem* root = nullptr;
     //Delete all table entries of Traktor feature
@@ -206,8 +217,12 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     clearTable("traktor_playlist_tracks");
     clearTable("traktor_library");
     clearTable("traktor_playlists");
+    storeImport(m_database, kImportedLibraryKey, QStringList{file}, nullptr);
     transaction.commit();
 
+    // Resolves the playlist entries without querying the database
+    m_trackIdsByLocation.clear();
+
     transaction.transaction();
     QSqlQuery query(m_database);
     query.prepare("INSERT INTO traktor_library (artist, title, album, year,"
@@ -265,6 +280,7 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
             }
         }
     }
+    m_trackIdsByLocation.clear();
     if (xml.hasError()) {
          // do error handling
          qDebug() << "Cannot process Traktor music collection";
@@ -275,6 +291,9 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     }
 
     qDebug() << "Found: " << nAudioFiles << " audio files in Traktor";
+    if (root && !m_cancelImport) {
+        storeImport(m_database, kImportedLibraryKey, QStringList{file}, root);
+    }
     //initialize TraktorTableModel
     transaction.commit();
 
@@ -399,6 +418,10 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
                  << __LINE__ << " " << query.lastError();
         return;
     }
+    // The first entry wins if a location occurs more than once
+    if (!m_trackIdsByLocation.contains(location)) {
+        m_trackIdsByLocation.insert(location, query.lastInsertId().toInt());
+    }
 }
 
 // Purpose: Parsing all the folder and playlists of Traktor
@@ -413,7 +436,7 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
     QString current_path = "";
     QMap<QString,QString> map;
 
-    QString delimiter = "-->";
+    const QString& delimiter = kPlaylistPathDelimiter;
 
     std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
     TreeItem* parent = rootItem.get();
@@ -497,23 +520,7 @@ void TraktorFeature::parsePlaylistEntries(
         return;
     }
 
-    // Get playlist id
-    QSqlQuery id_query(m_database);
-    id_query.prepare("select id from traktor_playlists where name=:path");
-    id_query.bindValue(":path", playlist_path);
-
-    if (!id_query.exec()) {
-        LOG_FAILED_QUERY(id_query) << "Could not get inserted playlist id for Traktor playlist::"
-                                   << playlist_path;
-        return;
-    }
-
-    //playlist_id = id_query.lastInsertId().toInt();
-    int playlist_id = -1;
-    const int idColumn = id_query.record().indexOf("id");
-    while (id_query.next()) {
-        playlist_id = id_query.value(idColumn).toInt();
-    }
+    const int playlist_id = query_insert_into_playlist.lastInsertId().toInt();
 
     int playlist_position = 1;
     while (!xml.atEnd() && !m_cancelImport) {
@@ -531,19 +538,7 @@ void TraktorFeature::parsePlaylistEntries(
                     #endif
 
                     //insert to database
-                    int track_id = -1;
-                    QSqlQuery finder_query(m_database);
-                    finder_query.prepare("select id from traktor_library where location=:path");
-                    finder_query.bindValue(":path", key);
-
-                    if (!finder_query.exec()) {
-                        LOG_FAILED_QUERY(finder_query) << "Could not get track id:" << key;
-                        continue;
-                    }
-
-                    if (finder_query.next()) {
-                        track_id = finder_query.value(finder_query.record().indexOf("id")).toInt();
-                    }
+                    const int track_id = m_trackIdsByLocation.value(key, -1);
 
                     query_insert_into_playlisttracks.bindValue(":playlist_id", playlist_id);
                     query_insert_into_playlisttracks.bindValue(":track_id", track_id);
@@ -75,4 +75,7 @@ class TraktorFeature : public BaseExternalLibraryFeature {
     QString m_title;
 
     QSharedPointer<BaseTrackCache> m_trackSource;
+
+    // Only accessed by the worker thread while parsing
+    QHash<QString, int> m_trackIdsByLocation;
 };
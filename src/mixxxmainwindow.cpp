@@ -3,6 +3,7 @@
 #include <QDesktopServices>
 #include <QFileDialog>
 #include <QGLFormat>
+#include <QTimer>
 #include <QUrl>
 #include <QtDebug>
 
@@ -76,7 +77,8 @@ MixxxMainWindow::MixxxMainWindow(std::shared_ptr<mixxx::CoreServices> pCoreServi
           m_pGuiTick(nullptr),
           m_pDeveloperToolsDlg(nullptr),
           m_pPrefDlg(nullptr),
-          m_toolTipsCfg(mixxx::TooltipsPreference::TOOLTIPS_ON) {
+          m_toolTipsCfg(mixxx::TooltipsPreference::TOOLTIPS_ON),
+          m_deferredInitializationPending(false) {
     DEBUG_ASSERT(pCoreServices);
     // These depend on the settings
     createMenuBar();
@@ -321,6 +323,10 @@ void MixxxMainWindow::initialize() {
             &PlayerInfo::currentPlayingTrackChanged,
             this,
             &MixxxMainWindow::slotUpdateWindowTitle);
+
+    // Postpone non-critical initialization until the skin has been painted
+    // for the first time, see eventFilter()
+    m_deferredInitializationPending = true;
 }
 
 MixxxMainWindow::~MixxxMainWindow() {
@@ -1047,6 +1053,17 @@ bool MixxxMainWindow::loadConfiguredSkin() {
 }
 
 bool MixxxMainWindow::eventFilter(QObject* obj, QEvent* event) {
+    if (m_deferredInitializationPending &&
+            event->type() == QEvent::Paint &&
+            obj->isWidgetType() &&
+            static_cast<QWidget*>(obj)->window() == this) {
+        m_deferredInitializationPending = false;
+        // The timer fires when the event loop is reached again, after the
+        // first frame of the skin has been painted and flushed
+        QTimer::singleShot(0, this, [this] {
+            m_pCoreServices->initializeDeferred();
+        });
+    }
     if (event->type() == QEvent::ToolTip) {
         // always show tooltips in the preferences window
         QWidget* activeWindow = QApplication::activeWindow();
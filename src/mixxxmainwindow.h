@@ -133,4 +133,7 @@ class MixxxMainWindow : public QMainWindow {
     mixxx::ScreenSaverPreference m_inhibitScreensaver;
 
     QSet<ControlObject*> m_skinCreatedControls;
+
+    // Set until the skin has been painted for the first time
+    bool m_deferredInitializationPending;
 };
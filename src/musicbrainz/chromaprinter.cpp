@@ -31,50 +31,69 @@ namespace
 // --kain88 July 2012
     constexpr SINT kFingerprintDuration = 120; // in seconds
 
+// Decoding and fingerprinting is done in chunks to keep the memory
+// footprint low. Decoding the whole range at once would take about 40 MB
+// for a stereo track at 44.1 kHz.
+constexpr SINT kChunkFrameCount = 32768;
+
 QString calcFingerprint(
         mixxx::AudioSourceStereoProxy& audioSourceProxy,
         mixxx::IndexRange fingerprintRange) {
-    PerformanceTimer timerReadingFile;
-    timerReadingFile.start();
-
-    mixxx::SampleBuffer sampleBuffer(math_max(
-            fingerprintRange.length(),
-            audioSourceProxy.getSignalInfo().frames2samples(fingerprintRange.length())));
-    const auto readableSampleFrames =
-            audioSourceProxy.readSampleFrames(
-                    mixxx::WritableSampleFrames(
-                            fingerprintRange,
-                            mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
-    if (fingerprintRange != readableSampleFrames.frameIndexRange()) {
-        qWarning() << "Failed to read sample data for fingerprint";
-        return QString();
-    }
-
-    std::vector<SAMPLE> fingerprintSamples(
-            audioSourceProxy.getSignalInfo().frames2samples(
-                    readableSampleFrames.frameLength()));
-    // Convert floating-point to integer
-    SampleUtil::convertFloat32ToS16(
-            &fingerprintSamples[0],
-            sampleBuffer.data(),
-            fingerprintSamples.size());
-
-    qDebug() << "reading file took" << timerReadingFile.elapsed().debugMillisWithUnit();
+    PerformanceTimer timerGeneratingFingerprint;
+    timerGeneratingFingerprint.start();
 
+    // Chromaprint mixes all channels down to mono before analyzing the
+    // signal. Doing this upfront halves the samples that need to be
+    // converted and passed to Chromaprint.
     ChromaprintContext* ctx = chromaprint_new(CHROMAPRINT_ALGORITHM_DEFAULT);
     chromaprint_start(
             ctx,
             audioSourceProxy.getSignalInfo().getSampleRate(),
-            audioSourceProxy.getSignalInfo().getChannelCount());
+            1);
+
+    mixxx::SampleBuffer sampleBuffer(
+            audioSourceProxy.getSignalInfo().frames2samples(kChunkFrameCount));
+    std::vector<SAMPLE> fingerprintSamples(kChunkFrameCount);
+    auto remainingRange = fingerprintRange;
+    while (!remainingRange.empty()) {
+        const auto chunkRange = mixxx::IndexRange::forward(
+                remainingRange.start(),
+                math_min(remainingRange.length(), kChunkFrameCount));
+        const auto readableSampleFrames =
+                audioSourceProxy.readSampleFrames(
+                        mixxx::WritableSampleFrames(
+                                chunkRange,
+                                mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+        if (chunkRange != readableSampleFrames.frameIndexRange()) {
+            qWarning() << "Failed to read sample data for fingerprint";
+            chromaprint_free(ctx);
+            return QString();
+        }
+
+        // Mix down to mono in place and convert floating-point to integer
+        const SINT frameCount = chunkRange.length();
+        CSAMPLE* pSamples = sampleBuffer.data();
+        for (SINT i = 0; i < frameCount; ++i) {
+            pSamples[i] = (pSamples[2 * i] + pSamples[2 * i + 1]) * 0.5f;
+        }
+        SampleUtil::convertFloat32ToS16(
+                fingerprintSamples.data(),
+                pSamples,
+                frameCount);
+
+        if (!chromaprint_feed(
+                    ctx,
+                    fingerprintSamples.data(),
+                    static_cast<int>(frameCount))) {
+            qWarning() << "Failed to generate fingerprint from sample data";
+            chromaprint_free(ctx);
+            return QString();
+        }
+        remainingRange = mixxx::IndexRange::between(
+                chunkRange.end(), remainingRange.end());
+    }
 
-    PerformanceTimer timerGeneratingFingerprint;
-    timerGeneratingFingerprint.start();
-    const int success = chromaprint_feed(
-            ctx,
-            &fingerprintSamples[0],
-            static_cast<int>(fingerprintSamples.size()));
-    chromaprint_finish(ctx);
-    if (!success) {
+    if (!chromaprint_finish(ctx)) {
         qWarning() << "Failed to generate fingerprint from sample data";
         chromaprint_free(ctx);
         return QString();
@@ -130,7 +149,7 @@ QString ChromaPrinter::getFingerprint(TrackPointer pTrack) {
                     kFingerprintDuration * pAudioSource->getSignalInfo().getSampleRate()));
     mixxx::AudioSourceStereoProxy audioSourceProxy(
             pAudioSource,
-            fingerprintRange.length());
+            kChunkFrameCount);
 
     return calcFingerprint(audioSourceProxy, fingerprintRange);
 }
@@ -93,7 +93,9 @@ const mixxx::Logger kLogger("BroadcastProfile");
 
 BroadcastProfile::BroadcastProfile(const QString& profileName,
                                    QObject* parent)
-    : QObject(parent) {
+    : QObject(parent),
+      m_encoderCpuLoad(0.0),
+      m_encoderConsumers(0) {
     adoptDefaultValues();
 
     // Direct assignment to avoid triggering the
@@ -443,6 +445,20 @@ int BroadcastProfile::connectionStatus() {
     return atomicLoadRelaxed(m_connectionStatus);
 }
 
+void BroadcastProfile::setEncoderUsage(double cpuLoad, int numConsumers) {
+    m_encoderCpuLoad.store(cpuLoad, std::memory_order_relaxed);
+    m_encoderConsumers = numConsumers;
+    emit encoderUsageChanged(cpuLoad, numConsumers);
+}
+
+double BroadcastProfile::encoderCpuLoad() const {
+    return m_encoderCpuLoad.load(std::memory_order_relaxed);
+}
+
+int BroadcastProfile::encoderConsumers() const {
+    return atomicLoadRelaxed(m_encoderConsumers);
+}
+
 void BroadcastProfile::setSecureCredentialStorage(bool value) {
     m_secureCredentials = value;
 }
@@ -533,6 +549,11 @@ void BroadcastProfile::relayConnectionStatus(int newConnectionStatus) {
     setConnectionStatus(newConnectionStatus);
 }
 
+// Used by BroadcastSettingsModel to relay the encoder usage to its copies
+void BroadcastProfile::relayEncoderUsage(double cpuLoad, int numConsumers) {
+    setEncoderUsage(cpuLoad, numConsumers);
+}
+
 // This was useless before, but now comes in handy for multi-broadcasting,
 // where it means "this connection is enabled and will be started by Mixxx"
 bool BroadcastProfile::getEnabled() const {
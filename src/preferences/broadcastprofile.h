@@ -3,6 +3,7 @@
 #include <QSharedPointer>
 #include <QObject>
 #include <QString>
+#include <atomic>
 
 #include "preferences/usersettings.h"
 
@@ -38,6 +39,12 @@ class BroadcastProfile : public QObject {
     void setConnectionStatus(int newState);
     int connectionStatus();
 
+    // The share of a CPU core spent in the encoder of the connection and
+    // the number of connections that share this encoder
+    void setEncoderUsage(double cpuLoad, int numConsumers);
+    double encoderCpuLoad() const;
+    int encoderConsumers() const;
+
     void setSecureCredentialStorage(bool enabled);
     bool secureCredentialStorage();
 
@@ -138,10 +145,12 @@ class BroadcastProfile : public QObject {
     void profileNameChanged(const QString& oldName, const QString& newName);
     void statusChanged(bool newStatus);
     void connectionStatusChanged(int newConnectionStatus);
+    void encoderUsageChanged(double cpuLoad, int numConsumers);
 
   public slots:
     void relayStatus(bool newStatus);
     void relayConnectionStatus(int newConnectionStatus);
+    void relayEncoderUsage(double cpuLoad, int numConsumers);
 
   private:
     void adoptDefaultValues();
@@ -194,4 +203,6 @@ class BroadcastProfile : public QObject {
     bool m_oggDynamicUpdate;
 
     QAtomicInt m_connectionStatus;
+    std::atomic<double> m_encoderCpuLoad;
+    QAtomicInt m_encoderConsumers;
 };
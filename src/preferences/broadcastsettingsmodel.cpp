@@ -8,6 +8,8 @@ namespace {
 constexpr int kColumnEnabled = 0;
 constexpr int kColumnName = 1;
 constexpr int kColumnStatus = 2;
+constexpr int kColumnEncoder = 3;
+constexpr int kColumnCount = 4;
 } // namespace
 
 BroadcastSettingsModel::BroadcastSettingsModel() {
@@ -28,6 +30,7 @@ void BroadcastSettingsModel::resetFromSettings(BroadcastSettingsPointer pSetting
     for (BroadcastProfilePtr profile : profiles) {
         BroadcastProfilePtr copy = profile->valuesCopy();
         copy->setConnectionStatus(profile->connectionStatus());
+        copy->setEncoderUsage(profile->encoderCpuLoad(), profile->encoderConsumers());
         connect(profile.data(),
                 &BroadcastProfile::statusChanged,
                 copy.data(),
@@ -36,6 +39,10 @@ void BroadcastSettingsModel::resetFromSettings(BroadcastSettingsPointer pSetting
                 &BroadcastProfile::connectionStatusChanged,
                 copy.data(),
                 &BroadcastProfile::relayConnectionStatus);
+        connect(profile.data(),
+                &BroadcastProfile::encoderUsageChanged,
+                copy.data(),
+                &BroadcastProfile::relayEncoderUsage);
         addProfileToModel(copy);
     }
 }
@@ -61,6 +68,10 @@ bool BroadcastSettingsModel::addProfileToModel(BroadcastProfilePtr profile) {
             &BroadcastProfile::connectionStatusChanged,
             this,
             &BroadcastSettingsModel::onConnectionStatusChanged);
+    connect(profile.data(),
+            &BroadcastProfile::encoderUsageChanged,
+            this,
+            &BroadcastSettingsModel::onEncoderUsageChanged);
     m_profiles.insert(profile->getProfileName(), BroadcastProfilePtr(profile));
 
     endInsertRows();
@@ -95,7 +106,7 @@ int BroadcastSettingsModel::rowCount(const QModelIndex& parent) const {
 
 int BroadcastSettingsModel::columnCount(const QModelIndex& parent) const {
     Q_UNUSED(parent);
-    return 3;
+    return kColumnCount;
 }
 
 QVariant BroadcastSettingsModel::data(const QModelIndex& index, int role) const {
@@ -130,6 +141,13 @@ QVariant BroadcastSettingsModel::data(const QModelIndex& index, int role) const
                 return Qt::AlignCenter;
             }
         }
+        else if (column == kColumnEncoder) {
+            if (role == Qt::DisplayRole) {
+                return encoderUsageString(profile);
+            } else if (role == Qt::TextAlignmentRole) {
+                return Qt::AlignCenter;
+            }
+        }
     }
 
     return QVariant();
@@ -145,6 +163,8 @@ QVariant BroadcastSettingsModel::headerData(int section, Qt::Orientation orienta
                 return tr("Name");
             } else if (section == kColumnStatus) {
                 return tr("Status");
+            } else if (section == kColumnEncoder) {
+                return tr("Encoder CPU");
             }
         }
     }
@@ -223,6 +243,21 @@ QColor BroadcastSettingsModel::connectionStatusBgColor(BroadcastProfilePtr profi
         }
 }
 
+QString BroadcastSettingsModel::encoderUsageString(BroadcastProfilePtr profile) {
+    const int numConsumers = profile->encoderConsumers();
+    if (numConsumers <= 0) {
+        // Not encoding
+        return QString();
+    }
+    const QString cpuLoad = QStringLiteral("%1 %").arg(
+            profile->encoderCpuLoad() * 100, 0, 'f', 1);
+    if (numConsumers == 1) {
+        return cpuLoad;
+    }
+    //: %1 is the CPU load of the encoder, %2 the number of connections using it
+    return tr("%1 (shared by %2)").arg(cpuLoad, QString::number(numConsumers));
+}
+
 void BroadcastSettingsModel::onProfileNameChanged(const QString& oldName, const QString& newName) {
     if (!m_profiles.contains(oldName)) {
         return;
@@ -246,3 +281,12 @@ void BroadcastSettingsModel::onConnectionStatusChanged(int newStatus) {
     QModelIndex end = this->index(this->rowCount()-1, kColumnStatus);
     emit dataChanged(start, end);
 }
+
+void BroadcastSettingsModel::onEncoderUsageChanged(double cpuLoad, int numConsumers) {
+    Q_UNUSED(cpuLoad);
+    Q_UNUSED(numConsumers);
+    // Refresh the whole encoder column
+    QModelIndex start = this->index(0, kColumnEncoder);
+    QModelIndex end = this->index(this->rowCount()-1, kColumnEncoder);
+    emit dataChanged(start, end);
+}
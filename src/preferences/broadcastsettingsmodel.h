@@ -36,10 +36,12 @@ class BroadcastSettingsModel : public QAbstractTableModel {
   private slots:
     void onProfileNameChanged(const QString& oldName, const QString& newName);
     void onConnectionStatusChanged(int newStatus);
+    void onEncoderUsageChanged(double cpuLoad, int numConsumers);
 
   private:
     static QString connectionStatusString(BroadcastProfilePtr profile);
     static QColor connectionStatusBgColor(BroadcastProfilePtr profile);
+    static QString encoderUsageString(BroadcastProfilePtr profile);
 
     QMap<QString, BroadcastProfilePtr> m_profiles;
 };
@@ -1,5 +1,6 @@
 #include "qmlapplication.h"
 
+#include <QQuickWindow>
 #include <QtQml/qqmlextensionplugin.h>
 
 #include "control/controlsortfiltermodel.h"
@@ -86,6 +87,25 @@ QmlApplication::QmlApplication(
 
     loadQml(m_mainFilePath);
 
+    // Postpone non-critical initialization until the first frame has been
+    // shown. frameSwapped() is emitted by the render thread.
+    QQuickWindow* pWindow = m_pAppEngine->rootObjects().isEmpty()
+            ? nullptr
+            : qobject_cast<QQuickWindow*>(m_pAppEngine->rootObjects().first());
+    if (pWindow) {
+        connect(
+                pWindow,
+                &QQuickWindow::frameSwapped,
+                this,
+                [this] {
+                    m_pCoreServices->initializeDeferred();
+                },
+                static_cast<Qt::ConnectionType>(
+                        Qt::QueuedConnection | Qt::SingleShotConnection));
+    } else {
+        m_pCoreServices->initializeDeferred();
+    }
+
     connect(&m_fileWatcher,
             &QFileSystemWatcher::fileChanged,
             this,
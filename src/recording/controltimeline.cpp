@@ -0,0 +1,282 @@
+#include "recording/controltimeline.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <algorithm>
+
+#include "track/beats.h"
+#include "track/cue.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ControlTimeline");
+
+const QString kFormatName = QStringLiteral("mixxx-control-timeline");
+constexpr int kFormatVersion = 1;
+
+const QString kTypeSet = QStringLiteral("set");
+const QString kTypeLoadTrack = QStringLiteral("load");
+
+// JSON has no representation for NaN, i.e. invalid positions
+QJsonValue framePosToJson(mixxx::audio::FramePos position) {
+    if (!position.isValid()) {
+        return QJsonValue();
+    }
+    return position.value();
+}
+
+mixxx::audio::FramePos framePosFromJson(const QJsonValue& value) {
+    if (!value.isDouble()) {
+        return mixxx::audio::kInvalidFramePos;
+    }
+    return mixxx::audio::FramePos(value.toDouble());
+}
+
+QJsonObject trackLoadToJson(const ControlTimeline::TrackLoad& track) {
+    QJsonObject object;
+    object.insert(QStringLiteral("location"), track.location);
+    object.insert(QStringLiteral("sample_rate"),
+            static_cast<double>(track.sampleRate.value()));
+    if (!track.beats.isEmpty()) {
+        QJsonObject beats;
+        beats.insert(QStringLiteral("version"), track.beatsVersion);
+        beats.insert(QStringLiteral("sub_version"), track.beatsSubVersion);
+        beats.insert(QStringLiteral("data"), QString::fromLatin1(track.beats.toBase64()));
+        object.insert(QStringLiteral("beats"), beats);
+    }
+    QJsonObject replayGain;
+    replayGain.insert(QStringLiteral("ratio"), track.replayGain.getRatio());
+    replayGain.insert(QStringLiteral("peak"), track.replayGain.getPeak());
+    object.insert(QStringLiteral("replay_gain"), replayGain);
+    object.insert(QStringLiteral("main_cue"), framePosToJson(track.mainCuePosition));
+    QJsonArray cuePoints;
+    for (const auto& cuePoint : track.cuePoints) {
+        QJsonObject cue;
+        cue.insert(QStringLiteral("type"), static_cast<int>(cuePoint.type));
+        cue.insert(QStringLiteral("hotcue"), cuePoint.hotCueIndex);
+        cue.insert(QStringLiteral("position"), framePosToJson(cuePoint.position));
+        cue.insert(QStringLiteral("end_position"), framePosToJson(cuePoint.endPosition));
+        cuePoints.append(cue);
+    }
+    object.insert(QStringLiteral("cues"), cuePoints);
+    return object;
+}
+
+ControlTimeline::TrackLoad trackLoadFromJson(const QJsonObject& object) {
+    ControlTimeline::TrackLoad track;
+    track.location = object.value(QStringLiteral("location")).toString();
+    track.sampleRate = mixxx::audio::SampleRate(static_cast<mixxx::audio::SampleRate::value_t>(
+            object.value(QStringLiteral("sample_rate")).toDouble()));
+    const QJsonObject beats = object.value(QStringLiteral("beats")).toObject();
+    if (!beats.isEmpty()) {
+        track.beatsVersion = beats.value(QStringLiteral("version")).toString();
+        track.beatsSubVersion = beats.value(QStringLiteral("sub_version")).toString();
+        track.beats = QByteArray::fromBase64(
+                beats.value(QStringLiteral("data")).toString().toLatin1());
+    }
+    const QJsonObject replayGain = object.value(QStringLiteral("replay_gain")).toObject();
+    track.replayGain = mixxx::ReplayGain(
+            replayGain.value(QStringLiteral("ratio"))
+                    .toDouble(mixxx::ReplayGain::kRatioUndefined),
+            static_cast<CSAMPLE>(replayGain.value(QStringLiteral("peak"))
+                                         .toDouble(mixxx::ReplayGain::kPeakUndefined)));
+    track.mainCuePosition = framePosFromJson(object.value(QStringLiteral("main_cue")));
+    const QJsonArray cuePoints = object.value(QStringLiteral("cues")).toArray();
+    for (const auto& value : cuePoints) {
+        const QJsonObject cue = value.toObject();
+        track.cuePoints.append(ControlTimeline::CuePoint{
+                static_cast<mixxx::CueType>(cue.value(QStringLiteral("type")).toInt()),
+                cue.value(QStringLiteral("hotcue")).toInt(Cue::kNoHotCue),
+                framePosFromJson(cue.value(QStringLiteral("position"))),
+                framePosFromJson(cue.value(QStringLiteral("end_position"))),
+        });
+    }
+    return track;
+}
+
+} // anonymous namespace
+
+// static
+ControlTimeline::TrackLoad ControlTimeline::TrackLoad::fromTrack(const Track& track) {
+    TrackLoad trackLoad;
+    trackLoad.location = track.getLocation();
+    trackLoad.sampleRate = track.getSampleRate();
+    const mixxx::BeatsPointer pBeats = track.getBeats();
+    if (pBeats) {
+        trackLoad.beatsVersion = pBeats->getVersion();
+        trackLoad.beatsSubVersion = pBeats->getSubVersion();
+        trackLoad.beats = pBeats->toByteArray();
+    }
+    trackLoad.replayGain = track.getReplayGain();
+    trackLoad.mainCuePosition = track.getMainCuePosition();
+    const QList<CuePointer> cuePoints = track.getCuePoints();
+    for (const auto& pCue : cuePoints) {
+        if (pCue->getType() == mixxx::CueType::MainCue) {
+            // Restored from mainCuePosition
+            continue;
+        }
+        trackLoad.cuePoints.append(CuePoint{
+                pCue->getType(),
+                pCue->getHotCue(),
+                pCue->getPosition(),
+                pCue->getEndPosition(),
+        });
+    }
+    return trackLoad;
+}
+
+void ControlTimeline::TrackLoad::applyAnalysis(Track* pTrack) const {
+    DEBUG_ASSERT(pTrack);
+    DEBUG_ASSERT(pTrack->getLocation() == location);
+    if (!beats.isEmpty()) {
+        const auto pBeats = mixxx::Beats::fromByteArray(
+                sampleRate, beatsVersion, beatsSubVersion, beats);
+        if (!pBeats || !pTrack->trySetBeats(pBeats)) {
+            kLogger.warning() << "Failed to restore the beats of" << location;
+        }
+    }
+    pTrack->setReplayGain(replayGain);
+    pTrack->setMainCuePosition(mainCuePosition);
+    for (const auto& cuePoint : cuePoints) {
+        pTrack->createAndAddCue(cuePoint.type,
+                cuePoint.hotCueIndex,
+                cuePoint.position,
+                cuePoint.endPosition);
+    }
+}
+
+ControlTimeline::ControlTimeline(mixxx::audio::SampleRate sampleRate)
+        : m_sampleRate(sampleRate),
+          m_endFrame(0) {
+}
+
+void ControlTimeline::setEndFrame(qint64 endFrame) {
+    m_endFrame = std::max(endFrame, m_endFrame);
+}
+
+void ControlTimeline::appendSet(qint64 frame, const ConfigKey& key, double value) {
+    Event event;
+    event.frame = frame;
+    event.type = Event::Type::Set;
+    event.key = key;
+    event.value = value;
+    append(std::move(event));
+}
+
+void ControlTimeline::appendLoadTrack(qint64 frame, const QString& group, TrackLoad track) {
+    Event event;
+    event.frame = frame;
+    event.type = Event::Type::LoadTrack;
+    event.key = ConfigKey(group, QString());
+    event.trackLoadIndex = m_trackLoads.size();
+    m_trackLoads.append(std::move(track));
+    append(std::move(event));
+}
+
+void ControlTimeline::append(Event event) {
+    VERIFY_OR_DEBUG_ASSERT(m_events.isEmpty() || m_events.last().frame <= event.frame) {
+        event.frame = m_events.last().frame;
+    }
+    m_endFrame = std::max(event.frame, m_endFrame);
+    m_events.append(std::move(event));
+}
+
+void ControlTimeline::clear() {
+    m_events.clear();
+    m_trackLoads.clear();
+    m_endFrame = 0;
+}
+
+bool ControlTimeline::save(const QString& filePath) const {
+    QJsonArray events;
+    for (const auto& event : m_events) {
+        QJsonObject object;
+        object.insert(QStringLiteral("frame"), static_cast<double>(event.frame));
+        object.insert(QStringLiteral("group"), event.key.group);
+        switch (event.type) {
+        case Event::Type::Set:
+            object.insert(QStringLiteral("type"), kTypeSet);
+            object.insert(QStringLiteral("item"), event.key.item);
+            object.insert(QStringLiteral("value"), event.value);
+            break;
+        case Event::Type::LoadTrack:
+            object.insert(QStringLiteral("type"), kTypeLoadTrack);
+            object.insert(QStringLiteral("track"), trackLoadToJson(trackLoad(event)));
+            break;
+        }
+        events.append(object);
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("format"), kFormatName);
+    root.insert(QStringLiteral("version"), kFormatVersion);
+    root.insert(QStringLiteral("sample_rate"), static_cast<double>(m_sampleRate.value()));
+    root.insert(QStringLiteral("end_frame"), static_cast<double>(m_endFrame));
+    root.insert(QStringLiteral("events"), events);
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0 ||
+            !file.commit()) {
+        kLogger.warning() << "Failed to write timeline" << filePath;
+        return false;
+    }
+    return true;
+}
+
+bool ControlTimeline::load(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        kLogger.warning() << "Failed to open timeline" << filePath;
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    const QJsonObject root = document.object();
+    if (parseError.error != QJsonParseError::NoError ||
+            root.value(QStringLiteral("format")).toString() != kFormatName ||
+            root.value(QStringLiteral("version")).toInt() != kFormatVersion) {
+        kLogger.warning() << "Invalid timeline" << filePath << parseError.errorString();
+        return false;
+    }
+    const auto sampleRate = mixxx::audio::SampleRate(
+            static_cast<mixxx::audio::SampleRate::value_t>(
+                    root.value(QStringLiteral("sample_rate")).toDouble()));
+    if (!sampleRate.isValid()) {
+        kLogger.warning() << "Invalid sample rate in timeline" << filePath;
+        return false;
+    }
+
+    ControlTimeline timeline(sampleRate);
+    const QJsonArray events = root.value(QStringLiteral("events")).toArray();
+    for (const auto& value : events) {
+        const QJsonObject object = value.toObject();
+        const auto frame = static_cast<qint64>(object.value(QStringLiteral("frame")).toDouble());
+        const QString type = object.value(QStringLiteral("type")).toString();
+        const QString group = object.value(QStringLiteral("group")).toString();
+        if (!timeline.isEmpty() && frame < timeline.m_events.last().frame) {
+            kLogger.warning() << "Unordered events in timeline" << filePath;
+            return false;
+        }
+        if (type == kTypeSet) {
+            timeline.appendSet(frame,
+                    ConfigKey(group, object.value(QStringLiteral("item")).toString()),
+                    object.value(QStringLiteral("value")).toDouble());
+        } else if (type == kTypeLoadTrack) {
+            timeline.appendLoadTrack(frame,
+                    group,
+                    trackLoadFromJson(object.value(QStringLiteral("track")).toObject()));
+        } else {
+            kLogger.warning() << "Ignoring unknown event" << type << "in timeline" << filePath;
+        }
+    }
+    timeline.setEndFrame(static_cast<qint64>(
+            root.value(QStringLiteral("end_frame")).toDouble()));
+    *this = std::move(timeline);
+    return true;
+}
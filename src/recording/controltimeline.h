@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "audio/types.h"
+#include "preferences/configobject.h"
+#include "track/cueinfo.h"
+#include "track/replaygain.h"
+#include "track/track_decl.h"
+#include "util/assert.h"
+
+/// A timestamped log of the control changes and track loads of a mix.
+///
+/// The timeline is recorded while playing live and replayed by the offline
+/// renderer, which reproduces the mix from the original audio files. The
+/// time of each event is the number of frames that have been recorded
+/// before it was applied, at the sample rate of the timeline.
+class ControlTimeline {
+  public:
+    struct CuePoint {
+        mixxx::CueType type;
+        int hotCueIndex;
+        mixxx::audio::FramePos position;
+        mixxx::audio::FramePos endPosition;
+    };
+
+    /// The track and the analysis data that affects playback. The offline
+    /// renderer has no access to the library and restores it from here.
+    struct TrackLoad {
+        QString location;
+        mixxx::audio::SampleRate sampleRate;
+        QString beatsVersion;
+        QString beatsSubVersion;
+        QByteArray beats;
+        mixxx::ReplayGain replayGain;
+        mixxx::audio::FramePos mainCuePosition;
+        QList<CuePoint> cuePoints;
+
+        static TrackLoad fromTrack(const Track& track);
+        /// Restores the analysis data of a temporary track that has
+        /// been loaded from the same location.
+        void applyAnalysis(Track* pTrack) const;
+    };
+
+    struct Event {
+        enum class Type {
+            Set,
+            LoadTrack,
+        };
+
+        qint64 frame = 0;
+        Type type = Type::Set;
+        /// The control for Set or the group of the player for LoadTrack
+        ConfigKey key;
+        double value = 0.0;
+        /// The index into trackLoads() for LoadTrack. Track loads are
+        /// rare and kept apart to keep the many Set events small.
+        int trackLoadIndex = -1;
+    };
+
+    explicit ControlTimeline(
+            mixxx::audio::SampleRate sampleRate = mixxx::audio::SampleRate());
+
+    mixxx::audio::SampleRate sampleRate() const {
+        return m_sampleRate;
+    }
+
+    const QList<Event>& events() const {
+        return m_events;
+    }
+
+    const QList<TrackLoad>& trackLoads() const {
+        return m_trackLoads;
+    }
+
+    /// The track of a LoadTrack event.
+    const TrackLoad& trackLoad(const Event& event) const {
+        DEBUG_ASSERT(event.type == Event::Type::LoadTrack);
+        return m_trackLoads.at(event.trackLoadIndex);
+    }
+
+    bool isEmpty() const {
+        return m_events.isEmpty();
+    }
+
+    /// The length of the recording, at least the frame of the last event.
+    qint64 endFrame() const {
+        return m_endFrame;
+    }
+    void setEndFrame(qint64 endFrame);
+
+    /// The frames of all events must be ascending.
+    void appendSet(qint64 frame, const ConfigKey& key, double value);
+    void appendLoadTrack(qint64 frame, const QString& group, TrackLoad track);
+
+    void clear();
+
+    /// Writes the timeline as a JSON document. Doubles are stored with the
+    /// shortest representation that converts back to the same value, so a
+    /// saved timeline replays exactly like the recorded one.
+    bool save(const QString& filePath) const;
+    bool load(const QString& filePath);
+
+  private:
+    void append(Event event);
+
+    mixxx::audio::SampleRate m_sampleRate;
+    QList<Event> m_events;
+    QList<TrackLoad> m_trackLoads;
+    qint64 m_endFrame;
+};
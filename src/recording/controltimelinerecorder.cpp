@@ -0,0 +1,182 @@
+#include "recording/controltimelinerecorder.h"
+
+#include <QStringList>
+#include <QThread>
+#include <algorithm>
+
+#include "mixer/playerinfo.h"
+#include "moc_controltimelinerecorder.cpp"
+#include "recording/defs_recording.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ControlTimelineRecorder");
+
+// Groups of the GUI, the library and the recording itself that do not
+// affect the mixed audio. Starting and stopping the recording must not be
+// replayed either.
+const QStringList kIgnoredGroups = {
+        QStringLiteral(RECORDING_PREF_KEY),
+        QStringLiteral("[AutoDJ]"),
+        QStringLiteral("[Controls]"),
+        QStringLiteral("[Library]"),
+        QStringLiteral("[Playlist]"),
+        QStringLiteral("[Skin]"),
+        QStringLiteral("[Waveform]"),
+};
+
+// The preview deck is only audible in the headphones
+const QString kPreviewDeckGroupPrefix = QStringLiteral("[PreviewDeck");
+
+// Controls of the widgets in otherwise recorded groups, e.g. the GuiTick
+// timers in [Master] and the waveform zoom of the decks
+const QStringList kIgnoredItemPrefixes = {
+        QStringLiteral("guiTick"),
+        QStringLiteral("waveform_zoom"),
+};
+
+bool isRecordedControl(const ConfigKey& key) {
+    if (kIgnoredGroups.contains(key.group) ||
+            key.group.startsWith(kPreviewDeckGroupPrefix)) {
+        return false;
+    }
+    for (const auto& prefix : kIgnoredItemPrefixes) {
+        if (key.item.startsWith(prefix)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Set in the threads whose control changes are recorded. Unlike
+// QThread::currentThread(), which creates a QAdoptedThread on the first
+// call from a thread that has not been started by Qt, e.g. the audio
+// callback thread of PortAudio, reading it never allocates.
+thread_local bool t_isSourceThread = false;
+
+} // anonymous namespace
+
+ControlTimelineRecorder::ControlTimelineRecorder(QObject* pParent)
+        : QObject(pParent),
+          m_recording(false),
+          m_framePosition(0) {
+    t_isSourceThread = true;
+}
+
+ControlTimelineRecorder::~ControlTimelineRecorder() {
+    if (isRecording()) {
+        ControlDoublePrivate::setSetObserver(nullptr);
+    }
+}
+
+void ControlTimelineRecorder::addSourceThread(QThread* pThread) {
+    VERIFY_OR_DEBUG_ASSERT(!isRecording()) {
+        return;
+    }
+    // The flag can only be set from within the thread
+    auto* pContext = new QObject();
+    pContext->moveToThread(pThread);
+    QMetaObject::invokeMethod(
+            pContext,
+            [pContext] {
+                t_isSourceThread = true;
+                pContext->deleteLater();
+            },
+            Qt::QueuedConnection);
+}
+
+void ControlTimelineRecorder::start(mixxx::audio::SampleRate sampleRate) {
+    VERIFY_OR_DEBUG_ASSERT(!isRecording()) {
+        return;
+    }
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_timeline = ControlTimeline(sampleRate);
+        m_framePosition.store(0, std::memory_order_release);
+        const auto loadedTracks = PlayerInfo::instance().getLoadedTracks();
+        for (auto it = loadedTracks.constBegin(); it != loadedTracks.constEnd(); ++it) {
+            if (it.value()) {
+                m_timeline.appendLoadTrack(0,
+                        it.key(),
+                        ControlTimeline::TrackLoad::fromTrack(*it.value()));
+            }
+        }
+        appendControlSnapshot();
+    }
+    connect(&PlayerInfo::instance(),
+            &PlayerInfo::trackChanged,
+            this,
+            &ControlTimelineRecorder::slotTrackChanged);
+    m_recording.store(true, std::memory_order_release);
+    ControlDoublePrivate::setSetObserver(this);
+}
+
+bool ControlTimelineRecorder::stop(const QString& filePath) {
+    VERIFY_OR_DEBUG_ASSERT(isRecording()) {
+        return false;
+    }
+    ControlDoublePrivate::setSetObserver(nullptr);
+    m_recording.store(false, std::memory_order_release);
+    disconnect(&PlayerInfo::instance(),
+            &PlayerInfo::trackChanged,
+            this,
+            &ControlTimelineRecorder::slotTrackChanged);
+
+    const auto locker = lockMutex(&m_mutex);
+    m_timeline.setEndFrame(m_framePosition.load(std::memory_order_acquire));
+    kLogger.info()
+            << "Writing" << m_timeline.events().size()
+            << "events to" << filePath;
+    const bool saved = m_timeline.save(filePath);
+    m_timeline.clear();
+    return saved;
+}
+
+void ControlTimelineRecorder::appendControlSnapshot() {
+    // The controls are sorted for deterministic and readable timelines
+    auto controls = ControlDoublePrivate::getAllInstances();
+    std::sort(controls.begin(),
+            controls.end(),
+            [](const auto& pLhs, const auto& pRhs) {
+                const ConfigKey& lhs = pLhs->getKey();
+                const ConfigKey& rhs = pRhs->getKey();
+                return lhs.group < rhs.group ||
+                        (lhs.group == rhs.group && lhs.item < rhs.item);
+            });
+    for (const auto& pControl : qAsConst(controls)) {
+        const ConfigKey& key = pControl->getKey();
+        const double value = pControl->get();
+        if (!isRecordedControl(key) || value == pControl->defaultValue()) {
+            continue;
+        }
+        m_timeline.appendSet(0, key, value);
+    }
+}
+
+void ControlTimelineRecorder::controlSet(const ConfigKey& key, double value) {
+    // This is invoked for each set() of each control from any thread. Only
+    // the source threads may block on the mutex, never the engine thread.
+    if (!isRecording() || !t_isSourceThread || !isRecordedControl(key)) {
+        return;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    m_timeline.appendSet(
+            m_framePosition.load(std::memory_order_acquire), key, value);
+}
+
+void ControlTimelineRecorder::slotTrackChanged(
+        const QString& group, TrackPointer pNewTrack, TrackPointer pOldTrack) {
+    Q_UNUSED(pOldTrack);
+    if (!pNewTrack) {
+        // Ejecting is recorded as a control change
+        return;
+    }
+    auto trackLoad = ControlTimeline::TrackLoad::fromTrack(*pNewTrack);
+    const auto locker = lockMutex(&m_mutex);
+    m_timeline.appendLoadTrack(
+            m_framePosition.load(std::memory_order_acquire), group, std::move(trackLoad));
+}
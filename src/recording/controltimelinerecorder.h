@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <atomic>
+
+#include "control/control.h"
+#include "recording/controltimeline.h"
+
+class QThread;
+
+/// Records the control changes and track loads during a recording session
+/// into a ControlTimeline, which can be replayed by the offline renderer.
+///
+/// Only the changes requested from the source threads are recorded, i.e.
+/// from the GUI and the controllers. Changes that are made by the engine
+/// itself are the result of the recorded input and would be reproduced
+/// anyway. Controls that do not affect the mixed audio, e.g. of the
+/// library, the skin or the GuiTick timers, are not recorded either.
+///
+/// The clock of the timeline is advanced by EngineRecord for each buffer
+/// that is written to the recording, so all events between two buffers
+/// share the same frame.
+class ControlTimelineRecorder : public QObject,
+                                public ControlDoublePrivate::SetObserver {
+    Q_OBJECT
+  public:
+    explicit ControlTimelineRecorder(QObject* pParent = nullptr);
+    ~ControlTimelineRecorder() override;
+
+    /// Records the changes requested from pThread in addition to those from
+    /// the thread of the recorder. Must not be called while recording.
+    /// There must only be a single recorder.
+    void addSourceThread(QThread* pThread);
+
+    /// Starts a new timeline with a snapshot of all loaded tracks and all
+    /// controls that differ from their default value.
+    void start(mixxx::audio::SampleRate sampleRate);
+    /// Stops recording and writes the timeline to filePath.
+    bool stop(const QString& filePath);
+
+    bool isRecording() const {
+        return m_recording.load(std::memory_order_acquire);
+    }
+
+    /// Called by EngineRecord after a buffer has been recorded.
+    void advance(qint64 frames) {
+        m_framePosition.fetch_add(frames, std::memory_order_acq_rel);
+    }
+
+    void controlSet(const ConfigKey& key, double value) override;
+
+  private slots:
+    void slotTrackChanged(const QString& group, TrackPointer pNewTrack, TrackPointer pOldTrack);
+
+  private:
+    void appendControlSnapshot();
+
+    std::atomic<bool> m_recording;
+    std::atomic<qint64> m_framePosition;
+
+    // Guards m_timeline
+    QMutex m_mutex;
+    ControlTimeline m_timeline;
+};
@@ -13,6 +13,7 @@
 #include "engine/sidechain/enginesidechain.h"
 #include "errordialoghandler.h"
 #include "moc_recordingmanager.cpp"
+#include "recording/controltimelinerecorder.h"
 #include "recording/defs_recording.h"
 
 #define MIN_DISK_FREE 1024 * 1024 * 1024ll // one gibibyte
@@ -38,6 +39,8 @@ RecordingManager::RecordingManager(UserSettingsPointer pConfig, EngineMaster* pE
             &RecordingManager::slotToggleRecording);
     m_recReadyCO = new ControlObject(ConfigKey(RECORDING_PREF_KEY, "status"));
     m_recReady = new ControlProxy(m_recReadyCO->getKey(), this);
+    m_pSampleRate = new ControlProxy("[Master]", "samplerate", this);
+    m_pTimelineRecorder = new ControlTimelineRecorder(this);
 
     m_split_size = getFileSplitSize();
     m_split_time = getFileSplitSeconds();
@@ -46,6 +49,7 @@ RecordingManager::RecordingManager(UserSettingsPointer pConfig, EngineMaster* pE
     EngineSideChain* pSidechain = pEngine->getSideChain();
     if (pSidechain) {
         EngineRecord* pEngineRecord = new EngineRecord(m_pConfig);
+        pEngineRecord->setControlTimelineRecorder(m_pTimelineRecorder);
         connect(pEngineRecord,
                 &EngineRecord::isRecording,
                 this,
@@ -65,6 +69,8 @@ RecordingManager::RecordingManager(UserSettingsPointer pConfig, EngineMaster* pE
 RecordingManager::~RecordingManager() {
     qDebug() << "Delete RecordingManager";
 
+    stopControlTimeline();
+
     delete m_recReadyCO;
     delete m_pToggleRecording;
 }
@@ -143,6 +149,7 @@ void RecordingManager::startRecording() {
     m_pConfig->set(ConfigKey(RECORDING_PREF_KEY, "CuePath"), ConfigValue(m_recording_base_file + QStringLiteral(".cue")));
 
     m_recReady->set(RECORD_READY);
+    startControlTimeline();
 }
 
 void RecordingManager::splitContinueRecording()
@@ -171,6 +178,7 @@ void RecordingManager::splitContinueRecording()
 void RecordingManager::stopRecording() {
     qDebug() << "Recording stopped";
     m_recReady->set(RECORD_OFF);
+    stopControlTimeline();
     m_recordingFile = "";
     m_recordingLocation = "";
     m_iNumberOfBytesRecorded = 0;
@@ -285,6 +293,11 @@ void RecordingManager::slotIsRecording(bool isRecordingActive, bool error) {
     m_bRecording = isRecordingActive;
     emit isRecording(isRecordingActive);
 
+    if (!isRecordingActive) {
+        // The engine might have failed to start recording
+        stopControlTimeline();
+    }
+
     if (error) {
         ErrorDialogProperties* props = ErrorDialogHandler::instance()->newDialogProperties();
         props->setType(DLG_WARNING);
@@ -309,6 +322,31 @@ const QString& RecordingManager::getRecordingLocation() const {
     return m_recordingLocation;
 }
 
+void RecordingManager::addControlTimelineSourceThread(QThread* pThread) {
+    m_pTimelineRecorder->addSourceThread(pThread);
+}
+
+void RecordingManager::startControlTimeline() {
+    // Recording all control changes is only needed for rendering
+    // the mix again offline, which is disabled by default.
+    if (!m_pConfig->getValue(ConfigKey(RECORDING_PREF_KEY, "TimelineEnabled"), false)) {
+        return;
+    }
+    m_pTimelineRecorder->start(mixxx::audio::SampleRate(
+            static_cast<mixxx::audio::SampleRate::value_t>(m_pSampleRate->get())));
+}
+
+void RecordingManager::stopControlTimeline() {
+    if (!m_pTimelineRecorder->isRecording()) {
+        return;
+    }
+    // A single timeline covers all split files of a recording
+    const QString timelineLocation = m_recording_base_file + QStringLiteral(".timeline");
+    if (!m_pTimelineRecorder->stop(timelineLocation)) {
+        qWarning() << "Failed to write control timeline" << timelineLocation;
+    }
+}
+
 quint64 RecordingManager::getFileSplitSize() {
     QString fileSizeStr = m_pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "FileSize"));
     if (fileSizeStr == SPLIT_650MB) {
@@ -13,6 +13,8 @@
 class EngineMaster;
 class ControlPushButton;
 class ControlProxy;
+class ControlTimelineRecorder;
+class QThread;
 
 /// The RecordingManager is a central class and manages
 /// the recording feature of Mixxx.
@@ -40,6 +42,11 @@ class RecordingManager : public QObject {
     const QString& getRecordingFile() const;
     const QString& getRecordingLocation() const;
 
+    // The control changes from this thread are recorded in addition to
+    // those from the GUI when writing a control timeline, e.g. for
+    // the controllers.
+    void addControlTimelineSourceThread(QThread* pThread);
+
   signals:
     // Emits the cumulative number of bytes currently recorded.
     void bytesRecorded(int);
@@ -60,9 +67,13 @@ class RecordingManager : public QObject {
     // name of the first split but with a suffix.
     void splitContinueRecording();
     void warnFreespace();
+    void startControlTimeline();
+    void stopControlTimeline();
     ControlProxy* m_recReady;
     ControlObject* m_recReadyCO;
     ControlPushButton* m_pToggleRecording;
+    ControlProxy* m_pSampleRate;
+    ControlTimelineRecorder* m_pTimelineRecorder;
 
     quint64 getFileSplitSize();
     unsigned int getFileSplitSeconds();
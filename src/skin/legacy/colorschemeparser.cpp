@@ -1,5 +1,7 @@
 #include "skin/legacy/colorschemeparser.h"
 
+#include <QTextStream>
+
 #include "widget/wpixmapstore.h"
 #include "widget/wimagestore.h"
 #include "widget/wskincolor.h"
@@ -10,6 +12,7 @@
 #include "skin/legacy/imgcolor.h"
 #include "skin/legacy/imginvert.h"
 #include "skin/legacy/legacyskinparser.h"
+#include "skin/legacy/skincache.h"
 #include "skin/legacy/skincontext.h"
 
 void ColorSchemeParser::setupLegacyColorSchemes(const QDomElement& docElem,
@@ -45,8 +48,14 @@ void ColorSchemeParser::setupLegacyColorSchemes(const QDomElement& docElem,
         }
 
         if (bSelectedColorSchemeFound) {
+            const QDomNode filtersNode = schemeNode.namedItem("Filters");
             QSharedPointer<ImgSource> imsrc =
-                    QSharedPointer<ImgSource>(parseFilters(schemeNode.namedItem("Filters")));
+                    QSharedPointer<ImgSource>(parseFilters(filtersNode));
+            // Images rasterized with different filters must not be mixed up
+            QString filters;
+            QTextStream filtersStream(&filters);
+            filtersNode.save(filtersStream, 0);
+            SkinCache::setColorSchemeFilters(filters);
             WPixmapStore::setLoader(imsrc);
             WImageStore::setLoader(imsrc);
             WSkinColor::setLoader(imsrc);
@@ -64,6 +73,7 @@ void ColorSchemeParser::setupLegacyColorSchemes(const QDomElement& docElem,
     if (!bSelectedColorSchemeFound) {
         QSharedPointer<ImgSource> imsrc =
                 QSharedPointer<ImgSource>(new ImgLoader());
+        SkinCache::setColorSchemeFilters(QString());
         WPixmapStore::setLoader(imsrc);
         WImageStore::setLoader(imsrc);
         WSkinColor::setLoader(imsrc);
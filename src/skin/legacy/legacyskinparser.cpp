@@ -23,6 +23,7 @@
 #include "recording/recordingmanager.h"
 #include "skin/legacy/colorschemeparser.h"
 #include "skin/legacy/launchimage.h"
+#include "skin/legacy/skincache.h"
 #include "skin/legacy/skincontext.h"
 #include "util/cmdlineargs.h"
 #include "util/timer.h"
@@ -97,6 +98,16 @@ QSet<QString> LegacySkinParser::s_sharedGroupStrings;
 
 static bool sDebug = false;
 
+namespace {
+
+// Relative to the settings path
+const QString kSkinCacheDirectory = QStringLiteral("cache/skins");
+
+const ConfigKey kRasterCacheLimitConfigKey =
+        ConfigKey(QStringLiteral("[Config]"), QStringLiteral("SkinRasterCacheLimitKB"));
+
+} // anonymous namespace
+
 ControlObject* LegacySkinParser::controlFromConfigKey(
         const ConfigKey& key, bool bPersist, bool* pCreated) {
     if (!key.isValid()) {
@@ -221,28 +232,20 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
     }
 
     QString skinXmlPath = skinDir.filePath("skin.xml");
-    QFile skinXmlFile(skinXmlPath);
-
-    if (!skinXmlFile.open(QIODevice::ReadOnly)) {
-        qDebug() << "LegacySkinParser::openSkin - can't open file:" << skinXmlPath
-                 << "in directory:" << skinDir.path();
-        return QDomElement();
-    }
-
-    QDomDocument skin("skin");
 
     QString errorMessage;
-    int errorLine;
-    int errorColumn;
+    int errorLine = 0;
+    int errorColumn = 0;
 
-    if (!skin.setContent(&skinXmlFile,&errorMessage,&errorLine,&errorColumn)) {
+    const QDomDocument skin = SkinCache::loadXmlDocument(
+            skinXmlPath, &errorMessage, &errorLine, &errorColumn);
+    if (skin.isNull()) {
         qDebug() << "LegacySkinParser::openSkin - setContent failed see"
-                 << "line:" << errorLine << "column:" << errorColumn;
+                 << skinXmlPath << "line:" << errorLine << "column:" << errorColumn;
         qDebug() << "LegacySkinParser::openSkin - message:" << errorMessage;
         return QDomElement();
     }
 
-    skinXmlFile.close();
     return skin.documentElement();
 }
 
@@ -327,6 +330,11 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     m_pContext = std::make_unique<SkinContext>(m_pConfig, skinPath + "/skin.xml");
     m_pContext->setSkinBasePath(skinPath);
 
+    SkinCache::setCacheDirectory(
+            QDir(m_pConfig->getSettingsPath()).filePath(kSkinCacheDirectory));
+    WPixmapStore::setRasterCacheLimit(m_pConfig->getValue(
+            kRasterCacheLimitConfigKey, WPixmapStore::kDefaultRasterCacheLimitKB));
+
     if (m_pParent) {
         qDebug() << "ERROR: Somehow a parent already exists -- you are probably re-using a LegacySkinParser which is not advisable!";
     }
@@ -875,20 +883,20 @@ QWidget* LegacySkinParser::parseBackground(const QDomElement& node,
     QLabel* bg = new QLabel(pInnerWidget);
 
     QString filename = m_pContext->selectString(node, "Path");
-    QPixmap* background = WPixmapStore::getPixmapNoCache(
+    const QPixmap background = WPixmapStore::getPixmap(
         m_pContext->makeSkinPath(filename), m_pContext->getScaleFactor());
 
     bg->move(0, 0);
-    if (background != nullptr && !background->isNull()) {
-        bg->setPixmap(*background);
+    if (!background.isNull()) {
+        bg->setPixmap(background);
     }
 
     bg->lower();
 
     pInnerWidget->move(0,0);
-    if (background != nullptr && !background->isNull()) {
-        pInnerWidget->setFixedSize(background->width(), background->height());
-        pOuterWidget->setMinimumSize(background->width(), background->height());
+    if (!background.isNull()) {
+        pInnerWidget->setFixedSize(background.width(), background.height());
+        pOuterWidget->setMinimumSize(background.width(), background.height());
     }
 
     // Default background color is now black, if people want to do <invert/>
@@ -905,10 +913,6 @@ QWidget* LegacySkinParser::parseBackground(const QDomElement& node,
     pOuterWidget->setPalette(palette);
     pOuterWidget->setAutoFillBackground(true);
 
-    // WPixmapStore::getPixmapNoCache() allocated background and gave us
-    // ownership. QLabel::setPixmap makes a copy, so we have to delete this.
-    delete background;
-
     return bg;
 }
 
@@ -1587,19 +1591,13 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         return it.value();
     }
 
-    QFile templateFile(absolutePath);
-
-    if (!templateFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not open template file:" << absolutePath;
-    }
-
-    QDomDocument tmpl("template");
     QString errorMessage;
-    int errorLine;
-    int errorColumn;
+    int errorLine = 0;
+    int errorColumn = 0;
 
-    if (!tmpl.setContent(&templateFile, &errorMessage,
-                         &errorLine, &errorColumn)) {
+    const QDomDocument tmpl = SkinCache::loadXmlDocument(
+            absolutePath, &errorMessage, &errorLine, &errorColumn);
+    if (tmpl.isNull()) {
         qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
                    << absolutePath << "line:" << errorLine << "column:" << errorColumn;
         qWarning() << "LegacySkinParser::loadTemplate - message:" << errorMessage;
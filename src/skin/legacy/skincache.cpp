@@ -0,0 +1,242 @@
+#include "skin/legacy/skincache.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtDebug>
+
+#include "skin/legacy/pixmapsource.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SkinCache");
+
+// Increment whenever the file format or the cache key changes
+constexpr quint32 kRasterFormatVersion = 1;
+constexpr quint32 kRasterFileMagic = 0x4D58534B; // "MXSK"
+const QString kRasterFileSuffix = QStringLiteral(".img");
+
+// Cache files are touched whenever they are loaded. Files that have not been
+// used for this long are left behind by edited skins, other scale factors or
+// other color schemes.
+constexpr qint64 kMaxUnusedRasterFileDays = 30;
+// The least recently used files are deleted beyond this total size
+constexpr qint64 kMaxRasterCacheBytes = 128 * 1024 * 1024;
+
+// The cost of a document is the size of its file in KiB. The DOM takes
+// a multiple of that, which still bounds the memory of a few skins.
+constexpr int kMaxXmlDocumentsCostKB = 8 * 1024;
+
+struct CachedXmlDocument {
+    QDomDocument document;
+    qint64 fileSize;
+    QDateTime lastModified;
+};
+
+QCache<QString, CachedXmlDocument> s_xmlDocuments(kMaxXmlDocumentsCostKB);
+QString s_cacheDirectory;
+QByteArray s_colorSchemeFiltersHash;
+
+/// Returns an empty key if the source cannot be identified reliably.
+QByteArray rasterCacheKey(const PixmapSource& source, double scaleFactor) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(kRasterFormatVersion));
+    if (!source.getSvgSourceData().isEmpty()) {
+        hash.addData(source.getSvgSourceData());
+    } else {
+        // Skin paths might be relative to a search path, e.g. "skin:".
+        const QFileInfo fileInfo(source.getPath());
+        const QString canonicalPath = fileInfo.canonicalFilePath();
+        if (canonicalPath.isEmpty()) {
+            return QByteArray();
+        }
+        hash.addData(canonicalPath.toUtf8());
+        hash.addData(QByteArray::number(fileInfo.size()));
+        hash.addData(QByteArray::number(
+                fileInfo.lastModified().toMSecsSinceEpoch()));
+    }
+    hash.addData(QByteArray::number(scaleFactor, 'g', 6));
+    hash.addData(s_colorSchemeFiltersHash);
+    return hash.result().toHex();
+}
+
+QString rasterCacheFilePath(const QByteArray& key) {
+    return QDir(s_cacheDirectory).filePath(QString::fromLatin1(key) + kRasterFileSuffix);
+}
+
+/// Deletes the files that have not been used for a long time and the least
+/// recently used ones beyond the size limit
+void pruneRasterCache(const QString& cacheDirectory) {
+    const QFileInfoList fileInfos = QDir(cacheDirectory).entryInfoList(
+            QStringList{QStringLiteral("*") + kRasterFileSuffix},
+            QDir::Files,
+            QDir::Time); // most recently used first
+    const QDateTime unusedBefore =
+            QDateTime::currentDateTime().addDays(-kMaxUnusedRasterFileDays);
+    qint64 totalBytes = 0;
+    int deletedFiles = 0;
+    for (const QFileInfo& fileInfo : fileInfos) {
+        totalBytes += fileInfo.size();
+        if (totalBytes > kMaxRasterCacheBytes ||
+                fileInfo.lastModified() < unusedBefore) {
+            if (QFile::remove(fileInfo.absoluteFilePath())) {
+                ++deletedFiles;
+            }
+        }
+    }
+    if (deletedFiles > 0) {
+        kLogger.debug() << "Deleted" << deletedFiles << "stale cache files";
+    }
+}
+
+} // anonymous namespace
+
+// static
+void SkinCache::setCacheDirectory(const QString& cacheDirectory) {
+    if (cacheDirectory == s_cacheDirectory) {
+        return;
+    }
+    s_cacheDirectory = cacheDirectory;
+    if (!s_cacheDirectory.isEmpty()) {
+        pruneRasterCache(s_cacheDirectory);
+    }
+}
+
+// static
+void SkinCache::setColorSchemeFilters(const QString& filters) {
+    if (filters.isEmpty()) {
+        s_colorSchemeFiltersHash.clear();
+        return;
+    }
+    s_colorSchemeFiltersHash = QCryptographicHash::hash(
+            filters.toUtf8(), QCryptographicHash::Sha1);
+}
+
+// static
+QDomDocument SkinCache::loadXmlDocument(
+        const QString& filePath,
+        QString* pErrorMessage,
+        int* pErrorLine,
+        int* pErrorColumn) {
+    const QFileInfo fileInfo(filePath);
+    const QString absolutePath = fileInfo.absoluteFilePath();
+    const qint64 fileSize = fileInfo.size();
+    const QDateTime lastModified = fileInfo.lastModified();
+
+    const CachedXmlDocument* pCached = s_xmlDocuments.object(absolutePath);
+    if (pCached) {
+        if (pCached->fileSize == fileSize && pCached->lastModified == lastModified) {
+            return pCached->document;
+        }
+        s_xmlDocuments.remove(absolutePath);
+    }
+
+    QFile file(absolutePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (pErrorMessage) {
+            *pErrorMessage = file.errorString();
+        }
+        return QDomDocument();
+    }
+
+    QDomDocument document;
+    if (!document.setContent(&file, pErrorMessage, pErrorLine, pErrorColumn)) {
+        return QDomDocument();
+    }
+
+    s_xmlDocuments.insert(absolutePath,
+            new CachedXmlDocument{document, fileSize, lastModified},
+            static_cast<int>(fileSize / 1024) + 1);
+    return document;
+}
+
+// static
+QImage SkinCache::loadRasterizedImage(
+        const PixmapSource& source,
+        double scaleFactor) {
+    if (s_cacheDirectory.isEmpty()) {
+        return QImage();
+    }
+    const QByteArray key = rasterCacheKey(source, scaleFactor);
+    if (key.isEmpty()) {
+        return QImage();
+    }
+    QFile file(rasterCacheFilePath(key));
+    // The file time can only be set on files that are opened for writing,
+    // at least on Windows. Read-only cache files are used nevertheless.
+    if (file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly)) {
+        // Marks the file as recently used for pruneRasterCache()
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    } else if (!file.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    stream >> magic >> version >> width >> height;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kRasterFileMagic ||
+            version != kRasterFormatVersion ||
+            width <= 0 || height <= 0) {
+        kLogger.debug() << "Ignoring invalid cache file" << file.fileName();
+        return QImage();
+    }
+
+    QImage image(width, height, QImage::Format_ARGB32);
+    const int bytesPerLine = width * 4;
+    for (int y = 0; y < height; ++y) {
+        if (stream.readRawData(reinterpret_cast<char*>(image.scanLine(y)),
+                    bytesPerLine) != bytesPerLine) {
+            kLogger.debug() << "Ignoring truncated cache file" << file.fileName();
+            return QImage();
+        }
+    }
+    return image;
+}
+
+// static
+void SkinCache::storeRasterizedImage(
+        const PixmapSource& source,
+        double scaleFactor,
+        const QImage& image) {
+    if (s_cacheDirectory.isEmpty() || image.isNull()) {
+        return;
+    }
+    const QByteArray key = rasterCacheKey(source, scaleFactor);
+    if (key.isEmpty()) {
+        return;
+    }
+    if (!QDir().mkpath(s_cacheDirectory)) {
+        kLogger.warning() << "Failed to create cache directory" << s_cacheDirectory;
+        return;
+    }
+
+    const QImage argbImage = image.convertToFormat(QImage::Format_ARGB32);
+    QSaveFile file(rasterCacheFilePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream << kRasterFileMagic
+           << kRasterFormatVersion
+           << static_cast<qint32>(argbImage.width())
+           << static_cast<qint32>(argbImage.height());
+    const int bytesPerLine = argbImage.width() * 4;
+    for (int y = 0; y < argbImage.height(); ++y) {
+        stream.writeRawData(
+                reinterpret_cast<const char*>(argbImage.constScanLine(y)),
+                bytesPerLine);
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning() << "Failed to write cache file" << file.fileName();
+    }
+}
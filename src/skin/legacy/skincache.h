@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QDomDocument>
+#include <QImage>
+#include <QString>
+
+class PixmapSource;
+
+/// Caches the results of the expensive but deterministic steps of loading
+/// a legacy skin.
+///
+/// Parsed XML documents (skin.xml and all templates) are kept in a bounded
+/// in-memory cache and revalidated against the size and modification time
+/// of their files. Switching skins, reloading the current
+/// skin or reading the skin manifest and color schemes does not need to
+/// parse the same files again.
+///
+/// SVG images that are rasterized by Paintable are persisted in a cache
+/// directory, keyed by their source, the scale factor and the filters of
+/// the current color scheme. Relaunching Mixxx with the same skin and
+/// scale factor loads these images instead of rendering the SVGs again.
+/// Files that have not been loaded for a long time and the least recently
+/// used ones beyond a size limit are deleted when the directory is set.
+///
+/// Only to be used from the GUI thread.
+class SkinCache {
+  public:
+    /// Sets the directory for persisting rasterized images and deletes its
+    /// stale files. The directory is created on demand. An empty path
+    /// disables the persistent cache.
+    static void setCacheDirectory(const QString& cacheDirectory);
+
+    /// Identifies the image filters of the current color scheme. Must be
+    /// updated whenever the filters change, i.e. when the ImgSource of
+    /// WPixmapStore is replaced.
+    static void setColorSchemeFilters(const QString& filters);
+
+    /// Returns the parsed document for the given XML file. Documents are
+    /// only parsed again if the file has been modified since. On errors
+    /// a null document is returned and the error details are stored
+    /// in the optional output parameters.
+    static QDomDocument loadXmlDocument(
+            const QString& filePath,
+            QString* pErrorMessage = nullptr,
+            int* pErrorLine = nullptr,
+            int* pErrorColumn = nullptr);
+
+    /// Returns a previously stored rasterized image or a null image.
+    static QImage loadRasterizedImage(
+            const PixmapSource& source,
+            double scaleFactor);
+    static void storeRasterizedImage(
+            const PixmapSource& source,
+            double scaleFactor,
+            const QImage& image);
+};
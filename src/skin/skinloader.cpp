@@ -16,6 +16,7 @@
 #include "util/debug.h"
 #include "util/timer.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
+#include "widget/wpixmapstore.h"
 
 namespace mixxx {
 namespace skin {
@@ -28,6 +29,8 @@ SkinLoader::SkinLoader(UserSettingsPointer pConfig) :
 
 SkinLoader::~SkinLoader() {
     LegacySkinParser::clearSharedGroupStrings();
+    // Don't keep any pixmaps alive until the QApplication is gone
+    WPixmapStore::clearRasterCache();
 }
 
 QList<SkinPointer> SkinLoader::getSkins() const {
@@ -0,0 +1,239 @@
+#include "soundio/driftresampler.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+// A windowed sinc interpolator with kTaps taps, whose coefficients are
+// tabulated for kPhases fractional positions between two frames and
+// linearly interpolated in between. The ratio is always close to 1.0,
+// so no band limiting below the Nyquist frequency is required.
+constexpr int kTaps = 16;
+constexpr int kHalfTaps = kTaps / 2;
+constexpr int kPhases = 128;
+
+// The error of the fill level is measured in chunks, which makes the gains
+// independent from the buffer size. The error is low-pass filtered against
+// the scheduling jitter of the callbacks. The loop is critically damped and
+// settles within about a thousand callbacks, while the clocks drift apart by
+// less than half a chunk in that time.
+constexpr double kErrorFilterCoefficient = 0.01;
+constexpr double kProportionalGain = 0.002;
+constexpr double kIntegralGain = 0.000001;
+
+typedef std::array<std::array<CSAMPLE, kTaps>, kPhases + 1> FilterTable;
+
+FilterTable makeFilterTable() {
+    FilterTable table;
+    for (int phase = 0; phase <= kPhases; ++phase) {
+        const double fraction = static_cast<double>(phase) / kPhases;
+        double sum = 0.0;
+        std::array<double, kTaps> coefficients;
+        for (int tap = 0; tap < kTaps; ++tap) {
+            // The distance of the tap from the interpolated position
+            const double x = tap - (kHalfTaps - 1) - fraction;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            // Blackman window
+            const double w = 0.42 + 0.5 * std::cos(2 * M_PI * x / kTaps) +
+                    0.08 * std::cos(4 * M_PI * x / kTaps);
+            coefficients[tap] = sinc * w;
+            sum += coefficients[tap];
+        }
+        // Unity gain for DC at every phase
+        for (int tap = 0; tap < kTaps; ++tap) {
+            table[phase][tap] = static_cast<CSAMPLE>(coefficients[tap] / sum);
+        }
+    }
+    return table;
+}
+
+const FilterTable& filterTable() {
+    static const FilterTable s_table = makeFilterTable();
+    return s_table;
+}
+
+} // anonymous namespace
+
+DriftResampler::DriftResampler(int numChannels,
+        SINT framesPerBuffer,
+        double sampleRate,
+        double targetFillFrames)
+        : m_numChannels(numChannels),
+          m_framesPerBuffer(framesPerBuffer),
+          m_chunkNanos(framesPerBuffer * 1e9 / sampleRate),
+          m_targetFillFrames(targetFillFrames),
+          m_lastTransferNanos(-1),
+          // The input of one callback at the maximum ratio plus the history
+          // of the filter, with some headroom
+          m_buffer((2 * framesPerBuffer + 2 * kTaps) * numChannels),
+          m_bufferedFrames(0),
+          m_outputBuffer(2 * framesPerBuffer * numChannels),
+          m_position(0.0),
+          m_ratio(1.0),
+          m_controlStarted(false),
+          m_filteredError(0.0),
+          m_integratedError(0.0) {
+    DEBUG_ASSERT(m_numChannels > 0);
+    DEBUG_ASSERT(m_framesPerBuffer > 0);
+    // Not initialized in the audio callback
+    filterTable();
+    reset();
+}
+
+void DriftResampler::reset() {
+    // Start with silence as history, which delays the stream by kHalfTaps
+    m_bufferedFrames = kHalfTaps - 1;
+    SampleUtil::clear(m_buffer.data(), m_bufferedFrames * m_numChannels);
+    m_position = kHalfTaps - 1;
+    m_ratio = 1.0;
+    m_controlStarted = false;
+    m_filteredError = 0.0;
+    m_integratedError = 0.0;
+}
+
+double DriftResampler::transferPhase(mixxx::Duration time) const {
+    const qint64 lastTransferNanos = m_lastTransferNanos.load(std::memory_order_acquire);
+    if (lastTransferNanos < 0) {
+        return 0.0;
+    }
+    const double phase = (time.toIntegerNanos() - lastTransferNanos) / m_chunkNanos;
+    // A stalled clock reference must not be taken for drift
+    return math_clamp(phase, 0.0, 1.0);
+}
+
+void DriftResampler::updateRatio(double fillFrames) {
+    const double error = (fillFrames - m_targetFillFrames) / m_framesPerBuffer;
+    if (!m_controlStarted) {
+        m_filteredError = error;
+        m_controlStarted = true;
+    } else {
+        m_filteredError += kErrorFilterCoefficient * (error - m_filteredError);
+    }
+    // A fill level above the target is reduced by consuming more input
+    // frames per output frame, for both directions
+    const double integratedError = m_integratedError + m_filteredError;
+    const double correction = kProportionalGain * m_filteredError +
+            kIntegralGain * integratedError;
+    if (std::abs(correction) < kMaxRatioCorrection) {
+        m_integratedError = integratedError;
+    } // else prevent the integral from winding up
+    m_ratio = 1.0 + math_clamp(correction, -kMaxRatioCorrection, kMaxRatioCorrection);
+}
+
+SINT DriftResampler::inputFramesNeeded(SINT numFrames) const {
+    if (numFrames <= 0) {
+        return 0;
+    }
+    const double lastPosition = m_position + (numFrames - 1) * m_ratio;
+    const SINT framesNeeded = static_cast<SINT>(lastPosition) + kHalfTaps + 1;
+    return math_max<SINT>(framesNeeded - m_bufferedFrames, 0);
+}
+
+SINT DriftResampler::resample(CSAMPLE* pOut, SINT maxFrames) {
+    const FilterTable& table = filterTable();
+    SINT frames = 0;
+    while (frames < maxFrames) {
+        const auto index = static_cast<SINT>(m_position);
+        if (index + kHalfTaps >= m_bufferedFrames) {
+            break;
+        }
+        const double phase = (m_position - index) * kPhases;
+        const auto phaseIndex = static_cast<int>(phase);
+        const auto phaseFraction = static_cast<CSAMPLE>(phase - phaseIndex);
+        const auto& coefficients0 = table[phaseIndex];
+        const auto& coefficients1 = table[phaseIndex + 1];
+        CSAMPLE coefficients[kTaps];
+        for (int tap = 0; tap < kTaps; ++tap) {
+            coefficients[tap] = coefficients0[tap] +
+                    phaseFraction * (coefficients1[tap] - coefficients0[tap]);
+        }
+        const CSAMPLE* pFrames =
+                &m_buffer[(index - kHalfTaps + 1) * m_numChannels];
+        for (int channel = 0; channel < m_numChannels; ++channel) {
+            CSAMPLE sum = 0;
+            for (int tap = 0; tap < kTaps; ++tap) {
+                sum += coefficients[tap] * pFrames[tap * m_numChannels + channel];
+            }
+            pOut[channel] = sum;
+        }
+        pOut += m_numChannels;
+        m_position += m_ratio;
+        ++frames;
+    }
+    discardConsumedFrames();
+    return frames;
+}
+
+void DriftResampler::discardConsumedFrames() {
+    const SINT firstNeededFrame = math_min<SINT>(
+            static_cast<SINT>(m_position) - kHalfTaps + 1, m_bufferedFrames);
+    if (firstNeededFrame <= 0) {
+        return;
+    }
+    m_bufferedFrames -= firstNeededFrame;
+    m_position -= firstNeededFrame;
+    std::memmove(m_buffer.data(),
+            &m_buffer[firstNeededFrame * m_numChannels],
+            m_bufferedFrames * m_numChannels * sizeof(CSAMPLE));
+}
+
+bool DriftResampler::readFromFifo(FIFO<CSAMPLE>* pFifo,
+        CSAMPLE* pOut,
+        SINT numFrames,
+        mixxx::Duration time) {
+    VERIFY_OR_DEBUG_ASSERT(numFrames <= m_framesPerBuffer) {
+        numFrames = m_framesPerBuffer;
+    }
+    const SINT availableFrames = pFifo->readAvailable() / m_numChannels;
+    // The clock reference side has progressed into its next chunk
+    updateRatio(availableFrames + transferPhase(time) * m_framesPerBuffer);
+
+    const SINT readFrames = math_min(inputFramesNeeded(numFrames), availableFrames);
+    pFifo->read(&m_buffer[m_bufferedFrames * m_numChannels],
+            static_cast<int>(readFrames * m_numChannels));
+    m_bufferedFrames += readFrames;
+
+    const SINT writtenFrames = resample(pOut, numFrames);
+    if (writtenFrames < numFrames) {
+        SampleUtil::clear(&pOut[writtenFrames * m_numChannels],
+                (numFrames - writtenFrames) * m_numChannels);
+        return false;
+    }
+    return true;
+}
+
+bool DriftResampler::writeToFifo(FIFO<CSAMPLE>* pFifo,
+        const CSAMPLE* pIn,
+        SINT numFrames,
+        mixxx::Duration time) {
+    VERIFY_OR_DEBUG_ASSERT(numFrames <= m_framesPerBuffer) {
+        numFrames = m_framesPerBuffer;
+    }
+    // The clock reference side has progressed into its next chunk
+    updateRatio(pFifo->readAvailable() / m_numChannels -
+            transferPhase(time) * m_framesPerBuffer);
+
+    SampleUtil::copy(&m_buffer[m_bufferedFrames * m_numChannels],
+            pIn,
+            numFrames * m_numChannels);
+    m_bufferedFrames += numFrames;
+
+    const SINT writableFrames = pFifo->writeAvailable() / m_numChannels;
+    const SINT writtenFrames = resample(m_outputBuffer.data(),
+            math_min<SINT>(writableFrames, m_outputBuffer.size() / m_numChannels));
+    pFifo->write(m_outputBuffer.data(), static_cast<int>(writtenFrames * m_numChannels));
+
+    if (inputFramesNeeded(1) == 0) {
+        // The FIFO is full, drop the remaining input but keep the history
+        m_position = m_bufferedFrames - kHalfTaps;
+        discardConsumedFrames();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "util/duration.h"
+#include "util/fifo.h"
+#include "util/types.h"
+
+/// Asynchronous sample rate conversion between the FIFO that is served by
+/// the clock reference device and a device that runs from its own crystal.
+///
+/// The two clocks differ by up to a few hundred ppm. Instead of dropping or
+/// duplicating whole frames, the stream of the device is resampled with a
+/// ratio slightly off 1.0 that is steered by a PI control loop on the fill
+/// level of the FIFO.
+///
+/// The clock reference side transfers whole chunks, so the raw fill level
+/// jumps by a chunk whenever the phase of the two callbacks slides past each
+/// other. The fill level is therefore interpolated by the time that has
+/// passed since the last transfer of the clock reference side, which has to
+/// be reported by calling chunkTransferred().
+///
+/// All functions except the constructor are real-time safe.
+class DriftResampler {
+  public:
+    /// The maximum deviation of the conversion ratio from 1.0, far beyond
+    /// the tolerance of any sound card crystal
+    static constexpr double kMaxRatioCorrection = 0.005;
+
+    /// targetFillFrames is the interpolated fill level of the FIFO that
+    /// is maintained before the device transfers its chunk.
+    DriftResampler(int numChannels,
+            SINT framesPerBuffer,
+            double sampleRate,
+            double targetFillFrames);
+
+    void reset();
+
+    /// Invoked by the clock reference side after it has transferred a chunk
+    void chunkTransferred(mixxx::Duration time) {
+        m_lastTransferNanos.store(time.toIntegerNanos(), std::memory_order_release);
+    }
+
+    /// Fills pOut with numFrames frames from the FIFO, which is filled by the
+    /// clock reference side. Returns false on a FIFO underflow, the missing
+    /// frames are cleared.
+    bool readFromFifo(FIFO<CSAMPLE>* pFifo,
+            CSAMPLE* pOut,
+            SINT numFrames,
+            mixxx::Duration time);
+    /// Writes the resampled numFrames frames from pIn into the FIFO, which is
+    /// drained by the clock reference side. Returns false on a FIFO
+    /// overflow, the frames that do not fit are discarded.
+    bool writeToFifo(FIFO<CSAMPLE>* pFifo,
+            const CSAMPLE* pIn,
+            SINT numFrames,
+            mixxx::Duration time);
+
+    /// The number of input frames consumed per output frame
+    double ratio() const {
+        return m_ratio;
+    }
+
+  private:
+    /// The fraction of a chunk the clock reference side has progressed
+    /// since its last transfer
+    double transferPhase(mixxx::Duration time) const;
+    void updateRatio(double fillFrames);
+
+    /// The number of additional input frames needed for numFrames output frames
+    SINT inputFramesNeeded(SINT numFrames) const;
+    /// Produces up to maxFrames output frames from the buffered input frames
+    SINT resample(CSAMPLE* pOut, SINT maxFrames);
+    /// Drops the buffered input frames that are no longer needed
+    void discardConsumedFrames();
+
+    const int m_numChannels;
+    const SINT m_framesPerBuffer;
+    const double m_chunkNanos;
+    const double m_targetFillFrames;
+
+    std::atomic<qint64> m_lastTransferNanos;
+
+    // Interleaved input frames, including the history for the filter
+    std::vector<CSAMPLE> m_buffer;
+    SINT m_bufferedFrames;
+    // The resampled frames of writeToFifo()
+    std::vector<CSAMPLE> m_outputBuffer;
+    // The position of the next output frame in m_buffer
+    double m_position;
+    double m_ratio;
+
+    bool m_controlStarted;
+    double m_filteredError;
+    double m_integratedError;
+};
@@ -5,6 +5,7 @@
 
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/assert.h"
 #include "util/debug.h"
 #include "util/defs.h"
 #include "util/sample.h"
@@ -17,7 +18,8 @@ SoundDevice::SoundDevice(UserSettingsPointer config, SoundManager* sm)
           m_iNumInputChannels(2),
           m_dSampleRate(44100.0),
           m_hostAPI("Unknown API"),
-          m_framesPerBuffer(0) {
+          m_framesPerBuffer(0),
+          m_numRoutedOutputChannels(0) {
 }
 
 int SoundDevice::getNumInputChannels() const {
@@ -59,11 +61,13 @@ SoundDeviceError SoundDevice::addOutput(const AudioOutputBuffer &out) {
         return SOUNDDEVICE_ERROR_EXCESSIVE_OUTPUT_CHANNEL;
     }
     m_audioOutputs.append(out);
+    updateOutputRoutes();
     return SOUNDDEVICE_ERROR_OK;
 }
 
 void SoundDevice::clearOutputs() {
     m_audioOutputs.clear();
+    updateOutputRoutes();
 }
 
 SoundDeviceError SoundDevice::addInput(const AudioInputBuffer &in) {
@@ -75,11 +79,41 @@ SoundDeviceError SoundDevice::addInput(const AudioInputBuffer &in) {
         return SOUNDDEVICE_ERROR_EXCESSIVE_INPUT_CHANNEL;
     }
     m_audioInputs.append(in);
+    updateInputRoutes();
     return SOUNDDEVICE_ERROR_OK;
 }
 
 void SoundDevice::clearInputs() {
     m_audioInputs.clear();
+    updateInputRoutes();
+}
+
+void SoundDevice::updateOutputRoutes() {
+    m_outputRoutes.clear();
+    m_numRoutedOutputChannels = 0;
+    for (const auto& out : qAsConst(m_audioOutputs)) {
+        const ChannelGroup channelGroup = out.getChannelGroup();
+        // All AudioOutputs are stereo as of Mixxx 1.12.0, mono outputs
+        // are mixed down.
+        DEBUG_ASSERT(channelGroup.getChannelCount() <= 2);
+        m_outputRoutes.append(OutputRoute{
+                out.getBuffer(),
+                channelGroup.getChannelBase(),
+                channelGroup.getChannelCount()});
+        // The channels of the outputs do not clash, see addOutput()
+        m_numRoutedOutputChannels += channelGroup.getChannelCount();
+    }
+}
+
+void SoundDevice::updateInputRoutes() {
+    m_inputRoutes.clear();
+    for (const auto& in : qAsConst(m_audioInputs)) {
+        const ChannelGroup channelGroup = in.getChannelGroup();
+        m_inputRoutes.append(InputRoute{
+                in.getBuffer(),
+                channelGroup.getChannelBase(),
+                channelGroup.getChannelCount()});
+    }
 }
 
 bool SoundDevice::operator==(const SoundDevice &other) const {
@@ -95,62 +129,37 @@ void SoundDevice::composeOutputBuffer(CSAMPLE* outputBuffer,
     //         << framesToCompose << iFrameSize;
 
     // Interlace Audio data onto portaudio buffer.  We iterate through the
-    // source list to find out what goes in the buffer data is interlaced in
-    // the order of the list
+    // routes of the outputs, the data is interlaced in their order.
 
-    if (iFrameSize == 2 && m_audioOutputs.size() == 1 &&
-            m_audioOutputs.at(0).getChannelGroup().getChannelCount() == 2) {
+    if (iFrameSize == 2 && m_outputRoutes.size() == 1 &&
+            m_outputRoutes.at(0).channelCount == 2) {
         // Special case for one stereo device only
-        const AudioOutputBuffer& out = m_audioOutputs.at(0);
-        const CSAMPLE* pAudioOutputBuffer = out.getBuffer(); // Always Stereo
+        const CSAMPLE* pAudioOutputBuffer = m_outputRoutes.at(0).pSource; // Always Stereo
         pAudioOutputBuffer = &pAudioOutputBuffer[framesReadOffset*2];
         SampleUtil::copyClampBuffer(outputBuffer, pAudioOutputBuffer,
                framesToCompose * 2);
     } else {
-        // Reset sample for each open channel
-        SampleUtil::clear(outputBuffer, framesToCompose * iFrameSize);
-
-        for (QList<AudioOutputBuffer>::iterator i = m_audioOutputs.begin(),
-                     e = m_audioOutputs.end(); i != e; ++i) {
-            AudioOutputBuffer& out = *i;
-
-            const ChannelGroup outChans = out.getChannelGroup();
-            const int iChannelCount = outChans.getChannelCount();
-            const int iChannelBase = outChans.getChannelBase();
+        // Reset the samples of the channels without an output
+        if (m_numRoutedOutputChannels < iFrameSize) {
+            SampleUtil::clear(outputBuffer, framesToCompose * iFrameSize);
+        }
 
-            const CSAMPLE* pAudioOutputBuffer = out.getBuffer();
+        for (const auto& route : qAsConst(m_outputRoutes)) {
             // advanced to offset; pAudioOutputBuffer is always stereo
-            pAudioOutputBuffer = &pAudioOutputBuffer[framesReadOffset*2];
-            if (iChannelCount == 1) {
+            const CSAMPLE* pAudioOutputBuffer = &route.pSource[framesReadOffset * 2];
+            CSAMPLE* pDeviceChannels = &outputBuffer[route.channelBase];
+            if (route.channelCount == 1) {
                 // All AudioOutputs are stereo as of Mixxx 1.12.0. If we have a mono
                 // output then we need to downsample.
-                for (SINT iFrameNo = 0; iFrameNo < framesToCompose; ++iFrameNo) {
-                    // iFrameBase is the "base sample" in a frame (ie. the first
-                    // sample in a frame)
-                    const SINT iFrameBase = iFrameNo * iFrameSize;
-                    outputBuffer[iFrameBase + iChannelBase] = SampleUtil::clampSample(
-                            (pAudioOutputBuffer[iFrameNo * 2] +
-                                    pAudioOutputBuffer[iFrameNo * 2 + 1]) / 2.0f);
-                }
+                SampleUtil::mixStereoToMultiMonoClamp(pDeviceChannels,
+                        pAudioOutputBuffer,
+                        framesToCompose,
+                        iFrameSize);
             } else {
-                for (SINT iFrameNo = 0; iFrameNo < framesToCompose; ++iFrameNo) {
-                    // iFrameBase is the "base sample" in a frame (ie. the first
-                    // sample in a frame)
-                    const SINT iFrameBase = iFrameNo * iFrameSize;
-                    const SINT iLocalFrameBase = iFrameNo * iChannelCount;
-
-                    // this will make sure a sample from each channel is copied
-                    for (int iChannel = 0; iChannel < iChannelCount; ++iChannel) {
-                        outputBuffer[iFrameBase + iChannelBase + iChannel] =
-                                SampleUtil::clampSample(
-                                        pAudioOutputBuffer[iLocalFrameBase + iChannel]);
-
-                        // Input audio pass-through (useful for debugging)
-                        //if (in)
-                        //    output[iFrameBase + src.channelBase + iChannel] =
-                        //    in[iFrameBase + src.channelBase + iChannel];
-                    }
-                }
+                SampleUtil::copyStereoToMultiClamp(pDeviceChannels,
+                        pAudioOutputBuffer,
+                        framesToCompose,
+                        iFrameSize);
             }
         }
     }
@@ -168,53 +177,37 @@ void SoundDevice::composeInputBuffer(const CSAMPLE* inputBuffer,
     // If the framesize is only 2, then we only have one pair of input channels
     //  That means we don't have to do any deinterlacing, and we can pass
     //  the audio on to its intended destination.
-    if (iFrameSize == 1 && m_audioInputs.size() == 1 &&
-            m_audioInputs.at(0).getChannelGroup().getChannelCount() == 1) {
+    if (iFrameSize == 1 && m_inputRoutes.size() == 1 &&
+            m_inputRoutes.at(0).channelCount == 1) {
         // One mono device only
-        const AudioInputBuffer& in = m_audioInputs.at(0);
-        CSAMPLE* pInputBuffer = in.getBuffer(); // Always Stereo
+        CSAMPLE* pInputBuffer = m_inputRoutes.at(0).pDest; // Always Stereo
         pInputBuffer = &pInputBuffer[framesWriteOffset * 2];
-        for (SINT iFrameNo = 0; iFrameNo < framesToPush; ++iFrameNo) {
-            pInputBuffer[iFrameNo * 2] =
-                    inputBuffer[iFrameNo];
-            pInputBuffer[iFrameNo * 2 + 1] =
-                    inputBuffer[iFrameNo];
-        }
-    } else if (iFrameSize == 2 && m_audioInputs.size() == 1 &&
-            m_audioInputs.at(0).getChannelGroup().getChannelCount() == 2) {
+        SampleUtil::copyMonoToDualMono(pInputBuffer, inputBuffer, framesToPush);
+    } else if (iFrameSize == 2 && m_inputRoutes.size() == 1 &&
+            m_inputRoutes.at(0).channelCount == 2) {
         // One stereo device only
-        const AudioInputBuffer& in = m_audioInputs.at(0);
-        CSAMPLE* pInputBuffer = in.getBuffer(); // Always Stereo
+        CSAMPLE* pInputBuffer = m_inputRoutes.at(0).pDest; // Always Stereo
         pInputBuffer = &pInputBuffer[framesWriteOffset * 2];
         SampleUtil::copy(pInputBuffer, inputBuffer, framesToPush * 2);
     } else {
         // Non Stereo input (iFrameSize != 2)
-        // Do crazy deinterleaving of the audio into the correct m_inputBuffers.
-
-        for (auto i = m_audioInputs.constBegin(), e = m_audioInputs.constEnd(); i != e; ++i) {
-            const AudioInputBuffer& in = *i;
-            ChannelGroup chanGroup = in.getChannelGroup();
-            int iChannelCount = chanGroup.getChannelCount();
-            int iChannelBase = chanGroup.getChannelBase();
-            CSAMPLE* pInputBuffer = in.getBuffer();
-            pInputBuffer = &pInputBuffer[framesWriteOffset * 2];
-
-            for (SINT iFrameNo = 0; iFrameNo < framesToPush; ++iFrameNo) {
-                // iFrameBase is the "base sample" in a frame (ie. the first
-                // sample in a frame)
-                SINT iFrameBase = iFrameNo * iFrameSize;
-                SINT iLocalFrameBase = iFrameNo * 2;
-
-                if (iChannelCount == 1) {
-                    pInputBuffer[iLocalFrameBase] =
-                            inputBuffer[iFrameBase + iChannelBase];
-                    pInputBuffer[iLocalFrameBase + 1] =
-                            inputBuffer[iFrameBase + iChannelBase];
-                } else if (iChannelCount > 1) {
-                    pInputBuffer[iLocalFrameBase] =
-                            inputBuffer[iFrameBase + iChannelBase];
-                    pInputBuffer[iLocalFrameBase + 1] =
-                            inputBuffer[iFrameBase + iChannelBase + 1];
+        // Deinterleave the audio into the correct m_inputBuffers.
+        for (const auto& route : qAsConst(m_inputRoutes)) {
+            CSAMPLE* pInputBuffer = &route.pDest[framesWriteOffset * 2];
+            const CSAMPLE* pDeviceChannels = &inputBuffer[route.channelBase];
+            if (route.channelCount == 1) {
+                SampleUtil::copyMultiMonoToDualMono(pInputBuffer,
+                        pDeviceChannels,
+                        framesToPush,
+                        iFrameSize);
+            } else if (route.channelCount > 1) {
+                if (iFrameSize == 2) {
+                    SampleUtil::copy(pInputBuffer, pDeviceChannels, framesToPush * 2);
+                } else {
+                    SampleUtil::copyMultiToStereo(pInputBuffer,
+                            pDeviceChannels,
+                            framesToPush,
+                            iFrameSize);
                 }
             }
         }
@@ -223,9 +216,8 @@ void SoundDevice::composeInputBuffer(const CSAMPLE* inputBuffer,
 
 void SoundDevice::clearInputBuffer(const SINT framesToPush,
                                    const SINT framesWriteOffset) {
-    for (auto i = m_audioInputs.constBegin(), e = m_audioInputs.constEnd(); i != e; ++i) {
-        const AudioInputBuffer& in = *i;
-        CSAMPLE* pInputBuffer = in.getBuffer();  // Always stereo
+    for (const auto& route : qAsConst(m_inputRoutes)) {
+        CSAMPLE* pInputBuffer = route.pDest;  // Always stereo
         SampleUtil::clear(&pInputBuffer[framesWriteOffset * 2], framesToPush * 2);
     }
 }
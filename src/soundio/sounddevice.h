@@ -2,6 +2,7 @@
 
 #include <QString>
 #include <QList>
+#include <QVector>
 
 #include "util/types.h"
 #include "preferences/usersettings.h"
@@ -87,6 +88,28 @@ class SoundDevice {
     SINT m_framesPerBuffer;
     QList<AudioOutputBuffer> m_audioOutputs;
     QList<AudioInputBuffer> m_audioInputs;
+
+  private:
+    // The routing of the stereo engine buffers from and to the channels
+    // of the interleaved device buffers, resolved when the outputs and
+    // inputs are set up so that composing a buffer only runs the kernels.
+    struct OutputRoute {
+        const CSAMPLE* pSource;
+        int channelBase;
+        int channelCount;
+    };
+    struct InputRoute {
+        CSAMPLE* pDest;
+        int channelBase;
+        int channelCount;
+    };
+    void updateOutputRoutes();
+    void updateInputRoutes();
+
+    QVector<OutputRoute> m_outputRoutes;
+    // The number of device channels that are written by m_outputRoutes
+    int m_numRoutedOutputChannels;
+    QVector<InputRoute> m_inputRoutes;
 };
 
 typedef QSharedPointer<SoundDevice> SoundDevicePointer;
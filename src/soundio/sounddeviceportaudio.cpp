@@ -8,6 +8,8 @@
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
+#include "engine/audiocallbackprofiler.h"
+#include "soundio/driftresampler.h"
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
@@ -15,6 +17,7 @@
 #include "util/fifo.h"
 #include "util/math.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
 #include "util/trace.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
@@ -33,6 +36,12 @@ constexpr int kDriftReserve = 1;
 // Buffer for drift correction 1 full, 1 for r/w, 1 empty
 constexpr int kFifoSize = 2 * kDriftReserve + 1;
 
+// The fill levels of the drift FIFOs that are maintained by resampling,
+// in chunks before the device callback transfers its chunk. This leaves
+// half a chunk for jitter to both sides.
+constexpr double kOutputDriftTargetFill = kDriftReserve + 1.5;
+constexpr double kInputDriftTargetFill = kDriftReserve - 0.5;
+
 constexpr int kCpuUsageUpdateRate = 30; // in 1/s, fits to display frame rate
 
 // We warn only at invalid timing 3, since the first two
@@ -113,7 +122,43 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
         m_deviceId.name = deviceInfo->name;
     }
     m_deviceId.portAudioIndex = devIndex;
+
+    const QString debugName = m_deviceId.debugName();
+    m_callbackProcessDriftTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcessDrift %1")
+                    .arg(debugName));
+    m_callbackProcessDriftDurationTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcessDrift %1_duration")
+                    .arg(debugName));
+    m_callbackProcessTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcess %1")
+                    .arg(debugName));
+    m_callbackProcessDurationTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcess %1_duration")
+                    .arg(debugName));
+    m_callbackProcessClkRefTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcessClkRef %1")
+                    .arg(debugName));
+    m_callbackProcessClkRefDurationTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcessClkRef %1_duration")
+                    .arg(debugName));
+    m_callbackProcessInputTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcess input %1")
+                    .arg(debugName));
+    m_callbackProcessPrepareTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcess prepare %1")
+                    .arg(debugName));
+    m_callbackProcessOutputTag = StatTag(
+            QStringLiteral("SoundDevicePortAudio::callbackProcess output %1")
+                    .arg(debugName));
     m_strDisplayName = QString::fromUtf8(deviceInfo->name);
+    auto& profiler = mixxx::AudioCallbackProfiler::instance();
+    profiler.setLabel(mixxx::AudioCallbackProfiler::Section::FifoRead,
+            devIndex,
+            m_strDisplayName);
+    profiler.setLabel(mixxx::AudioCallbackProfiler::Section::FifoWrite,
+            devIndex,
+            m_strDisplayName);
     m_iNumInputChannels = m_deviceInfo->maxInputChannels;
     m_iNumOutputChannels = m_deviceInfo->maxOutputChannels;
 
@@ -274,6 +319,11 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_outputFifo->releaseWriteRegions(writeCount);
+            m_pOutputResampler = std::make_unique<DriftResampler>(
+                    m_outputParams.channelCount,
+                    m_framesPerBuffer,
+                    m_dSampleRate,
+                    kOutputDriftTargetFill * m_framesPerBuffer);
         }
         if (m_inputParams.channelCount) {
             m_inputFifo = new FIFO<CSAMPLE>(
@@ -290,6 +340,11 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_inputFifo->releaseWriteRegions(writeCount);
+            m_pInputResampler = std::make_unique<DriftResampler>(
+                    m_inputParams.channelCount,
+                    m_framesPerBuffer,
+                    m_dSampleRate,
+                    kInputDriftTargetFill * m_framesPerBuffer);
         }
     } else if (m_syncBuffers == 1) { // "Disabled (short delay)"
         // this can be used on a second device when it is driven by the Clock
@@ -432,6 +487,8 @@ SoundDeviceError SoundDevicePortAudio::close() {
 
     m_outputFifo = nullptr;
     m_inputFifo = nullptr;
+    m_pOutputResampler.reset();
+    m_pInputResampler.reset();
     m_bSetThreadPriority = false;
 
     return SOUNDDEVICE_ERROR_OK;
@@ -444,6 +501,9 @@ QString SoundDevicePortAudio::getError() const {
 void SoundDevicePortAudio::readProcess() {
     PaStream* pStream = m_pStream;
     if (pStream && m_inputParams.channelCount && m_inputFifo) {
+        mixxx::ScopedAudioCallbackSpan span(
+                mixxx::AudioCallbackProfiler::Section::FifoRead,
+                m_deviceId.portAudioIndex);
         int inChunkSize = m_framesPerBuffer * m_inputParams.channelCount;
         if (m_syncBuffers == 0) { // "Experimental (no delay)"
 
@@ -563,6 +623,9 @@ void SoundDevicePortAudio::readProcess() {
             }
             m_inputFifo->releaseReadRegions(readCount);
         }
+        if (m_pInputResampler) {
+            m_pInputResampler->chunkTransferred(mixxx::Time::elapsed());
+        }
         if (readCount < inChunkSize) {
             // Fill remaining buffers with zeros
             clearInputBuffer(inChunkSize - readCount, readCount);
@@ -576,6 +639,9 @@ void SoundDevicePortAudio::writeProcess() {
     PaStream* pStream = m_pStream;
 
     if (pStream && m_outputParams.channelCount && m_outputFifo) {
+        mixxx::ScopedAudioCallbackSpan span(
+                mixxx::AudioCallbackProfiler::Section::FifoWrite,
+                m_deviceId.portAudioIndex);
         int outChunkSize = m_framesPerBuffer * m_outputParams.channelCount;
         int writeAvailable = m_outputFifo->writeAvailable();
         int writeCount = outChunkSize;
@@ -603,6 +669,9 @@ void SoundDevicePortAudio::writeProcess() {
             }
             m_outputFifo->releaseWriteRegions(writeCount);
         }
+        if (m_pOutputResampler) {
+            m_pOutputResampler->chunkTransferred(mixxx::Time::elapsed());
+        }
 
         if (m_syncBuffers == 0) { // "Experimental (no delay)"
             // Polling
@@ -682,8 +751,7 @@ int SoundDevicePortAudio::callbackProcessDrift(
         const PaStreamCallbackTimeInfo *timeInfo,
         PaStreamCallbackFlags statusFlags) {
     Q_UNUSED(timeInfo);
-    Trace trace("SoundDevicePortAudio::callbackProcessDrift %1",
-            m_deviceId.debugName());
+    Trace trace(m_callbackProcessDriftTag, m_callbackProcessDriftDurationTag);
 
     if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
         m_pSoundManager->underflowHappened(7);
@@ -699,114 +767,31 @@ int SoundDevicePortAudio::callbackProcessDrift(
     //
     // Additional we need an filled chunk and an empty chunk. These are used when on
     // sound card overtakes the other. This always happens, if they are driven form
-    // two crystals. In a test case every 30 s @ 23 ms. After they are consumed,
-    // the drift correction takes place and fills or clears the reserve buffers.
-    // If this is finished before another overtake happens, we do not face any
-    // dropouts or clicks.
+    // two crystals. In a test case every 30 s @ 23 ms. They also absorb the jitter
+    // effect, when one callback is delayed and the other one fires two times.
     // So that's why we need a Fifo of 3 chunks.
     //
-    // In addition there is a jitter effect. It happens that one callback is delayed,
-    // in this case the second one fires two times and then the first one fires two
-    // time as well to catch up. This is also fixed by the additional buffers. If this
-    // happens just after an regular overtake, we will have clicks again.
-    //
-    // I the tests it turns out that it only happens in the opposite direction, so
-    // 3 chunks are just fine.
+    // Dropping or duplicating frames to keep the fill level in range produces
+    // audible clicks. Instead, the stream is resampled with a ratio that follows
+    // the drift between the two clocks, which is estimated from the fill level
+    // of the Fifo.
+    const mixxx::Duration callbackTime = mixxx::Time::elapsed();
 
     if (m_inputParams.channelCount) {
-        int inChunkSize = framesPerBuffer * m_inputParams.channelCount;
-        int readAvailable = m_inputFifo->readAvailable();
-        int writeAvailable = m_inputFifo->writeAvailable();
-        if (readAvailable < inChunkSize * kDriftReserve) {
-            // risk of an underflow, duplicate one frame
-            m_inputFifo->write(in, inChunkSize);
-            if (m_inputDrift) {
-                // Do not compensate the first delay, because it is likely a jitter
-                // corrected in the next cycle
-                // Duplicate one frame
-                m_inputFifo->write(
-                        &in[inChunkSize - m_inputParams.channelCount],
-                        m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == inChunkSize * kDriftReserve) {
-            // Everything Ok
-            m_inputFifo->write(in, inChunkSize);
-            m_inputDrift = false;
-            //qDebug() << "callbackProcess write:" << (float) readAvailable / inChunkSize << "Normal";
-        } else if (writeAvailable >= inChunkSize) {
-            // Risk of overflow, skip one frame
-            if (m_inputDrift) {
-                m_inputFifo->write(in, inChunkSize - m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputFifo->write(in, inChunkSize);
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (writeAvailable) {
+        if (!m_pInputResampler->writeToFifo(
+                    m_inputFifo, in, framesPerBuffer, callbackTime)) {
             // Fifo Overflow
-            m_inputFifo->write(in, writeAvailable);
             m_pSoundManager->underflowHappened(8);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Overflow";
-        } else {
-            // Buffer full
-            m_pSoundManager->underflowHappened(9);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Buffer full";
         }
     }
 
     if (m_outputParams.channelCount) {
-        int outChunkSize = framesPerBuffer * m_outputParams.channelCount;
-        int readAvailable = m_outputFifo->readAvailable();
-
-        if (readAvailable > outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            if (m_outputDrift) {
-                // Risk of overflow, skip one frame
-                m_outputFifo->releaseReadRegions(m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Skip";
-            } else {
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            m_outputDrift = false;
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Normal";
-        } else if (readAvailable >= outChunkSize) {
-            if (m_outputDrift) {
-                // Risk of underflow, duplicate one frame
-                m_outputFifo->read(out,
-                        outChunkSize - m_outputParams.channelCount);
-                SampleUtil::copy(
-                        &out[outChunkSize - m_outputParams.channelCount],
-                        &out[outChunkSize - (2 * m_outputParams.channelCount)],
-                        m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Save";
-            } else {
-                m_outputFifo->read(out, outChunkSize);
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Save";
-            }
-        } else if (readAvailable) {
-            m_outputFifo->read(out,
-                    readAvailable);
+        if (!m_pOutputResampler->readFromFifo(
+                    m_outputFifo, out, framesPerBuffer, callbackTime)) {
             // underflow
-            SampleUtil::clear(&out[readAvailable],
-                    outChunkSize - readAvailable);
             m_pSoundManager->underflowHappened(10);
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Underflow";
-        } else {
-            // underflow
-            SampleUtil::clear(out, outChunkSize);
-            m_pSoundManager->underflowHappened(11);
-            //qDebug() << "callbackProcess read:" << (float)readAvailable / outChunkSize << "Buffer empty";
         }
-     }
+    }
     return paContinue;
 }
 
@@ -815,7 +800,7 @@ int SoundDevicePortAudio::callbackProcess(const SINT framesPerBuffer,
         const PaStreamCallbackTimeInfo *timeInfo,
         PaStreamCallbackFlags statusFlags) {
     Q_UNUSED(timeInfo);
-    Trace trace("SoundDevicePortAudio::callbackProcess %1", m_deviceId.debugName());
+    Trace trace(m_callbackProcessTag, m_callbackProcessDurationTag);
 
     if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
         m_pSoundManager->underflowHappened(1);
@@ -869,8 +854,11 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     // This must be the very first call, else timeInfo becomes invalid
     updateCallbackEntryToDacTime(timeInfo);
 
-    Trace trace("SoundDevicePortAudio::callbackProcessClkRef %1",
-                m_deviceId.debugName());
+    auto& profiler = mixxx::AudioCallbackProfiler::instance();
+    profiler.beginCallback(mixxx::Duration::fromSeconds(framesPerBuffer / m_dSampleRate));
+    const bool xrun = (statusFlags & (paOutputUnderflow | paInputOverflow)) != 0;
+
+    Trace trace(m_callbackProcessClkRefTag, m_callbackProcessClkRefDurationTag);
 
     //qDebug() << "SoundDevicePortAudio::callbackProcess:" << m_deviceId;
     // Turn on TimeCritical priority for the callback thread. If we are running
@@ -939,7 +927,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 #endif
 #endif
 
-    if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
+    if (xrun) {
         m_pSoundManager->underflowHappened(6);
     }
 
@@ -951,8 +939,9 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 
     // Send audio from the soundcard's input off to the SoundManager...
     if (in) {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess input %1",
-                m_deviceId.debugName());
+        ScopedTimer t(m_callbackProcessInputTag);
+        mixxx::ScopedAudioCallbackSpan span(
+                mixxx::AudioCallbackProfiler::Section::Input);
         composeInputBuffer(in, framesPerBuffer, 0, m_inputParams.channelCount);
         m_pSoundManager->pushInputBuffers(m_audioInputs, m_framesPerBuffer);
     }
@@ -960,29 +949,31 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     m_pSoundManager->readProcess();
 
     {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess prepare %1",
-                m_deviceId.debugName());
+        ScopedTimer t(m_callbackProcessPrepareTag);
         m_pSoundManager->onDeviceOutputCallback(framesPerBuffer);
     }
 
     if (out) {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess output %1",
-                m_deviceId.debugName());
+        ScopedTimer t(m_callbackProcessOutputTag);
 
         if (m_outputParams.channelCount <= 0) {
             qWarning()
                     << "SoundDevicePortAudio::callbackProcess m_outputParams channel count is zero or less:"
                     << m_outputParams.channelCount;
             // Bail out.
+            profiler.endCallback(xrun);
             return paContinue;
         }
 
+        mixxx::ScopedAudioCallbackSpan span(
+                mixxx::AudioCallbackProfiler::Section::Output);
         composeOutputBuffer(out, framesPerBuffer, 0, m_outputParams.channelCount);
     }
 
     m_pSoundManager->writeProcess();
 
     updateAudioLatencyUsage(framesPerBuffer);
+    profiler.endCallback(xrun);
 
     return paContinue;
 }
@@ -3,13 +3,16 @@
 
 #include <portaudio.h>
 #include <QString>
+#include <memory>
 
 #include "soundio/sounddevice.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
+#include "util/stat.h"
 
 class SoundManager;
 class ControlProxy;
+class DriftResampler;
 
 class SoundDevicePortAudio : public SoundDevice {
   public:
@@ -67,6 +70,9 @@ class SoundDevicePortAudio : public SoundDevice {
     FIFO<CSAMPLE>* m_inputFifo;
     bool m_outputDrift;
     bool m_inputDrift;
+    // Compensate the clock drift in callbackProcessDrift()
+    std::unique_ptr<DriftResampler> m_pOutputResampler;
+    std::unique_ptr<DriftResampler> m_pInputResampler;
 
     // A string describing the last PortAudio error to occur.
     QString m_lastError;
@@ -79,4 +85,16 @@ class SoundDevicePortAudio : public SoundDevice {
     int m_invalidTimeInfoCount;
     PerformanceTimer m_clkRefTimer;
     PaTime m_lastCallbackEntrytoDacSecs;
+
+    // The tags of the traces and timers in the callbacks are interned
+    // once, looking them up takes a lock.
+    StatTag m_callbackProcessDriftTag;
+    StatTag m_callbackProcessDriftDurationTag;
+    StatTag m_callbackProcessTag;
+    StatTag m_callbackProcessDurationTag;
+    StatTag m_callbackProcessClkRefTag;
+    StatTag m_callbackProcessClkRefDurationTag;
+    StatTag m_callbackProcessInputTag;
+    StatTag m_callbackProcessPrepareTag;
+    StatTag m_callbackProcessOutputTag;
 };
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <QTextStream>
+
+#include "engine/audiocallbackprofiler.h"
+#include "util/time.h"
+
+using mixxx::AudioCallbackProfiler;
+using mixxx::Duration;
+
+namespace {
+
+const Duration kBudget = Duration::fromMillis(5);
+
+class AudioCallbackProfilerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        mixxx::Time::setTestMode(true);
+        mixxx::Time::setTestElapsedTime(Duration::fromSeconds(1));
+    }
+
+    void TearDown() override {
+        mixxx::Time::setTestMode(false);
+    }
+
+    void advance(Duration duration) {
+        mixxx::Time::setTestElapsedTime(mixxx::Time::elapsed() + duration);
+    }
+
+    /// Runs a callback with a single channel span of the given duration
+    void runCallback(Duration duration, bool xrun = false) {
+        m_profiler.beginCallback(kBudget);
+        const qint64 start = AudioCallbackProfiler::now();
+        advance(duration);
+        m_profiler.addSpan(AudioCallbackProfiler::Section::Channel,
+                1,
+                start,
+                AudioCallbackProfiler::now());
+        m_profiler.endCallback(xrun);
+    }
+
+    AudioCallbackProfiler m_profiler;
+};
+
+TEST_F(AudioCallbackProfilerTest, NoSnapshotWithoutXrun) {
+    for (int i = 0; i < 2 * AudioCallbackProfiler::kHistorySize; ++i) {
+        runCallback(Duration::fromMillis(1));
+    }
+    AudioCallbackProfiler::Snapshot snapshot;
+    EXPECT_FALSE(m_profiler.takeSnapshot(&snapshot));
+}
+
+TEST_F(AudioCallbackProfilerTest, OverrunFreezesHistory) {
+    for (int i = 0; i < AudioCallbackProfiler::kHistorySize + 3; ++i) {
+        runCallback(Duration::fromMillis(1));
+    }
+    runCallback(Duration::fromMillis(7));
+
+    AudioCallbackProfiler::Snapshot snapshot;
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    ASSERT_EQ(AudioCallbackProfiler::kHistorySize,
+            static_cast<int>(snapshot.callbacks.size()));
+    EXPECT_EQ(0, snapshot.numMissedXruns);
+
+    // The callback that caused the freeze is the newest one
+    const auto& last = snapshot.callbacks.back();
+    EXPECT_TRUE(last.isOverrun());
+    EXPECT_FALSE(last.xrun);
+    EXPECT_EQ(Duration::fromMillis(7).toIntegerNanos(), last.durationNanos);
+    ASSERT_EQ(1, last.numSpans);
+    EXPECT_EQ(AudioCallbackProfiler::Section::Channel, last.spans[0].section);
+    EXPECT_EQ(1, last.spans[0].index);
+    EXPECT_EQ(Duration::fromMillis(7).toIntegerNanos(), last.spans[0].durationNanos);
+
+    // Callbacks are in chronological order
+    for (size_t i = 1; i < snapshot.callbacks.size(); ++i) {
+        EXPECT_LT(snapshot.callbacks[i - 1].startNanos, snapshot.callbacks[i].startNanos);
+        EXPECT_FALSE(snapshot.callbacks[i - 1].isOverrun());
+    }
+
+    // A snapshot can only be taken once
+    EXPECT_FALSE(m_profiler.takeSnapshot(&snapshot));
+}
+
+TEST_F(AudioCallbackProfilerTest, KeepsFirstXrunUntilTaken) {
+    runCallback(Duration::fromMillis(1));
+    runCallback(Duration::fromMillis(1), true);
+    // Neither of these replace the unread snapshot
+    runCallback(Duration::fromMillis(1), true);
+    runCallback(Duration::fromMillis(6));
+
+    AudioCallbackProfiler::Snapshot snapshot;
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    ASSERT_EQ(2u, snapshot.callbacks.size());
+    EXPECT_TRUE(snapshot.callbacks.back().xrun);
+    EXPECT_EQ(2, snapshot.numMissedXruns);
+
+    // The next xrun is frozen again
+    runCallback(Duration::fromMillis(1), true);
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    EXPECT_EQ(5u, snapshot.callbacks.size());
+    EXPECT_EQ(0, snapshot.numMissedXruns);
+}
+
+TEST_F(AudioCallbackProfilerTest, DropsExcessSpans) {
+    m_profiler.beginCallback(kBudget);
+    const qint64 now = AudioCallbackProfiler::now();
+    for (int i = 0; i < AudioCallbackProfiler::kMaxSpansPerCallback + 4; ++i) {
+        m_profiler.addSpan(AudioCallbackProfiler::Section::EffectChain, i, now, now);
+    }
+    m_profiler.endCallback(true);
+
+    AudioCallbackProfiler::Snapshot snapshot;
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    ASSERT_EQ(1u, snapshot.callbacks.size());
+    EXPECT_EQ(AudioCallbackProfiler::kMaxSpansPerCallback,
+            snapshot.callbacks[0].numSpans);
+    EXPECT_EQ(4, snapshot.callbacks[0].numDroppedSpans);
+}
+
+TEST_F(AudioCallbackProfilerTest, IgnoresSpansOutsideOfCallback) {
+    EXPECT_FALSE(m_profiler.isInCallback());
+    const qint64 now = AudioCallbackProfiler::now();
+    m_profiler.addSpan(AudioCallbackProfiler::Section::SideChain, 0, now, now);
+    runCallback(Duration::fromMillis(1), true);
+
+    AudioCallbackProfiler::Snapshot snapshot;
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    EXPECT_EQ(1, snapshot.callbacks[0].numSpans);
+}
+
+TEST_F(AudioCallbackProfilerTest, ReportNamesSpans) {
+    m_profiler.setLabel(AudioCallbackProfiler::Section::Channel, 1, "[Channel1]");
+    EXPECT_EQ(0,
+            m_profiler.registerLabel(
+                    AudioCallbackProfiler::Section::EffectChain, "[EffectRack1_EffectUnit1]"));
+    EXPECT_EQ(1,
+            m_profiler.registerLabel(
+                    AudioCallbackProfiler::Section::EffectChain, "[EffectRack1_EffectUnit2]"));
+
+    m_profiler.beginCallback(kBudget);
+    const qint64 start = AudioCallbackProfiler::now();
+    advance(Duration::fromMillis(2));
+    m_profiler.addSpan(AudioCallbackProfiler::Section::EffectChain,
+            1,
+            start,
+            AudioCallbackProfiler::now());
+    m_profiler.addSpan(AudioCallbackProfiler::Section::Channel,
+            1,
+            start,
+            AudioCallbackProfiler::now());
+    m_profiler.endCallback(true);
+
+    AudioCallbackProfiler::Snapshot snapshot;
+    ASSERT_TRUE(m_profiler.takeSnapshot(&snapshot));
+    QString report;
+    QTextStream stream(&report);
+    m_profiler.writeReport(snapshot, &stream);
+    stream.flush();
+    EXPECT_TRUE(report.contains("XRUN"));
+    EXPECT_TRUE(report.contains("Channel [Channel1]"));
+    EXPECT_TRUE(report.contains("EffectChain [EffectRack1_EffectUnit2]"));
+}
+
+} // anonymous namespace
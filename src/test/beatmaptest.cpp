@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 #include <memory.h>
 
@@ -251,4 +252,124 @@ TEST_F(BeatMapTest, HasBeatInRangeWithFractionalPos) {
             mixxx::audio::kStartFramePos + 0.2));
 }
 
+TEST_F(BeatMapTest, FindNthBeatAcrossMarkers) {
+    // A tempo change at every other beat, which results in many markers
+    QVector<mixxx::audio::FramePos> beats;
+    mixxx::audio::FramePos beatPos = mixxx::audio::FramePos(100);
+    for (int i = 0; i < 64; ++i) {
+        beats.append(beatPos);
+        beatPos += (i % 4 < 2) ? 5000 : 5200;
+    }
+    const auto pMap = Beats::fromBeatPositions(m_pTrack->getSampleRate(), beats);
+    ASSERT_FALSE(pMap->hasConstantTempo());
+
+    for (int i = 0; i < beats.size(); ++i) {
+        for (int n = 1; i + n - 1 < beats.size(); n += 7) {
+            EXPECT_EQ(beats[i + n - 1], pMap->findNthBeat(beats[i], n));
+            EXPECT_EQ(beats[i + n - 1], pMap->findNthBeat(beats[i] - 10, n));
+        }
+        for (int n = -1; i + n + 1 >= 0; n -= 7) {
+            EXPECT_EQ(beats[i + n + 1], pMap->findNthBeat(beats[i], n));
+            EXPECT_EQ(beats[i + n + 1], pMap->findNthBeat(beats[i] + 10, n));
+        }
+        EXPECT_EQ(i, pMap->iteratorFrom(beats[i]) - pMap->cfirstmarker());
+        EXPECT_EQ(-i, pMap->cfirstmarker() - pMap->iteratorFrom(beats[i]));
+    }
+}
+
+TEST_F(BeatMapTest, GetBpmInRangeBeforeFirstBeat) {
+    constexpr mixxx::Bpm bpm(60.0);
+    const mixxx::audio::FrameDiff_t beatLengthFrames = getBeatLengthFrames(bpm);
+    QVector<mixxx::audio::FramePos> beats = createBeatVector(
+            mixxx::audio::FramePos(10 * beatLengthFrames), 8, beatLengthFrames);
+    // Change the tempo for the last beat to get a beat map
+    beats.append(beats.back() + beatLengthFrames / 2);
+    const auto pMap = Beats::fromBeatPositions(m_pTrack->getSampleRate(), beats);
+    ASSERT_FALSE(pMap->hasConstantTempo());
+
+    EXPECT_DOUBLE_EQ(bpm.value(),
+            pMap->getBpmInRange(mixxx::audio::kStartFramePos,
+                        mixxx::audio::FramePos(5 * beatLengthFrames))
+                    .value());
+}
+
+// A beat map with a tempo change at every beat, which results in one marker
+// per beat, and positions spread over the whole map to look up.
+class BeatMapBenchmarkData {
+  public:
+    explicit BeatMapBenchmarkData(int numBeats) {
+        QVector<mixxx::audio::FramePos> beats;
+        mixxx::audio::FramePos beatPos = mixxx::audio::kStartFramePos;
+        for (int i = 0; i < numBeats; ++i) {
+            beats.append(beatPos);
+            beatPos += (i % 2 == 0) ? 20000 : 20100;
+        }
+        m_pBeats = Beats::fromBeatPositions(mixxx::audio::SampleRate(44100), beats);
+        for (int i = 0; i < kNumPositions; ++i) {
+            m_positions.append(mixxx::audio::FramePos(
+                    (beatPos.value() * ((i * 7919) % kNumPositions)) / kNumPositions));
+        }
+    }
+
+    const BeatsPointer& beats() const {
+        return m_pBeats;
+    }
+
+    const QVector<mixxx::audio::FramePos>& positions() const {
+        return m_positions;
+    }
+
+  private:
+    static constexpr int kNumPositions = 1024;
+
+    BeatsPointer m_pBeats;
+    QVector<mixxx::audio::FramePos> m_positions;
+};
+
+static void BM_BeatMapFindNthBeat(benchmark::State& state) {
+    const BeatMapBenchmarkData data(static_cast<int>(state.range(0)));
+    int i = 0;
+    for (auto _ : state) {
+        const auto position = data.positions()[i++ % data.positions().size()];
+        benchmark::DoNotOptimize(data.beats()->findNthBeat(position, 4));
+        benchmark::DoNotOptimize(data.beats()->findNthBeat(position, -4));
+    }
+}
+BENCHMARK(BM_BeatMapFindNthBeat)->Range(16, 16384);
+
+static void BM_BeatMapFindPrevNextBeats(benchmark::State& state) {
+    const BeatMapBenchmarkData data(static_cast<int>(state.range(0)));
+    int i = 0;
+    for (auto _ : state) {
+        const auto position = data.positions()[i++ % data.positions().size()];
+        mixxx::audio::FramePos prevBeatPosition;
+        mixxx::audio::FramePos nextBeatPosition;
+        data.beats()->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, true);
+        benchmark::DoNotOptimize(prevBeatPosition);
+        benchmark::DoNotOptimize(nextBeatPosition);
+    }
+}
+BENCHMARK(BM_BeatMapFindPrevNextBeats)->Range(16, 16384);
+
+static void BM_BeatMapGetBpmInRange(benchmark::State& state) {
+    const BeatMapBenchmarkData data(static_cast<int>(state.range(0)));
+    int i = 0;
+    for (auto _ : state) {
+        const auto position = data.positions()[i++ % data.positions().size()];
+        benchmark::DoNotOptimize(data.beats()->getBpmInRange(position, position + 80000));
+    }
+}
+BENCHMARK(BM_BeatMapGetBpmInRange)->Range(16, 16384);
+
+static void BM_BeatMapIteratorDistance(benchmark::State& state) {
+    const BeatMapBenchmarkData data(static_cast<int>(state.range(0)));
+    const auto first = data.beats()->cfirstmarker();
+    int i = 0;
+    for (auto _ : state) {
+        const auto position = data.positions()[i++ % data.positions().size()];
+        benchmark::DoNotOptimize(data.beats()->iteratorFrom(position) - first);
+    }
+}
+BENCHMARK(BM_BeatMapIteratorDistance)->Range(16, 16384);
+
 }  // namespace
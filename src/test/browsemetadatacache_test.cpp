@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "library/browse/browsemetadatacache.h"
+
+namespace {
+
+class BrowseMetadataCacheTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    mixxx::FileInfo writeFile(const QString& fileName, const QByteArray& content) {
+        const QString filePath = QDir(m_tempDir.path()).filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        EXPECT_EQ(content.size(), file.write(content));
+        file.close();
+        return mixxx::FileInfo(filePath);
+    }
+
+    QString cacheFilePath() const {
+        return QDir(m_tempDir.path()).filePath(QStringLiteral("browse_metadata.cache"));
+    }
+
+    static mixxx::TrackMetadata testMetadata(const QString& title) {
+        mixxx::TrackMetadata trackMetadata;
+        trackMetadata.refTrackInfo().setTitle(title);
+        trackMetadata.refTrackInfo().setArtist(QStringLiteral("Artist"));
+        trackMetadata.refTrackInfo().setBpm(mixxx::Bpm(124.5));
+        trackMetadata.refTrackInfo().setYear(QStringLiteral("2021-04-01"));
+        trackMetadata.refAlbumInfo().setArtist(QStringLiteral("Album Artist"));
+        trackMetadata.refStreamInfo().setDuration(mixxx::Duration::fromSeconds(215));
+        trackMetadata.refStreamInfo().setBitrate(mixxx::audio::Bitrate(320));
+        return trackMetadata;
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(BrowseMetadataCacheTest, SaveAndLoad) {
+    const auto fileInfo = writeFile(QStringLiteral("a.mp3"), QByteArray(100, 'a'));
+    const auto trackMetadata = testMetadata(QStringLiteral("Title"));
+    {
+        BrowseMetadataCache cache;
+        cache.insert(fileInfo, trackMetadata);
+        ASSERT_TRUE(cache.save(cacheFilePath()));
+    }
+
+    BrowseMetadataCache cache;
+    ASSERT_TRUE(cache.load(cacheFilePath()));
+    mixxx::TrackMetadata cachedMetadata;
+    ASSERT_TRUE(cache.lookup(fileInfo, &cachedMetadata));
+    EXPECT_EQ(QStringLiteral("Title"), cachedMetadata.getTrackInfo().getTitle());
+    EXPECT_EQ(QStringLiteral("Artist"), cachedMetadata.getTrackInfo().getArtist());
+    EXPECT_EQ(mixxx::Bpm(124.5), cachedMetadata.getTrackInfo().getBpm());
+    EXPECT_EQ(trackMetadata.getTrackInfo().getYear(),
+            cachedMetadata.getTrackInfo().getYear());
+    EXPECT_EQ(QStringLiteral("Album Artist"), cachedMetadata.getAlbumInfo().getArtist());
+    EXPECT_EQ(trackMetadata.getDurationText(mixxx::Duration::Precision::SECONDS),
+            cachedMetadata.getDurationText(mixxx::Duration::Precision::SECONDS));
+    EXPECT_EQ(trackMetadata.getBitrateText(), cachedMetadata.getBitrateText());
+}
+
+TEST_F(BrowseMetadataCacheTest, ModifiedFileIsNotFound) {
+    const QString fileName = QStringLiteral("a.mp3");
+    BrowseMetadataCache cache;
+    cache.insert(writeFile(fileName, QByteArray(100, 'a')),
+            testMetadata(QStringLiteral("Title")));
+
+    const auto modifiedFileInfo = writeFile(fileName, QByteArray(200, 'b'));
+    mixxx::TrackMetadata cachedMetadata;
+    EXPECT_FALSE(cache.lookup(modifiedFileInfo, &cachedMetadata));
+    // The stale entry has been removed
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(BrowseMetadataCacheTest, LeastRecentlyUsedEntriesAreEvicted) {
+    const auto fileA = writeFile(QStringLiteral("a.mp3"), QByteArray(1, 'a'));
+    const auto fileB = writeFile(QStringLiteral("b.mp3"), QByteArray(2, 'b'));
+    const auto fileC = writeFile(QStringLiteral("c.mp3"), QByteArray(3, 'c'));
+    {
+        BrowseMetadataCache cache(2);
+        cache.insert(fileA, testMetadata(QStringLiteral("A")));
+        cache.insert(fileB, testMetadata(QStringLiteral("B")));
+        cache.insert(fileC, testMetadata(QStringLiteral("C")));
+        // A is used more recently than B now
+        mixxx::TrackMetadata cachedMetadata;
+        ASSERT_TRUE(cache.lookup(fileA, &cachedMetadata));
+        ASSERT_TRUE(cache.save(cacheFilePath()));
+        EXPECT_EQ(2, cache.size());
+    }
+
+    BrowseMetadataCache cache;
+    ASSERT_TRUE(cache.load(cacheFilePath()));
+    EXPECT_EQ(2, cache.size());
+    mixxx::TrackMetadata cachedMetadata;
+    EXPECT_TRUE(cache.lookup(fileA, &cachedMetadata));
+    EXPECT_FALSE(cache.lookup(fileB, &cachedMetadata));
+    EXPECT_TRUE(cache.lookup(fileC, &cachedMetadata));
+}
+
+TEST_F(BrowseMetadataCacheTest, InvalidCacheFileIsIgnored) {
+    QFile file(cacheFilePath());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("garbage");
+    file.close();
+
+    BrowseMetadataCache cache;
+    EXPECT_FALSE(cache.load(cacheFilePath()));
+    EXPECT_EQ(0, cache.size());
+}
+
+} // anonymous namespace
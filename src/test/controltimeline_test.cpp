@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "recording/controltimeline.h"
+#include "track/beats.h"
+
+namespace {
+
+class ControlTimelineTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    QString timelineFilePath() const {
+        return QDir(m_tempDir.path()).filePath(QStringLiteral("mix.timeline"));
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(ControlTimelineTest, SaveAndLoad) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const auto pBeats = mixxx::Beats::fromConstTempo(
+            sampleRate, mixxx::audio::FramePos(123.5), mixxx::Bpm(124.0));
+
+    ControlTimeline::TrackLoad track;
+    track.location = QStringLiteral("/music/track.flac");
+    track.sampleRate = sampleRate;
+    track.beatsVersion = pBeats->getVersion();
+    track.beatsSubVersion = pBeats->getSubVersion();
+    track.beats = pBeats->toByteArray();
+    track.replayGain = mixxx::ReplayGain(0.5, 0.9f);
+    track.mainCuePosition = mixxx::audio::FramePos(1000);
+    track.cuePoints.append(ControlTimeline::CuePoint{
+            mixxx::CueType::HotCue,
+            2,
+            mixxx::audio::FramePos(44100.25),
+            mixxx::audio::kInvalidFramePos});
+
+    // Values without an exact decimal representation must be restored
+    // exactly, otherwise the rendered mix would differ.
+    const double rate = 1.0 / 3.0;
+    {
+        ControlTimeline timeline(sampleRate);
+        timeline.appendLoadTrack(0, QStringLiteral("[Channel1]"), track);
+        timeline.appendSet(0, ConfigKey(QStringLiteral("[Channel1]"), QStringLiteral("rate")), rate);
+        timeline.appendSet(1024, ConfigKey(QStringLiteral("[Channel1]"), QStringLiteral("play")), 1.0);
+        timeline.setEndFrame(4096);
+        ASSERT_TRUE(timeline.save(timelineFilePath()));
+    }
+
+    ControlTimeline timeline;
+    ASSERT_TRUE(timeline.load(timelineFilePath()));
+    EXPECT_EQ(sampleRate, timeline.sampleRate());
+    EXPECT_EQ(4096, timeline.endFrame());
+    ASSERT_EQ(3, timeline.events().size());
+
+    const auto& loadEvent = timeline.events().at(0);
+    EXPECT_EQ(ControlTimeline::Event::Type::LoadTrack, loadEvent.type);
+    EXPECT_EQ(QStringLiteral("[Channel1]"), loadEvent.key.group);
+    ASSERT_EQ(1, timeline.trackLoads().size());
+    const auto& loadedTrack = timeline.trackLoad(loadEvent);
+    EXPECT_EQ(track.location, loadedTrack.location);
+    EXPECT_EQ(track.beats, loadedTrack.beats);
+    EXPECT_EQ(track.beatsVersion, loadedTrack.beatsVersion);
+    EXPECT_EQ(track.replayGain, loadedTrack.replayGain);
+    EXPECT_EQ(track.mainCuePosition, loadedTrack.mainCuePosition);
+    ASSERT_EQ(1, loadedTrack.cuePoints.size());
+    EXPECT_EQ(mixxx::CueType::HotCue, loadedTrack.cuePoints.at(0).type);
+    EXPECT_EQ(2, loadedTrack.cuePoints.at(0).hotCueIndex);
+    EXPECT_EQ(mixxx::audio::FramePos(44100.25), loadedTrack.cuePoints.at(0).position);
+    EXPECT_FALSE(loadedTrack.cuePoints.at(0).endPosition.isValid());
+
+    const auto& rateEvent = timeline.events().at(1);
+    EXPECT_EQ(ControlTimeline::Event::Type::Set, rateEvent.type);
+    EXPECT_EQ(ConfigKey(QStringLiteral("[Channel1]"), QStringLiteral("rate")), rateEvent.key);
+    EXPECT_EQ(rate, rateEvent.value);
+
+    const auto& playEvent = timeline.events().at(2);
+    EXPECT_EQ(1024, playEvent.frame);
+    EXPECT_EQ(1.0, playEvent.value);
+}
+
+TEST_F(ControlTimelineTest, InvalidFileIsRejected) {
+    QFile file(timelineFilePath());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("{\"format\": \"something else\"}");
+    file.close();
+
+    ControlTimeline timeline;
+    EXPECT_FALSE(timeline.load(timelineFilePath()));
+    EXPECT_TRUE(timeline.isEmpty());
+}
+
+} // anonymous namespace
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "library/coverartcache.h"
+#include "library/coverartthumbnailstore.h"
 #include "library/coverartutils.h"
 #include "library/trackcollection.h"
 #include "test/librarytest.h"
@@ -89,3 +91,31 @@ TEST_F(CoverArtCacheTest, loadCoverFromFileAbsolute) {
             getTestDir().filePath(kCoverLocationTest),
             getTestDir().filePath(kCoverLocationTest));
 }
+
+TEST_F(CoverArtCacheTest, loadCoverFromThumbnailStore) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    CoverArtThumbnailStore thumbnailStore(tempDir.path());
+
+    const QString absoluteCoverLocation = getTestDir().filePath(kCoverLocationTest);
+    const QImage img = QImage(absoluteCoverLocation);
+    ASSERT_FALSE(img.isNull());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = absoluteCoverLocation;
+    info.setImage(img);
+
+    // The first request decodes the original image and stores a thumbnail
+    auto res = CoverArtCache::loadCover(nullptr, TrackPointer(), info, 50, false, &thumbnailStore);
+    EXPECT_FALSE(res.coverInfoUpdated);
+    EXPECT_EQ(50, res.coverArt.loadedImage.image.width());
+    EXPECT_FALSE(thumbnailStore.load(info.cacheKey(), 1).isNull());
+
+    // The thumbnail is found even if the original image is gone
+    info.coverLocation = tempDir.filePath(kCoverFileTest);
+    res = CoverArtCache::loadCover(nullptr, TrackPointer(), info, 40, false, &thumbnailStore);
+    EXPECT_EQ(CoverInfo::LoadedImage::Result::Ok, res.coverArt.loadedImage.result);
+    EXPECT_EQ(40, res.coverArt.loadedImage.image.width());
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "library/coverartthumbnailstore.h"
+
+namespace {
+
+constexpr int kTier = 2;
+
+QImage testImage(int width, QRgb color) {
+    QImage image(width, width, QImage::Format_RGB32);
+    image.fill(color);
+    return image;
+}
+
+class CoverArtThumbnailStoreTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    QString packFilePath() const {
+        return QDir(m_tempDir.path())
+                .filePath(QStringLiteral("thumbnails_%1.pack")
+                                  .arg(CoverArtThumbnailStore::kTierWidths[kTier]));
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(CoverArtThumbnailStoreTest, TierForWidth) {
+    EXPECT_EQ(0, CoverArtThumbnailStore::tierForWidth(1));
+    EXPECT_EQ(0, CoverArtThumbnailStore::tierForWidth(32));
+    EXPECT_EQ(1, CoverArtThumbnailStore::tierForWidth(33));
+    EXPECT_EQ(2, CoverArtThumbnailStore::tierForWidth(128));
+    EXPECT_EQ(-1, CoverArtThumbnailStore::tierForWidth(129));
+}
+
+TEST_F(CoverArtThumbnailStoreTest, StoreAndReopen) {
+    {
+        CoverArtThumbnailStore store(m_tempDir.path());
+        EXPECT_TRUE(store.load(1, kTier).isNull());
+        EXPECT_TRUE(store.store(1, kTier, testImage(500, qRgb(255, 0, 0))));
+        EXPECT_TRUE(store.store(2, kTier, testImage(100, qRgb(0, 0, 255))));
+
+        // Thumbnails are scaled down, but never up
+        EXPECT_EQ(128, store.load(1, kTier).width());
+        EXPECT_EQ(100, store.load(2, kTier).width());
+        EXPECT_TRUE(store.load(1, kTier - 1).isNull());
+    }
+
+    CoverArtThumbnailStore store(m_tempDir.path());
+    const QImage thumbnail = store.load(2, kTier);
+    ASSERT_FALSE(thumbnail.isNull());
+    EXPECT_EQ(100, thumbnail.width());
+    EXPECT_FALSE(store.load(1, kTier).isNull());
+
+    // Loading remaps the pack file after it has grown
+    EXPECT_TRUE(store.store(3, kTier, testImage(64, qRgb(0, 255, 0))));
+    EXPECT_EQ(64, store.load(3, kTier).width());
+}
+
+TEST_F(CoverArtThumbnailStoreTest, TruncatedRecordIsDiscarded) {
+    qint64 sizeAfterFirstRecord;
+    {
+        CoverArtThumbnailStore store(m_tempDir.path());
+        ASSERT_TRUE(store.store(1, kTier, testImage(64, qRgb(255, 0, 0))));
+        sizeAfterFirstRecord = QFile(packFilePath()).size();
+        ASSERT_TRUE(store.store(2, kTier, testImage(64, qRgb(0, 0, 255))));
+    }
+    // Simulate an interrupted write
+    QFile packFile(packFilePath());
+    ASSERT_TRUE(packFile.resize(packFile.size() - 10));
+
+    CoverArtThumbnailStore store(m_tempDir.path());
+    EXPECT_FALSE(store.load(1, kTier).isNull());
+    EXPECT_TRUE(store.load(2, kTier).isNull());
+    EXPECT_EQ(sizeAfterFirstRecord, QFile(packFilePath()).size());
+
+    // Appending continues after the last complete record
+    EXPECT_TRUE(store.store(2, kTier, testImage(64, qRgb(0, 0, 255))));
+    EXPECT_FALSE(store.load(2, kTier).isNull());
+}
+
+TEST_F(CoverArtThumbnailStoreTest, PackFileIsEmptiedAtSizeLimit) {
+    const QImage thumbnail = testImage(64, qRgb(255, 0, 0));
+    qint64 sizeWithOneRecord;
+    {
+        QTemporaryDir otherDir;
+        ASSERT_TRUE(otherDir.isValid());
+        CoverArtThumbnailStore store(otherDir.path());
+        ASSERT_TRUE(store.store(1, kTier, thumbnail));
+        sizeWithOneRecord = QFileInfo(QDir(otherDir.path()),
+                QFileInfo(packFilePath()).fileName())
+                                    .size();
+    }
+
+    // Room for one thumbnail, but not for two
+    CoverArtThumbnailStore store(m_tempDir.path(), sizeWithOneRecord + 1);
+    ASSERT_TRUE(store.store(1, kTier, thumbnail));
+    ASSERT_TRUE(store.store(2, kTier, thumbnail));
+    EXPECT_TRUE(store.load(1, kTier).isNull());
+    EXPECT_FALSE(store.load(2, kTier).isNull());
+    EXPECT_EQ(sizeWithOneRecord, QFile(packFilePath()).size());
+}
+
+} // anonymous namespace
@@ -1,9 +1,34 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QThread>
+#include <atomic>
+
 #include "library/dao/settingsdao.h"
 #include "test/mixxxdbtest.h"
 #include "util/db/dbconnectionpooler.h"
 
+namespace {
+
+const QString kCreateTable = QStringLiteral(
+        "CREATE TABLE test_table (id INTEGER PRIMARY KEY, value TEXT)");
+const QString kInsertRow = QStringLiteral(
+        "INSERT INTO test_table (value) VALUES (:value)");
+const QString kCountRows = QStringLiteral(
+        "SELECT COUNT(*) FROM test_table");
+
+int countRows(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    if (!query.exec(kCountRows) || !query.next()) {
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+} // anonymous namespace
+
 class DbConnectionPoolTest : public MixxxTest {};
 
 TEST_F(DbConnectionPoolTest, MoveSemantics) {
@@ -20,3 +45,111 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+TEST_F(DbConnectionPoolTest, WriteAheadLog) {
+    const auto pPool = MixxxDb(config()).connectionPool();
+    const mixxx::DbConnectionPooler pooler(pPool);
+    QSqlQuery query(mixxx::DbConnectionPooled(pPool));
+    ASSERT_TRUE(query.exec(QStringLiteral("PRAGMA journal_mode")));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("wal"), query.value(0).toString().toLower());
+}
+
+TEST_F(DbConnectionPoolTest, ReaderRejectsModifications) {
+    const auto pPool = MixxxDb(config()).connectionPool();
+    const mixxx::DbConnectionPooler writerPooler(pPool);
+    const mixxx::DbConnectionPooler readerPooler(
+            pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+    const QSqlDatabase writer = mixxx::DbConnectionPooled(pPool);
+    const QSqlDatabase reader = mixxx::DbConnectionPooled(
+            pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+    ASSERT_NE(writer.connectionName(), reader.connectionName());
+
+    ASSERT_TRUE(QSqlQuery(writer).exec(kCreateTable));
+    EXPECT_EQ(0, countRows(reader));
+    EXPECT_FALSE(QSqlQuery(reader).exec(
+            QStringLiteral("INSERT INTO test_table (value) VALUES ('a')")));
+    EXPECT_EQ(0, countRows(writer));
+}
+
+TEST_F(DbConnectionPoolTest, ReaderNotBlockedByWriter) {
+    const auto pPool = MixxxDb(config()).connectionPool();
+    const mixxx::DbConnectionPooler writerPooler(pPool);
+    const mixxx::DbConnectionPooler readerPooler(
+            pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+    QSqlDatabase writer = mixxx::DbConnectionPooled(pPool);
+    const QSqlDatabase reader = mixxx::DbConnectionPooled(
+            pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+    ASSERT_TRUE(QSqlQuery(writer).exec(kCreateTable));
+
+    ASSERT_TRUE(writer.transaction());
+    {
+        QSqlQuery query(writer);
+        ASSERT_TRUE(query.prepare(kInsertRow));
+        query.bindValue(QStringLiteral(":value"), QStringLiteral("a"));
+        ASSERT_TRUE(query.exec());
+    }
+    // The reader only sees the last committed state and must
+    // not wait until the pending transaction has finished
+    EXPECT_EQ(0, countRows(reader));
+    ASSERT_TRUE(writer.commit());
+    EXPECT_EQ(1, countRows(reader));
+}
+
+// Measures the latency of reads while another thread continuously
+// commits write transactions. Arg(0) uses a rollback journal and
+// regular connections, Arg(1) a write-ahead log and reader connections.
+static void BM_DbConnectionPoolReadWhileWriting(benchmark::State& state) {
+    const QTemporaryDir tempDir;
+    mixxx::DbConnection::Params params;
+    params.type = QStringLiteral("QSQLITE");
+    params.filePath = tempDir.filePath(QStringLiteral("benchmark.sqlite"));
+    params.writeAheadLog = state.range(0) != 0;
+    const auto pPool = mixxx::DbConnectionPool::create(
+            params, QStringLiteral("BENCHMARK"));
+
+    {
+        const mixxx::DbConnectionPooler pooler(pPool);
+        QSqlDatabase database = mixxx::DbConnectionPooled(pPool);
+        QSqlQuery(database).exec(kCreateTable);
+    }
+
+    std::atomic<bool> stopWriting(false);
+    std::atomic<int> numWriteTransactions(0);
+    std::unique_ptr<QThread> pWriterThread(QThread::create([&] {
+        const mixxx::DbConnectionPooler pooler(pPool);
+        QSqlDatabase database = mixxx::DbConnectionPooled(pPool);
+        QSqlQuery query(database);
+        query.prepare(kInsertRow);
+        while (!stopWriting.load()) {
+            database.transaction();
+            for (int i = 0; i < 100; ++i) {
+                query.bindValue(QStringLiteral(":value"), QString::number(i));
+                query.exec();
+            }
+            database.commit();
+            ++numWriteTransactions;
+        }
+    }));
+    pWriterThread->start();
+
+    {
+        const mixxx::DbConnectionPooler pooler(
+                pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+        const QSqlDatabase database = mixxx::DbConnectionPooled(
+                pPool, mixxx::DbConnection::AccessMode::ReadOnly);
+        for (auto _ : state) {
+            const int numRows = countRows(database);
+            if (numRows < 0) {
+                state.SkipWithError("Failed to read rows");
+                break;
+            }
+            benchmark::DoNotOptimize(numRows);
+        }
+    }
+
+    stopWriting.store(true);
+    pWriterThread->wait();
+    state.counters["writeTransactions"] = numWriteTransactions.load();
+}
+BENCHMARK(BM_DbConnectionPoolReadWhileWriting)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,276 @@
+#include "soundio/driftresampler.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "util/sample.h"
+
+namespace {
+
+constexpr double kSampleRate = 44100;
+constexpr SINT kFramesPerBuffer = 256;
+constexpr int kChannels = 2;
+// Same as the drift FIFOs of SoundDevicePortAudio
+constexpr int kFifoChunks = 3;
+constexpr double kOutputTargetFill = 2.5 * kFramesPerBuffer;
+constexpr double kInputTargetFill = 0.5 * kFramesPerBuffer;
+
+// Long enough for many overtakes of the two callbacks
+constexpr double kSimulatedSeconds = 300;
+// The control loop settles in a few seconds
+constexpr double kSettleSeconds = 20;
+
+constexpr double kSineFrequency = 1000;
+constexpr double kSineAmplitude = 0.5;
+
+/// The callbacks of a device with a crystal that deviates by driftPpm
+/// from the nominal sample rate. Each callback is delayed by a random
+/// scheduling jitter.
+class SimulatedClock {
+  public:
+    SimulatedClock(double driftPpm, unsigned int seed)
+            : m_period(kFramesPerBuffer / (kSampleRate * (1 + driftPpm * 1e-6))),
+              m_callbacks(0),
+              m_random(seed),
+              m_jitter(0.0, 0.1 * m_period) {
+        advance();
+    }
+
+    double nextCallbackTime() const {
+        return m_nextCallbackTime;
+    }
+
+    void advance() {
+        m_nextCallbackTime = m_callbacks * m_period + m_jitter(m_random);
+        ++m_callbacks;
+    }
+
+  private:
+    const double m_period;
+    qint64 m_callbacks;
+    std::mt19937 m_random;
+    std::uniform_real_distribution<double> m_jitter;
+    double m_nextCallbackTime;
+};
+
+mixxx::Duration toDuration(double seconds) {
+    return mixxx::Duration::fromNanos(static_cast<qint64>(seconds * 1e9));
+}
+
+/// Generates a stereo sine wave chunk by chunk
+class SineGenerator {
+  public:
+    SineGenerator()
+            : m_frame(0) {
+    }
+
+    void generate(CSAMPLE* pBuffer, SINT numFrames) {
+        for (SINT i = 0; i < numFrames; ++i) {
+            const auto value = static_cast<CSAMPLE>(kSineAmplitude *
+                    std::sin(2 * M_PI * kSineFrequency * m_frame / kSampleRate));
+            for (int channel = 0; channel < kChannels; ++channel) {
+                pBuffer[i * kChannels + channel] = value;
+            }
+            ++m_frame;
+        }
+    }
+
+  private:
+    qint64 m_frame;
+};
+
+/// Detects clicks in a sine wave stream by its second difference, which is
+/// tiny for a sine but jumps when a frame is dropped or duplicated.
+class ClickDetector {
+  public:
+    ClickDetector()
+            : m_previous{0, 0},
+              m_maxDeviation(0) {
+    }
+
+    void process(const CSAMPLE* pBuffer, SINT numFrames) {
+        const double k = 2 * std::cos(2 * M_PI * kSineFrequency / kSampleRate);
+        for (SINT i = 0; i < numFrames; ++i) {
+            const CSAMPLE sample = pBuffer[i * kChannels];
+            const double deviation = std::abs(sample - k * m_previous[1] + m_previous[0]);
+            m_maxDeviation = std::max(m_maxDeviation, deviation);
+            m_previous[0] = m_previous[1];
+            m_previous[1] = sample;
+        }
+    }
+
+    void reset() {
+        m_maxDeviation = 0;
+    }
+
+    double maxDeviation() const {
+        return m_maxDeviation;
+    }
+
+  private:
+    double m_previous[2];
+    double m_maxDeviation;
+};
+
+void prefill(FIFO<CSAMPLE>* pFifo) {
+    // 1.5 chunks of silence, like SoundDevicePortAudio::open()
+    std::vector<CSAMPLE> silence(kFramesPerBuffer * kChannels * kFifoChunks / 2);
+    pFifo->write(silence.data(), static_cast<int>(silence.size()));
+}
+
+struct SimulationResult {
+    int failures = 0;
+    double maxClickDeviation = 0;
+    double meanRatio = 0;
+    double maxRatioDeviation = 0;
+};
+
+void evaluateRatios(const std::vector<double>& ratios, SimulationResult* pResult) {
+    double sum = 0;
+    for (double ratio : ratios) {
+        sum += ratio;
+    }
+    pResult->meanRatio = sum / ratios.size();
+    for (double ratio : ratios) {
+        pResult->maxRatioDeviation = std::max(
+                pResult->maxRatioDeviation, std::abs(ratio - pResult->meanRatio));
+    }
+}
+
+/// The device reads from a FIFO that is filled by the clock reference
+SimulationResult simulateOutput(double deviceDriftPpm) {
+    FIFO<CSAMPLE> fifo(kFramesPerBuffer * kChannels * kFifoChunks);
+    prefill(&fifo);
+    DriftResampler resampler(kChannels, kFramesPerBuffer, kSampleRate, kOutputTargetFill);
+    SimulatedClock clockReference(0, 1);
+    SimulatedClock device(deviceDriftPpm, 2);
+    SineGenerator generator;
+    ClickDetector detector;
+    std::vector<CSAMPLE> buffer(kFramesPerBuffer * kChannels);
+
+    SimulationResult result;
+    std::vector<double> ratios;
+    bool settled = false;
+    while (device.nextCallbackTime() < kSimulatedSeconds) {
+        if (clockReference.nextCallbackTime() < device.nextCallbackTime()) {
+            const double time = clockReference.nextCallbackTime();
+            generator.generate(buffer.data(), kFramesPerBuffer);
+            fifo.write(buffer.data(), static_cast<int>(buffer.size()));
+            resampler.chunkTransferred(toDuration(time));
+            clockReference.advance();
+        } else {
+            const double time = device.nextCallbackTime();
+            if (!settled && time > kSettleSeconds) {
+                settled = true;
+                detector.reset();
+            }
+            const bool ok = resampler.readFromFifo(
+                    &fifo, buffer.data(), kFramesPerBuffer, toDuration(time));
+            if (settled) {
+                if (!ok) {
+                    ++result.failures;
+                }
+                ratios.push_back(resampler.ratio());
+            }
+            detector.process(buffer.data(), kFramesPerBuffer);
+            device.advance();
+        }
+    }
+    result.maxClickDeviation = detector.maxDeviation();
+    evaluateRatios(ratios, &result);
+    return result;
+}
+
+/// The device writes into a FIFO that is drained by the clock reference
+SimulationResult simulateInput(double deviceDriftPpm) {
+    FIFO<CSAMPLE> fifo(kFramesPerBuffer * kChannels * kFifoChunks);
+    prefill(&fifo);
+    DriftResampler resampler(kChannels, kFramesPerBuffer, kSampleRate, kInputTargetFill);
+    SimulatedClock clockReference(0, 3);
+    SimulatedClock device(deviceDriftPpm, 4);
+    SineGenerator generator;
+    ClickDetector detector;
+    std::vector<CSAMPLE> buffer(kFramesPerBuffer * kChannels);
+
+    SimulationResult result;
+    std::vector<double> ratios;
+    bool settled = false;
+    while (clockReference.nextCallbackTime() < kSimulatedSeconds) {
+        if (device.nextCallbackTime() < clockReference.nextCallbackTime()) {
+            const double time = device.nextCallbackTime();
+            generator.generate(buffer.data(), kFramesPerBuffer);
+            const bool ok = resampler.writeToFifo(
+                    &fifo, buffer.data(), kFramesPerBuffer, toDuration(time));
+            if (settled) {
+                if (!ok) {
+                    ++result.failures;
+                }
+                ratios.push_back(resampler.ratio());
+            }
+            device.advance();
+        } else {
+            const double time = clockReference.nextCallbackTime();
+            if (!settled && time > kSettleSeconds) {
+                settled = true;
+                detector.reset();
+            }
+            const int read = fifo.read(buffer.data(), static_cast<int>(buffer.size()));
+            if (read < static_cast<int>(buffer.size())) {
+                SampleUtil::clear(&buffer[read], buffer.size() - read);
+                if (settled) {
+                    ++result.failures;
+                }
+            }
+            resampler.chunkTransferred(toDuration(time));
+            detector.process(buffer.data(), kFramesPerBuffer);
+            clockReference.advance();
+        }
+    }
+    result.maxClickDeviation = detector.maxDeviation();
+    evaluateRatios(ratios, &result);
+    return result;
+}
+
+// A dropped or duplicated frame of the sine deviates by about 0.07
+constexpr double kMaxClickDeviation = 0.001;
+// The pitch of the resampled stream is modulated by less than 0.1 cent
+constexpr double kMaxRatioDeviation = 50e-6;
+
+TEST(DriftResamplerTest, OutputToFasterDevice) {
+    const SimulationResult result = simulateOutput(100);
+    EXPECT_EQ(0, result.failures);
+    EXPECT_LT(result.maxClickDeviation, kMaxClickDeviation);
+    // The device consumes more frames than the clock reference produces
+    EXPECT_NEAR(1 - 100e-6, result.meanRatio, 5e-6);
+    EXPECT_LT(result.maxRatioDeviation, kMaxRatioDeviation);
+}
+
+TEST(DriftResamplerTest, OutputToSlowerDevice) {
+    const SimulationResult result = simulateOutput(-100);
+    EXPECT_EQ(0, result.failures);
+    EXPECT_LT(result.maxClickDeviation, kMaxClickDeviation);
+    EXPECT_NEAR(1 + 100e-6, result.meanRatio, 5e-6);
+    EXPECT_LT(result.maxRatioDeviation, kMaxRatioDeviation);
+}
+
+TEST(DriftResamplerTest, InputFromFasterDevice) {
+    const SimulationResult result = simulateInput(100);
+    EXPECT_EQ(0, result.failures);
+    EXPECT_LT(result.maxClickDeviation, kMaxClickDeviation);
+    // The device produces more frames than the clock reference consumes
+    EXPECT_NEAR(1 + 100e-6, result.meanRatio, 5e-6);
+    EXPECT_LT(result.maxRatioDeviation, kMaxRatioDeviation);
+}
+
+TEST(DriftResamplerTest, InputFromSlowerDevice) {
+    const SimulationResult result = simulateInput(-100);
+    EXPECT_EQ(0, result.failures);
+    EXPECT_LT(result.maxClickDeviation, kMaxClickDeviation);
+    EXPECT_NEAR(1 - 100e-6, result.meanRatio, 5e-6);
+    EXPECT_LT(result.maxRatioDeviation, kMaxRatioDeviation);
+}
+
+} // anonymous namespace
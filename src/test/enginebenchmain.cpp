@@ -0,0 +1,131 @@
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QStringList>
+#include <cstdio>
+
+#include "test/enginebenchmark.h"
+#include "test/headlessengine.h"
+
+namespace {
+
+QStringList splitList(const QString& value) {
+    return value.split(',',
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            Qt::SkipEmptyParts);
+#else
+            QString::SkipEmptyParts);
+#endif
+}
+
+QList<int> parseIntList(const QString& value, bool* pOk) {
+    QList<int> values;
+    const QStringList parts = splitList(value);
+    for (const auto& part : parts) {
+        const int intValue = part.trimmed().toInt(pOk);
+        if (!*pOk || intValue <= 0) {
+            *pOk = false;
+            return {};
+        }
+        values.append(intValue);
+    }
+    *pOk = !values.isEmpty();
+    return values;
+}
+
+} // anonymous namespace
+
+// Runs the engine without a sound device as fast as possible and writes the
+// distribution of the callback times per scenario and buffer size to a JSON
+// file, e.g. for comparing releases:
+//
+//   mixxx-engine-bench --decks 4 --output engine-bench.json track1.mp3 track2.flac
+int main(int argc, char** argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Measures the time of engine callbacks without a sound device."));
+    const QCommandLineOption decksOption(QStringLiteral("decks"),
+            QStringLiteral("Number of playing decks."),
+            QStringLiteral("count"),
+            QStringLiteral("3"));
+    const QCommandLineOption bufferFramesOption(QStringLiteral("buffer-frames"),
+            QStringLiteral("Comma-separated list of buffer sizes in frames."),
+            QStringLiteral("frames"),
+            QStringLiteral("64,128,256,512,1024,2048"));
+    const QCommandLineOption callbacksOption(QStringLiteral("callbacks"),
+            QStringLiteral("Number of measured callbacks per scenario and buffer size."),
+            QStringLiteral("count"),
+            QStringLiteral("2000"));
+    const QCommandLineOption scenariosOption(QStringLiteral("scenarios"),
+            QStringLiteral("Comma-separated list of scenarios: %1")
+                    .arg(EngineBenchmark::scenarioNames().join(QChar(','))),
+            QStringLiteral("names"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+            QStringLiteral("The JSON file with the results."),
+            QStringLiteral("file"),
+            QStringLiteral("engine-bench.json"));
+    parser.addOptions({
+            decksOption,
+            bufferFramesOption,
+            callbacksOption,
+            scenariosOption,
+            outputOption,
+    });
+    parser.addPositionalArgument(QStringLiteral("files"),
+            QStringLiteral("Audio files that are loaded into the decks in turn."));
+    int exitCode;
+    if (!HeadlessEngine::parseArguments(&parser, argc, argv, &exitCode)) {
+        return exitCode;
+    }
+
+    EngineBenchmark::Options options;
+    bool ok = false;
+    options.numDecks = parser.value(decksOption).toInt(&ok);
+    if (!ok || options.numDecks <= 0) {
+        std::fprintf(stderr, "Invalid number of decks\n");
+        return 1;
+    }
+    options.bufferFrames = parseIntList(parser.value(bufferFramesOption), &ok);
+    if (!ok) {
+        std::fprintf(stderr, "Invalid buffer sizes\n");
+        return 1;
+    }
+    options.numCallbacks = parser.value(callbacksOption).toInt(&ok);
+    if (!ok || options.numCallbacks <= 0) {
+        std::fprintf(stderr, "Invalid number of callbacks\n");
+        return 1;
+    }
+    if (parser.isSet(scenariosOption)) {
+        options.scenarios = splitList(parser.value(scenariosOption));
+        for (const auto& scenario : qAsConst(options.scenarios)) {
+            if (!EngineBenchmark::scenarioNames().contains(scenario)) {
+                std::fprintf(stderr, "Unknown scenario %s\n", qPrintable(scenario));
+                return 1;
+            }
+        }
+    }
+    options.trackLocations = parser.positionalArguments();
+
+    HeadlessEngine::ApplicationScope applicationScope(argv);
+
+    if (options.trackLocations.isEmpty()) {
+        options.trackLocations.append(
+                HeadlessEngine::testDir().filePath(QStringLiteral("sine-30.wav")));
+    }
+
+    QJsonObject report;
+    {
+        EngineBenchmark benchmark(std::move(options));
+        report = benchmark.run();
+    }
+
+    QFile outputFile(parser.value(outputOption));
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            outputFile.write(QJsonDocument(report).toJson()) < 0) {
+        std::fprintf(stderr,
+                "Failed to write %s\n",
+                qPrintable(outputFile.fileName()));
+        return 1;
+    }
+    return 0;
+}
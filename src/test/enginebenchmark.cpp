@@ -0,0 +1,239 @@
+#include "test/enginebenchmark.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "control/controlobject.h"
+#include "effects/chains/quickeffectchain.h"
+#include "effects/chains/standardeffectchain.h"
+#include "mixer/deck.h"
+#include "track/beats.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+#include "util/versionstore.h"
+
+namespace {
+
+const mixxx::Logger kLogger("EngineBenchmark");
+
+const QString kMasterGroup = QStringLiteral("[Master]");
+
+const QString kScenarioPlay = QStringLiteral("play");
+const QString kScenarioSync = QStringLiteral("sync");
+const QString kScenarioKeylock = QStringLiteral("keylock");
+const QString kScenarioLoop = QStringLiteral("loop");
+const QString kScenarioEffects = QStringLiteral("effects");
+const QString kScenarioAll = QStringLiteral("all");
+
+// Slightly different tempos, otherwise syncing would be a no-op
+constexpr double kBaseBpm = 120.0;
+constexpr double kBpmStepPerDeck = 1.5;
+// +4% with the default rate range of 8%
+constexpr double kRateSliderValue = 0.5;
+constexpr double kLoopSizeBeats = 0.5;
+constexpr double kQuickEffectSuperKnob = 0.25;
+constexpr int kNumEffectUnits = 2;
+// Applies the reset controls before the next scenario
+constexpr int kResetBufferFrames = 512;
+
+void setControl(const QString& group, const QString& item, double value) {
+    ControlObject::set(ConfigKey(group, item), value);
+}
+
+void pushButton(const QString& group, const QString& item) {
+    setControl(group, item, 1.0);
+    setControl(group, item, 0.0);
+}
+
+// Nearest-rank percentile of sorted values
+double percentile(const std::vector<double>& sortedValues, double p) {
+    DEBUG_ASSERT(!sortedValues.empty());
+    const auto rank = static_cast<std::size_t>(
+            std::ceil(p * static_cast<double>(sortedValues.size())));
+    return sortedValues[std::max<std::size_t>(rank, 1) - 1];
+}
+
+} // anonymous namespace
+
+// static
+QStringList EngineBenchmark::scenarioNames() {
+    return {
+            kScenarioPlay,
+            kScenarioSync,
+            kScenarioKeylock,
+            kScenarioLoop,
+            kScenarioEffects,
+            kScenarioAll,
+    };
+}
+
+EngineBenchmark::EngineBenchmark(Options options)
+        : m_options(std::move(options)),
+          m_engine(m_options.numDecks) {
+    DEBUG_ASSERT(!m_options.trackLocations.isEmpty());
+
+    const auto& decks = m_engine.decks();
+    for (int deckIndex = 0; deckIndex < decks.size(); ++deckIndex) {
+        const QString& trackLocation = m_options.trackLocations.at(
+                deckIndex % m_options.trackLocations.size());
+        TrackPointer pTrack = Track::newTemporary(trackLocation);
+        if (!m_engine.loadTrack(decks[deckIndex], pTrack)) {
+            kLogger.warning() << "Failed to load" << trackLocation;
+            continue;
+        }
+        // Scripted loops and sync require beats, the benchmark
+        // should not depend on the analyzers.
+        pTrack->trySetBeats(mixxx::Beats::fromConstTempo(
+                pTrack->getSampleRate(),
+                mixxx::audio::kStartFramePos,
+                mixxx::Bpm(kBaseBpm + deckIndex * kBpmStepPerDeck)));
+    }
+    QCoreApplication::processEvents();
+}
+
+void EngineBenchmark::resetDecks() {
+    for (const auto* pDeck : m_engine.decks()) {
+        const QString group = pDeck->getGroup();
+        setControl(group, QStringLiteral("play"), 0.0);
+        setControl(group, QStringLiteral("sync_enabled"), 0.0);
+        setControl(group, QStringLiteral("keylock"), 0.0);
+        setControl(group, QStringLiteral("rate"), 0.0);
+        if (ControlObject::get(ConfigKey(group, QStringLiteral("loop_enabled"))) > 0.0) {
+            pushButton(group, QStringLiteral("reloop_toggle"));
+        }
+        setControl(QuickEffectChain::formatEffectChainGroup(group),
+                QStringLiteral("super1"),
+                0.5);
+        for (int unitNumber = 1; unitNumber <= kNumEffectUnits; ++unitNumber) {
+            setControl(StandardEffectChain::formatEffectChainGroup(unitNumber),
+                    QStringLiteral("group_%1_enable").arg(group),
+                    0.0);
+        }
+        setControl(group, QStringLiteral("playposition"), 0.0);
+    }
+    m_engine.process(kResetBufferFrames);
+    QCoreApplication::processEvents();
+}
+
+void EngineBenchmark::applyScenario(const QString& scenario) {
+    const bool all = scenario == kScenarioAll;
+    for (const auto* pDeck : m_engine.decks()) {
+        const QString group = pDeck->getGroup();
+        if (all || scenario == kScenarioSync) {
+            setControl(group, QStringLiteral("sync_enabled"), 1.0);
+        }
+        if (all || scenario == kScenarioKeylock) {
+            setControl(group, QStringLiteral("keylock"), 1.0);
+            setControl(group, QStringLiteral("rate"), kRateSliderValue);
+        }
+        if (all || scenario == kScenarioEffects) {
+            setControl(QuickEffectChain::formatEffectChainGroup(group),
+                    QStringLiteral("super1"),
+                    kQuickEffectSuperKnob);
+            for (int unitNumber = 1; unitNumber <= kNumEffectUnits; ++unitNumber) {
+                setControl(StandardEffectChain::formatEffectChainGroup(unitNumber),
+                        QStringLiteral("group_%1_enable").arg(group),
+                        1.0);
+            }
+        }
+        setControl(group, QStringLiteral("play"), 1.0);
+        if (all || scenario == kScenarioLoop) {
+            setControl(group, QStringLiteral("beatloop_size"), kLoopSizeBeats);
+            pushButton(group, QStringLiteral("beatloop_activate"));
+        }
+    }
+    QCoreApplication::processEvents();
+}
+
+QJsonObject EngineBenchmark::measure(const QString& scenario, int bufferFrames) {
+    const double sampleRate = ControlObject::get(ConfigKey(kMasterGroup, "samplerate"));
+    const double budgetMicros = bufferFrames * 1000000.0 / sampleRate;
+    setControl(kMasterGroup, QStringLiteral("audio_buffer_size"), budgetMicros / 1000.0);
+
+    resetDecks();
+    applyScenario(scenario);
+    for (int i = 0; i < m_options.numWarmupCallbacks; ++i) {
+        m_engine.process(bufferFrames);
+    }
+
+    m_callbackMicros.clear();
+    m_callbackMicros.reserve(m_options.numCallbacks);
+    PerformanceTimer timer;
+    for (int i = 0; i < m_options.numCallbacks; ++i) {
+        timer.start();
+        m_engine.process(bufferFrames);
+        m_callbackMicros.push_back(timer.elapsed().toDoubleMicros());
+        // Not measured: Give the reader threads a chance to keep up,
+        // otherwise the decks would mostly play silence.
+        QThread::yieldCurrentThread();
+    }
+    std::sort(m_callbackMicros.begin(), m_callbackMicros.end());
+
+    const double totalMicros = std::accumulate(
+            m_callbackMicros.begin(), m_callbackMicros.end(), 0.0);
+    const double meanMicros = totalMicros / m_callbackMicros.size();
+    const auto overruns = std::count_if(m_callbackMicros.begin(),
+            m_callbackMicros.end(),
+            [budgetMicros](double micros) { return micros > budgetMicros; });
+
+    QJsonObject result;
+    result.insert(QStringLiteral("scenario"), scenario);
+    result.insert(QStringLiteral("buffer_frames"), bufferFrames);
+    result.insert(QStringLiteral("budget_us"), budgetMicros);
+    result.insert(QStringLiteral("mean_us"), meanMicros);
+    result.insert(QStringLiteral("p50_us"), percentile(m_callbackMicros, 0.5));
+    result.insert(QStringLiteral("p99_us"), percentile(m_callbackMicros, 0.99));
+    result.insert(QStringLiteral("max_us"), m_callbackMicros.back());
+    result.insert(QStringLiteral("overruns"), static_cast<qint64>(overruns));
+    result.insert(QStringLiteral("realtime_factor"), budgetMicros / meanMicros);
+
+    kLogger.info()
+            << scenario
+            << bufferFrames << "frames:"
+            << "p50" << percentile(m_callbackMicros, 0.5) << "us,"
+            << "p99" << percentile(m_callbackMicros, 0.99) << "us,"
+            << "max" << m_callbackMicros.back() << "us,"
+            << "budget" << budgetMicros << "us";
+    return result;
+}
+
+QJsonObject EngineBenchmark::run() {
+    const QStringList scenarios = m_options.scenarios.isEmpty()
+            ? scenarioNames()
+            : m_options.scenarios;
+
+    QJsonArray results;
+    for (const auto& scenario : scenarios) {
+        for (const int bufferFrames : m_options.bufferFrames) {
+            results.append(measure(scenario, bufferFrames));
+        }
+    }
+    resetDecks();
+
+    QJsonArray tracks;
+    for (const auto& trackLocation : m_options.trackLocations) {
+        tracks.append(QFileInfo(trackLocation).fileName());
+    }
+
+    QJsonObject report;
+    report.insert(QStringLiteral("version"), VersionStore::version());
+    report.insert(QStringLiteral("git_version"), VersionStore::gitVersion());
+    report.insert(QStringLiteral("platform"), VersionStore::platform());
+    report.insert(QStringLiteral("date"),
+            QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QStringLiteral("sample_rate"),
+            ControlObject::get(ConfigKey(kMasterGroup, "samplerate")));
+    report.insert(QStringLiteral("decks"), m_options.numDecks);
+    report.insert(QStringLiteral("callbacks"), m_options.numCallbacks);
+    report.insert(QStringLiteral("tracks"), tracks);
+    report.insert(QStringLiteral("results"), results);
+    return report;
+}
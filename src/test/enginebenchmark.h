@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+#include <vector>
+
+#include "test/headlessengine.h"
+
+/// Drives a HeadlessEngine with real audio files and the real scalers, but
+/// without a sound device. EngineMaster::process() is invoked as fast as
+/// possible and the time of each callback is measured, which reveals
+/// performance regressions long before they turn into xruns.
+class EngineBenchmark {
+  public:
+    struct Options {
+        QStringList trackLocations;
+        int numDecks = 3;
+        QList<int> bufferFrames = {64, 128, 256, 512, 1024, 2048};
+        int numCallbacks = 2000;
+        int numWarmupCallbacks = 100;
+        /// All scenarios if empty
+        QStringList scenarios;
+    };
+
+    /// The names of the scripted scenarios in the order they are run.
+    static QStringList scenarioNames();
+
+    explicit EngineBenchmark(Options options);
+
+    /// Runs all selected scenarios with all buffer sizes. The returned
+    /// object contains the setup and the callback time distribution of
+    /// each run.
+    QJsonObject run();
+
+  private:
+    void resetDecks();
+    void applyScenario(const QString& scenario);
+    QJsonObject measure(const QString& scenario, int bufferFrames);
+
+    const Options m_options;
+    HeadlessEngine m_engine;
+    std::vector<double> m_callbackMicros;
+};
@@ -0,0 +1,171 @@
+#include "test/headlessengine.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QStringList>
+#include <cstdio>
+
+#include "control/control.h"
+#include "control/controlindicatortimer.h"
+#include "control/controlobject.h"
+#include "effects/effectsmanager.h"
+#include "engine/channels/enginedeck.h"
+#include "engine/enginebuffer.h"
+#include "engine/engine.h"
+#include "errordialoghandler.h"
+#include "library/coverartutils.h"
+#include "mixer/deck.h"
+#include "mixer/playerinfo.h"
+#include "mixer/playermanager.h"
+#include "mixxxapplication.h"
+#include "test/testenginemaster.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/logging.h"
+
+namespace {
+
+const QString kMasterGroup = QStringLiteral("[Master]");
+
+// Matches MixxxTest, the test folder is a sibling of the res folder
+const QString kTestPath = QStringLiteral("../src/test");
+
+// Matches BaseSignalPathTest
+constexpr double kDefaultRateRange = 0.08;
+constexpr double kDefaultRateDir = 1.0;
+
+} // anonymous namespace
+
+HeadlessEngine::ApplicationScope::ApplicationScope(char** argv)
+        // The arguments of the tool are not understood by MixxxApplication
+        : m_argc(1) {
+    ErrorDialogHandler::setEnabled(false);
+    mixxx::Logging::initialize(
+            QString(), // Only log to stderr
+            mixxx::kLogLevelDefault,
+            mixxx::kLogLevelDefault,
+            mixxx::LogFlag::DebugAssertBreak);
+    // Guessing cover art is not needed for playing tracks
+    disableConcurrentGuessingOfTrackCoverInfoDuringTests();
+    m_pApplication = std::make_unique<MixxxApplication>(m_argc, argv);
+}
+
+HeadlessEngine::ApplicationScope::~ApplicationScope() {
+    m_pApplication.reset();
+    mixxx::Logging::shutdown();
+}
+
+// static
+bool HeadlessEngine::parseArguments(
+        QCommandLineParser* pParser,
+        int argc,
+        char** argv,
+        int* pExitCode) {
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments.append(QString::fromLocal8Bit(argv[i]));
+    }
+    pParser->addHelpOption();
+    if (!pParser->parse(arguments)) {
+        std::fprintf(stderr, "%s\n", qPrintable(pParser->errorText()));
+        *pExitCode = 1;
+        return false;
+    }
+    if (pParser->isSet(QStringLiteral("help"))) {
+        std::printf("%s", qPrintable(pParser->helpText()));
+        *pExitCode = 0;
+        return false;
+    }
+    return true;
+}
+
+// static
+QDir HeadlessEngine::testDir() {
+    return QDir(ConfigObject<ConfigValue>::computeResourcePath() +
+            QChar('/') + kTestPath);
+}
+
+HeadlessEngine::HeadlessEngine(int numDecks)
+        : m_pControlIndicatorTimer(std::make_unique<mixxx::ControlIndicatorTimer>()),
+          m_pChannelHandleFactory(std::make_shared<ChannelHandleFactory>()) {
+    DEBUG_ASSERT(m_configDir.isValid());
+    DEBUG_ASSERT(numDecks > 0);
+    m_pConfig = UserSettingsPointer(new UserSettings(
+            m_configDir.filePath(QStringLiteral("mixxx.cfg"))));
+    ControlDoublePrivate::setUserConfig(m_pConfig);
+
+    m_pNumDecks = std::make_unique<ControlObject>(ConfigKey(kMasterGroup, "num_decks"));
+    m_pEffectsManager = new EffectsManager(m_pConfig, m_pChannelHandleFactory);
+    m_pEngineMaster = new TestEngineMaster(m_pConfig,
+            kMasterGroup,
+            m_pEffectsManager,
+            m_pChannelHandleFactory,
+            false);
+
+    for (int deckIndex = 0; deckIndex < numDecks; ++deckIndex) {
+        const QString group = PlayerManager::groupForDeck(deckIndex);
+        auto* pDeck = new Deck(nullptr,
+                m_pConfig,
+                m_pEngineMaster,
+                m_pEffectsManager,
+                EngineChannel::CENTER,
+                m_pEngineMaster->registerChannelGroup(group));
+        ControlObject::set(ConfigKey(group, "master"), 1.0);
+        ControlObject::set(ConfigKey(group, "rate_dir"), kDefaultRateDir);
+        ControlObject::set(ConfigKey(group, "rateRange"), kDefaultRateRange);
+        m_pNumDecks->set(m_pNumDecks->get() + 1);
+        m_decks.append(pDeck);
+    }
+
+    // Setup the equalizer, QuickEffect and standard effect
+    // chains like PlayerManager and CoreServices do.
+    for (const auto* pDeck : qAsConst(m_decks)) {
+        m_pEffectsManager->addDeck(pDeck->getGroup());
+    }
+    m_pEffectsManager->setup();
+
+    ControlObject::set(ConfigKey(kMasterGroup, "enabled"), 1.0);
+    PlayerInfo::create();
+}
+
+HeadlessEngine::~HeadlessEngine() {
+    qDeleteAll(m_decks);
+    // Deletes all EngineChannels added to it.
+    delete m_pEngineMaster;
+    delete m_pEffectsManager;
+    m_pNumDecks.reset();
+    PlayerInfo::destroy();
+
+    // Delete the controls that have been leaked by the engine
+    const auto controls = ControlDoublePrivate::takeAllInstances();
+    for (const auto& pControl : controls) {
+        pControl->deleteCreatorCO();
+    }
+}
+
+Deck* HeadlessEngine::deckForGroup(const QString& group) const {
+    int deckNumber;
+    if (!PlayerManager::isDeckGroup(group, &deckNumber)) {
+        return nullptr;
+    }
+    return m_decks.value(deckNumber - 1);
+}
+
+bool HeadlessEngine::loadTrack(Deck* pDeck, TrackPointer pTrack) {
+    pDeck->slotLoadTrack(pTrack, false);
+    // The track is loaded by the reader worker without an engine callback
+    settle();
+    return pDeck->getEngineDeck()->getEngineBuffer()->isTrackLoaded();
+}
+
+void HeadlessEngine::process(int bufferFrames) {
+    m_pEngineMaster->process(bufferFrames * mixxx::kEngineChannelCount);
+}
+
+void HeadlessEngine::settle() {
+    // Deliver queued signals, e.g. from loading a track, before and
+    // after the readers have caught up with the requested chunks.
+    QCoreApplication::processEvents();
+    m_pEngineMaster->waitForIdleWorkers();
+    QCoreApplication::processEvents();
+}
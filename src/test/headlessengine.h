@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QDir>
+#include <QList>
+#include <QString>
+#include <QTemporaryDir>
+#include <memory>
+
+#include "engine/channelhandle.h"
+#include "preferences/usersettings.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track_decl.h"
+
+class ControlObject;
+class Deck;
+class EffectsManager;
+class MixxxApplication;
+class QCommandLineParser;
+class TestEngineMaster;
+
+namespace mixxx {
+class ControlIndicatorTimer;
+} // namespace mixxx
+
+/// The engine with a number of decks and the equalizer, QuickEffect and
+/// standard effect chains, but without a sound device, GUI or library.
+/// The engine callbacks are driven by the owner, e.g. by the engine
+/// benchmark or the offline renderer.
+///
+/// Unlike BaseSignalPathTest this does not depend on gtest, so command line
+/// tools can use it outside of the test runner.
+class HeadlessEngine : private SoundSourceProviderRegistration {
+  public:
+    /// Creates the application of a command line tool and keeps it alive
+    /// while in scope. Error dialogs are disabled, there is no one to
+    /// confirm them.
+    class ApplicationScope final {
+      public:
+        explicit ApplicationScope(char** argv);
+        ~ApplicationScope();
+
+      private:
+        // Referenced by QCoreApplication
+        int m_argc;
+        std::unique_ptr<MixxxApplication> m_pApplication;
+    };
+
+    /// Parses the arguments of a command line tool and prints the help or
+    /// the parser error. Returns false if the tool should exit immediately
+    /// with *pExitCode.
+    static bool parseArguments(
+            QCommandLineParser* pParser,
+            int argc,
+            char** argv,
+            int* pExitCode);
+
+    /// The test data directory, e.g. for the default tracks of a tool.
+    static QDir testDir();
+
+    explicit HeadlessEngine(int numDecks);
+    ~HeadlessEngine();
+
+    UserSettingsPointer config() const {
+        return m_pConfig;
+    }
+
+    TestEngineMaster* engineMaster() const {
+        return m_pEngineMaster;
+    }
+
+    const QList<Deck*>& decks() const {
+        return m_decks;
+    }
+
+    /// Returns nullptr if there is no such deck.
+    Deck* deckForGroup(const QString& group) const;
+
+    /// Loads the track and waits until the reader has opened it. Returns
+    /// false if the track could not be loaded.
+    bool loadTrack(Deck* pDeck, TrackPointer pTrack);
+
+    /// Runs a single engine callback.
+    void process(int bufferFrames);
+
+    /// Delivers queued signals and waits until the engine workers have
+    /// finished all requested work, see EngineMaster::waitForIdleWorkers().
+    void settle();
+
+  private:
+    const QTemporaryDir m_configDir;
+    UserSettingsPointer m_pConfig;
+
+    std::unique_ptr<mixxx::ControlIndicatorTimer> m_pControlIndicatorTimer;
+    ChannelHandleFactoryPointer m_pChannelHandleFactory;
+    std::unique_ptr<ControlObject> m_pNumDecks;
+    EffectsManager* m_pEffectsManager;
+    TestEngineMaster* m_pEngineMaster;
+    QList<Deck*> m_decks;
+};
@@ -0,0 +1,197 @@
+#include "engine/sidechain/networksendqueue.h"
+
+#include <gtest/gtest.h>
+
+#include <QAtomicInt>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+namespace {
+
+constexpr int kTimeoutMillis = 5000;
+
+/// Sends to a local TCP server without blocking. The socket is created by
+/// the sending thread that uses it.
+class TcpSink : public NetworkSendQueue::Sink {
+  public:
+    explicit TcpSink(quint16 port)
+            : m_port(port) {
+    }
+
+    void open() override {
+        m_pSocket = std::make_unique<QTcpSocket>();
+        m_pSocket->connectToHost(QHostAddress::LocalHost, m_port);
+        m_pSocket->waitForConnected(kTimeoutMillis);
+    }
+
+    void close() override {
+        m_pSocket->waitForBytesWritten(kTimeoutMillis);
+        m_pSocket.reset();
+    }
+
+    qint64 sendNonBlocking(const char* pData, qint64 size) override {
+        if (m_pSocket->state() != QAbstractSocket::ConnectedState) {
+            return -1;
+        }
+        // QTcpSocket buffers without limit, which is not what a
+        // non-blocking socket would do
+        if (m_pSocket->bytesToWrite() > kMaxBufferedBytes) {
+            return 0;
+        }
+        const qint64 written = m_pSocket->write(pData, size);
+        // Writes as much as possible without blocking
+        m_pSocket->flush();
+        return written;
+    }
+
+    void waitForWritable(int timeoutMillis) override {
+        m_pSocket->waitForBytesWritten(timeoutMillis);
+    }
+
+  private:
+    static constexpr qint64 kMaxBufferedBytes = 4096;
+
+    const quint16 m_port;
+    std::unique_ptr<QTcpSocket> m_pSocket;
+};
+
+/// Accepts nothing until it is released, like a stalled server
+class StalledSink : public NetworkSendQueue::Sink {
+  public:
+    qint64 sendNonBlocking(const char* pData, qint64 size) override {
+        m_attempts.fetchAndAddRelease(1);
+        if (!m_released.loadAcquire()) {
+            return 0;
+        }
+        m_received.append(pData, static_cast<int>(size));
+        return size;
+    }
+
+    void waitForWritable(int timeoutMillis) override {
+        QThread::msleep(std::min(timeoutMillis, 1));
+    }
+
+    bool hasBeenCalled() const {
+        return m_attempts.loadAcquire() > 0;
+    }
+
+    void release() {
+        m_released.storeRelease(1);
+    }
+
+    // Only to be read after the sending thread has stopped
+    const QByteArray& received() const {
+        return m_received;
+    }
+
+  private:
+    QAtomicInt m_attempts;
+    QAtomicInt m_released;
+    QByteArray m_received;
+};
+
+class FailingSink : public NetworkSendQueue::Sink {
+  public:
+    qint64 sendNonBlocking(const char* pData, qint64 size) override {
+        Q_UNUSED(pData);
+        Q_UNUSED(size);
+        return -1;
+    }
+
+    void waitForWritable(int timeoutMillis) override {
+        Q_UNUSED(timeoutMillis);
+    }
+};
+
+QByteArray packet(char value, int size) {
+    return QByteArray(size, value);
+}
+
+bool waitUntil(const std::function<bool()>& condition) {
+    for (int i = 0; i < kTimeoutMillis; ++i) {
+        if (condition()) {
+            return true;
+        }
+        QThread::msleep(1);
+    }
+    return condition();
+}
+
+TEST(NetworkSendQueueTest, SendsAllPacketsInOrderToTcpSink) {
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    TcpSink sink(server.serverPort());
+    NetworkSendQueue queue(&sink, 1024 * 1024);
+    queue.startSending();
+
+    ASSERT_TRUE(server.waitForNewConnection(kTimeoutMillis));
+    std::unique_ptr<QTcpSocket> pReceiver(server.nextPendingConnection());
+    ASSERT_TRUE(pReceiver);
+
+    QByteArray expected;
+    for (int i = 0; i < 64; ++i) {
+        const QByteArray data = packet(static_cast<char>('a' + i % 26), 1000 + i);
+        expected.append(data);
+        EXPECT_TRUE(queue.enqueue(data));
+    }
+
+    QByteArray received;
+    while (received.size() < expected.size() &&
+            pReceiver->waitForReadyRead(kTimeoutMillis)) {
+        received.append(pReceiver->readAll());
+    }
+    EXPECT_EQ(expected, received);
+    EXPECT_TRUE(waitUntil([&queue] { return queue.queuedBytes() == 0; }));
+    EXPECT_EQ(0, queue.droppedPackets());
+    EXPECT_FALSE(queue.hasFailed());
+    queue.stopSending();
+}
+
+TEST(NetworkSendQueueTest, DropsOldestPacketsWhenStalled) {
+    StalledSink sink;
+    NetworkSendQueue queue(&sink, 3000);
+    queue.startSending();
+
+    // The first packet is taken by the sending thread and stalls there
+    EXPECT_TRUE(queue.enqueue(packet('a', 1000)));
+    ASSERT_TRUE(waitUntil([&sink] { return sink.hasBeenCalled(); }));
+    EXPECT_EQ(1000, queue.queuedBytes());
+    // Enqueueing never blocks on the stalled sink
+    EXPECT_TRUE(queue.enqueue(packet('b', 1000)));
+    EXPECT_TRUE(queue.enqueue(packet('c', 1000)));
+    EXPECT_TRUE(queue.enqueue(packet('d', 1000)));
+    EXPECT_FALSE(queue.enqueue(packet('e', 1000)));
+    EXPECT_EQ(1, queue.droppedPackets());
+    EXPECT_EQ(4000, queue.queuedBytes());
+
+    sink.release();
+    EXPECT_TRUE(waitUntil([&queue] { return queue.queuedBytes() == 0; }));
+    queue.stopSending();
+
+    EXPECT_EQ(packet('a', 1000) + packet('c', 1000) + packet('d', 1000) + packet('e', 1000),
+            sink.received());
+    EXPECT_EQ(1, queue.droppedPackets());
+}
+
+TEST(NetworkSendQueueTest, SinkErrorStopsSending) {
+    FailingSink sink;
+    NetworkSendQueue queue(&sink, 3000);
+    queue.startSending();
+
+    queue.enqueue(packet('a', 100));
+    EXPECT_TRUE(waitUntil([&queue] { return queue.hasFailed(); }));
+    EXPECT_TRUE(queue.wait(kTimeoutMillis));
+    EXPECT_EQ(0, queue.queuedBytes());
+
+    // Restarting resets the error
+    queue.startSending();
+    EXPECT_FALSE(queue.hasFailed());
+    queue.stopSending();
+}
+
+} // anonymous namespace
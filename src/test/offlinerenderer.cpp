@@ -0,0 +1,156 @@
+#include "test/offlinerenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "control/control.h"
+#include "control/controlobject.h"
+#include "engine/engine.h"
+#include "engine/sidechain/enginerecord.h"
+#include "mixer/deck.h"
+#include "mixer/playermanager.h"
+#include "recording/defs_recording.h"
+#include "test/testenginemaster.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("OfflineRenderer");
+
+const QString kMasterGroup = QStringLiteral("[Master]");
+
+// At least as many decks as in the default skins
+constexpr int kMinNumDecks = 3;
+
+int numDecksOfTimeline(const ControlTimeline& timeline) {
+    int numDecks = kMinNumDecks;
+    for (const auto& event : timeline.events()) {
+        int deckNumber;
+        if (PlayerManager::isDeckGroup(event.key.group, &deckNumber)) {
+            numDecks = std::max(numDecks, deckNumber);
+        }
+    }
+    return numDecks;
+}
+
+} // anonymous namespace
+
+OfflineRenderer::OfflineRenderer(ControlTimeline timeline, Options options)
+        : m_timeline(std::move(timeline)),
+          m_options(std::move(options)),
+          m_sampleRate(m_options.sampleRate.isValid()
+                          ? m_options.sampleRate
+                          : m_timeline.sampleRate()),
+          m_engine(numDecksOfTimeline(m_timeline)) {
+    DEBUG_ASSERT(m_sampleRate.isValid());
+    DEBUG_ASSERT(m_options.bufferFrames > 0);
+
+    // The setup of the renderer is not part of the mix
+    m_ignoredControls = {
+            ConfigKey(kMasterGroup, QStringLiteral("samplerate")),
+            ConfigKey(kMasterGroup, QStringLiteral("audio_buffer_size")),
+            ConfigKey(kMasterGroup, QStringLiteral("num_decks")),
+    };
+
+    ControlObject::set(ConfigKey(kMasterGroup, QStringLiteral("samplerate")),
+            m_sampleRate.value());
+
+    // EngineRecord is controlled by the same settings and control as
+    // when it is driven by RecordingManager in the engine side chain.
+    const UserSettingsPointer pConfig = m_engine.config();
+    pConfig->set(ConfigKey(RECORDING_PREF_KEY, "Encoding"), ConfigValue(m_options.encoding));
+    pConfig->set(ConfigKey(RECORDING_PREF_KEY, "Path"), ConfigValue(m_options.outputPath));
+    pConfig->set(ConfigKey(RECORDING_PREF_KEY, "CueEnabled"), ConfigValue(0));
+    m_pRecordingStatus = std::make_unique<ControlObject>(
+            ConfigKey(RECORDING_PREF_KEY, "status"));
+    m_pEngineRecord = std::make_unique<EngineRecord>(pConfig);
+}
+
+OfflineRenderer::~OfflineRenderer() {
+    m_pEngineRecord.reset();
+    m_pRecordingStatus.reset();
+}
+
+qint64 OfflineRenderer::renderFrame(qint64 timelineFrame) const {
+    if (m_sampleRate == m_timeline.sampleRate()) {
+        return timelineFrame;
+    }
+    return std::llround(static_cast<double>(timelineFrame) *
+            m_sampleRate.value() / m_timeline.sampleRate().value());
+}
+
+void OfflineRenderer::loadTrack(Deck* pDeck, const ControlTimeline::TrackLoad& trackLoad) {
+    TrackPointer pTrack = Track::newTemporary(trackLoad.location);
+    if (!m_engine.loadTrack(pDeck, pTrack)) {
+        kLogger.warning() << "Failed to load" << trackLoad.location << "into" << pDeck->getGroup();
+        return;
+    }
+    trackLoad.applyAnalysis(pTrack.get());
+    m_engine.settle();
+}
+
+void OfflineRenderer::applyEvent(const ControlTimeline::Event& event) {
+    switch (event.type) {
+    case ControlTimeline::Event::Type::Set: {
+        if (m_ignoredControls.contains(event.key)) {
+            return;
+        }
+        // Controls of the GUI or of other players do not exist here
+        const auto pControl = ControlDoublePrivate::getControl(
+                event.key, ControlFlag::NoWarnIfMissing);
+        if (pControl) {
+            pControl->set(event.value, nullptr);
+        }
+        return;
+    }
+    case ControlTimeline::Event::Type::LoadTrack: {
+        Deck* pDeck = m_engine.deckForGroup(event.key.group);
+        if (pDeck) {
+            loadTrack(pDeck, m_timeline.trackLoad(event));
+        } else {
+            kLogger.info() << "Skipping track load into" << event.key.group;
+        }
+        return;
+    }
+    }
+    DEBUG_ASSERT(!"unreachable");
+}
+
+bool OfflineRenderer::render() {
+    const qint64 endFrame = renderFrame(m_timeline.endFrame());
+    const auto& events = m_timeline.events();
+    auto nextEvent = events.begin();
+
+    m_pRecordingStatus->set(RECORD_READY);
+    qint64 framePos = 0;
+    while (framePos < endFrame) {
+        // Events between two callbacks are applied when the next callback
+        // starts, just like a sound device would do it.
+        while (nextEvent != events.end() && renderFrame(nextEvent->frame) <= framePos) {
+            applyEvent(*nextEvent);
+            ++nextEvent;
+        }
+        m_engine.settle();
+
+        const auto bufferFrames = static_cast<int>(std::min<qint64>(
+                m_options.bufferFrames, endFrame - framePos));
+        m_engine.process(bufferFrames);
+        m_pEngineRecord->process(m_engine.engineMaster()->getMasterBuffer(),
+                bufferFrames * mixxx::kEngineChannelCount);
+        if (m_pRecordingStatus->get() != RECORD_ON) {
+            kLogger.warning() << "Failed to record" << m_options.outputPath;
+            return false;
+        }
+        framePos += bufferFrames;
+    }
+
+    m_pRecordingStatus->set(RECORD_OFF);
+    // Closes the file
+    m_pEngineRecord->process(m_engine.engineMaster()->getMasterBuffer(), 0);
+    kLogger.info()
+            << "Rendered" << framePos << "frames with" << events.size()
+            << "events to" << m_options.outputPath;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <memory>
+
+#include "recording/controltimeline.h"
+#include "test/headlessengine.h"
+
+class ControlObject;
+class Deck;
+class EngineRecord;
+
+/// Renders a recorded ControlTimeline with a HeadlessEngine into an audio
+/// file, as fast as possible and without a sound device.
+///
+/// The events of the timeline are applied between the engine callbacks and
+/// after each callback the renderer waits until the track readers have
+/// finished all requested work. This makes the result independent of the
+/// thread scheduling, i.e. rendering the same timeline twice produces
+/// bit-identical files.
+class OfflineRenderer {
+  public:
+    struct Options {
+        QString outputPath;
+        /// The internal name of the encoder format, e.g. WAV or FLAC
+        QString encoding;
+        /// The sample rate of the timeline if invalid
+        mixxx::audio::SampleRate sampleRate;
+        int bufferFrames = 1024;
+    };
+
+    OfflineRenderer(ControlTimeline timeline, Options options);
+    ~OfflineRenderer();
+
+    bool render();
+
+  private:
+    qint64 renderFrame(qint64 timelineFrame) const;
+
+    void applyEvent(const ControlTimeline::Event& event);
+    void loadTrack(Deck* pDeck, const ControlTimeline::TrackLoad& trackLoad);
+
+    const ControlTimeline m_timeline;
+    const Options m_options;
+    mixxx::audio::SampleRate m_sampleRate;
+    HeadlessEngine m_engine;
+    QSet<ConfigKey> m_ignoredControls;
+
+    std::unique_ptr<ControlObject> m_pRecordingStatus;
+    std::unique_ptr<EngineRecord> m_pEngineRecord;
+};
@@ -0,0 +1,82 @@
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QStringList>
+#include <cstdio>
+
+#include "recording/controltimeline.h"
+#include "recording/defs_recording.h"
+#include "test/headlessengine.h"
+#include "test/offlinerenderer.h"
+
+// Renders a control timeline that has been written next to a recording
+// into a WAV or FLAC file without a sound device, e.g. for re-rendering
+// a recorded set at a higher sample rate or for regression tests:
+//
+//   mixxx-render --sample-rate 96000 2021-04-01_21h00m00s.timeline mix.flac
+int main(int argc, char** argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Renders a recorded control timeline into an audio file."));
+    const QCommandLineOption sampleRateOption(QStringLiteral("sample-rate"),
+            QStringLiteral("Sample rate of the output, the recorded one by default."),
+            QStringLiteral("hz"));
+    const QCommandLineOption bufferFramesOption(QStringLiteral("buffer-frames"),
+            QStringLiteral("Frames per engine callback. Events are applied at "
+                           "callback boundaries like during the recording."),
+            QStringLiteral("frames"),
+            QStringLiteral("1024"));
+    parser.addOptions({
+            sampleRateOption,
+            bufferFramesOption,
+    });
+    parser.addPositionalArgument(QStringLiteral("timeline"),
+            QStringLiteral("The recorded control timeline."));
+    parser.addPositionalArgument(QStringLiteral("output"),
+            QStringLiteral("The rendered .wav or .flac file."));
+    int exitCode;
+    if (!HeadlessEngine::parseArguments(&parser, argc, argv, &exitCode)) {
+        return exitCode;
+    }
+    const QStringList positionalArguments = parser.positionalArguments();
+    if (positionalArguments.size() != 2) {
+        std::fprintf(stderr, "%s", qPrintable(parser.helpText()));
+        return 1;
+    }
+
+    OfflineRenderer::Options options;
+    options.outputPath = QFileInfo(positionalArguments.at(1)).absoluteFilePath();
+    const QString suffix = QFileInfo(options.outputPath).suffix().toLower();
+    if (suffix == QStringLiteral("wav")) {
+        options.encoding = QStringLiteral(ENCODING_WAVE);
+    } else if (suffix == QStringLiteral("flac")) {
+        options.encoding = QStringLiteral(ENCODING_FLAC);
+    } else {
+        std::fprintf(stderr, "Unsupported output format %s\n", qPrintable(suffix));
+        return 1;
+    }
+    bool ok = false;
+    if (parser.isSet(sampleRateOption)) {
+        options.sampleRate = mixxx::audio::SampleRate(
+                parser.value(sampleRateOption).toUInt(&ok));
+        if (!ok || !options.sampleRate.isValid()) {
+            std::fprintf(stderr, "Invalid sample rate\n");
+            return 1;
+        }
+    }
+    options.bufferFrames = parser.value(bufferFramesOption).toInt(&ok);
+    if (!ok || options.bufferFrames <= 0) {
+        std::fprintf(stderr, "Invalid number of frames per callback\n");
+        return 1;
+    }
+
+    HeadlessEngine::ApplicationScope applicationScope(argv);
+
+    ControlTimeline timeline;
+    if (!timeline.load(positionalArguments.at(0))) {
+        std::fprintf(stderr, "Failed to load %s\n", qPrintable(positionalArguments.at(0)));
+        return 1;
+    }
+
+    OfflineRenderer renderer(std::move(timeline), std::move(options));
+    return renderer.render() ? 0 : 1;
+}
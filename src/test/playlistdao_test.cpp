@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "library/dao/playlistdao.h"
+#include "test/librarytest.h"
+#include "track/track.h"
+
+class PlaylistDAOTest : public LibraryTest {
+  protected:
+    void SetUp() override {
+        const QDir dir(QDir::tempPath() + QStringLiteral("/playlist"));
+        for (int i = 0; i < 6; ++i) {
+            TrackPointer pTrack = Track::newTemporary(mixxx::FileAccess(
+                    mixxx::FileInfo(dir, QStringLiteral("file%1.mp3").arg(i))));
+            m_trackIds.append(internalCollection()->addTrack(pTrack, false));
+            ASSERT_TRUE(m_trackIds.last().isValid());
+        }
+        m_playlistId = playlistDAO().createPlaylist(QStringLiteral("Playlist"));
+        ASSERT_LE(0, m_playlistId);
+        ASSERT_TRUE(playlistDAO().appendTracksToPlaylist(m_trackIds, m_playlistId));
+    }
+
+    PlaylistDAO& playlistDAO() const {
+        return internalCollection()->getPlaylistDAO();
+    }
+
+    QList<int> getPositions() const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral(
+                "SELECT position FROM PlaylistTracks "
+                "WHERE playlist_id=:id ORDER BY position"));
+        query.bindValue(":id", m_playlistId);
+        EXPECT_TRUE(query.exec());
+        QList<int> positions;
+        while (query.next()) {
+            positions.append(query.value(0).toInt());
+        }
+        return positions;
+    }
+
+    QList<TrackId> getTrackIdsByPosition() const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral(
+                "SELECT track_id FROM PlaylistTracks "
+                "WHERE playlist_id=:id ORDER BY position"));
+        query.bindValue(":id", m_playlistId);
+        EXPECT_TRUE(query.exec());
+        QList<TrackId> trackIds;
+        while (query.next()) {
+            trackIds.append(TrackId(query.value(0)));
+        }
+        return trackIds;
+    }
+
+    QList<TrackId> m_trackIds;
+    int m_playlistId;
+};
+
+TEST_F(PlaylistDAOTest, removeTracksClosesGaps) {
+    int numSignals = 0;
+    QList<TrackId> removedTrackIds;
+    QList<int> removedPositions;
+    QObject::connect(&playlistDAO(),
+            &PlaylistDAO::tracksRemoved,
+            [&](int playlistId,
+                    const QList<TrackId>& trackIds,
+                    const QList<int>& positions) {
+                EXPECT_EQ(m_playlistId, playlistId);
+                removedTrackIds = trackIds;
+                removedPositions = positions;
+                ++numSignals;
+            });
+
+    // Unordered with a duplicate and a non-existing position
+    playlistDAO().removeTracksFromPlaylist(m_playlistId, {5, 2, 4, 5, 42});
+
+    EXPECT_EQ(1, numSignals);
+    EXPECT_EQ(QList<int>({2, 4, 5}), removedPositions);
+    EXPECT_EQ(QList<TrackId>({m_trackIds[1], m_trackIds[3], m_trackIds[4]}),
+            removedTrackIds);
+    EXPECT_EQ(QList<TrackId>({m_trackIds[0], m_trackIds[2], m_trackIds[5]}),
+            getTrackIdsByPosition());
+    EXPECT_EQ(QList<int>({1, 2, 3}), getPositions());
+    EXPECT_FALSE(playlistDAO().isTrackInPlaylist(m_trackIds[1], m_playlistId));
+    EXPECT_TRUE(playlistDAO().isTrackInPlaylist(m_trackIds[2], m_playlistId));
+}
+
+TEST_F(PlaylistDAOTest, removeDuplicateTrackById) {
+    ASSERT_TRUE(playlistDAO().appendTrackToPlaylist(m_trackIds[0], m_playlistId));
+
+    playlistDAO().removeTracksFromPlaylistById(m_playlistId, m_trackIds[0]);
+
+    EXPECT_EQ(m_trackIds.mid(1), getTrackIdsByPosition());
+    EXPECT_EQ(QList<int>({1, 2, 3, 4, 5}), getPositions());
+    EXPECT_FALSE(playlistDAO().isTrackInPlaylist(m_trackIds[0], m_playlistId));
+}
+
+TEST_F(PlaylistDAOTest, insertTracks) {
+    int numSignals = 0;
+    QObject::connect(&playlistDAO(),
+            &PlaylistDAO::tracksAdded,
+            [&](int playlistId, const QList<TrackId>& trackIds) {
+                EXPECT_EQ(m_playlistId, playlistId);
+                EXPECT_EQ(QList<TrackId>({m_trackIds[5], m_trackIds[4]}), trackIds);
+                ++numSignals;
+            });
+
+    EXPECT_EQ(2,
+            playlistDAO().insertTracksIntoPlaylist(
+                    {m_trackIds[5], TrackId(), m_trackIds[4]}, m_playlistId, 2));
+
+    EXPECT_EQ(1, numSignals);
+    EXPECT_EQ(QList<TrackId>({m_trackIds[0],
+                      m_trackIds[5],
+                      m_trackIds[4],
+                      m_trackIds[1],
+                      m_trackIds[2],
+                      m_trackIds[3],
+                      m_trackIds[4],
+                      m_trackIds[5]}),
+            getTrackIdsByPosition());
+    EXPECT_EQ(QList<int>({1, 2, 3, 4, 5, 6, 7, 8}), getPositions());
+}
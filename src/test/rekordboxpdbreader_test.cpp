@@ -0,0 +1,494 @@
+#include "library/rekordbox/rekordboxpdbreader.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTextCodec>
+#include <QVector>
+#include <QtDebug>
+#include <fstream>
+
+#include "library/rekordbox/rekordbox_pdb.h"
+
+using namespace mixxx::rekordboxpdb;
+
+namespace {
+
+constexpr int kPageSize = 4096;
+constexpr int kPageHeaderSize = 0x28;
+constexpr int kRowGroupSize = 0x24;
+constexpr int kTrackRowSize = 0x5E + 2 * 21;
+
+void writeU8(QByteArray* pData, int pos, quint8 value) {
+    (*pData)[pos] = static_cast<char>(value);
+}
+
+void writeU16(QByteArray* pData, int pos, quint16 value) {
+    qToLittleEndian(value, reinterpret_cast<uchar*>(pData->data()) + pos);
+}
+
+void writeU32(QByteArray* pData, int pos, quint32 value) {
+    qToLittleEndian(value, reinterpret_cast<uchar*>(pData->data()) + pos);
+}
+
+QByteArray encodeString(const QString& text) {
+    QByteArray encoded;
+    bool isAscii = true;
+    for (const QChar c : text) {
+        if (c.unicode() >= 0x80) {
+            isAscii = false;
+            break;
+        }
+    }
+    if (isAscii && text.size() <= 126) {
+        encoded.append(static_cast<char>((text.size() + 1) * 2 + 1));
+        encoded.append(text.toLatin1());
+    } else if (isAscii) {
+        encoded.resize(3);
+        writeU8(&encoded, 0, 0x40);
+        writeU16(&encoded, 1, static_cast<quint16>(text.size()));
+        encoded.append(text.toLatin1());
+    } else {
+        encoded.resize(3 + text.size() * 2);
+        writeU8(&encoded, 0, 0x90);
+        writeU16(&encoded, 1, static_cast<quint16>(text.size() * 2 + 4));
+        for (int i = 0; i < text.size(); ++i) {
+            qToBigEndian(text.at(i).unicode(),
+                    reinterpret_cast<uchar*>(encoded.data()) + 3 + 2 * i);
+        }
+    }
+    return encoded;
+}
+
+struct TestTrack {
+    quint32 id;
+    quint32 artistId;
+    quint32 tempo;
+    QString title;
+    QString filePath;
+};
+
+QByteArray trackRow(const TestTrack& track) {
+    QByteArray row(kTrackRowSize, '\0');
+    writeU16(&row, 0x00, 0x24);
+    writeU32(&row, 0x38, track.tempo);
+    writeU32(&row, 0x44, track.artistId);
+    writeU32(&row, 0x48, track.id);
+    for (int i = 0; i < 21; ++i) {
+        QString text;
+        if (i == 17) {
+            text = track.title;
+        } else if (i == 20) {
+            text = track.filePath;
+        }
+        writeU16(&row, 0x5E + 2 * i, static_cast<quint16>(row.size()));
+        row.append(encodeString(text));
+    }
+    return row;
+}
+
+QByteArray artistRow(quint32 id, const QString& name) {
+    QByteArray row(0x0A, '\0');
+    writeU16(&row, 0x00, 0x60);
+    writeU32(&row, 0x04, id);
+    writeU8(&row, 0x08, 0x03);
+    writeU8(&row, 0x09, 0x0A);
+    row.append(encodeString(name));
+    return row;
+}
+
+QByteArray playlistTreeRow(quint32 parentId,
+        quint32 sortOrder,
+        quint32 id,
+        bool isFolder,
+        const QString& name) {
+    QByteArray row(0x14, '\0');
+    writeU32(&row, 0x00, parentId);
+    writeU32(&row, 0x08, sortOrder);
+    writeU32(&row, 0x0C, id);
+    writeU32(&row, 0x10, isFolder ? 1 : 0);
+    row.append(encodeString(name));
+    return row;
+}
+
+QByteArray playlistEntryRow(quint32 entryIndex, quint32 trackId, quint32 playlistId) {
+    QByteArray row(0x0C, '\0');
+    writeU32(&row, 0x00, entryIndex);
+    writeU32(&row, 0x04, trackId);
+    writeU32(&row, 0x08, playlistId);
+    return row;
+}
+
+/// Writes a minimal DeviceSQL database with the layout described in
+/// rekordbox_pdb.ksy. Each table starts with an empty non-data page
+/// like the files exported by Rekordbox.
+class PdbWriter {
+  public:
+    void addRow(TableType type, const QByteArray& row, bool present = true) {
+        m_tables[static_cast<quint32>(type)].append(PendingRow{row, present});
+    }
+
+    QByteArray build() const {
+        QVector<QByteArray> pages;
+        // The file header is located in the first page
+        pages.append(QByteArray(kPageSize, '\0'));
+        writeU32(&pages[0], 0x04, kPageSize);
+        writeU32(&pages[0], 0x08, static_cast<quint32>(m_tables.size()));
+
+        int tableIndex = 0;
+        for (auto it = m_tables.constBegin(); it != m_tables.constEnd(); ++it) {
+            const quint32 type = it.key();
+            QVector<int> pageIndices;
+            pageIndices.append(pages.size());
+            pages.append(newPage(pages.size(), type, 0x64));
+
+            int rowIndex = 0;
+            int heapPos = kPageHeaderSize;
+            for (const auto& row : it.value()) {
+                const int numGroups = rowIndex / 16 + 1;
+                if (pageIndices.size() == 1 ||
+                        heapPos + row.data.size() + numGroups * kRowGroupSize >
+                                kPageSize) {
+                    pageIndices.append(pages.size());
+                    pages.append(newPage(pages.size(), type, 0x24));
+                    rowIndex = 0;
+                    heapPos = kPageHeaderSize;
+                }
+                QByteArray& page = pages[pageIndices.last()];
+                page.replace(heapPos, row.data.size(), row.data);
+                const int base = kPageSize - (rowIndex / 16) * kRowGroupSize;
+                writeU16(&page,
+                        base - (6 + 2 * (rowIndex % 16)),
+                        static_cast<quint16>(heapPos - kPageHeaderSize));
+                if (row.present) {
+                    const quint16 flags = qFromLittleEndian<quint16>(
+                            reinterpret_cast<const uchar*>(page.constData()) +
+                            base - 4);
+                    writeU16(&page, base - 4, flags | (1 << (rowIndex % 16)));
+                }
+                heapPos += row.data.size();
+                ++rowIndex;
+                writeU8(&page, 0x18, static_cast<quint8>(qMin(rowIndex, 0xFF)));
+                writeU16(&page, 0x22, static_cast<quint16>(rowIndex));
+            }
+
+            for (int i = 0; i < pageIndices.size() - 1; ++i) {
+                writeU32(&pages[pageIndices[i]], 0x0C, pageIndices[i + 1]);
+            }
+            const int tablePos = 0x1C + 0x10 * tableIndex++;
+            writeU32(&pages[0], tablePos, type);
+            writeU32(&pages[0], tablePos + 0x08, pageIndices.first());
+            writeU32(&pages[0], tablePos + 0x0C, pageIndices.last());
+        }
+
+        QByteArray data;
+        for (const auto& page : pages) {
+            data.append(page);
+        }
+        return data;
+    }
+
+  private:
+    struct PendingRow {
+        QByteArray data;
+        bool present;
+    };
+
+    static QByteArray newPage(int index, quint32 type, quint8 flags) {
+        QByteArray page(kPageSize, '\0');
+        writeU32(&page, 0x04, index);
+        writeU32(&page, 0x08, type);
+        writeU32(&page, 0x0C, index + 1);
+        writeU8(&page, 0x1B, flags);
+        return page;
+    }
+
+    QMap<quint32, QList<PendingRow>> m_tables;
+};
+
+QVector<TestTrack> testTracks(int count) {
+    QVector<TestTrack> tracks;
+    tracks.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        tracks.append(TestTrack{
+                static_cast<quint32>(i),
+                static_cast<quint32>(i % 7 + 1),
+                static_cast<quint32>(12000 + i),
+                QStringLiteral("Title %1").arg(i),
+                QStringLiteral("/Contents/Artist %1/Track %2.mp3").arg(i % 7).arg(i)});
+    }
+    return tracks;
+}
+
+QString writePdbFile(const QTemporaryDir& tempDir, const QByteArray& data) {
+    const QString filePath = tempDir.filePath(QStringLiteral("export.pdb"));
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        return QString();
+    }
+    return filePath;
+}
+
+QString createTracksPdbFile(const QTemporaryDir& tempDir, int trackCount) {
+    PdbWriter writer;
+    for (const auto& track : testTracks(trackCount)) {
+        writer.addRow(TableType::Tracks, trackRow(track));
+    }
+    return writePdbFile(tempDir, writer.build());
+}
+
+QString kaitaiText(rekordbox_pdb_t::device_sql_string_t* deviceString) {
+    QString text;
+    if (auto* pShortAscii = dynamic_cast<rekordbox_pdb_t::device_sql_short_ascii_t*>(
+                deviceString->body())) {
+        text = QString::fromStdString(pShortAscii->text());
+    } else if (auto* pLongAscii = dynamic_cast<rekordbox_pdb_t::device_sql_long_ascii_t*>(
+                       deviceString->body())) {
+        text = QString::fromStdString(pLongAscii->text());
+    } else if (auto* pLongUtf16be = dynamic_cast<rekordbox_pdb_t::device_sql_long_utf16be_t*>(
+                       deviceString->body())) {
+        const std::string& bytes = pLongUtf16be->text();
+        text = QTextCodec::codecForName("UTF-16BE")
+                       ->toUnicode(bytes.data(), static_cast<int>(bytes.length()));
+    }
+    return text.remove(QChar('\x0'));
+}
+
+/// Reads the tracks in the same way as RekordboxFeature did before
+/// the introduction of the in-place reader.
+QVector<TestTrack> readTracksKaitai(const QString& filePath) {
+    QVector<TestTrack> tracks;
+    std::ifstream ifs(filePath.toStdString(), std::ifstream::binary);
+    kaitai::kstream ks(&ifs);
+    rekordbox_pdb_t db(&ks);
+    for (auto* table : *db.tables()) {
+        if (table->type() != rekordbox_pdb_t::PAGE_TYPE_TRACKS) {
+            continue;
+        }
+        const uint32_t lastIndex = table->last_page()->index();
+        rekordbox_pdb_t::page_ref_t* currentRef = table->first_page();
+        while (true) {
+            rekordbox_pdb_t::page_t* page = currentRef->body();
+            if (page->is_data_page()) {
+                for (auto* rowGroup : *page->row_groups()) {
+                    for (auto* rowRef : *rowGroup->rows()) {
+                        if (!rowRef->present()) {
+                            continue;
+                        }
+                        auto* track = static_cast<rekordbox_pdb_t::track_row_t*>(
+                                rowRef->body());
+                        tracks.append(TestTrack{
+                                track->id(),
+                                track->artist_id(),
+                                track->tempo(),
+                                kaitaiText(track->title()),
+                                kaitaiText(track->file_path())});
+                    }
+                }
+            }
+            if (currentRef->index() == lastIndex) {
+                break;
+            }
+            currentRef = page->next_page();
+        }
+    }
+    return tracks;
+}
+
+QVector<TestTrack> readTracks(const Reader& reader) {
+    QVector<TestTrack> tracks;
+    reader.forEachRow(TableType::Tracks, [&tracks](const Row& row) {
+        const TrackRow track(row);
+        tracks.append(TestTrack{
+                track.id(),
+                track.artistId(),
+                track.tempo(),
+                track.title(),
+                track.filePath()});
+    });
+    return tracks;
+}
+
+void expectEqualTracks(const QVector<TestTrack>& expected, const QVector<TestTrack>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].id, actual[i].id);
+        EXPECT_EQ(expected[i].artistId, actual[i].artistId);
+        EXPECT_EQ(expected[i].tempo, actual[i].tempo);
+        EXPECT_EQ(expected[i].title, actual[i].title);
+        EXPECT_EQ(expected[i].filePath, actual[i].filePath);
+    }
+}
+
+class RekordboxPdbReaderTest : public testing::Test {
+  protected:
+    const QTemporaryDir m_tempDir;
+};
+
+TEST_F(RekordboxPdbReaderTest, ReadTracks) {
+    // Spans multiple pages and row groups
+    const QVector<TestTrack> tracks = testTracks(500);
+    const QString filePath = createTracksPdbFile(m_tempDir, tracks.size());
+    ASSERT_FALSE(filePath.isEmpty());
+
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    expectEqualTracks(tracks, readTracks(reader));
+}
+
+TEST_F(RekordboxPdbReaderTest, MatchesKaitai) {
+    const QString filePath = createTracksPdbFile(m_tempDir, 500);
+    ASSERT_FALSE(filePath.isEmpty());
+
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    expectEqualTracks(readTracksKaitai(filePath), readTracks(reader));
+}
+
+TEST_F(RekordboxPdbReaderTest, Strings) {
+    const QString longAscii = QString(200, QChar('a'));
+    const QString utf16 = QString::fromUtf8("Ünïcødé ✓");
+    PdbWriter writer;
+    writer.addRow(TableType::Artists, artistRow(1, QStringLiteral("Short")));
+    writer.addRow(TableType::Artists, artistRow(2, longAscii));
+    writer.addRow(TableType::Artists, artistRow(3, utf16));
+    writer.addRow(TableType::Artists,
+            artistRow(4, QStringLiteral("Null") + QChar('\x0') + QStringLiteral("Char")));
+    writer.addRow(TableType::Artists, artistRow(5, QString()));
+    const QString filePath = writePdbFile(m_tempDir, writer.build());
+    ASSERT_FALSE(filePath.isEmpty());
+
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    QMap<quint32, QString> names;
+    EXPECT_TRUE(reader.forEachRow(TableType::Artists, [&names](const Row& row) {
+        const ArtistRow artist(row);
+        names.insert(artist.id(), artist.name());
+    }));
+    ASSERT_EQ(5, names.size());
+    EXPECT_EQ(QStringLiteral("Short"), names.value(1));
+    EXPECT_EQ(longAscii, names.value(2));
+    EXPECT_EQ(utf16, names.value(3));
+    EXPECT_EQ(QStringLiteral("NullChar"), names.value(4));
+    EXPECT_TRUE(names.value(5).isEmpty());
+}
+
+TEST_F(RekordboxPdbReaderTest, SkipDeletedRows) {
+    PdbWriter writer;
+    for (const auto& track : testTracks(40)) {
+        writer.addRow(TableType::Tracks, trackRow(track), track.id % 3 != 0);
+    }
+    const QString filePath = writePdbFile(m_tempDir, writer.build());
+    ASSERT_FALSE(filePath.isEmpty());
+
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    const QVector<TestTrack> tracks = readTracks(reader);
+    EXPECT_EQ(27, tracks.size());
+    for (const auto& track : tracks) {
+        EXPECT_NE(0u, track.id % 3);
+    }
+}
+
+TEST_F(RekordboxPdbReaderTest, Playlists) {
+    PdbWriter writer;
+    writer.addRow(TableType::PlaylistTree,
+            playlistTreeRow(0, 0, 1, true, QStringLiteral("Folder")));
+    writer.addRow(TableType::PlaylistTree,
+            playlistTreeRow(1, 0, 2, false, QStringLiteral("Playlist")));
+    writer.addRow(TableType::PlaylistEntries, playlistEntryRow(1, 42, 2));
+    writer.addRow(TableType::PlaylistEntries, playlistEntryRow(2, 43, 2));
+    const QString filePath = writePdbFile(m_tempDir, writer.build());
+    ASSERT_FALSE(filePath.isEmpty());
+
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    int nodeCount = 0;
+    EXPECT_TRUE(reader.forEachRow(TableType::PlaylistTree, [&nodeCount](const Row& row) {
+        const PlaylistTreeRow node(row);
+        if (node.id() == 1) {
+            EXPECT_EQ(0u, node.parentId());
+            EXPECT_TRUE(node.isFolder());
+            EXPECT_EQ(QStringLiteral("Folder"), node.name());
+        } else {
+            EXPECT_EQ(2u, node.id());
+            EXPECT_EQ(1u, node.parentId());
+            EXPECT_FALSE(node.isFolder());
+            EXPECT_EQ(QStringLiteral("Playlist"), node.name());
+        }
+        ++nodeCount;
+    }));
+    EXPECT_EQ(2, nodeCount);
+
+    QMap<quint32, quint32> entries;
+    EXPECT_TRUE(reader.forEachRow(TableType::PlaylistEntries, [&entries](const Row& row) {
+        const PlaylistEntryRow entry(row);
+        EXPECT_EQ(2u, entry.playlistId());
+        entries.insert(entry.entryIndex(), entry.trackId());
+    }));
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ(42u, entries.value(1));
+    EXPECT_EQ(43u, entries.value(2));
+
+    // Missing tables are empty
+    EXPECT_TRUE(reader.forEachRow(TableType::Tracks, [](const Row&) {
+        ADD_FAILURE();
+    }));
+}
+
+TEST_F(RekordboxPdbReaderTest, CorruptFile) {
+    const QString filePath = createTracksPdbFile(m_tempDir, 100);
+    ASSERT_FALSE(filePath.isEmpty());
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    const QByteArray data = file.readAll();
+
+    // Truncated pages
+    ASSERT_TRUE(file.resize(data.size() - 2 * kPageSize));
+    file.close();
+    Reader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    EXPECT_FALSE(reader.forEachRow(TableType::Tracks, [](const Row&) {}));
+    reader.close();
+
+    // Cyclic page links that never reach the last page
+    QByteArray cyclicData = data;
+    const quint32 firstPage = qFromLittleEndian<quint32>(
+            reinterpret_cast<const uchar*>(cyclicData.constData()) + 0x1C + 0x08);
+    writeU32(&cyclicData, 0x1C + 0x0C, 0xFFFF);
+    writeU32(&cyclicData, (firstPage + 1) * kPageSize + 0x0C, firstPage);
+    ASSERT_FALSE(writePdbFile(m_tempDir, cyclicData).isEmpty());
+    ASSERT_TRUE(reader.open(filePath));
+    EXPECT_FALSE(reader.forEachRow(TableType::Tracks, [](const Row&) {}));
+    reader.close();
+
+    // Invalid header
+    ASSERT_FALSE(writePdbFile(m_tempDir, data.left(16)).isEmpty());
+    EXPECT_FALSE(reader.open(filePath));
+}
+
+static void BM_RekordboxPdbReadTracksKaitai(benchmark::State& state) {
+    const QTemporaryDir tempDir;
+    const QString filePath = createTracksPdbFile(tempDir, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(readTracksKaitai(filePath));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RekordboxPdbReadTracksKaitai)->Range(1024, 16384);
+
+static void BM_RekordboxPdbReadTracks(benchmark::State& state) {
+    const QTemporaryDir tempDir;
+    const QString filePath = createTracksPdbFile(tempDir, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        Reader reader;
+        reader.open(filePath);
+        benchmark::DoNotOptimize(readTracks(reader));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RekordboxPdbReadTracks)->Range(1024, 16384);
+
+} // namespace
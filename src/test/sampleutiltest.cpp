@@ -397,6 +397,75 @@ TEST_F(SampleUtilTest, copyReverse) {
     }
 }
 
+TEST_F(SampleUtilTest, copyStereoToMultiClamp) {
+    constexpr SINT kNumFrames = 37;
+    // 14 is not specialized and uses the generic kernel
+    for (int numChannels : {2, 8, 14, 16}) {
+        std::vector<CSAMPLE> stereo(kNumFrames * 2);
+        for (SINT i = 0; i < kNumFrames; ++i) {
+            stereo[i * 2] = i * 0.1f;
+            stereo[i * 2 + 1] = -i * 0.01f;
+        }
+        std::vector<CSAMPLE> multi(kNumFrames * numChannels, 0.5f);
+        const int channelBase = numChannels - 2;
+        SampleUtil::copyStereoToMultiClamp(
+                &multi[channelBase], stereo.data(), kNumFrames, numChannels);
+
+        for (SINT i = 0; i < kNumFrames; ++i) {
+            for (int channel = 0; channel < channelBase; ++channel) {
+                EXPECT_FLOAT_EQ(0.5f, multi[i * numChannels + channel]);
+            }
+            EXPECT_FLOAT_EQ(SampleUtil::clampSample(i * 0.1f),
+                    multi[i * numChannels + channelBase]);
+            EXPECT_FLOAT_EQ(-i * 0.01f, multi[i * numChannels + channelBase + 1]);
+        }
+    }
+}
+
+TEST_F(SampleUtilTest, mixStereoToMultiMonoClamp) {
+    constexpr SINT kNumFrames = 37;
+    for (int numChannels : {1, 4, 13}) {
+        std::vector<CSAMPLE> stereo(kNumFrames * 2);
+        for (SINT i = 0; i < kNumFrames; ++i) {
+            stereo[i * 2] = i * 0.1f;
+            stereo[i * 2 + 1] = 0.2f;
+        }
+        std::vector<CSAMPLE> multi(kNumFrames * numChannels, 0.5f);
+        SampleUtil::mixStereoToMultiMonoClamp(
+                multi.data(), stereo.data(), kNumFrames, numChannels);
+
+        for (SINT i = 0; i < kNumFrames; ++i) {
+            EXPECT_FLOAT_EQ(SampleUtil::clampSample((i * 0.1f + 0.2f) / 2),
+                    multi[i * numChannels]);
+            for (int channel = 1; channel < numChannels; ++channel) {
+                EXPECT_FLOAT_EQ(0.5f, multi[i * numChannels + channel]);
+            }
+        }
+    }
+}
+
+TEST_F(SampleUtilTest, copyMultiToStereo) {
+    constexpr SINT kNumFrames = 37;
+    for (int numChannels : {4, 14, 24}) {
+        std::vector<CSAMPLE> multi(kNumFrames * numChannels);
+        for (SINT i = 0; i < static_cast<SINT>(multi.size()); ++i) {
+            multi[i] = static_cast<CSAMPLE>(i);
+        }
+        std::vector<CSAMPLE> stereo(kNumFrames * 2);
+        SampleUtil::copyMultiToStereo(
+                stereo.data(), &multi[2], kNumFrames, numChannels);
+        SampleUtil::copyMultiMonoToDualMono(
+                stereo.data(), &multi[3], 1, numChannels);
+
+        EXPECT_FLOAT_EQ(3, stereo[0]);
+        EXPECT_FLOAT_EQ(3, stereo[1]);
+        for (SINT i = 1; i < kNumFrames; ++i) {
+            EXPECT_FLOAT_EQ(i * numChannels + 2, stereo[i * 2]);
+            EXPECT_FLOAT_EQ(i * numChannels + 3, stereo[i * 2 + 1]);
+        }
+    }
+}
+
 static void BM_MemCpy(benchmark::State& state) {
     SINT size = static_cast<SINT>(state.range(0));
     CSAMPLE* buffer = SampleUtil::alloc(size);
@@ -583,4 +652,49 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
 }
 BENCHMARK(BM_Copy2WithRampingGain)->Range(64, 4096);
 
+// Composing a 1024 frame device buffer from stereo outputs that fill
+// all of its channels, like SoundDevice::composeOutputBuffer().
+static void BM_CopyStereoToMultiClamp(benchmark::State& state) {
+    constexpr SINT kNumFrames = 1024;
+    const auto numChannels = static_cast<int>(state.range(0));
+    CSAMPLE* stereo = SampleUtil::alloc(kNumFrames * 2);
+    SampleUtil::fill(stereo, 0.5f, kNumFrames * 2);
+    CSAMPLE* multi = SampleUtil::alloc(kNumFrames * numChannels);
+    SampleUtil::fill(multi, 0.0f, kNumFrames * numChannels);
+
+    while (state.KeepRunning()) {
+        for (int channelBase = 0; channelBase < numChannels; channelBase += 2) {
+            SampleUtil::copyStereoToMultiClamp(
+                    &multi[channelBase], stereo, kNumFrames, numChannels);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(stereo);
+    SampleUtil::free(multi);
+}
+// 14 channels use the generic kernel
+BENCHMARK(BM_CopyStereoToMultiClamp)->Arg(2)->Arg(8)->Arg(14)->Arg(16)->Arg(32);
+
+static void BM_CopyMultiToStereo(benchmark::State& state) {
+    constexpr SINT kNumFrames = 1024;
+    const auto numChannels = static_cast<int>(state.range(0));
+    CSAMPLE* stereo = SampleUtil::alloc(kNumFrames * 2);
+    SampleUtil::fill(stereo, 0.0f, kNumFrames * 2);
+    CSAMPLE* multi = SampleUtil::alloc(kNumFrames * numChannels);
+    SampleUtil::fill(multi, 0.5f, kNumFrames * numChannels);
+
+    while (state.KeepRunning()) {
+        for (int channelBase = 0; channelBase < numChannels; channelBase += 2) {
+            SampleUtil::copyMultiToStereo(
+                    stereo, &multi[channelBase], kNumFrames, numChannels);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(stereo);
+    SampleUtil::free(multi);
+}
+BENCHMARK(BM_CopyMultiToStereo)->Arg(8)->Arg(14)->Arg(16)->Arg(32);
+
 }  // namespace
@@ -0,0 +1,271 @@
+#ifdef __BROADCAST__
+
+#include <gtest/gtest.h>
+
+#include <QVector>
+
+#include "encoder/sharedencoder.h"
+#include "engine/engine.h"
+#include "recording/defs_recording.h"
+
+namespace {
+
+constexpr mixxx::audio::SampleRate kSampleRate(44100);
+
+class TestEncoderSettings : public EncoderSettings {
+  public:
+    explicit TestEncoderSettings(QString format)
+            : m_format(std::move(format)) {
+    }
+
+    QString getFormat() const override {
+        return m_format;
+    }
+
+  private:
+    const QString m_format;
+};
+
+// Passes each buffer unmodified as a single packet
+class PassThroughEncoder : public Encoder {
+  public:
+    explicit PassThroughEncoder(EncoderCallback* pCallback)
+            : m_pCallback(pCallback) {
+    }
+
+    int initEncoder(mixxx::audio::SampleRate sampleRate, QString* pUserErrorMessage) override {
+        Q_UNUSED(sampleRate);
+        Q_UNUSED(pUserErrorMessage);
+        return 0;
+    }
+    void encodeBuffer(const CSAMPLE* samples, const int size) override {
+        m_pCallback->write(nullptr,
+                reinterpret_cast<const unsigned char*>(samples),
+                0,
+                size * static_cast<int>(sizeof(CSAMPLE)));
+    }
+    void updateMetaData(const QString&, const QString&, const QString&) override {
+    }
+    void flush() override {
+    }
+    void setEncoderSettings(const EncoderSettings&) override {
+    }
+
+  private:
+    EncoderCallback* const m_pCallback;
+};
+
+// Collects the samples of all packets
+class TestSubscriber : public EncoderCallback {
+  public:
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override {
+        Q_UNUSED(header);
+        Q_UNUSED(headerLen);
+        const auto* pSamples = reinterpret_cast<const CSAMPLE*>(body);
+        for (int i = 0; i < bodyLen / static_cast<int>(sizeof(CSAMPLE)); ++i) {
+            m_samples.append(pSamples[i]);
+        }
+        ++m_packets;
+    }
+    int tell() override {
+        return -1;
+    }
+    void seek(int) override {
+    }
+    int filelen() override {
+        return 0;
+    }
+
+    QVector<CSAMPLE> m_samples;
+    int m_packets = 0;
+};
+
+// Consecutive sample values, i.e. each value identifies a position
+// of the stream
+QVector<CSAMPLE> streamSamples(int first, int count) {
+    QVector<CSAMPLE> samples(count);
+    for (int i = 0; i < count; ++i) {
+        samples[i] = static_cast<CSAMPLE>(first + i);
+    }
+    return samples;
+}
+
+class SharedEncoderTest : public testing::Test {
+  protected:
+    SharedEncoderTest()
+            : m_pool([this](const EncoderSettingsPointer&, EncoderCallback* pCallback) {
+                  ++m_createdEncoders;
+                  return std::make_shared<PassThroughEncoder>(pCallback);
+              }) {
+    }
+
+    SharedEncoderPointer acquire(const QString& format, EncoderCallback* pSubscriber) {
+        QString errorMessage;
+        return m_pool.acquire(std::make_shared<TestEncoderSettings>(format),
+                kSampleRate,
+                pSubscriber,
+                &errorMessage);
+    }
+
+    static void encode(const SharedEncoderPointer& pEncoder,
+            EncoderCallback* pSubscriber,
+            const QVector<CSAMPLE>& samples) {
+        pEncoder->encodeBuffer(pSubscriber, samples.constData(), samples.size());
+    }
+
+    int m_createdEncoders = 0;
+    SharedEncoderPool m_pool;
+};
+
+TEST_F(SharedEncoderTest, SubscribeAndUnsubscribe) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pFirstEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    auto pSecondEncoder = acquire(QStringLiteral(ENCODING_MP3), &second);
+    ASSERT_TRUE(pFirstEncoder);
+    EXPECT_EQ(pFirstEncoder, pSecondEncoder);
+    EXPECT_EQ(1, m_createdEncoders);
+    EXPECT_EQ(2, pFirstEncoder->numSubscribers());
+
+    pSecondEncoder->unsubscribe(&second);
+    pSecondEncoder.reset();
+    EXPECT_EQ(1, pFirstEncoder->numSubscribers());
+
+    // Released by all subscribers
+    pFirstEncoder->unsubscribe(&first);
+    pFirstEncoder.reset();
+    auto pThirdEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    EXPECT_EQ(2, m_createdEncoders);
+    pThirdEncoder->unsubscribe(&first);
+}
+
+TEST_F(SharedEncoderTest, OggIsNotShared) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pFirstEncoder = acquire(QStringLiteral(ENCODING_OGG), &first);
+    auto pSecondEncoder = acquire(QStringLiteral(ENCODING_OGG), &second);
+    EXPECT_NE(pFirstEncoder, pSecondEncoder);
+    EXPECT_EQ(2, m_createdEncoders);
+    pFirstEncoder->unsubscribe(&first);
+    pSecondEncoder->unsubscribe(&second);
+}
+
+TEST_F(SharedEncoderTest, FanOut) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    acquire(QStringLiteral(ENCODING_MP3), &second);
+
+    // Both connections pass the same audio, which is encoded only once
+    const auto samples = streamSamples(0, 1024);
+    encode(pEncoder, &first, samples);
+    encode(pEncoder, &second, samples);
+    pEncoder->deliver(&first);
+    pEncoder->deliver(&second);
+
+    EXPECT_EQ(samples, first.m_samples);
+    EXPECT_EQ(samples, second.m_samples);
+    EXPECT_EQ(1, first.m_packets);
+    EXPECT_EQ(1, second.m_packets);
+
+    pEncoder->unsubscribe(&first);
+    pEncoder->unsubscribe(&second);
+}
+
+TEST_F(SharedEncoderTest, StreamIsContinuousAfterOverflow) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    acquire(QStringLiteral(ENCODING_MP3), &second);
+
+    encode(pEncoder, &first, streamSamples(0, 1024));
+    encode(pEncoder, &second, streamSamples(0, 1024));
+    // The FIFO of the second connection has overflowed and lost samples,
+    // so it passes the following audio earlier than the first connection
+    encode(pEncoder, &second, streamSamples(1536, 1024));
+    encode(pEncoder, &first, streamSamples(1024, 1024));
+    encode(pEncoder, &first, streamSamples(2048, 1024));
+    encode(pEncoder, &second, streamSamples(2560, 1024));
+    pEncoder->deliver(&first);
+    pEncoder->deliver(&second);
+
+    // Neither repeated nor dropped audio
+    const auto expectedSamples = streamSamples(0, 3072);
+    EXPECT_EQ(expectedSamples, first.m_samples);
+    EXPECT_EQ(expectedSamples, second.m_samples);
+
+    pEncoder->unsubscribe(&first);
+    pEncoder->unsubscribe(&second);
+}
+
+TEST_F(SharedEncoderTest, TakeOverFromStalledSubscriber) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    acquire(QStringLiteral(ENCODING_MP3), &second);
+
+    encode(pEncoder, &first, streamSamples(0, 1024));
+    // The first connection stops passing audio, e.g. while reconnecting
+    const int timeoutSamples = kSampleRate.value() * mixxx::kEngineChannelCount *
+            SharedEncoder::kLeaderTimeoutSeconds;
+    encode(pEncoder, &second, streamSamples(0, timeoutSamples - 1));
+    pEncoder->deliver(&second);
+    EXPECT_EQ(streamSamples(0, 1024), second.m_samples);
+
+    encode(pEncoder, &second, streamSamples(timeoutSamples - 1, 1024));
+    pEncoder->deliver(&second);
+    EXPECT_EQ(2, second.m_packets);
+    EXPECT_EQ(static_cast<CSAMPLE>(timeoutSamples - 1), second.m_samples.at(1024));
+
+    // The first connection is now ignored
+    encode(pEncoder, &first, streamSamples(1024, 1024));
+    pEncoder->deliver(&first);
+    EXPECT_EQ(2, first.m_packets);
+
+    pEncoder->unsubscribe(&first);
+    pEncoder->unsubscribe(&second);
+}
+
+TEST_F(SharedEncoderTest, UnsubscribedLeaderIsReplaced) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    acquire(QStringLiteral(ENCODING_MP3), &second);
+
+    encode(pEncoder, &first, streamSamples(0, 1024));
+    pEncoder->unsubscribe(&first);
+    encode(pEncoder, &second, streamSamples(1024, 1024));
+    pEncoder->deliver(&second);
+    EXPECT_EQ(streamSamples(0, 2048), second.m_samples);
+
+    pEncoder->unsubscribe(&second);
+}
+
+TEST_F(SharedEncoderTest, DropPacketsOfStalledSubscriber) {
+    TestSubscriber first;
+    TestSubscriber second;
+    auto pEncoder = acquire(QStringLiteral(ENCODING_MP3), &first);
+    acquire(QStringLiteral(ENCODING_MP3), &second);
+
+    // The second connection does not deliver its packets
+    for (int i = 0; i < SharedEncoder::kMaxPendingPackets + 1; ++i) {
+        encode(pEncoder, &first, streamSamples(i, 1));
+        pEncoder->deliver(&first);
+    }
+    pEncoder->deliver(&second);
+
+    EXPECT_EQ(SharedEncoder::kMaxPendingPackets + 1, first.m_packets);
+    // Only the oldest packet has been dropped
+    EXPECT_EQ(SharedEncoder::kMaxPendingPackets, second.m_packets);
+    EXPECT_EQ(streamSamples(1, SharedEncoder::kMaxPendingPackets), second.m_samples);
+
+    pEncoder->unsubscribe(&first);
+    pEncoder->unsubscribe(&second);
+}
+
+} // anonymous namespace
+
+#endif // __BROADCAST__
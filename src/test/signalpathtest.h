@@ -23,6 +23,7 @@
 #include "preferences/usersettings.h"
 #include "test/mixxxtest.h"
 #include "test/soundsourceproviderregistration.h"
+#include "test/testenginemaster.h"
 #include "track/track.h"
 #include "util/defs.h"
 #include "util/memory.h"
@@ -46,30 +47,6 @@ using ::testing::_;
         EXPECT_FRAMEPOS_EQ(position, controlPos);                        \
     }
 
-// Subclass of EngineMaster that provides access to the master buffer object
-// for comparison.
-class TestEngineMaster : public EngineMaster {
-  public:
-    TestEngineMaster(UserSettingsPointer _config,
-            const QString& group,
-            EffectsManager* pEffectsManager,
-            ChannelHandleFactoryPointer pChannelHandleFactory,
-            bool bEnableSidechain)
-            : EngineMaster(_config,
-                      group,
-                      pEffectsManager,
-                      pChannelHandleFactory,
-                      bEnableSidechain) {
-        m_pMasterEnabled->forceSet(1);
-        m_pHeadphoneEnabled->forceSet(1);
-        m_pBoothEnabled->forceSet(1);
-    }
-
-    CSAMPLE* masterBuffer() {
-        return m_pMaster;
-    }
-};
-
 class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
   protected:
     BaseSignalPathTest() {
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "util/stat.h"
+
+TEST(StatTagTest, Interning) {
+    const StatTag invalid;
+    EXPECT_FALSE(invalid.isValid());
+
+    const StatTag tag1(QStringLiteral("StatTagTest tag1"));
+    const StatTag tag2(QStringLiteral("StatTagTest tag2"));
+    ASSERT_TRUE(tag1.isValid());
+    ASSERT_TRUE(tag2.isValid());
+    EXPECT_NE(tag1.id(), tag2.id());
+
+    // The same name always maps onto the same id
+    EXPECT_EQ(tag1.id(), StatTag(QStringLiteral("StatTagTest tag1")).id());
+    EXPECT_EQ(tag1.id(), StatTag::fromId(tag1.id()).id());
+
+    EXPECT_EQ(QStringLiteral("StatTagTest tag1"), tag1.name());
+    EXPECT_EQ(QStringLiteral("StatTagTest tag2"), StatTag::nameOf(tag2.id()));
+    EXPECT_TRUE(invalid.name().isNull());
+}
+
+TEST(StatTagTest, ReportIsPlainRecord) {
+    StatReport report;
+    report.tagId = StatTag(QStringLiteral("StatTagTest report")).id();
+    report.type = Stat::EVENT_START;
+    report.compute = Stat::COUNT;
+    report.time = 1;
+    report.value = 0.0;
+    // Copying a report must not share or allocate any memory
+    StatReport copy;
+    std::memcpy(&copy, &report, sizeof(StatReport));
+    EXPECT_EQ(report.tagId, copy.tagId);
+    EXPECT_EQ(QStringLiteral("StatTagTest report"), StatTag::nameOf(copy.tagId));
+}
+
+static void BM_StatTagIntern(benchmark::State& state) {
+    const QString name = QStringLiteral("BM_StatTagIntern");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StatTag(name).id());
+    }
+}
+BENCHMARK(BM_StatTagIntern);
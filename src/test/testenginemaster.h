@@ -0,0 +1,27 @@
+#pragma once
+
+#include "engine/enginemaster.h"
+
+// Subclass of EngineMaster that provides access to the master buffer object
+// for comparison.
+class TestEngineMaster : public EngineMaster {
+  public:
+    TestEngineMaster(UserSettingsPointer _config,
+            const QString& group,
+            EffectsManager* pEffectsManager,
+            ChannelHandleFactoryPointer pChannelHandleFactory,
+            bool bEnableSidechain)
+            : EngineMaster(_config,
+                      group,
+                      pEffectsManager,
+                      pChannelHandleFactory,
+                      bEnableSidechain) {
+        m_pMasterEnabled->forceSet(1);
+        m_pHeadphoneEnabled->forceSet(1);
+        m_pBoothEnabled->forceSet(1);
+    }
+
+    CSAMPLE* masterBuffer() {
+        return m_pMaster;
+    }
+};
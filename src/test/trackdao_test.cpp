@@ -56,3 +56,56 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getTracksByIds) {
+    const QDir dir(QDir::tempPath() + QStringLiteral("/batch"));
+    QList<TrackId> trackIds;
+    for (int i = 0; i < 3; ++i) {
+        TrackPointer pTrack = Track::newTemporary(mixxx::FileAccess(
+                mixxx::FileInfo(dir, QStringLiteral("file%1.mp3").arg(i))));
+        pTrack->setTitle(QStringLiteral("Title %1").arg(i));
+        trackIds.append(internalCollection()->addTrack(pTrack, false));
+        ASSERT_TRUE(trackIds.last().isValid());
+    }
+
+    // Two hot cues with the same number, only the last one is loaded
+    QSqlQuery query(dbConnection());
+    query.prepare(QStringLiteral(
+            "INSERT INTO cues (track_id, type, position, hotcue) "
+            "VALUES (:track_id, 1, :position, :hotcue)"));
+    const auto insertHotCue = [&](TrackId trackId, int position, int hotCue) {
+        query.bindValue(":track_id", trackId.toVariant());
+        query.bindValue(":position", position);
+        query.bindValue(":hotcue", hotCue);
+        ASSERT_TRUE(query.exec());
+    };
+    insertHotCue(trackIds[0], 100, 0);
+    insertHotCue(trackIds[0], 200, 1);
+    insertHotCue(trackIds[0], 300, 1);
+    insertHotCue(trackIds[2], 400, 0);
+
+    const TrackPointerList tracks = trackCollectionManager()->getTracksByIds(
+            {trackIds[2], TrackId(), trackIds[0], TrackId(12345), trackIds[2]});
+    ASSERT_EQ(5, tracks.size());
+    ASSERT_TRUE(tracks[0]);
+    EXPECT_FALSE(tracks[1]);
+    ASSERT_TRUE(tracks[2]);
+    EXPECT_FALSE(tracks[3]);
+    EXPECT_EQ(tracks[0], tracks[4]);
+
+    EXPECT_EQ(trackIds[2], tracks[0]->getId());
+    EXPECT_EQ(QStringLiteral("Title 2"), tracks[0]->getTitle());
+    EXPECT_EQ(1, tracks[0]->getCuePoints().size());
+    EXPECT_EQ(trackIds[0], tracks[2]->getId());
+    EXPECT_EQ(QStringLiteral("Title 0"), tracks[2]->getTitle());
+    EXPECT_EQ(2, tracks[2]->getCuePoints().size());
+
+    // Loaded tracks are cached and cached tracks are reused
+    EXPECT_EQ(tracks[2], trackCollectionManager()->getTrackById(trackIds[0]));
+    const TrackPointerList cachedTracks =
+            trackCollectionManager()->getTracksByIds({trackIds[0], trackIds[1]});
+    ASSERT_EQ(2, cachedTracks.size());
+    EXPECT_EQ(tracks[2], cachedTracks[0]);
+    ASSERT_TRUE(cachedTracks[1]);
+    EXPECT_EQ(QStringLiteral("Title 1"), cachedTracks[1]->getTitle());
+}
@@ -300,3 +300,42 @@ TEST_F(TrackExporterTest, MungeFilename) {
     // Remove the track we created.
     tempPath.remove("cover-test.ogg");
 }
+
+TEST_F(TrackExporterTest, LargeFileExport) {
+    // Files larger than the copy buffer must be copied completely.
+    QTemporaryDir sourceDir;
+    ASSERT_TRUE(sourceDir.isValid());
+    QByteArray content;
+    content.reserve(3 * 1024 * 1024 + 17);
+    while (content.size() < 3 * 1024 * 1024 + 17) {
+        content.append(static_cast<char>(content.size() % 251));
+    }
+    QFile sourceFile(QDir(sourceDir.path()).filePath("large.wav"));
+    ASSERT_TRUE(sourceFile.open(QIODevice::WriteOnly));
+    ASSERT_EQ(content.size(), sourceFile.write(content));
+    sourceFile.close();
+    TrackPointer track(Track::newTemporary(
+            mixxx::FileAccess(mixxx::FileInfo(sourceFile))));
+
+    TrackPointerList tracks;
+    tracks.append(track);
+    TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
+    m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+    double bytesPerSecond = 0;
+    QObject::connect(&worker,
+            &TrackExportWorker::throughput,
+            [&bytesPerSecond](double bytes, double) {
+                bytesPerSecond = bytes;
+            });
+
+    worker.run();
+    EXPECT_TRUE(worker.wait(10000));
+
+    EXPECT_EQ(1, m_answerer->currentProgress());
+    EXPECT_EQ(1, m_answerer->currentProgressCount());
+    EXPECT_GT(bytesPerSecond, 0);
+
+    QFile exportedFile(m_exportDir.filePath("large.wav"));
+    ASSERT_TRUE(exportedFile.open(QIODevice::ReadOnly));
+    EXPECT_EQ(content, exportedFile.readAll());
+}
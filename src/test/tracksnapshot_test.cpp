@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include "track/keyutils.h"
+#include "track/track.h"
+
+namespace {
+
+TrackPointer newTestTrack() {
+    auto pTrack = Track::newTemporary();
+    pTrack->setAudioProperties(
+            mixxx::audio::ChannelCount(2),
+            mixxx::audio::SampleRate(44100),
+            mixxx::audio::Bitrate(320),
+            mixxx::Duration::fromSeconds(180));
+    return pTrack;
+}
+
+class TrackSnapshotTest : public testing::Test {
+  protected:
+    TrackSnapshotTest()
+            : m_pTrack(newTestTrack()) {
+    }
+
+    const TrackPointer m_pTrack;
+};
+
+TEST_F(TrackSnapshotTest, ReflectsModifications) {
+    EXPECT_EQ(180.0, m_pTrack->getDuration());
+    EXPECT_EQ(180.0,
+            m_pTrack->getRecordSnapshot()
+                    ->getMetadata()
+                    .getStreamInfo()
+                    .getDuration()
+                    .toDoubleSeconds());
+
+    ASSERT_TRUE(m_pTrack->trySetBpm(128.0));
+    EXPECT_EQ(128.0, m_pTrack->getBpm());
+
+    m_pTrack->setKey(mixxx::track::io::key::A_MINOR, mixxx::track::io::key::USER);
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, m_pTrack->getKey());
+    EXPECT_EQ(KeyUtils::getGlobalKeyText(m_pTrack->getKeys()),
+            m_pTrack->getKeyText());
+
+    mixxx::ReplayGain replayGain;
+    replayGain.setRatio(0.5);
+    m_pTrack->setReplayGain(replayGain);
+    EXPECT_EQ(replayGain, m_pTrack->getReplayGain());
+
+    m_pTrack->setTitle(QStringLiteral("Title"));
+    const auto pSnapshot = m_pTrack->getRecordSnapshot();
+    EXPECT_EQ(QStringLiteral("Title"), pSnapshot->getMetadata().getTrackInfo().getTitle());
+    EXPECT_EQ(128.0, pSnapshot->getMetadata().getTrackInfo().getBpm().value());
+    EXPECT_EQ(m_pTrack->getRecord(), *pSnapshot);
+}
+
+TEST_F(TrackSnapshotTest, IsImmutable) {
+    m_pTrack->setTitle(QStringLiteral("Before"));
+    const auto pBefore = m_pTrack->getRecordSnapshot();
+
+    m_pTrack->setTitle(QStringLiteral("After"));
+    ASSERT_TRUE(m_pTrack->trySetBpm(100.0));
+    const auto pAfter = m_pTrack->getRecordSnapshot();
+
+    EXPECT_NE(pBefore, pAfter);
+    EXPECT_EQ(QStringLiteral("Before"), pBefore->getMetadata().getTrackInfo().getTitle());
+    EXPECT_FALSE(pBefore->getMetadata().getTrackInfo().getBpm().isValid());
+    EXPECT_EQ(QStringLiteral("After"), pAfter->getMetadata().getTrackInfo().getTitle());
+
+    // The snapshot is shared until the track is modified
+    EXPECT_EQ(pAfter, m_pTrack->getRecordSnapshot());
+    m_pTrack->markClean();
+    EXPECT_EQ(pAfter, m_pTrack->getRecordSnapshot());
+    m_pTrack->setTitle(QStringLiteral("Again"));
+    EXPECT_NE(pAfter, m_pTrack->getRecordSnapshot());
+}
+
+TEST_F(TrackSnapshotTest, ReplaceRecord) {
+    auto record = m_pTrack->getRecord();
+    record.refMetadata().refTrackInfo().setArtist(QStringLiteral("Artist"));
+    record.setRating(3);
+    ASSERT_TRUE(m_pTrack->replaceRecord(std::move(record)));
+
+    const auto pSnapshot = m_pTrack->getRecordSnapshot();
+    EXPECT_EQ(QStringLiteral("Artist"), pSnapshot->getMetadata().getTrackInfo().getArtist());
+    EXPECT_EQ(3, pSnapshot->getRating());
+    EXPECT_TRUE(m_pTrack->isDirty());
+}
+
+TEST_F(TrackSnapshotTest, ReplaceRecordUpdatesLockFreeGetters) {
+    auto record = m_pTrack->getRecord();
+    record.refMetadata().refTrackInfo().setBpm(mixxx::Bpm(140.0));
+    record.updateGlobalKey(mixxx::track::io::key::C_MAJOR, mixxx::track::io::key::USER);
+    ASSERT_TRUE(m_pTrack->replaceRecord(std::move(record)));
+
+    EXPECT_EQ(140.0, m_pTrack->getBpm());
+    EXPECT_EQ(mixxx::track::io::key::C_MAJOR, m_pTrack->getKey());
+    EXPECT_EQ(180.0, m_pTrack->getDuration());
+    EXPECT_EQ(180, m_pTrack->getDurationSecondsInt());
+}
+
+// Multiple threads read two properties of the same track while the first
+// thread also modifies it now and then. Compares the lock-free getters of
+// BPM and duration (Arg 0) with getters that lock the track once per
+// property (Arg 1) and with reading both properties from a shared
+// snapshot (Arg 2).
+static void BM_TrackGetterContention(benchmark::State& state) {
+    static TrackPointer s_pTrack;
+    if (state.thread_index() == 0) {
+        s_pTrack = newTestTrack();
+        s_pTrack->trySetBpm(120.0);
+    }
+    int iteration = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0 && ++iteration % 64 == 0) {
+            s_pTrack->setRating(iteration % 5);
+        }
+        switch (state.range(0)) {
+        case 0:
+            benchmark::DoNotOptimize(s_pTrack->getBpm());
+            benchmark::DoNotOptimize(s_pTrack->getDuration());
+            break;
+        case 1:
+            benchmark::DoNotOptimize(s_pTrack->getRating());
+            benchmark::DoNotOptimize(s_pTrack->getBitrate());
+            break;
+        default: {
+            const auto pSnapshot = s_pTrack->getRecordSnapshot();
+            benchmark::DoNotOptimize(pSnapshot->getMetadata().getTrackInfo().getBpm());
+            benchmark::DoNotOptimize(pSnapshot->getMetadata().getStreamInfo().getDuration());
+        }
+        }
+    }
+    if (state.thread_index() == 0) {
+        s_pTrack.reset();
+    }
+}
+BENCHMARK(BM_TrackGetterContention)
+        ->Arg(0)
+        ->Arg(1)
+        ->Arg(2)
+        ->ThreadRange(1, 8)
+        ->UseRealTime();
+
+} // anonymous namespace
@@ -0,0 +1,204 @@
+#include "waveform/renderers/waveformrenderbeat.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDomDocument>
+#include <QImage>
+#include <QPainter>
+#include <memory>
+
+#include "preferences/usersettings.h"
+#include "skin/legacy/skincontext.h"
+#include "track/beats.h"
+#include "track/track.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 100;
+constexpr int kSampleRate = 44100;
+constexpr int kTrackSeconds = 180;
+constexpr int kTrackSamples = kSampleRate * kTrackSeconds * 2;
+constexpr double kBpm = 120.0;
+constexpr double kSamplesPerBeat = 60.0 / kBpm * kSampleRate * 2;
+
+/// Renders without a widget. The view is set directly instead of being
+/// derived from the play position at the next VSync.
+class OffscreenWaveformRenderer : public WaveformWidgetRenderer {
+  public:
+    OffscreenWaveformRenderer()
+            : WaveformWidgetRenderer(QStringLiteral("[Test]")) {
+        m_trackSamples = kTrackSamples;
+        resize(kWidth, kHeight, 1.0f);
+    }
+
+    void setView(double pixelsPerBeat, double playPos) {
+        m_trackPixelCount = kTrackSamples / kSamplesPerBeat * pixelsPerBeat;
+        m_playPos = playPos;
+        const double displayedLength = getLength() / m_trackPixelCount;
+        m_firstDisplayedPosition = playPos - displayedLength * m_playMarkerPosition;
+        m_lastDisplayedPosition = playPos + displayedLength * (1.0 - m_playMarkerPosition);
+    }
+};
+
+TrackPointer newTrack(double bpm) {
+    TrackPointer pTrack = Track::newTemporary();
+    pTrack->setAudioProperties(
+            mixxx::audio::ChannelCount(2),
+            mixxx::audio::SampleRate(kSampleRate),
+            mixxx::audio::Bitrate(),
+            mixxx::Duration::fromSeconds(kTrackSeconds));
+    pTrack->trySetBeats(mixxx::Beats::fromConstTempo(pTrack->getSampleRate(),
+            mixxx::audio::kStartFramePos,
+            mixxx::Bpm(bpm)));
+    return pTrack;
+}
+
+class WaveformRenderBeatFixture {
+  public:
+    WaveformRenderBeatFixture()
+            : m_pConfig(new UserSettings(QString())),
+              m_pRenderBeat(m_renderer.addRenderer<WaveformRenderBeat>()),
+              m_image(kWidth, kHeight, QImage::Format_ARGB32_Premultiplied) {
+        QDomDocument document;
+        QDomElement node = document.createElement(QStringLiteral("Waveform"));
+        QDomElement color = document.createElement(QStringLiteral("BeatColor"));
+        color.appendChild(document.createTextNode(QStringLiteral("#ffffff")));
+        node.appendChild(color);
+        SkinContext context(m_pConfig, QString());
+        m_pRenderBeat->setup(node, context);
+    }
+
+    void setTrack(TrackPointer pTrack) {
+        m_renderer.setTrack(pTrack);
+    }
+
+    void setView(double pixelsPerBeat, double playPos) {
+        m_renderer.setView(pixelsPerBeat, playPos);
+    }
+
+    const QImage& draw() {
+        m_image.fill(Qt::transparent);
+        QPainter painter(&m_image);
+        m_pRenderBeat->draw(&painter, nullptr);
+        return m_image;
+    }
+
+    /// The visible beats in the renderer world, including those before the
+    /// start and after the end of the track
+    QVector<int> expectedBeats(double samplesPerBeat = kSamplesPerBeat) const {
+        QVector<int> beats;
+        for (double beat = -kTrackSamples; beat < 2 * kTrackSamples;
+                beat += samplesPerBeat) {
+            const double x = m_renderer.transformSamplePositionInRendererWorld(beat);
+            if (x >= 0 && x <= kWidth) {
+                beats.append(qRound(x));
+            }
+        }
+        return beats;
+    }
+
+  private:
+    UserSettingsPointer m_pConfig;
+    OffscreenWaveformRenderer m_renderer;
+    WaveformRenderBeat* m_pRenderBeat;
+    QImage m_image;
+};
+
+bool isPainted(const QImage& image, int x) {
+    if (x < 0 || x >= image.width()) {
+        return false;
+    }
+    return qAlpha(image.pixel(x, image.height() / 2)) > 0;
+}
+
+/// A line on a pixel boundary is antialiased into the pixels on both sides
+void expectBeatsAt(const QImage& image, const QVector<int>& beats) {
+    ASSERT_FALSE(beats.isEmpty());
+    for (int x : beats) {
+        EXPECT_TRUE(isPainted(image, x - 1) || isPainted(image, x)) << x;
+    }
+    int paintedColumns = 0;
+    for (int x = 0; x < image.width(); ++x) {
+        if (isPainted(image, x)) {
+            ++paintedColumns;
+        }
+    }
+    EXPECT_LE(paintedColumns, 2 * beats.size());
+}
+
+class WaveformRenderBeatTest : public testing::Test, public WaveformRenderBeatFixture {
+};
+
+TEST_F(WaveformRenderBeatTest, DrawsVisibleBeats) {
+    setTrack(newTrack(kBpm));
+    setView(50, 0.5);
+    expectBeatsAt(draw(), expectedBeats());
+}
+
+TEST_F(WaveformRenderBeatTest, DrawsBeatsBeforeTrackStart) {
+    setTrack(newTrack(kBpm));
+    setView(50, 0.0);
+    const QVector<int> beats = expectedBeats();
+    expectBeatsAt(draw(), beats);
+    // The track starts at the play position in the center
+    EXPECT_LT(beats.first(), kWidth / 2);
+}
+
+TEST_F(WaveformRenderBeatTest, FollowsScrolling) {
+    setTrack(newTrack(kBpm));
+    for (int pixel = 0; pixel < 100; pixel += 7) {
+        setView(50, 0.5 + pixel * kSamplesPerBeat / 50 / kTrackSamples);
+        expectBeatsAt(draw(), expectedBeats());
+    }
+}
+
+TEST_F(WaveformRenderBeatTest, FollowsZoom) {
+    setTrack(newTrack(kBpm));
+    setView(50, 0.5);
+    expectBeatsAt(draw(), expectedBeats());
+    setView(23.7, 0.5);
+    expectBeatsAt(draw(), expectedBeats());
+}
+
+TEST_F(WaveformRenderBeatTest, FollowsBeats) {
+    TrackPointer pTrack = newTrack(kBpm);
+    setTrack(pTrack);
+    setView(50, 0.5);
+    expectBeatsAt(draw(), expectedBeats());
+    pTrack->trySetBeats(mixxx::Beats::fromConstTempo(pTrack->getSampleRate(),
+            mixxx::audio::kStartFramePos,
+            mixxx::Bpm(kBpm / 2)));
+    expectBeatsAt(draw(), expectedBeats(2 * kSamplesPerBeat));
+}
+
+static void BM_WaveformRenderBeatScrolling(benchmark::State& state) {
+    WaveformRenderBeatFixture fixture;
+    fixture.setTrack(newTrack(kBpm));
+    const double pixelsPerBeat = static_cast<double>(state.range(0));
+    const double positionPerPixel = kSamplesPerBeat / pixelsPerBeat / kTrackSamples;
+    int pixel = 0;
+    for (auto _ : state) {
+        fixture.setView(pixelsPerBeat, 0.25 + pixel * positionPerPixel);
+        benchmark::DoNotOptimize(fixture.draw().constBits());
+        pixel = (pixel + 1) % 10000;
+    }
+}
+BENCHMARK(BM_WaveformRenderBeatScrolling)->Range(4, 64);
+
+static void BM_WaveformRenderBeatZooming(benchmark::State& state) {
+    WaveformRenderBeatFixture fixture;
+    fixture.setTrack(newTrack(kBpm));
+    const double pixelsPerBeat = static_cast<double>(state.range(0));
+    int step = 0;
+    for (auto _ : state) {
+        fixture.setView(pixelsPerBeat * (1.0 + 0.001 * step), 0.25);
+        benchmark::DoNotOptimize(fixture.draw().constBits());
+        step = (step + 1) % 1000;
+    }
+}
+BENCHMARK(BM_WaveformRenderBeatZooming)->Range(4, 64);
+
+} // anonymous namespace
@@ -1,5 +1,6 @@
 #include "track/beats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <vector>
@@ -72,9 +73,17 @@ Beats::ConstIterator Beats::ConstIterator::operator+=(Beats::ConstIterator::diff
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
-        m_beatOffset -= m_it->beatsTillNextMarker();
-        m_it++;
+    if (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
+        // Find the last marker at or before the beat
+        const auto& markerBeatIndices = m_beats->m_markerBeatIndices;
+        const qint64 beatIndex = m_beats->beatIndex(m_it, m_beatOffset);
+        const auto markerIndex = m_it - m_beats->m_markers.cbegin();
+        const auto indexIt = std::prev(std::upper_bound(
+                markerBeatIndices.cbegin() + markerIndex + 1,
+                markerBeatIndices.cend(),
+                beatIndex));
+        m_it = m_beats->m_markers.cbegin() + (indexIt - markerBeatIndices.cbegin());
+        m_beatOffset = static_cast<int>(beatIndex - *indexIt);
     }
     updateValue();
     return *this;
@@ -115,9 +124,19 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
-        m_it--;
-        m_beatOffset += m_it->beatsTillNextMarker();
+    if (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
+        // Find the last marker at or before the beat, if any
+        const auto& markerBeatIndices = m_beats->m_markerBeatIndices;
+        const qint64 beatIndex = m_beats->beatIndex(m_it, m_beatOffset);
+        const auto markerIndex = m_it - m_beats->m_markers.cbegin();
+        auto indexIt = std::upper_bound(markerBeatIndices.cbegin(),
+                markerBeatIndices.cbegin() + markerIndex,
+                beatIndex);
+        if (indexIt != markerBeatIndices.cbegin()) {
+            indexIt--;
+        }
+        m_it = m_beats->m_markers.cbegin() + (indexIt - markerBeatIndices.cbegin());
+        m_beatOffset = static_cast<int>(beatIndex - *indexIt);
     }
     updateValue();
     return *this;
@@ -125,23 +144,11 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
 
 Beats::ConstIterator::difference_type Beats::ConstIterator::operator-(
         const Beats::ConstIterator& other) const {
-    const int vectorItDiff = m_it - other.m_it;
-    if (vectorItDiff == 0) {
+    if (m_it == other.m_it) {
         return m_beatOffset - other.m_beatOffset;
     }
-
-    if (vectorItDiff > 0) {
-        return -(other - *this);
-    }
-
-    auto it = m_it;
-    int result = -m_beatOffset + other.m_beatOffset;
-    while (it != m_beats->m_markers.cend() && it != other.m_it) {
-        result += it->beatsTillNextMarker();
-        it++;
-    }
-    DEBUG_ASSERT(it == other.m_it);
-    return -result;
+    return static_cast<difference_type>(m_beats->beatIndex(m_it, m_beatOffset) -
+            m_beats->beatIndex(other.m_it, other.m_beatOffset));
 }
 
 void Beats::ConstIterator::updateValue() {
@@ -443,8 +450,30 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
             return cbegin();
         }
         it -= static_cast<int>(n);
+    } else if (position == m_lastMarkerPosition) {
+        it = clastmarker();
     } else {
-        it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+        // Lookup position is inside the section of a marker. Find the
+        // marker by binary search and the beat inside of its section.
+        const auto markerIt = std::prev(std::upper_bound(m_markers.cbegin(),
+                m_markers.cend(),
+                position,
+                [](audio::FramePos framePos, const BeatMarker& marker) {
+                    return framePos < marker.position();
+                }));
+        it = ConstIterator(this, markerIt, 0);
+        const double n = std::ceil((position - markerIt->position()) / it.beatLengthFrames());
+        it += static_cast<int>(n);
+
+        // Work around tiny floating point errors of `std::ceil`, like above
+        if (*it < position) {
+            it++;
+        } else {
+            auto previousBeatIt = it - 1;
+            if (*previousBeatIt >= position) {
+                it = previousBeatIt;
+            }
+        }
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() ||
@@ -518,8 +547,23 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
 
     std::unordered_map<int, audio::FrameDiff_t> map;
 
-    auto markerIt = m_markers.crbegin();
-    auto nextMarkerPosition = m_lastMarkerPosition;
+    // Skip the markers after the range
+    const auto endMarkerIt = std::lower_bound(m_markers.cbegin(),
+            m_markers.cend(),
+            endPosition,
+            [](const BeatMarker& marker, audio::FramePos framePos) {
+                return marker.position() < framePos;
+            });
+    if (endMarkerIt == m_markers.cbegin()) {
+        // The range is before the first marker, where the tempo of the
+        // first section continues
+        const auto bpm = 60.0 * m_sampleRate / firstBeatLengthFrames();
+        return Bpm(std::round(100 * bpm) / 100);
+    }
+    auto markerIt = std::make_reverse_iterator(endMarkerIt);
+    auto nextMarkerPosition = (endMarkerIt != m_markers.cend())
+            ? endMarkerIt->position()
+            : m_lastMarkerPosition;
 
     if (endPosition > m_lastMarkerPosition) {
         DEBUG_ASSERT(startPosition < m_lastMarkerPosition);
@@ -528,12 +572,7 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
     }
 
     while (markerIt != m_markers.crend() && nextMarkerPosition > startPosition) {
-        if (endPosition <= markerIt->position()) {
-            nextMarkerPosition = markerIt->position();
-            markerIt++;
-            continue;
-        }
-
+        DEBUG_ASSERT(endPosition > markerIt->position());
         audio::FrameDiff_t sectionLengthFrames = nextMarkerPosition - markerIt->position();
         const audio::FrameDiff_t beatLengthFrames =
                 sectionLengthFrames / markerIt->beatsTillNextMarker();
@@ -669,6 +708,17 @@ std::optional<BeatsPointer> Beats::trySetBpm(mixxx::Bpm bpm) const {
     return BeatsPointer(new Beats({}, *it, bpm, m_sampleRate, m_subVersion));
 }
 
+void Beats::initMarkerBeatIndices() {
+    m_markerBeatIndices.clear();
+    m_markerBeatIndices.reserve(m_markers.size() + 1);
+    int beatIndex = 0;
+    for (const auto& marker : m_markers) {
+        m_markerBeatIndices.push_back(beatIndex);
+        beatIndex += marker.beatsTillNextMarker();
+    }
+    m_markerBeatIndices.push_back(beatIndex);
+}
+
 bool Beats::isValid() const {
     if (!m_lastMarkerPosition.isValid() || !m_lastMarkerBpm.isValid()) {
         return false;
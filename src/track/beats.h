@@ -165,6 +165,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        initMarkerBeatIndices();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -424,10 +425,23 @@ class Beats : private std::enable_shared_from_this<Beats> {
     QByteArray toBeatGridByteArray() const;
     QByteArray toBeatMapByteArray() const;
 
+    void initMarkerBeatIndices();
+    /// The index of the beat `beatOffset` beats after the marker `it`,
+    /// counted from the first marker.
+    qint64 beatIndex(std::vector<BeatMarker>::const_iterator it, int beatOffset) const {
+        return m_markerBeatIndices[it - m_markers.cbegin()] +
+                static_cast<qint64>(beatOffset);
+    }
+
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
     std::vector<BeatMarker> m_markers;
+    /// The number of beats before each marker, counted from the first
+    /// marker, followed by the beat index of the last marker. This allows
+    /// to move iterators and to measure their distance without walking
+    /// the markers, which matters for beat maps with thousands of markers.
+    std::vector<int> m_markerBeatIndices;
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
@@ -2,6 +2,7 @@
 
 #include <QDirIterator>
 #include <atomic>
+#include <cmath>
 
 #include "engine/engine.h"
 #include "library/library_prefs.h"
@@ -85,6 +86,7 @@ Track::Track(
           m_record(trackId),
           m_bDirty(false),
           m_bMarkedForMetadataExport(false) {
+    updateRecordSnapshotWhileLocked();
     if (kLogStats && kLogger.debugEnabled()) {
         long numberOfInstancesBefore = s_numberOfInstances.fetch_add(1);
         kLogger.debug()
@@ -183,7 +185,7 @@ void Track::replaceMetadataFromSource(
         auto beatsAndBpmModified = false;
         if (importedBpm.isValid() &&
                 (!m_pBeats ||
-                        !getBeatsPointerBpm(m_pBeats, getDuration())
+                        !getBeatsPointerBpm(m_pBeats, getDurationWhileLocked())
                                  .isValid())) {
             // Only use the imported BPM if the current beat grid is either
             // missing or not valid! The BPM value in the metadata might be
@@ -276,6 +278,22 @@ mixxx::TrackRecord Track::getRecord(
     return m_record;
 }
 
+std::shared_ptr<const mixxx::TrackRecord> Track::getRecordSnapshot() const {
+    const auto locked = lockMutex(&m_qMutex);
+    if (!m_pRecordSnapshot) {
+        m_pRecordSnapshot = std::make_shared<const mixxx::TrackRecord>(m_record);
+    }
+    return m_pRecordSnapshot;
+}
+
+void Track::updateRecordSnapshotWhileLocked() {
+    m_pRecordSnapshot.reset();
+    const mixxx::Bpm bpm = m_record.getMetadata().getTrackInfo().getBpm();
+    m_bpm.store(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined);
+    m_duration.store(getDurationWhileLocked());
+    m_key.store(m_record.getGlobalKey());
+}
+
 bool Track::replaceRecord(
         mixxx::TrackRecord newRecord,
         mixxx::BeatsPointer pOptionalBeats) {
@@ -358,7 +376,7 @@ void Track::adjustReplayGainFromPregain(double gain) {
 mixxx::Bpm Track::getBpmWhileLocked() const {
     // BPM values must be synchronized at all times!
     DEBUG_ASSERT(m_record.getMetadata().getTrackInfo().getBpm() ==
-            getBeatsPointerBpm(m_pBeats, getDuration()));
+            getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()));
     return m_record.getMetadata().getTrackInfo().getBpm();
 }
 
@@ -377,7 +395,7 @@ bool Track::trySetBpmWhileLocked(mixxx::Bpm bpm) {
                 cuePosition,
                 bpm);
         return trySetBeatsWhileLocked(std::move(pBeats));
-    } else if (getBeatsPointerBpm(m_pBeats, getDuration()) != bpm) {
+    } else if (getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()) != bpm) {
         // Continue with the regular cases
         const auto newBeats = m_pBeats->trySetBpm(bpm);
         if (newBeats) {
@@ -391,12 +409,6 @@ bool Track::trySetBpmWhileLocked(mixxx::Bpm bpm) {
     return false;
 }
 
-double Track::getBpm() const {
-    const auto locked = lockMutex(&m_qMutex);
-    const mixxx::Bpm bpm = getBpmWhileLocked();
-    return bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined;
-}
-
 bool Track::trySetBpm(mixxx::Bpm bpm) {
     auto locked = lockMutex(&m_qMutex);
     if (!trySetBpmWhileLocked(bpm)) {
@@ -421,7 +433,8 @@ bool Track::setBeatsWhileLocked(mixxx::BeatsPointer pBeats) {
         return false;
     }
     m_pBeats = std::move(pBeats);
-    m_record.refMetadata().refTrackInfo().setBpm(getBeatsPointerBpm(m_pBeats, getDuration()));
+    m_record.refMetadata().refTrackInfo().setBpm(
+            getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()));
     return true;
 }
 
@@ -548,6 +561,7 @@ QDateTime Track::getDateAdded() const {
 void Track::setDateAdded(const QDateTime& dateAdded) {
     auto locked = lockMutex(&m_qMutex);
     m_record.setDateAdded(dateAdded);
+    updateRecordSnapshotWhileLocked();
 }
 
 void Track::setDuration(mixxx::Duration duration) {
@@ -575,14 +589,9 @@ void Track::setDuration(double duration) {
     setDuration(mixxx::Duration::fromSeconds(duration));
 }
 
-double Track::getDuration() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getStreamInfo().getDuration().toDoubleSeconds();
-}
-
 int Track::getDurationSecondsInt() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return static_cast<int>(m_record.getMetadata().getDurationSecondsRounded());
+    // Rounded like TrackMetadata::getDurationSecondsRounded()
+    return static_cast<int>(std::round(getDuration()));
 }
 
 QString Track::getDurationText(
@@ -842,6 +851,7 @@ void Track::initId(TrackId id) {
         return; // abort
     }
     m_record.setId(id);
+    updateRecordSnapshotWhileLocked();
     // Changing the Id does not make the track dirty because the Id is always
     // generated by the database itself.
 }
@@ -849,6 +859,7 @@ void Track::initId(TrackId id) {
 void Track::resetId() {
     const auto locked = lockMutex(&m_qMutex);
     m_record.setId(TrackId());
+    updateRecordSnapshotWhileLocked();
 }
 
 void Track::setURL(const QString& url) {
@@ -1308,6 +1319,10 @@ void Track::setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty) {
 
     const auto trackId = m_record.getId();
 
+    if (bDirty) {
+        updateRecordSnapshotWhileLocked();
+    }
+
     // Unlock before emitting any signals!
     pLock->unlock();
 
@@ -1386,11 +1401,6 @@ void Track::setKey(mixxx::track::io::key::ChromaticKey key,
     }
 }
 
-mixxx::track::io::key::ChromaticKey Track::getKey() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getGlobalKey();
-}
-
 QString Track::getKeyText() const {
     const auto locked = lockMutex(&m_qMutex);
     return m_record.getGlobalKeyText();
@@ -1563,6 +1573,7 @@ ExportTrackMetadataResult Track::exportMetadata(
                     streamInfo->getSignalInfo(),
                     streamInfo->getDuration(),
                     timingOffset);
+            updateRecordSnapshotWhileLocked();
         }
     }
 
@@ -1587,6 +1598,7 @@ ExportTrackMetadataResult Track::exportMetadata(
         // that is stored in the database. New columns that need to be populated
         // from file tags cannot be filled during a database migration.
         m_record.mergeExtraMetadataFromSource(importedFromFile);
+        updateRecordSnapshotWhileLocked();
 
         // Prepare export by cloning and normalizing the metadata
         normalizedFromRecord = m_record.getMetadata();
@@ -1656,6 +1668,7 @@ ExportTrackMetadataResult Track::exportMetadata(
         // The database update will follow immediately after returning from
         // this operation!
         m_record.updateSourceSynchronizedAt(trackMetadataExported.second);
+        updateRecordSnapshotWhileLocked();
         if (kLogger.debugEnabled()) {
             kLogger.debug()
                     << "Exported track metadata:"
@@ -1740,6 +1753,9 @@ void Track::updateStreamInfoFromSource(
     }
 
     if (!beatsImported && !cuesImported) {
+        if (updated) {
+            updateRecordSnapshotWhileLocked();
+        }
         return;
     }
 
@@ -3,6 +3,8 @@
 #include <QList>
 #include <QObject>
 #include <QUrl>
+#include <atomic>
+#include <memory>
 
 #include "audio/streaminfo.h"
 #include "sources/metadatasource.h"
@@ -90,6 +92,13 @@ class Track : public QObject {
 
     TrackId getId() const;
 
+    /// Returns an immutable copy of the track's record that is consistent
+    /// in itself. The copy is created on demand and shared until the
+    /// track is modified. Prefer it over the individual getters, most
+    /// of which lock the track once per property, for reading many
+    /// properties at once.
+    std::shared_ptr<const mixxx::TrackRecord> getRecordSnapshot() const;
+
     // Returns absolute path to the file, including the filename.
     QString getLocation() const {
         if (!m_fileAccess.info().hasLocation()) {
@@ -121,7 +130,10 @@ class Track : public QObject {
 
     void setDuration(mixxx::Duration duration);
     void setDuration(double duration);
-    double getDuration() const;
+    // Does not lock the track
+    double getDuration() const {
+        return m_duration.load();
+    }
     // Returns the duration rounded to seconds
     int getDurationSecondsInt() const;
     // Returns the duration formatted as a string (H:MM:SS or H:MM:SS.cc or H:MM:SS.mmm)
@@ -144,8 +156,10 @@ class Track : public QObject {
     }
     bool trySetBpm(mixxx::Bpm bpm);
 
-    // Returns BPM
-    double getBpm() const;
+    // Returns BPM. Does not lock the track.
+    double getBpm() const {
+        return m_bpm.load();
+    }
     // Returns BPM as a string
     QString getBpmText() const {
         return mixxx::Bpm::displayValueText(getBpm());
@@ -385,7 +399,10 @@ class Track : public QObject {
             mixxx::track::io::key::Source keySource);
     void setKeyText(const QString& keyText,
             mixxx::track::io::key::Source keySource = mixxx::track::io::key::USER);
-    mixxx::track::io::key::ChromaticKey getKey() const;
+    // Does not lock the track
+    mixxx::track::io::key::ChromaticKey getKey() const {
+        return m_key.load();
+    }
     QString getKeyText() const;
 
     void setCoverInfo(const CoverInfoRelative& coverInfo);
@@ -520,7 +537,15 @@ class Track : public QObject {
     /// caller guards this a lock.
     bool importPendingCueInfosWhileLocked();
 
+    /// Discards the copy of m_record returned by getRecordSnapshot() and
+    /// publishes the properties that are read without locking. Must be
+    /// invoked after modifying m_record and before releasing the lock.
+    void updateRecordSnapshotWhileLocked();
+
     mixxx::Bpm getBpmWhileLocked() const;
+    double getDurationWhileLocked() const {
+        return m_record.getMetadata().getStreamInfo().getDuration().toDoubleSeconds();
+    }
     bool trySetBpmWhileLocked(mixxx::Bpm bpm);
     bool trySetBeatsWhileLocked(
             mixxx::BeatsPointer pBeats,
@@ -571,6 +596,17 @@ class Track : public QObject {
 
     mixxx::TrackRecord m_record;
 
+    // Lazily created, immutable copy of m_record that is shared
+    // by all readers until m_record is modified. Guarded by m_qMutex.
+    mutable std::shared_ptr<const mixxx::TrackRecord> m_pRecordSnapshot;
+
+    // Copies of the most frequently read properties of m_record, for
+    // reading them without locking m_qMutex. Only written while locked,
+    // together with discarding m_pRecordSnapshot.
+    std::atomic<double> m_bpm;
+    std::atomic<double> m_duration;
+    std::atomic<mixxx::track::io::key::ChromaticKey> m_key;
+
     // Flag that indicates whether or not the TIO has changed. This is used by
     // TrackDAO to determine whether or not to write the Track back.
     bool m_bDirty;
@@ -598,6 +634,7 @@ class Track : public QObject {
         // to lock the mutex.
         DEBUG_ASSERT(!m_record.m_headerParsed);
         m_record.m_headerParsed = headerParsed;
+        updateRecordSnapshotWhileLocked();
     }
     /// Set the genre text WITHOUT updating the corresponding custom tags.
     ///
@@ -160,7 +160,9 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
 
     const QCommandLineOption timelinePath(QStringLiteral("timeline-path"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
-                                      "Path the debug statistics time line is written to")
+                                      "Path the debug statistics time line is written to. "
+                                      "Paths ending with .json are written in the trace "
+                                      "event format that can be loaded into Perfetto.")
                             : QString(),
             QStringLiteral("path"));
     QCommandLineOption timelinePathDeprecated(
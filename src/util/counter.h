@@ -23,5 +23,5 @@ class Counter {
         return result;
     }
   private:
-    QString m_tag;
+    StatTag m_tag;
 };
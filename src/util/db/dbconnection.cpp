@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlQuery>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -22,6 +23,20 @@ namespace {
 
 const mixxx::Logger kLogger("DbConnection");
 
+const QString kSqliteDriverType = QStringLiteral("QSQLITE");
+
+const QString kSqliteReadOnlyConnectOption = QStringLiteral("QSQLITE_OPEN_READONLY");
+
+// The write-ahead log is checkpointed automatically when it exceeds
+// this number of pages (SQLite default).
+constexpr int kWalAutoCheckpointPages = 1000;
+
+// The write-ahead log is truncated to this size after it has been
+// checkpointed. Otherwise the file would keep its maximum size that
+// is reached during long write transactions, e.g. when rescanning
+// the library.
+constexpr qint64 kJournalSizeLimitBytes = 16 * 1024 * 1024;
+
 QSqlDatabase createDatabase(
         const DbConnection::Params& params,
         const QString& connectionName) {
@@ -312,18 +327,112 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
     return true;
 }
 
+bool execPragma(
+        const QSqlDatabase& database,
+        const QString& pragma,
+        QString* pResult = nullptr) {
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA ") + pragma)) {
+        kLogger.warning()
+                << "Failed to execute PRAGMA"
+                << pragma
+                << query.lastError();
+        return false;
+    }
+    if (pResult && query.next()) {
+        *pResult = query.value(0).toString();
+    }
+    return true;
+}
+
+void configureDatabase(
+        const QSqlDatabase& database,
+        const DbConnection::Params& params,
+        DbConnection::AccessMode accessMode) {
+    DEBUG_ASSERT(database.isOpen());
+    if (database.driverName() != kSqliteDriverType) {
+        return;
+    }
+    if (accessMode == DbConnection::AccessMode::ReadWrite) {
+        // The journal mode is stored persistently in the database file.
+        // Existing files are migrated in both directions when opening
+        // the first connection, i.e. before any other connection might
+        // block the migration.
+        const QString journalMode = params.writeAheadLog
+                ? QStringLiteral("WAL")
+                : QStringLiteral("DELETE");
+        QString actualJournalMode;
+        if (execPragma(database,
+                    QStringLiteral("journal_mode=") + journalMode,
+                    &actualJournalMode) &&
+                actualJournalMode.compare(journalMode, Qt::CaseInsensitive) != 0) {
+            // In-memory databases and some (network) file systems do not
+            // support a write-ahead log
+            kLogger.info()
+                    << "Using journal mode"
+                    << actualJournalMode
+                    << "instead of"
+                    << journalMode;
+        }
+        if (params.writeAheadLog) {
+            // Committed transactions are durable when the application
+            // crashes, but might be rolled back after a power loss.
+            execPragma(database, QStringLiteral("synchronous=NORMAL"));
+            execPragma(database,
+                    QStringLiteral("wal_autocheckpoint=%1")
+                            .arg(kWalAutoCheckpointPages));
+            execPragma(database,
+                    QStringLiteral("journal_size_limit=%1")
+                            .arg(kJournalSizeLimitBytes));
+        }
+    } else {
+        // Reject any modifications instead of failing later when trying
+        // to commit them
+        execPragma(database, QStringLiteral("query_only=1"));
+    }
+    if (params.cacheSizeKiB > 0) {
+        // Negative values are interpreted as KiB instead of pages
+        execPragma(database,
+                QStringLiteral("cache_size=-%1").arg(params.cacheSizeKiB));
+    }
+    if (params.mmapSizeBytes > 0) {
+        execPragma(database,
+                QStringLiteral("mmap_size=%1").arg(params.mmapSizeBytes));
+    }
+}
+
+QString connectOptions(
+        const DbConnection::Params& params,
+        DbConnection::AccessMode accessMode) {
+    if (accessMode == DbConnection::AccessMode::ReadWrite) {
+        return params.connectOptions;
+    }
+    if (params.connectOptions.isEmpty()) {
+        return kSqliteReadOnlyConnectOption;
+    }
+    return params.connectOptions + QChar(';') + kSqliteReadOnlyConnectOption;
+}
+
 } // anonymous namespace
 
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_params(params),
+      m_accessMode(AccessMode::ReadWrite),
+      m_sqlDatabase(createDatabase(params, connectionName)) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
-        const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+        const QString& connectionName,
+        AccessMode accessMode)
+    : m_params(prototype.m_params),
+      // Without a write-ahead log readers would block the writer
+      // and vice versa. Fall back to a regular connection.
+      m_accessMode(m_params.writeAheadLog ? accessMode : AccessMode::ReadWrite),
+      m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    m_sqlDatabase.setConnectOptions(connectOptions(m_params, m_accessMode));
 }
 
 DbConnection::~DbConnection() {
@@ -351,9 +460,18 @@ bool DbConnection::open() {
         m_sqlDatabase.close();
         return false; // abort
     }
+    configureDatabase(m_sqlDatabase, m_params, m_accessMode);
     return true;
 }
 
+bool DbConnection::checkpoint() {
+    if (!isOpen() || isReadOnly() || !m_params.writeAheadLog ||
+            m_sqlDatabase.driverName() != kSqliteDriverType) {
+        return false;
+    }
+    return execPragma(m_sqlDatabase, QStringLiteral("wal_checkpoint(PASSIVE)"));
+}
+
 void DbConnection::close() {
     if (m_sqlDatabase.isOpen()) {
         // There should never be an outstanding transaction when this code is
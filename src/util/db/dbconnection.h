@@ -29,6 +29,28 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+
+        // The following settings are only applied to SQLite databases.
+
+        // Use a write-ahead log instead of a rollback journal. Readers
+        // and a writer no longer block each other and the writer does
+        // not need to sync the database file on every commit. Not
+        // supported by in-memory databases. If disabled the database
+        // file is migrated back to a rollback journal.
+        bool writeAheadLog = false;
+        // The size of the page cache of each connection in KiB.
+        // 0 = SQLite default
+        int cacheSizeKiB = 0;
+        // The maximum number of bytes of the database file that are
+        // accessed through memory-mapped I/O. 0 = disabled
+        qint64 mmapSizeBytes = 0;
+    };
+
+    enum class AccessMode {
+        ReadWrite,
+        // Read-only connections are only supported with a write-ahead
+        // log. Otherwise a read/write connection is opened instead.
+        ReadOnly,
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -37,7 +59,8 @@ class DbConnection final {
             const QString& connectionName);
     DbConnection(
             const DbConnection& prototype,
-            const QString& connectionName);
+            const QString& connectionName,
+            AccessMode accessMode = AccessMode::ReadWrite);
     ~DbConnection();
 
     QString name() const {
@@ -51,6 +74,16 @@ class DbConnection final {
         return m_sqlDatabase.isOpen();
     }
 
+    bool isReadOnly() const {
+        return m_accessMode == AccessMode::ReadOnly;
+    }
+
+    // Transfers the contents of the write-ahead log back into the
+    // database file without waiting for readers or writers, i.e.
+    // a checkpoint might be incomplete. The log is also checkpointed
+    // automatically whenever it exceeds a certain size.
+    bool checkpoint();
+
     operator QSqlDatabase() const {
         return m_sqlDatabase;
     }
@@ -61,6 +94,8 @@ class DbConnection final {
     DbConnection(const DbConnection&) = delete;
     DbConnection(const DbConnection&&) = delete;
 
+    Params m_params;
+    AccessMode m_accessMode;
     QSqlDatabase m_sqlDatabase;
     mixxx::StringCollator m_collator;
 };
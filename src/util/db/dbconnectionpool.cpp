@@ -11,12 +11,14 @@ const Logger kLogger("DbConnectionPool");
 
 } // anonymous namespace
 
-bool DbConnectionPool::createThreadLocalConnection() {
-    VERIFY_OR_DEBUG_ASSERT(!m_threadLocalConnections.hasLocalData()) {
-        DEBUG_ASSERT(m_threadLocalConnections.localData());
+bool DbConnectionPool::createThreadLocalConnection(
+        DbConnection::AccessMode accessMode) {
+    QThreadStorage<DbConnection*>& connections = threadLocalConnections(accessMode);
+    VERIFY_OR_DEBUG_ASSERT(!connections.hasLocalData()) {
+        DEBUG_ASSERT(connections.localData());
         kLogger.critical()
                 << "Thread-local database connection already exists"
-                << *m_threadLocalConnections.localData();
+                << *connections.localData();
         return false; // abort
     }
     const int connectionIndex =
@@ -25,29 +27,41 @@ bool DbConnectionPool::createThreadLocalConnection() {
             QString("%1-%2").arg(
                     m_prototypeConnection.name(),
                     QString::number(connectionIndex));
-    auto pConnection = std::make_unique<DbConnection>(m_prototypeConnection, indexedConnectionName);
+    auto pConnection = std::make_unique<DbConnection>(
+            m_prototypeConnection, indexedConnectionName, accessMode);
     if (!pConnection->open()) {
         kLogger.critical()
                 << "Failed to open thread-local database connection"
                 << *pConnection;
         return false; // abort
     }
-    m_threadLocalConnections.setLocalData(pConnection.get()); // transfer ownership
+    connections.setLocalData(pConnection.get()); // transfer ownership
     pConnection.release(); // release ownership
-    DEBUG_ASSERT(m_threadLocalConnections.hasLocalData());
-    DEBUG_ASSERT(m_threadLocalConnections.localData());
+    DEBUG_ASSERT(connections.hasLocalData());
+    DEBUG_ASSERT(connections.localData());
     kLogger.info()
             << "Cloned thread-local database connection"
-            << *m_threadLocalConnections.localData();
+            << *connections.localData();
     return true;
 }
 
-void DbConnectionPool::destroyThreadLocalConnection() {
-    VERIFY_OR_DEBUG_ASSERT(m_threadLocalConnections.hasLocalData()) {
+void DbConnectionPool::destroyThreadLocalConnection(
+        DbConnection::AccessMode accessMode) {
+    QThreadStorage<DbConnection*>& connections = threadLocalConnections(accessMode);
+    VERIFY_OR_DEBUG_ASSERT(connections.hasLocalData()) {
         kLogger.critical()
                 << "Thread-local database connection not found";
+        return;
     }
-    m_threadLocalConnections.setLocalData(nullptr);
+    DbConnection* pConnection = connections.localData();
+    // Connections are released after a batch of modifications, e.g.
+    // when the scanner or the analyzer finished. The write-ahead log
+    // is then checkpointed without waiting for the next automatic
+    // checkpoint.
+    if (pConnection && !pConnection->isReadOnly()) {
+        pConnection->checkpoint();
+    }
+    connections.setLocalData(nullptr);
 }
 
 DbConnectionPool::DbConnectionPool(
@@ -34,8 +34,15 @@ class DbConnectionPool final {
     // Prefer to use DbConnectionPooler instead of the
     // following functions. Only if there is no appropriate
     // scoping possible then use these functions directly.
-    bool createThreadLocalConnection();
-    void destroyThreadLocalConnection();
+    //
+    // Each thread might own both a read/write and a separate
+    // read-only connection. Read-only connections never wait
+    // for the writer and vice versa if the database uses a
+    // write-ahead log.
+    bool createThreadLocalConnection(
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite);
+    void destroyThreadLocalConnection(
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite);
 
   private:
     DbConnectionPool(const DbConnectionPool&) = delete;
@@ -50,8 +57,22 @@ class DbConnectionPool final {
     // to be created through DbConnectionPooler the latter case should
     // never happen.
     friend class DbConnectionPooled;
-    const DbConnection* threadLocalConnection() const {
-        return m_threadLocalConnections.localData();
+    const DbConnection* threadLocalConnection(
+            DbConnection::AccessMode accessMode) const {
+        return threadLocalConnections(accessMode).localData();
+    }
+
+    QThreadStorage<DbConnection*>& threadLocalConnections(
+            DbConnection::AccessMode accessMode) {
+        return accessMode == DbConnection::AccessMode::ReadOnly
+                ? m_threadLocalReaderConnections
+                : m_threadLocalConnections;
+    }
+    const QThreadStorage<DbConnection*>& threadLocalConnections(
+            DbConnection::AccessMode accessMode) const {
+        return accessMode == DbConnection::AccessMode::ReadOnly
+                ? m_threadLocalReaderConnections
+                : m_threadLocalConnections;
     }
 
     const DbConnection m_prototypeConnection;
@@ -59,6 +80,7 @@ class DbConnectionPool final {
     QAtomicInt m_connectionCounter;
 
     QThreadStorage<DbConnection*> m_threadLocalConnections;
+    QThreadStorage<DbConnection*> m_threadLocalReaderConnections;
 
 };
 
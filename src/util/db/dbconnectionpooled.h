@@ -12,8 +12,10 @@ namespace mixxx {
 class DbConnectionPooled final {
   public:
     explicit DbConnectionPooled(
-            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr())
-        : m_pDbConnectionPool(std::move(pDbConnectionPool)) {
+            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr(),
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite)
+        : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_accessMode(accessMode) {
     }
 
     // Checks if this instance actually references a connection pool
@@ -26,8 +28,9 @@ class DbConnectionPooled final {
     // from the pool. This might fail if either the reference to the
     // connection pool is missing or if the pool does not contain a
     // thread-local connection for this thread (previously created
-    // by some DbConnectionPooler). On failure a non-functional default
-    // constructed database connection is returned.
+    // by some DbConnectionPooler with the same access mode). On failure
+    // a non-functional default constructed database connection is
+    // returned.
     //
     // The returned connections is not bound to this instance:
     // QSqlDatabase dbConnection = DbConnectionPooled(...);
@@ -35,6 +38,7 @@ class DbConnectionPooled final {
 
   private:
     DbConnectionPoolPtr m_pDbConnectionPool;
+    DbConnection::AccessMode m_accessMode;
 };
 
 } // namespace mixxx
@@ -12,8 +12,10 @@ const Logger kLogger("DbConnectionPooler");
 } // anonymous namespace
 
 DbConnectionPooler::DbConnectionPooler(
-        DbConnectionPoolPtr pDbConnectionPool) {
-    if (pDbConnectionPool && pDbConnectionPool->createThreadLocalConnection()) {
+        DbConnectionPoolPtr pDbConnectionPool,
+        DbConnection::AccessMode accessMode)
+        : m_accessMode(accessMode) {
+    if (pDbConnectionPool && pDbConnectionPool->createThreadLocalConnection(accessMode)) {
         // m_pDbConnectionPool indicates if the thread-local connection has actually
         // been created during construction. Otherwise this instance does not store
         // any reference to the connection pool and is non-functional.
@@ -25,7 +27,7 @@ DbConnectionPooler::~DbConnectionPooler() {
     if (m_pDbConnectionPool) {
         // Only destroy the thread-local connection if it has actually been created
         // during construction (see above).
-        m_pDbConnectionPool->destroyThreadLocalConnection();
+        m_pDbConnectionPool->destroyThreadLocalConnection(m_accessMode);
     }
 }
 
@@ -17,7 +17,8 @@ namespace mixxx {
 class DbConnectionPooler final {
   public:
     explicit DbConnectionPooler(
-            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr());
+            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr(),
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite);
     DbConnectionPooler(const DbConnectionPooler&) = delete;
     DbConnectionPooler(DbConnectionPooler&&) = default;
     ~DbConnectionPooler();
@@ -41,6 +42,7 @@ class DbConnectionPooler final {
     static void * operator new[](std::size_t);
 
     DbConnectionPoolPtr m_pDbConnectionPool;
+    DbConnection::AccessMode m_accessMode;
 };
 
 } // namespace mixxx
@@ -23,6 +23,27 @@ class SqlStringFormatter final {
             const QSqlDatabase& database,
             const QSet<QString>& values);
 
+    // The maximum number of values in a single list, to bound the
+    // length of statements that address multiple rows at once.
+    static constexpr int kMaxListSize = 500;
+
+    // Join the values in consecutive chunks of at most kMaxListSize
+    // elements separated by "," and invoke the callback with each list.
+    // The values are not quoted, they must already be valid SQL literals
+    // like the string representation of numbers or ids. Stops and returns
+    // false as soon as the callback returns false.
+    template<typename Callback>
+    static bool joinListChunks(
+            const QStringList& values,
+            Callback&& callback) {
+        for (int first = 0; first < values.size(); first += kMaxListSize) {
+            if (!callback(values.mid(first, kMaxListSize).join(QChar(',')))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
   private:
     SqlStringFormatter() = delete; // utility class
 };
@@ -9,15 +9,33 @@
 class Event {
   public:
     Event()
-            : m_type(Stat::UNSPECIFIED) {
+            : m_type(Stat::UNSPECIFIED),
+              m_threadIndex(0) {
     }
 
     typedef Stat::StatType EventType;
 
-    QString m_tag;
+    StatTag m_tag;
     EventType m_type;
     mixxx::Duration m_time;
+    // Only for events of type Stat::DURATION_NANOSEC that end at m_time
+    mixxx::Duration m_duration;
+    // Identifies the reporting thread
+    int m_threadIndex;
 
+    static bool event(StatTag tag, Event::EventType type = Stat::EVENT) {
+        return Stat::track(tag, type, Stat::experimentFlags(Stat::COUNT), 0.0);
+    }
+
+    static bool start(StatTag tag) {
+        return event(tag, Stat::EVENT_START);
+    }
+
+    static bool end(StatTag tag) {
+        return event(tag, Stat::EVENT_END);
+    }
+
+    // Interns the tag on every invocation, prefer to use a StatTag instead.
     static bool event(const QString& tag, Event::EventType type = Stat::EVENT) {
         return Stat::track(tag, type, Stat::experimentFlags(Stat::COUNT), 0.0);
     }
@@ -33,7 +51,7 @@ class Event {
     // Disallow to use this class with implicit converted char strings.
     // This should not be uses to avoid unicode encoding and memory
     // allocation at every call. Use a static tag like this:
-    // static const QString tag("TAG TEXT");
+    // static const StatTag tag(QStringLiteral("TAG TEXT"));
     static bool event(const char*, Event::EventType) = delete;
     static bool start(const char*) = delete;
     static bool end(const char*) = delete;
@@ -1,12 +1,90 @@
 #include "util/file.h"
 
+#include <QFile>
 #include <QFileDialog>
 #include <QRegularExpression>
+#include <QtDebug>
+#include <vector>
+
+#ifdef __LINUX__
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#endif
 
 namespace {
 
 const QRegularExpression kExtractExtensionRegex(R"(\(\*\.(.*)\)$)");
 
+// Large enough to keep the drive busy with few system calls
+constexpr qint64 kCopyBufferSize = 1024 * 1024;
+
+#if defined(__LINUX__) && defined(__GLIBC__) && \
+        (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#define MIXXX_HAVE_COPY_FILE_RANGE
+#endif
+
+#ifdef MIXXX_HAVE_COPY_FILE_RANGE
+enum class KernelCopyResult {
+    Finished,
+    Failed,
+    // Not supported between these files, e.g. across file systems
+    // on older kernels. Nothing has been written yet.
+    Unsupported,
+};
+
+KernelCopyResult copyFileRange(QFile* pSource, QFile* pDest, QString* pErrorString) {
+    const int sourceFd = pSource->handle();
+    const int destFd = pDest->handle();
+    bool copiedAny = false;
+    while (true) {
+        const ssize_t copied = copy_file_range(
+                sourceFd, nullptr, destFd, nullptr, kCopyBufferSize, 0);
+        if (copied == 0) {
+            return KernelCopyResult::Finished;
+        }
+        if (copied > 0) {
+            copiedAny = true;
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (!copiedAny &&
+                (errno == ENOSYS || errno == EXDEV || errno == EINVAL ||
+                        errno == EOPNOTSUPP || errno == EBADF)) {
+            return KernelCopyResult::Unsupported;
+        }
+        if (pErrorString) {
+            *pErrorString = QString::fromLocal8Bit(strerror(errno));
+        }
+        return KernelCopyResult::Failed;
+    }
+}
+#endif
+
+bool copyBuffered(QFile* pSource, QFile* pDest, QString* pErrorString) {
+    std::vector<char> buffer(kCopyBufferSize);
+    while (true) {
+        const qint64 bytesRead = pSource->read(buffer.data(), kCopyBufferSize);
+        if (bytesRead == 0) {
+            return true;
+        }
+        if (bytesRead < 0) {
+            if (pErrorString) {
+                *pErrorString = pSource->errorString();
+            }
+            return false;
+        }
+        if (pDest->write(buffer.data(), bytesRead) != bytesRead) {
+            if (pErrorString) {
+                *pErrorString = pDest->errorString();
+            }
+            return false;
+        }
+    }
+}
+
 } //anonymous namespace
 
 QString filePathWithSelectedExtension(const QString& fileLocationInput,
@@ -69,3 +147,47 @@ QString getFilePathWithVerifiedExtensionFromFileDialog(
     }
     return fileLocation;
 }
+
+bool copyFileContents(const QString& sourcePath,
+        const QString& destPath,
+        QString* pErrorString) {
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        if (pErrorString) {
+            *pErrorString = source.errorString();
+        }
+        return false;
+    }
+    QFile dest(destPath);
+    if (!dest.open(QIODevice::WriteOnly | QIODevice::NewOnly | QIODevice::Unbuffered)) {
+        if (pErrorString) {
+            *pErrorString = dest.errorString();
+        }
+        return false;
+    }
+
+    bool success = false;
+#ifdef MIXXX_HAVE_COPY_FILE_RANGE
+    switch (copyFileRange(&source, &dest, pErrorString)) {
+    case KernelCopyResult::Finished:
+        success = true;
+        break;
+    case KernelCopyResult::Failed:
+        break;
+    case KernelCopyResult::Unsupported:
+        success = copyBuffered(&source, &dest, pErrorString);
+        break;
+    }
+#else
+    success = copyBuffered(&source, &dest, pErrorString);
+#endif
+
+    if (success && !dest.setPermissions(source.permissions())) {
+        qWarning() << "Failed to copy permissions of" << sourcePath << "to" << destPath;
+    }
+    dest.close();
+    if (!success) {
+        dest.remove();
+    }
+    return success;
+}
@@ -18,3 +18,13 @@ QString getFilePathWithVerifiedExtensionFromFileDialog(
         const QString& preSelectedDirectory,
         const QString& fileFilters,
         const QString& preSelectedFileFilter);
+
+// Copies the contents and permissions of the file at sourcePath to the new
+// file at destPath, which must not exist yet. Unlike QFile::copy() this
+// copies within the kernel if possible and otherwise uses a large buffer,
+// which is much faster when writing to slow external drives. A partially
+// written destination file is removed on failure. May be called from any
+// thread.
+bool copyFileContents(const QString& sourcePath,
+        const QString& destPath,
+        QString* pErrorString = nullptr);
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <type_traits>
 
 #include "util/math.h"
 
@@ -37,6 +38,51 @@ constexpr bool useAlignedAlloc() {
             sizeof(CSAMPLE*) == sizeof(size_t);
 }
 
+// Invokes kernel with the number of interleaved channels. The strided loops
+// are only vectorized with a constant stride, so the channel counts of
+// common audio interfaces are passed as compile time constants.
+template<typename Kernel>
+inline void withNumChannels(int numChannels, Kernel&& kernel) {
+    switch (numChannels) {
+    case 2:
+        kernel(std::integral_constant<int, 2>());
+        return;
+    case 4:
+        kernel(std::integral_constant<int, 4>());
+        return;
+    case 6:
+        kernel(std::integral_constant<int, 6>());
+        return;
+    case 8:
+        kernel(std::integral_constant<int, 8>());
+        return;
+    case 10:
+        kernel(std::integral_constant<int, 10>());
+        return;
+    case 12:
+        kernel(std::integral_constant<int, 12>());
+        return;
+    case 16:
+        kernel(std::integral_constant<int, 16>());
+        return;
+    case 18:
+        kernel(std::integral_constant<int, 18>());
+        return;
+    case 20:
+        kernel(std::integral_constant<int, 20>());
+        return;
+    case 24:
+        kernel(std::integral_constant<int, 24>());
+        return;
+    case 32:
+        kernel(std::integral_constant<int, 32>());
+        return;
+    default:
+        kernel(numChannels);
+        return;
+    }
+}
+
 } // anonymous namespace
 
 // static
@@ -581,11 +627,66 @@ void SampleUtil::copyMultiToStereo(
         SINT numFrames,
         int numChannels) {
     DEBUG_ASSERT(numChannels > 2);
-    // forward loop
-    for (SINT i = 0; i < numFrames; ++i) {
-        pDest[i * 2] = pSrc[i * numChannels];
-        pDest[i * 2 + 1] = pSrc[i * numChannels + 1];
-    }
+    withNumChannels(numChannels, [=](auto stride) {
+        // forward loop
+        // note: LOOP VECTORIZED for constant strides
+        for (SINT i = 0; i < numFrames; ++i) {
+            pDest[i * 2] = pSrc[i * stride];
+            pDest[i * 2 + 1] = pSrc[i * stride + 1];
+        }
+    });
+}
+
+// static
+void SampleUtil::copyMultiMonoToDualMono(
+        CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames,
+        int numChannels) {
+    DEBUG_ASSERT(numChannels >= 1);
+    withNumChannels(numChannels, [=](auto stride) {
+        // forward loop
+        // note: LOOP VECTORIZED for constant strides
+        for (SINT i = 0; i < numFrames; ++i) {
+            const CSAMPLE s = pSrc[i * stride];
+            pDest[i * 2] = s;
+            pDest[i * 2 + 1] = s;
+        }
+    });
+}
+
+// static
+void SampleUtil::copyStereoToMultiClamp(
+        CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames,
+        int numChannels) {
+    DEBUG_ASSERT(numChannels >= 2);
+    withNumChannels(numChannels, [=](auto stride) {
+        // forward loop
+        // note: LOOP VECTORIZED for constant strides
+        for (SINT i = 0; i < numFrames; ++i) {
+            pDest[i * stride] = clampSample(pSrc[i * 2]);
+            pDest[i * stride + 1] = clampSample(pSrc[i * 2 + 1]);
+        }
+    });
+}
+
+// static
+void SampleUtil::mixStereoToMultiMonoClamp(
+        CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames,
+        int numChannels) {
+    DEBUG_ASSERT(numChannels >= 1);
+    withNumChannels(numChannels, [=](auto stride) {
+        // forward loop
+        // note: LOOP VECTORIZED for constant strides
+        for (SINT i = 0; i < numFrames; ++i) {
+            pDest[i * stride] = clampSample(
+                    (pSrc[i * 2] + pSrc[i * 2 + 1]) * CSAMPLE_GAIN(0.5));
+        }
+    });
 }
 
 
@@ -272,6 +272,27 @@ class SampleUtil {
     static void copyMultiToStereo(CSAMPLE* pDest, const CSAMPLE* pSrc,
             SINT numFrames, int numChannels);
 
+    // Copies the first channel of the interleaved multi-channel samples in
+    // pSrc to dual mono samples into pDest.
+    // pSrc must contain (numFrames * numChannels) samples
+    // (numFrames * 2) samples will be written into pDest
+    static void copyMultiMonoToDualMono(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            SINT numFrames, int numChannels);
+
+    // Copies the stereo samples in pSrc into the first two channels of the
+    // interleaved multi-channel samples in pDest with numChannels >= 2,
+    // limiting the values to the valid range of CSAMPLE. The samples of all
+    // other channels in pDest are left untouched, i.e. pDest can be offset
+    // to fill other channels.
+    // (numFrames * 2) samples will be read from pSrc
+    static void copyStereoToMultiClamp(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            SINT numFrames, int numChannels);
+
+    // Like copyStereoToMultiClamp(), but mixes the stereo samples down
+    // to the first channel of pDest using (L+R)/2.
+    static void mixStereoToMultiMonoClamp(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            SINT numFrames, int numChannels);
+
     // reverses stereo sample in place
     static void reverse(CSAMPLE* pBuffer, SINT numSamples);
 
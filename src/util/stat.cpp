@@ -1,5 +1,6 @@
 #include <limits>
 
+#include <QHash>
 #include <QStringList>
 #include <QtDebug>
 
@@ -7,6 +8,48 @@
 #include "util/time.h"
 #include "util/math.h"
 #include "util/statsmanager.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+// Tags are never removed from the registry. The number of distinct
+// tags is small and bounded.
+struct TagRegistry {
+    QMutex mutex;
+    QHash<QString, int> ids;
+    QVector<QString> names;
+};
+
+// Tags might be constructed during static initialization
+TagRegistry& tagRegistry() {
+    static TagRegistry s_registry;
+    return s_registry;
+}
+
+} // anonymous namespace
+
+StatTag::StatTag(const QString& name) {
+    TagRegistry& registry = tagRegistry();
+    const auto locker = lockMutex(&registry.mutex);
+    const auto it = registry.ids.constFind(name);
+    if (it != registry.ids.constEnd()) {
+        m_id = it.value();
+        return;
+    }
+    m_id = registry.names.size();
+    registry.names.append(name);
+    registry.ids.insert(name, m_id);
+}
+
+// static
+QString StatTag::nameOf(int id) {
+    TagRegistry& registry = tagRegistry();
+    const auto locker = lockMutex(&registry.mutex);
+    if (id < 0 || id >= registry.names.size()) {
+        return QString();
+    }
+    return registry.names.at(id);
+}
 
 Stat::Stat()
         : m_type(UNSPECIFIED),
@@ -137,19 +180,30 @@ QDebug operator<<(QDebug dbg, const Stat &stat) {
 }
 
 // static
-bool Stat::track(QString tag,
-                 Stat::StatType type,
-                 Stat::ComputeFlags compute,
-                 double value) {
+bool Stat::track(StatTag tag,
+        Stat::StatType type,
+        Stat::ComputeFlags compute,
+        double value) {
     if (!StatsManager::s_bStatsManagerEnabled) {
         return false;
     }
     StatReport report;
-    report.tag = std::move(tag);
+    report.tagId = tag.id();
     report.type = type;
     report.compute = compute;
     report.time = mixxx::Time::elapsed().toIntegerNanos();
     report.value = value;
     StatsManager* pManager = StatsManager::instance();
-    return pManager && pManager->maybeWriteReport(std::move(report));
+    return pManager && pManager->maybeWriteReport(report);
+}
+
+// static
+bool Stat::track(const QString& tag,
+        Stat::StatType type,
+        Stat::ComputeFlags compute,
+        double value) {
+    if (!StatsManager::s_bStatsManagerEnabled) {
+        return false;
+    }
+    return track(StatTag(tag), type, compute, value);
 }
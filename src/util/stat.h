@@ -3,11 +3,54 @@
 #include <QMap>
 #include <QVector>
 #include <QString>
+#include <type_traits>
 
 #include "util/experiment.h"
 
 struct StatReport;
 
+/// A tag that identifies a Stat or an Event.
+///
+/// Tags are interned once when they are constructed and are then
+/// referenced by an integer id. Reporting stats with a tag neither
+/// copies nor allocates strings. Tags should be constructed outside
+/// of real-time code, e.g. as function-local statics or members:
+/// static const StatTag tag(QStringLiteral("TAG TEXT"));
+class StatTag {
+  public:
+    StatTag()
+            : m_id(kInvalidId) {
+    }
+    explicit StatTag(const QString& name);
+
+    bool isValid() const {
+        return m_id != kInvalidId;
+    }
+
+    int id() const {
+        return m_id;
+    }
+
+    /// Returns a tag that has already been interned.
+    static StatTag fromId(int id) {
+        StatTag tag;
+        tag.m_id = id;
+        return tag;
+    }
+
+    /// Returns the name of the tag with the given id.
+    static QString nameOf(int id);
+
+    QString name() const {
+        return nameOf(m_id);
+    }
+
+  private:
+    static constexpr int kInvalidId = -1;
+
+    int m_id;
+};
+
 class Stat {
   public:
     enum StatType {
@@ -117,15 +160,21 @@ class Stat {
     double m_variance_sk;
     QMap<double, double> m_histogram;
 
-    static bool track(QString tag,
-                      Stat::StatType type,
-                      Stat::ComputeFlags compute,
-                      double value);
+    static bool track(StatTag tag,
+            Stat::StatType type,
+            Stat::ComputeFlags compute,
+            double value);
+
+    // Interns the tag on every invocation, prefer to use a StatTag instead.
+    static bool track(const QString& tag,
+            Stat::StatType type,
+            Stat::ComputeFlags compute,
+            double value);
 
     // Disallow to use this class with implicit converted char strings.
     // This should not be uses to avoid unicode encoding and memory
     // allocation at every call. Use a static tag like this:
-    // static const QString tag("TAG TEXT");
+    // static const StatTag tag(QStringLiteral("TAG TEXT"));
     static bool track(const char *,
                       Stat::StatType,
                       Stat::ComputeFlags,
@@ -134,10 +183,14 @@ class Stat {
 
 QDebug operator<<(QDebug dbg, const Stat &stat);
 
+// Reports are passed through lock-free queues and must not own
+// any memory that needs to be allocated or freed.
 struct StatReport {
-    QString tag;
-    qint64 time;
+    int tagId;
     Stat::StatType type;
     Stat::ComputeFlags compute;
+    qint64 time;
     double value;
 };
+static_assert(std::is_trivially_copyable_v<StatReport>,
+        "StatReport must be a plain record");
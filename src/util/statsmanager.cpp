@@ -1,23 +1,29 @@
 #include "util/statsmanager.h"
 
 #include <QFile>
+#include <QIODevice>
 #include <QMetaType>
 #include <QTextStream>
 #include <QtDebug>
 
 #include "moc_statsmanager.cpp"
+#include "util/assert.h"
 #include "util/cmdlineargs.h"
 #include "util/compatibility/qmutex.h"
 
 // In practice we process stats pipes about once a minute @1ms latency.
 constexpr int kStatsPipeSize = 1 << 10;
 constexpr int kProcessLength = kStatsPipeSize * 4 / 5;
+// The timeline keeps the most recent events. The audio callback alone
+// reports several durations per buffer, i.e. ~1000 events per second.
+constexpr int kMaxTimelineEvents = 1 << 20;
 
 // static
 bool StatsManager::s_bStatsManagerEnabled = false;
 
-StatsPipe::StatsPipe(StatsManager* pManager)
+StatsPipe::StatsPipe(StatsManager* pManager, int threadIndex)
         : m_pManager(pManager),
+          m_threadIndex(threadIndex),
           m_queue(kStatsPipeSize) {
     qRegisterMetaType<Stat>("Stat");
 }
@@ -30,7 +36,8 @@ StatsPipe::~StatsPipe() {
 
 StatsManager::StatsManager()
         : QThread(),
-          m_quit(0) {
+          m_quit(0),
+          m_droppedEvents(0) {
     s_bStatsManagerEnabled = true;
     setObjectName("StatsManager");
     moveToThread(this);
@@ -103,6 +110,35 @@ QString humanizeNanos(qint64 nanos) {
     return QString("%1ns").arg(QString::number(nanos));
 }
 
+QString toJsonString(const QString& text) {
+    QString result;
+    result.reserve(text.size() + 2);
+    result.append(QChar('"'));
+    for (const QChar ch : text) {
+        if (ch == QChar('"') || ch == QChar('\\')) {
+            result.append(QChar('\\'));
+            result.append(ch);
+        } else if (ch.unicode() < 0x20) {
+            result.append(QStringLiteral("\\u%1").arg(ch.unicode(), 4, 16, QChar('0')));
+        } else {
+            result.append(ch);
+        }
+    }
+    result.append(QChar('"'));
+    return result;
+}
+
+QString toTraceTimestamp(mixxx::Duration time) {
+    // Microseconds with nanosecond precision
+    return QString::number(time.toIntegerNanos() / 1000.0, 'f', 3);
+}
+
+bool isTimelineEvent(Stat::StatType type) {
+    return type == Stat::EVENT ||
+            type == Stat::EVENT_START ||
+            type == Stat::EVENT_END;
+}
+
 void StatsManager::writeTimeline(const QString& filename) {
     QFile timeline(filename);
     if (!timeline.open(QIODevice::WriteOnly | QIODevice::Text)) {
@@ -115,9 +151,17 @@ void StatsManager::writeTimeline(const QString& filename) {
         qDebug() << "No events recorded.";
         return;
     }
+    if (m_droppedEvents > 0) {
+        qDebug() << "Dropped the oldest" << m_droppedEvents << "events";
+    }
 
     // Sort by time.
-    std::sort(m_events.begin(), m_events.end(), OrderByTime());
+    std::stable_sort(m_events.begin(), m_events.end(), OrderByTime());
+
+    if (filename.endsWith(QStringLiteral(".json"), Qt::CaseInsensitive)) {
+        writeTraceEvents(&timeline);
+        return;
+    }
 
     mixxx::Duration last_time = m_events[0].m_time;
 
@@ -126,8 +170,12 @@ void StatsManager::writeTimeline(const QString& filename) {
 
     QTextStream out(&timeline);
     foreach (const Event& event, m_events) {
-        qint64 last_start = startTimes.value(event.m_tag, -1);
-        qint64 last_end = endTimes.value(event.m_tag, -1);
+        if (!isTimelineEvent(event.m_type)) {
+            continue;
+        }
+        const QString& tag = tagName(event.m_tag.id());
+        qint64 last_start = startTimes.value(tag, -1);
+        qint64 last_end = endTimes.value(tag, -1);
 
         qint64 duration_since_last_start = last_start == -1 ? 0 :
                 event.m_time.toIntegerNanos() - last_start;
@@ -137,15 +185,15 @@ void StatsManager::writeTimeline(const QString& filename) {
         if (event.m_type == Stat::EVENT_START) {
             // We last saw a start and we just saw another start.
             if (last_start > last_end) {
-                qDebug() << "Mismatched start/end pair" << event.m_tag;
+                qDebug() << "Mismatched start/end pair" << tag;
             }
-            startTimes[event.m_tag] = event.m_time.toIntegerNanos();
+            startTimes[tag] = event.m_time.toIntegerNanos();
         } else if (event.m_type == Stat::EVENT_END) {
             // We last saw an end and we just saw another end.
             if (last_end > last_start) {
-                qDebug() << "Mismatched start/end pair" << event.m_tag;
+                qDebug() << "Mismatched start/end pair" << tag;
             }
-            endTimes[event.m_tag] = event.m_time.toIntegerNanos();
+            endTimes[tag] = event.m_time.toIntegerNanos();
         }
 
         // TODO(rryan): CSV escaping
@@ -155,13 +203,63 @@ void StatsManager::writeTimeline(const QString& filename) {
             << "+" << humanizeNanos(duration_since_last_start) << ","
             << "+" << humanizeNanos(duration_since_last_end) << ","
             << Stat::statTypeToString(event.m_type) << ","
-            << event.m_tag << "\n";
+            << tag << "\n";
         last_time = event.m_time;
     }
 
     timeline.close();
 }
 
+void StatsManager::writeTraceEvents(QIODevice* pDevice) {
+    QTextStream out(pDevice);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+           "\"args\":{\"name\":\"Mixxx\"}}";
+    for (int threadIndex = 0; threadIndex < m_threadNames.size(); ++threadIndex) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            << "\"tid\":" << threadIndex << ","
+            << "\"args\":{\"name\":" << toJsonString(m_threadNames[threadIndex]) << "}}";
+    }
+    for (const Event& event : qAsConst(m_events)) {
+        out << ",\n{\"name\":" << toJsonString(tagName(event.m_tag.id()))
+            << ",\"pid\":1,\"tid\":" << event.m_threadIndex;
+        switch (event.m_type) {
+        case Stat::EVENT_START:
+            out << ",\"ph\":\"B\",\"ts\":" << toTraceTimestamp(event.m_time);
+            break;
+        case Stat::EVENT_END:
+            out << ",\"ph\":\"E\",\"ts\":" << toTraceTimestamp(event.m_time);
+            break;
+        case Stat::DURATION_NANOSEC:
+            // Durations are reported when they end
+            out << ",\"ph\":\"X\",\"ts\":"
+                << toTraceTimestamp(event.m_time - event.m_duration)
+                << ",\"dur\":" << toTraceTimestamp(event.m_duration);
+            break;
+        default:
+            out << ",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << toTraceTimestamp(event.m_time);
+            break;
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+}
+
+const QString& StatsManager::tagName(int tagId) {
+    VERIFY_OR_DEBUG_ASSERT(tagId >= 0) {
+        static const QString kEmpty;
+        return kEmpty;
+    }
+    if (tagId >= m_tagNames.size()) {
+        m_tagNames.resize(tagId + 1);
+    }
+    QString& name = m_tagNames[tagId];
+    if (name.isNull()) {
+        name = StatTag::nameOf(tagId);
+    }
+    return name;
+}
+
 void StatsManager::onStatsPipeDestroyed(StatsPipe* pPipe) {
     const auto locker = lockMutex(&m_statsPipeLock);
     processIncomingStatReports();
@@ -172,19 +270,25 @@ StatsPipe* StatsManager::getStatsPipeForThread() {
     if (m_threadStatsPipes.hasLocalData()) {
         return m_threadStatsPipes.localData();
     }
-    StatsPipe* pResult = new StatsPipe(this);
-    m_threadStatsPipes.setLocalData(pResult);
+    QString threadName = QThread::currentThread()->objectName();
     const auto locker = lockMutex(&m_statsPipeLock);
+    const int threadIndex = m_threadNames.size();
+    if (threadName.isEmpty()) {
+        threadName = QStringLiteral("Thread %1").arg(threadIndex);
+    }
+    m_threadNames.append(threadName);
+    StatsPipe* pResult = new StatsPipe(this, threadIndex);
+    m_threadStatsPipes.setLocalData(pResult);
     m_statsPipes.push_back(pResult);
     return pResult;
 }
 
-bool StatsManager::maybeWriteReport(StatReport report) {
+bool StatsManager::maybeWriteReport(const StatReport& report) {
     StatsPipe* pStatsPipe = getStatsPipeForThread();
     if (!pStatsPipe) {
         return false;
     }
-    bool success = pStatsPipe->enqueue(std::move(report));
+    bool success = pStatsPipe->enqueue(report);
     if (pStatsPipe->remainingCapacity() < kProcessLength) {
         m_statsPipeCondition.wakeAll();
     }
@@ -198,10 +302,11 @@ bool StatsManager::maybeWriteReport(StatReport report) {
 }
 
 void StatsManager::processIncomingStatReports() {
+    const bool timelineEnabled = CmdlineArgs::Instance().getTimelineEnabled();
     StatReport report;
     foreach (StatsPipe* pStatsPipe, m_statsPipes) {
         while (pStatsPipe->dequeue(&report)) {
-            QString tag = report.tag;
+            const QString& tag = tagName(report.tagId);
             Stat& info = m_stats[tag];
             info.m_tag = tag;
             info.m_type = report.type;
@@ -223,14 +328,25 @@ void StatsManager::processIncomingStatReports() {
                 base.processReport(report);
             }
 
-            if (CmdlineArgs::Instance().getTimelineEnabled() &&
-                    (report.type == Stat::EVENT ||
-                     report.type == Stat::EVENT_START ||
-                     report.type == Stat::EVENT_END)) {
+            if (timelineEnabled &&
+                    (isTimelineEvent(report.type) ||
+                            report.type == Stat::DURATION_NANOSEC)) {
                 Event event;
-                event.m_tag = tag;
+                event.m_tag = StatTag::fromId(report.tagId);
                 event.m_type = report.type;
                 event.m_time = mixxx::Duration::fromNanos(report.time);
+                if (report.type == Stat::DURATION_NANOSEC) {
+                    event.m_duration = mixxx::Duration::fromNanos(
+                            static_cast<qint64>(report.value));
+                }
+                event.m_threadIndex = pStatsPipe->threadIndex();
+                if (m_events.size() >= kMaxTimelineEvents) {
+                    if (m_droppedEvents == 0) {
+                        qWarning() << "Timeline is full, dropping the oldest events";
+                    }
+                    m_events.removeFirst();
+                    ++m_droppedEvents;
+                }
                 m_events.append(event);
             }
         }
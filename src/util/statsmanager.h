@@ -10,6 +10,7 @@
 #include <QWaitCondition>
 #include <QThreadStorage>
 #include <QList>
+#include <QVector>
 
 #include "rigtorp/SPSCQueue.h"
 
@@ -21,11 +22,11 @@ class StatsManager;
 
 class StatsPipe final {
   public:
-    explicit StatsPipe(StatsManager* pManager);
+    StatsPipe(StatsManager* pManager, int threadIndex);
     ~StatsPipe();
 
-    bool enqueue(StatReport report) {
-        return m_queue.try_emplace(std::move(report));
+    bool enqueue(const StatReport& report) {
+        return m_queue.try_emplace(report);
     }
 
     bool dequeue(StatReport* pReport) {
@@ -42,8 +43,13 @@ class StatsPipe final {
         return m_queue.capacity() - m_queue.size();
     }
 
+    int threadIndex() const {
+        return m_threadIndex;
+    }
+
   private:
     StatsManager* m_pManager;
+    const int m_threadIndex;
     rigtorp::SPSCQueue<StatReport> m_queue;
 };
 
@@ -54,7 +60,7 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     virtual ~StatsManager();
 
     // Returns true if write succeeds.
-    bool maybeWriteReport(StatReport report);
+    bool maybeWriteReport(const StatReport& report);
 
     static bool s_bStatsManagerEnabled;
 
@@ -78,6 +84,10 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     StatsPipe* getStatsPipeForThread();
     void onStatsPipeDestroyed(StatsPipe* pPipe);
     void writeTimeline(const QString& filename);
+    // Writes the timeline in the Trace Event Format that is understood
+    // by chrome://tracing and https://ui.perfetto.dev
+    void writeTraceEvents(QIODevice* pDevice);
+    const QString& tagName(int tagId);
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
@@ -85,11 +95,17 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     QMap<QString, Stat> m_baseStats;
     QMap<QString, Stat> m_experimentStats;
     QList<Event> m_events;
+    int m_droppedEvents;
+    // Cached names of interned tags, indexed by id
+    QVector<QString> m_tagNames;
 
     QWaitCondition m_statsPipeCondition;
     QMutex m_statsPipeLock;
     QList<StatsPipe*> m_statsPipes;
     QThreadStorage<StatsPipe*> m_threadStatsPipes;
+    // The names of all threads that have reported stats, indexed
+    // by the thread index of their StatsPipe
+    QVector<QString> m_threadNames;
 
     friend class StatsPipe;
 };
@@ -6,7 +6,11 @@
 #include "waveform/guitick.h"
 
 Timer::Timer(const QString& key, Stat::ComputeFlags compute)
-        : m_key(key),
+        : Timer(StatTag(key), compute) {
+}
+
+Timer::Timer(StatTag tag, Stat::ComputeFlags compute)
+        : m_tag(tag),
           m_compute(Stat::experimentFlags(compute)),
           m_running(false) {
 }
@@ -23,7 +27,7 @@ mixxx::Duration Timer::restart(bool report) {
             // Ignore the report if it crosses the experiment boundary.
             Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
             if (oldMode == Experiment::mode()) {
-                Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+                Stat::track(m_tag, Stat::DURATION_NANOSEC, m_compute,
                             elapsed.toIntegerNanos());
             }
         }
@@ -40,7 +44,7 @@ mixxx::Duration Timer::elapsed(bool report) {
         // Ignore the report if it crosses the experiment boundary.
         Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
         if (oldMode == Experiment::mode()) {
-            Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+            Stat::track(m_tag, Stat::DURATION_NANOSEC, m_compute,
                         elapsedTime.toIntegerNanos());
         }
     }
@@ -74,7 +78,7 @@ mixxx::Duration SuspendableTimer::elapsed(bool report) {
         // Ignore the report if it crosses the experiment boundary.
         Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
         if (oldMode == Experiment::mode()) {
-            Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+            Stat::track(m_tag, Stat::DURATION_NANOSEC, m_compute,
                         m_leapTime.toIntegerNanos());
         }
     }
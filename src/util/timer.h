@@ -19,6 +19,8 @@ class Timer {
   public:
     Timer(const QString& key,
           Stat::ComputeFlags compute = kDefaultComputeFlags);
+    explicit Timer(StatTag tag,
+            Stat::ComputeFlags compute = kDefaultComputeFlags);
     void start();
 
     // Restart the timer returning the time duration since it was last
@@ -31,7 +33,7 @@ class Timer {
     mixxx::Duration elapsed(bool report);
 
   protected:
-    QString m_key;
+    StatTag m_tag;
     Stat::ComputeFlags m_compute;
     bool m_running;
     PerformanceTimer m_time;
@@ -79,6 +81,19 @@ class ScopedTimer {
         }
     }
 
+    // The constructors above intern the key on every invocation. Prefer
+    // this one in the engine, e.g. with
+    // static const StatTag tag(QStringLiteral("TAG TEXT"));
+    explicit ScopedTimer(const StatTag& tag,
+            Stat::ComputeFlags compute = kDefaultComputeFlags)
+            : m_pTimer(NULL),
+              m_cancel(false) {
+        if (CmdlineArgs::Instance().getDeveloper()) {
+            m_pTimer = new (m_timerMem) Timer(tag, compute);
+            m_pTimer->start();
+        }
+    }
+
     virtual ~ScopedTimer() {
         if (m_pTimer) {
             if (!m_cancel) {
@@ -38,13 +38,27 @@ class Trace {
         }
     }
 
+    // The constructors above intern the tags on every invocation. Prefer
+    // this one in the engine, the duration tag is named "<tag>_duration"
+    // by convention.
+    Trace(const StatTag& eventTag, const StatTag& durationTag)
+            : m_writeToStdout(false),
+              m_time(true) {
+        if (CmdlineArgs::Instance().getDeveloper()) {
+            m_eventTag = eventTag;
+            m_durationTag = durationTag;
+            Event::start(m_eventTag);
+            m_timer.start();
+        }
+    }
+
     virtual ~Trace() {
-        // Proxy for whether initialize was called.
-        if (m_tag.isEmpty()) {
+        // Proxy for whether the trace has been started.
+        if (!m_eventTag.isValid()) {
             return;
         }
 
-        Event::end(m_tag);
+        Event::end(m_eventTag);
 
         if (m_time) {
             mixxx::Duration elapsed = m_timer.elapsed();
@@ -53,12 +67,12 @@ class Trace {
                          << elapsed.debugNanosWithUnit();
             }
 
-            // NOTE(rryan) do we need to do this string append? We could add
+            // NOTE(rryan) do we need a separate tag? We could add
             // a check in StatsManager to infer that a DURATION_NANOSEC
             // event for the same tag that has an EVENT_START/EVENT_END is a
             // duration instead of changing the tag.
             Stat::track(
-                m_tag + "_duration",
+                m_durationTag,
                 Stat::DURATION_NANOSEC,
                 Stat::COUNT | Stat::AVERAGE | Stat::SAMPLE_VARIANCE |
                 Stat::MAX | Stat::MIN,
@@ -75,8 +89,12 @@ class Trace {
         } else {
             m_tag = key.arg(arg);
         }
+        m_eventTag = StatTag(m_tag);
+        if (m_time) {
+            m_durationTag = StatTag(m_tag + QStringLiteral("_duration"));
+        }
 
-        Event::start(m_tag);
+        Event::start(m_eventTag);
         if (m_time) {
             m_timer.start();
         }
@@ -86,6 +104,8 @@ class Trace {
     }
 
     QString m_tag;
+    StatTag m_eventTag;
+    StatTag m_durationTag;
     const bool m_writeToStdout, m_time;
     PerformanceTimer m_timer;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QBrush>
 #include <QDomNode>
 #include <QImage>
 
@@ -103,6 +104,8 @@ class WaveformMark {
     std::unique_ptr<ControlProxy> m_pVisibleCO;
     int m_iHotCue;
     QImage m_image;
+    // The gradient of the range, which depends on the size like m_image
+    QBrush m_rangeBrush;
 
     QColor m_fillColor;
     QColor m_borderColor;
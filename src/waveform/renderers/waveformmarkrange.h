@@ -40,6 +40,20 @@ class WaveformMarkRange {
 
     bool showDuration() const;
 
+    // Connects the changes of the start, end, enabled and visibility
+    // controls, i.e. of everything that is drawn differently.
+    template<typename Receiver, typename Slot>
+    void connectChanged(Receiver receiver, Slot slot) const {
+        for (ControlProxy* pControl : {m_markStartPointControl.get(),
+                     m_markEndPointControl.get(),
+                     m_markEnabledControl.get(),
+                     m_markVisibleControl.get()}) {
+            if (pControl) {
+                pControl->connectValueChanged(receiver, slot, Qt::AutoConnection);
+            }
+        }
+    }
+
     enum class DurationTextLocation {
         Before = 0,
         After = 1
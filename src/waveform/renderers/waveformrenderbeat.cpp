@@ -1,6 +1,7 @@
 #include <QDomNode>
 #include <QPaintEvent>
 #include <QPainter>
+#include <algorithm>
 
 #include "waveform/renderers/waveformrenderbeat.h"
 
@@ -12,7 +13,10 @@
 #include "util/painterscope.h"
 
 WaveformRenderBeat::WaveformRenderBeat(WaveformWidgetRenderer* waveformWidgetRenderer)
-        : WaveformRendererAbstract(waveformWidgetRenderer) {
+        : WaveformRendererAbstract(waveformWidgetRenderer),
+          m_cachedTrackSamples(0),
+          m_cachedFirstSample(0.0),
+          m_cachedLastSample(0.0) {
     m_beats.resize(128);
 }
 
@@ -47,23 +51,27 @@ void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
         return;
     }
 
-    const double firstDisplayedPosition =
-            m_waveformRenderer->getFirstDisplayedPosition();
-    const double lastDisplayedPosition =
-            m_waveformRenderer->getLastDisplayedPosition();
-
-    // qDebug() << "trackSamples" << trackSamples
-    //          << "firstDisplayedPosition" << firstDisplayedPosition
-    //          << "lastDisplayedPosition" << lastDisplayedPosition;
+    const double firstDisplayedSample =
+            m_waveformRenderer->getFirstDisplayedPosition() * trackSamples;
+    const double lastDisplayedSample =
+            m_waveformRenderer->getLastDisplayedPosition() * trackSamples;
+    if (trackBeats != m_pCachedBeats ||
+            trackSamples != m_cachedTrackSamples ||
+            firstDisplayedSample < m_cachedFirstSample ||
+            lastDisplayedSample > m_cachedLastSample) {
+        updateBeatPositions(trackBeats,
+                trackSamples,
+                firstDisplayedSample,
+                lastDisplayedSample);
+    }
 
-    const auto startPosition = mixxx::audio::FramePos::fromEngineSamplePos(
-            firstDisplayedPosition * trackSamples);
-    const auto endPosition = mixxx::audio::FramePos::fromEngineSamplePos(
-            lastDisplayedPosition * trackSamples);
-    auto it = trackBeats->iteratorFrom(startPosition);
+    const auto firstBeat = std::lower_bound(
+            m_beatPositions.cbegin(), m_beatPositions.cend(), firstDisplayedSample);
+    const auto endBeat = std::upper_bound(
+            firstBeat, m_beatPositions.cend(), lastDisplayedSample);
 
     // if no beat do not waste time saving/restoring painter
-    if (it == trackBeats->cend() || *it > endPosition) {
+    if (firstBeat == endBeat) {
         return;
     }
 
@@ -71,35 +79,63 @@ void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
 
     painter->setRenderHint(QPainter::Antialiasing);
 
-    QPen beatPen(m_beatColor);
-    beatPen.setWidthF(std::max(1.0, scaleFactor()));
-    painter->setPen(beatPen);
+    // Only replaced on changes, because modifying the pen after it has been
+    // shared with the painter would detach it on every frame.
+    const double beatWidth = std::max(1.0, scaleFactor());
+    if (m_beatPen.color() != m_beatColor || m_beatPen.widthF() != beatWidth) {
+        m_beatPen = QPen(m_beatColor);
+        m_beatPen.setWidthF(beatWidth);
+    }
+    painter->setPen(m_beatPen);
 
     const Qt::Orientation orientation = m_waveformRenderer->getOrientation();
     const float rendererWidth = m_waveformRenderer->getWidth();
     const float rendererHeight = m_waveformRenderer->getHeight();
 
-    int beatCount = 0;
-
-    for (; it != trackBeats->cend() && *it <= endPosition; ++it) {
-        double beatPosition = it->toEngineSamplePos();
-        double xBeatPoint =
-                m_waveformRenderer->transformSamplePositionInRendererWorld(beatPosition);
-
-        xBeatPoint = qRound(xBeatPoint);
-
-        // If we don't have enough space, double the size.
-        if (beatCount >= m_beats.size()) {
-            m_beats.resize(m_beats.size() * 2);
-        }
+    const int beatCount = static_cast<int>(endBeat - firstBeat);
+    // If we don't have enough space, double the size.
+    while (beatCount > m_beats.size()) {
+        m_beats.resize(m_beats.size() * 2);
+    }
 
+    QLineF* pLine = m_beats.data();
+    for (auto it = firstBeat; it != endBeat; ++it, ++pLine) {
+        const double xBeatPoint = qRound(
+                m_waveformRenderer->transformSamplePositionInRendererWorld(*it));
         if (orientation == Qt::Horizontal) {
-            m_beats[beatCount++].setLine(xBeatPoint, 0.0f, xBeatPoint, rendererHeight);
+            pLine->setLine(xBeatPoint, 0.0f, xBeatPoint, rendererHeight);
         } else {
-            m_beats[beatCount++].setLine(0.0f, xBeatPoint, rendererWidth, xBeatPoint);
+            pLine->setLine(0.0f, xBeatPoint, rendererWidth, xBeatPoint);
         }
     }
 
     // Make sure to use constData to prevent detaches!
     painter->drawLines(m_beats.constData(), beatCount);
 }
+
+void WaveformRenderBeat::updateBeatPositions(
+        const mixxx::BeatsPointer& pBeats,
+        int trackSamples,
+        double firstDisplayedSample,
+        double lastDisplayedSample) {
+    // The play position marker can be dragged to the edges of the widget,
+    // so beats before the start and after the end of the track are visible.
+    // The margin covers the whole view, which keeps the cache valid while
+    // zooming and changing the rate within these limits.
+    const double marginSamples = lastDisplayedSample - firstDisplayedSample;
+    m_pCachedBeats = pBeats;
+    m_cachedTrackSamples = trackSamples;
+    m_cachedFirstSample = std::min(firstDisplayedSample, 0.0) - marginSamples;
+    m_cachedLastSample = std::max(lastDisplayedSample, static_cast<double>(trackSamples)) +
+            marginSamples;
+
+    // Keeps the capacity of the previous positions
+    m_beatPositions.clear();
+    const auto endPosition = mixxx::audio::FramePos::fromEngineSamplePos(m_cachedLastSample);
+    for (auto it = pBeats->iteratorFrom(
+                 mixxx::audio::FramePos::fromEngineSamplePos(m_cachedFirstSample));
+            it != pBeats->cend() && *it <= endPosition;
+            ++it) {
+        m_beatPositions.push_back(it->toEngineSamplePos());
+    }
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <QColor>
+#include <QPen>
+#include <vector>
 
 #include "skin/legacy/skincontext.h"
+#include "track/beats.h"
 #include "util/class.h"
 #include "waveform/renderers/waveformrendererabstract.h"
 
@@ -15,8 +18,26 @@ class WaveformRenderBeat : public WaveformRendererAbstract {
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
   private:
+    // Collects the positions of the beats in samples around the displayed
+    // range, including the beats before the start and after the end of
+    // the track.
+    void updateBeatPositions(
+            const mixxx::BeatsPointer& pBeats,
+            int trackSamples,
+            double firstDisplayedSample,
+            double lastDisplayedSample);
+
     QColor m_beatColor;
+    QPen m_beatPen;
     QVector<QLineF> m_beats;
 
+    // The beat positions in samples only change with the beats. Each frame
+    // transforms the visible ones into the renderer world.
+    std::vector<double> m_beatPositions;
+    mixxx::BeatsPointer m_pCachedBeats;
+    int m_cachedTrackSamples;
+    double m_cachedFirstSample;
+    double m_cachedLastSample;
+
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderBeat);
 };
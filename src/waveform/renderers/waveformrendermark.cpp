@@ -28,12 +28,26 @@ WaveformRenderMark::WaveformRenderMark(
 void WaveformRenderMark::setup(const QDomNode& node, const SkinContext& context) {
     WaveformSignalColors signalColors = *m_waveformRenderer->getWaveformSignalColors();
     m_marks.setup(m_waveformRenderer->getGroup(), node, context, signalColors);
+    // The moved marks have to be rendered even if the view is unchanged
+    for (const auto& pMark : m_marks) {
+        if (pMark->isValid()) {
+            pMark->connectSamplePositionChanged(this,
+                    &WaveformRenderMark::slotMarkChanged);
+            pMark->connectSampleEndPositionChanged(this,
+                    &WaveformRenderMark::slotMarkChanged);
+        }
+        if (pMark->hasVisible()) {
+            pMark->connectVisibleChanged(this,
+                    &WaveformRenderMark::slotMarkChanged);
+        }
+    }
 }
 
 void WaveformRenderMark::draw(QPainter* painter, QPaintEvent* /*event*/) {
     PainterScope PainterScope(painter);
-    // Maps mark objects to their positions in the widget.
-    QMap<WaveformMarkPointer, int> marksOnScreen;
+    // The marks with their positions in the widget. Clearing keeps the
+    // capacity of the buffer that has been handed back by the last frame.
+    m_marksOnScreen.clear();
     /*
     //DEBUG
     for (int i = 0; i < m_markPoints.size(); i++) {
@@ -87,27 +101,18 @@ void WaveformRenderMark::draw(QPainter* painter, QPaintEvent* /*event*/) {
                             m_waveformRenderer->transformSamplePositionInRendererWorld(
                                     sampleEndPosition);
                     if (visible || currentMarkEndPoint > 0) {
-                        QColor color = pMark->fillColor();
-                        color.setAlphaF(0.4);
-
-                        QLinearGradient gradient(QPointF(0, 0),
-                                QPointF(0, m_waveformRenderer->getHeight()));
-                        gradient.setColorAt(0, color);
-                        gradient.setColorAt(0.25, QColor(Qt::transparent));
-                        gradient.setColorAt(0.75, QColor(Qt::transparent));
-                        gradient.setColorAt(1, color);
                         painter->fillRect(
                                 QRectF(QPointF(currentMarkPoint, 0),
                                         QPointF(currentMarkEndPoint,
                                                 m_waveformRenderer
                                                         ->getHeight())),
-                                QBrush(gradient));
+                                pMark->m_rangeBrush);
                         visible = true;
                     }
                 }
 
                 if (visible) {
-                    marksOnScreen[pMark] = drawOffset;
+                    m_marksOnScreen.append({pMark, drawOffset});
                 }
             } else {
                 const int markHalfHeight = static_cast<int>(pMark->m_image.height() / 2.0);
@@ -130,31 +135,22 @@ void WaveformRenderMark::draw(QPainter* painter, QPaintEvent* /*event*/) {
                                     ->transformSamplePositionInRendererWorld(
                                             sampleEndPosition);
                     if (currentMarkEndPoint < m_waveformRenderer->getHeight()) {
-                        QColor color = pMark->fillColor();
-                        color.setAlphaF(0.4);
-
-                        QLinearGradient gradient(QPointF(0, 0),
-                                QPointF(m_waveformRenderer->getWidth(), 0));
-                        gradient.setColorAt(0, color);
-                        gradient.setColorAt(0.25, QColor(Qt::transparent));
-                        gradient.setColorAt(0.75, QColor(Qt::transparent));
-                        gradient.setColorAt(1, color);
                         painter->fillRect(
                                 QRectF(QPointF(0, currentMarkPoint),
                                         QPointF(m_waveformRenderer->getWidth(),
                                                 currentMarkEndPoint)),
-                                QBrush(gradient));
+                                pMark->m_rangeBrush);
                         visible = true;
                     }
                 }
 
                 if (visible) {
-                    marksOnScreen[pMark] = drawOffset;
+                    m_marksOnScreen.append({pMark, drawOffset});
                 }
             }
         }
     }
-    m_waveformRenderer->setMarkPositions(marksOnScreen);
+    m_waveformRenderer->swapMarkPositions(&m_marksOnScreen);
 }
 
 void WaveformRenderMark::onResize() {
@@ -177,11 +173,16 @@ void WaveformRenderMark::onSetTrack() {
             &WaveformRenderMark::slotCuesUpdated);
 }
 
+void WaveformRenderMark::slotMarkChanged() {
+    m_waveformRenderer->requestRender();
+}
+
 void WaveformRenderMark::slotCuesUpdated() {
     TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
     if (!trackInfo) {
         return;
     }
+    m_waveformRenderer->requestRender();
 
     QList<CuePointer> loadedCues = trackInfo->getCuePoints();
     for (const CuePointer& pCue : loadedCues) {
@@ -210,7 +211,30 @@ void WaveformRenderMark::slotCuesUpdated() {
     }
 }
 
+void WaveformRenderMark::generateRangeBrush(WaveformMarkPointer pMark) {
+    QColor color = pMark->fillColor();
+    color.setAlphaF(0.4);
+
+    QLinearGradient gradient;
+    if (m_waveformRenderer->getOrientation() == Qt::Horizontal) {
+        gradient = QLinearGradient(QPointF(0, 0),
+                QPointF(0, m_waveformRenderer->getHeight()));
+    } else {
+        gradient = QLinearGradient(QPointF(0, 0),
+                QPointF(m_waveformRenderer->getWidth(), 0));
+    }
+    gradient.setColorAt(0, color);
+    gradient.setColorAt(0.25, QColor(Qt::transparent));
+    gradient.setColorAt(0.75, QColor(Qt::transparent));
+    gradient.setColorAt(1, color);
+    pMark->m_rangeBrush = QBrush(gradient);
+}
+
 void WaveformRenderMark::generateMarkImage(WaveformMarkPointer pMark) {
+    // The range is regenerated together with the image, which happens when
+    // the color or the size of the renderer changes.
+    generateRangeBrush(pMark);
+
     // Load the pixmap from file.
     // If that succeeds loading the text and stroke is skipped.
     float devicePixelRatio = m_waveformRenderer->getDevicePixelRatio();
@@ -7,6 +7,7 @@
 #include "util/color/color.h"
 #include "waveform/renderers/waveformmarkset.h"
 #include "waveform/renderers/waveformrendererabstract.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
 #include "track/cue.h"
 #include "preferences/configobject.h"
 
@@ -31,9 +32,15 @@ class WaveformRenderMark : public QObject, public WaveformRendererAbstract {
     // This method is used for hotcues.
     void slotCuesUpdated();
 
+  private slots:
+    void slotMarkChanged();
+
   private:
     void generateMarkImage(WaveformMarkPointer pMark);
+    void generateRangeBrush(WaveformMarkPointer pMark);
 
     WaveformMarkSet m_marks;
+    // Reused for every frame, see WaveformWidgetRenderer::swapMarkPositions()
+    QVector<WaveformWidgetRenderer::MarkOnScreen> m_marksOnScreen;
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderMark);
 };
@@ -8,6 +8,7 @@
 
 #include "waveform/renderers/waveformrendermarkrange.h"
 
+#include "moc_waveformrendermarkrange.cpp"
 #include "preferences/usersettings.h"
 #include "track/track.h"
 #include "waveform/renderers/waveformwidgetrenderer.h"
@@ -35,6 +36,15 @@ void WaveformRenderMarkRange::setup(const QDomNode& node, const SkinContext& con
         }
         child = child.nextSibling();
     }
+    // Changed ranges, e.g. of a loop on a paused deck, have to be rendered
+    // even if the view is unchanged
+    for (const auto& markRange : m_markRanges) {
+        markRange.connectChanged(this, &WaveformRenderMarkRange::slotMarkRangeChanged);
+    }
+}
+
+void WaveformRenderMarkRange::slotMarkRangeChanged() {
+    m_waveformRenderer->requestRender();
 }
 
 void WaveformRenderMarkRange::draw(QPainter *painter, QPaintEvent * /*event*/) {
@@ -16,7 +16,8 @@
 class ConfigKey;
 class ControlObject;
 
-class WaveformRenderMarkRange : public WaveformRendererAbstract {
+class WaveformRenderMarkRange : public QObject, public WaveformRendererAbstract {
+    Q_OBJECT
   public:
     explicit WaveformRenderMarkRange(WaveformWidgetRenderer* waveformWidgetRenderer);
     ~WaveformRenderMarkRange() override = default;
@@ -24,6 +25,9 @@ class WaveformRenderMarkRange : public WaveformRendererAbstract {
     void setup(const QDomNode& node, const SkinContext& context) override;
     void draw(QPainter* painter, QPaintEvent* event) override;
 
+  private slots:
+    void slotMarkRangeChanged();
+
   private:
     void generateImages();
 
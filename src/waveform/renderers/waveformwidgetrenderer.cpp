@@ -2,6 +2,7 @@
 
 #include <QPainter>
 #include <QPainterPath>
+#include <algorithm>
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
@@ -50,7 +51,8 @@ WaveformWidgetRenderer::WaveformWidgetRenderer(const QString& group)
           m_pTrackSamplesControlObject(nullptr),
           m_trackSamples(0.0),
           m_scaleFactor(1.0),
-          m_playMarkerPosition(s_defaultPlayMarkerPosition) {
+          m_playMarkerPosition(s_defaultPlayMarkerPosition),
+          m_renderRequested(true) {
     //qDebug() << "WaveformWidgetRenderer";
 
 #ifdef WAVEFORMWIDGETRENDERER_DEBUG
@@ -107,6 +109,7 @@ void WaveformWidgetRenderer::onPreRender(VSyncThread* vsyncThread) {
     // For a valid track to render we need
     m_trackSamples = static_cast<int>(m_pTrackSamplesControlObject->get());
     if (m_trackSamples <= 0) {
+        m_preparedFrameState = currentFrameState();
         return;
     }
 
@@ -172,6 +175,42 @@ void WaveformWidgetRenderer::onPreRender(VSyncThread* vsyncThread) {
     //        "m_playPos" << m_playPos <<
     //        "m_rateRatio" << m_rate <<
     //        "m_gain" << m_gain;
+
+    m_preparedFrameState = currentFrameState();
+}
+
+bool WaveformWidgetRenderer::FrameState::operator!=(const FrameState& other) const {
+    return pTrack != other.pTrack ||
+            pBeats != other.pBeats ||
+            pWaveform != other.pWaveform ||
+            waveformCompletion != other.waveformCompletion ||
+            trackSamples != other.trackSamples ||
+            playPos != other.playPos ||
+            trackPixelCount != other.trackPixelCount ||
+            gain != other.gain ||
+            playMarkerPosition != other.playMarkerPosition ||
+            alphaBeatGrid != other.alphaBeatGrid;
+}
+
+WaveformWidgetRenderer::FrameState WaveformWidgetRenderer::currentFrameState() const {
+    FrameState state;
+    const TrackPointer pTrack = m_pTrack;
+    if (pTrack) {
+        state.pTrack = pTrack.get();
+        state.pBeats = pTrack->getBeats().get();
+        const ConstWaveformPointer pWaveform = pTrack->getWaveform();
+        if (pWaveform) {
+            state.pWaveform = pWaveform.data();
+            state.waveformCompletion = pWaveform->getCompletion();
+        }
+    }
+    state.trackSamples = m_trackSamples;
+    state.playPos = m_playPos;
+    state.trackPixelCount = m_trackPixelCount;
+    state.gain = m_gain;
+    state.playMarkerPosition = m_playMarkerPosition;
+    state.alphaBeatGrid = m_alphaBeatGrid;
+    return state;
 }
 
 void WaveformWidgetRenderer::draw(QPainter* painter, QPaintEvent* event) {
@@ -311,6 +350,7 @@ void WaveformWidgetRenderer::resize(int width, int height, float devicePixelRati
     m_width = width;
     m_height = height;
     m_devicePixelRatio = devicePixelRatio;
+    requestRender();
     for (int i = 0; i < m_rendererStack.size(); ++i) {
         m_rendererStack[i]->setDirty(true);
         m_rendererStack[i]->onResize();
@@ -353,6 +393,7 @@ void WaveformWidgetRenderer::setTrack(TrackPointer track) {
     m_pTrack = track;
     //used to postpone first display until track sample is actually available
     m_trackSamples = -1.0;
+    requestRender();
 
     for (int i = 0; i < m_rendererStack.size(); ++i) {
         m_rendererStack[i]->onSetTrack();
@@ -360,13 +401,21 @@ void WaveformWidgetRenderer::setTrack(TrackPointer track) {
 }
 
 WaveformMarkPointer WaveformWidgetRenderer::getCueMarkAtPoint(QPoint point) const {
-    for (auto it = m_markPositions.constBegin(); it != m_markPositions.constEnd(); ++it) {
-        WaveformMarkPointer pMark = it.key();
+    // Overlapping marks are picked in the order of their addresses, which
+    // is arbitrary but stable while the marks exist.
+    QVector<MarkOnScreen> markPositions = m_markPositions;
+    std::sort(markPositions.begin(),
+            markPositions.end(),
+            [](const MarkOnScreen& lhs, const MarkOnScreen& rhs) {
+                return lhs.pMark < rhs.pMark;
+            });
+    for (const auto& markOnScreen : std::as_const(markPositions)) {
+        const WaveformMarkPointer& pMark = markOnScreen.pMark;
         VERIFY_OR_DEBUG_ASSERT(pMark) {
             continue;
         }
 
-        int markImagePositionInWidgetSpace = it.value();
+        int markImagePositionInWidgetSpace = markOnScreen.drawOffset;
         QPoint pointInImageSpace;
         if (getOrientation() == Qt::Horizontal) {
             pointInImageSpace = QPoint(point.x() - markImagePositionInWidgetSpace, point.y());
@@ -17,9 +17,20 @@
 class ControlProxy;
 class VisualPlayPosition;
 class VSyncThread;
+class Waveform;
+
+namespace mixxx {
+class Beats;
+} // namespace mixxx
 
 class WaveformWidgetRenderer {
   public:
+    /// A mark and the position of its image in the widget
+    struct MarkOnScreen {
+        WaveformMarkPointer pMark;
+        int drawOffset;
+    };
+
     static const double s_waveformMinZoom;
     static const double s_waveformMaxZoom;
     static const double s_waveformDefaultZoom;
@@ -36,6 +47,24 @@ class WaveformWidgetRenderer {
     void onPreRender(VSyncThread* vsyncThread);
     void draw(QPainter* painter, QPaintEvent* event);
 
+    /// Whether the frame that has been prepared by onPreRender() looks
+    /// different from the last rendered one. This is the case while the deck
+    /// is playing, when the play position has been moved and when the track,
+    /// its beats, its waveform, the zoom, the gain or the size have changed.
+    bool isFrameChanged() const {
+        return m_renderRequested || m_preparedFrameState != m_renderedFrameState;
+    }
+    /// Records the prepared frame as the one that is on screen
+    void setFrameRendered() {
+        m_renderedFrameState = m_preparedFrameState;
+        m_renderRequested = false;
+    }
+    /// Forces the next frame to be rendered, for changes that are not
+    /// covered by isFrameChanged(), e.g. of the marks
+    void requestRender() {
+        m_renderRequested = true;
+    }
+
     const QString& getGroup() const {
         return m_group;
     }
@@ -138,8 +167,10 @@ class WaveformWidgetRenderer {
     }
 
     void setTrack(TrackPointer track);
-    void setMarkPositions(const QMap<WaveformMarkPointer, int>& markPositions) {
-        m_markPositions = markPositions;
+    /// Takes the marks on screen and hands the previous ones back, so the
+    /// caller can reuse the buffer for the next frame without allocating.
+    void swapMarkPositions(QVector<MarkOnScreen>* pMarkPositions) {
+        m_markPositions.swap(*pMarkPositions);
     }
 
     double getPlayMarkerPosition() {
@@ -202,7 +233,30 @@ class WaveformWidgetRenderer {
 private:
     DISALLOW_COPY_AND_ASSIGN(WaveformWidgetRenderer);
     friend class WaveformWidgetFactory;
-    QMap<WaveformMarkPointer, int> m_markPositions;
+
+    /// The values a rendered frame depends on. Pointers are only compared
+    /// and never dereferenced.
+    struct FrameState {
+        const Track* pTrack = nullptr;
+        const mixxx::Beats* pBeats = nullptr;
+        const Waveform* pWaveform = nullptr;
+        int waveformCompletion = -1;
+        int trackSamples = -1;
+        double playPos = -1;
+        double trackPixelCount = 0;
+        double gain = 0;
+        double playMarkerPosition = 0;
+        int alphaBeatGrid = 0;
+
+        bool operator!=(const FrameState& other) const;
+    };
+    FrameState currentFrameState() const;
+
+    FrameState m_preparedFrameState;
+    FrameState m_renderedFrameState;
+    bool m_renderRequested;
+
+    QVector<MarkOnScreen> m_markPositions;
     // draw play position indicator triangles
     void drawPlayPosmarker(QPainter* painter);
     void drawTriangle(QPainter* painter,
@@ -14,7 +14,45 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
         return;
     }
 
+    // The labels of the overview are prerendered on every paint event, while
+    // mostly their position changes with the play position.
+    if (m_pixmap.isNull() ||
+            text != m_text ||
+            icon.cacheKey() != m_icon.cacheKey() ||
+            font != m_font ||
+            textColor != m_textColor ||
+            backgroundColor != m_backgroundColor ||
+            widgetWidth != m_widgetWidth ||
+            scaleFactor != m_scaleFactor) {
+        render(icon, text, font, textColor, backgroundColor, widgetWidth, scaleFactor);
+    }
+
+    // m_pixmapSize has a top left of (0,0) for rendering to m_pixmap.
+    // m_areaRect is the same size but shifted to the coordinates of the widget.
+    QPointF topLeft = QPointF(bottomLeft.x(),
+            bottomLeft.y() - m_pixmapSize.height());
+    m_areaRect = QRectF(topLeft, m_pixmapSize);
+
+    if (m_areaRect.right() > widgetWidth) {
+        m_areaRect.setLeft(widgetWidth - m_areaRect.width());
+    }
+}
+
+void WaveformMarkLabel::render(const QPixmap& icon,
+        QString text,
+        const QFont& font,
+        QColor textColor,
+        QColor backgroundColor,
+        float widgetWidth,
+        double scaleFactor) {
+    m_icon = icon;
     m_text = text;
+    m_font = font;
+    m_textColor = textColor;
+    m_backgroundColor = backgroundColor;
+    m_widgetWidth = widgetWidth;
+    m_scaleFactor = scaleFactor;
+
     QFontMetrics fontMetrics(font);
     constexpr int padding = 2;
 
@@ -35,17 +73,7 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
         pixmapRect.setWidth(widgetWidth);
     }
     pixmapRect.setHeight(math_max(fontMetrics.height(), icon.height()));
-
-    // pixmapRect has a top left of (0,0) for rendering to m_pixmap.
-    // m_areaRect is the same size but shifted to the coordinates of the widget.
-    m_areaRect = pixmapRect;
-    QPointF topLeft = QPointF(bottomLeft.x(),
-            bottomLeft.y() - pixmapRect.height());
-    m_areaRect.moveTo(topLeft);
-
-    if (m_areaRect.right() > widgetWidth) {
-        m_areaRect.setLeft(widgetWidth - m_areaRect.width());
-    }
+    m_pixmapSize = pixmapRect.size();
 
     m_pixmap = QPixmap(static_cast<int>(pixmapRect.width() * scaleFactor),
             static_cast<int>(pixmapRect.height() * scaleFactor));
@@ -72,7 +100,7 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
         painter.setPen(textColor);
         painter.drawText(textBottomLeft, text);
     }
-};
+}
 
 void WaveformMarkLabel::draw(QPainter* pPainter) {
     pPainter->drawPixmap(m_areaRect.topLeft(), m_pixmap);
@@ -13,9 +13,13 @@
 // to be compared so overlapping labels are not drawn.
 class WaveformMarkLabel {
   public:
-    WaveformMarkLabel() {};
+    WaveformMarkLabel()
+            : m_widgetWidth(0),
+              m_scaleFactor(0) {
+    }
 
-    // Render the label to an internal QPixmap buffer
+    // Render the label to an internal QPixmap buffer. The buffer is reused
+    // if only the position has changed since the last call.
     void prerender(QPointF bottomLeft,
             const QPixmap& icon,
             QString text,
@@ -51,12 +55,24 @@ class WaveformMarkLabel {
     }
 
   private:
+    void render(const QPixmap& icon,
+            QString text,
+            const QFont& font,
+            QColor textColor,
+            QColor backgroundColor,
+            float widgetWidth,
+            double scaleFactor);
+
     QPixmap m_icon;
     QString m_text;
     QFont m_font;
     QColor m_textColor;
     QColor m_backgroundColor;
+    float m_widgetWidth;
+    double m_scaleFactor;
 
     QPixmap m_pixmap;
+    // The size of m_pixmap in widget pixels
+    QSizeF m_pixmapSize;
     QRectF m_areaRect;
 };
@@ -12,6 +12,7 @@
 
 #include "control/controlpotmeter.h"
 #include "moc_waveformwidgetfactory.cpp"
+#include "util/battery/battery.h"
 #include "util/cmdlineargs.h"
 #include "util/math.h"
 #include "util/performancetimer.h"
@@ -39,6 +40,17 @@
 #include "widget/wwaveformviewer.h"
 
 namespace {
+// The frame rate while neither a waveform has changed nor another widget
+// has been animated for kIdleDelay, e.g. while all decks are stopped
+constexpr int kIdleFrameRate = 10;
+constexpr mixxx::Duration kIdleDelay = mixxx::Duration::fromMillis(1000);
+// On battery the configured frame rate is halved, but not below this
+constexpr int kMinBatteryFrameRate = 20;
+// Unchanged waveforms are still rendered in this interval, for controls that
+// renderers read directly and that are not part of the frame state, like the
+// EQ filters and kills of the signal renderers of a stopped deck
+constexpr mixxx::Duration kHeartbeatInterval = mixxx::Duration::fromMillis(250);
+
 // Returns true if the given waveform should be rendered.
 bool shouldRenderWaveform(WaveformWidgetAbstract* pWaveformWidget) {
     if (pWaveformWidget == nullptr ||
@@ -80,7 +92,9 @@ WaveformWidgetAbstractHandle::WaveformWidgetAbstractHandle()
 WaveformWidgetHolder::WaveformWidgetHolder()
         : m_waveformWidget(nullptr),
           m_waveformViewer(nullptr),
-          m_skinContextCache(UserSettingsPointer(), QString()) {
+          m_skinContextCache(UserSettingsPointer(), QString()),
+          m_visible(false),
+          m_rendered(false) {
 }
 
 WaveformWidgetHolder::WaveformWidgetHolder(WaveformWidgetAbstract* waveformWidget,
@@ -90,7 +104,13 @@ WaveformWidgetHolder::WaveformWidgetHolder(WaveformWidgetAbstract* waveformWidge
     : m_waveformWidget(waveformWidget),
       m_waveformViewer(waveformViewer),
       m_skinNodeCache(node.cloneNode()),
-      m_skinContextCache(&parentContext) {
+      m_skinContextCache(&parentContext),
+      m_visible(false),
+      m_rendered(false),
+      m_renderTag(QStringLiteral("WaveformWidgetFactory::render %1")
+                          .arg(waveformViewer->getGroup())),
+      m_renderBudgetTag(QStringLiteral("WaveformWidgetFactory::render budget %1")
+                                .arg(waveformViewer->getGroup())) {
 }
 
 ///////////////////////////////////////////
@@ -104,6 +124,9 @@ WaveformWidgetFactory::WaveformWidgetFactory()
           m_config(nullptr),
           m_skipRender(false),
           m_frameRate(30),
+          m_syncFrameRate(0),
+          m_idle(false),
+          m_onBattery(false),
           m_endOfTrackWarningTime(30),
           m_defaultZoom(WaveformWidgetRenderer::s_waveformDefaultZoom),
           m_zoomSync(true),
@@ -353,6 +376,14 @@ void WaveformWidgetFactory::destroyWidgets() {
     m_waveformWidgetHolders.clear();
 }
 
+void WaveformWidgetFactory::notifyVisualActivity() {
+    m_lastChange.start();
+    if (m_idle) {
+        m_idle = false;
+        updateSyncInterval();
+    }
+}
+
 void WaveformWidgetFactory::addTimerListener(WVuMeter* pWidget) {
     // Do not hold the pointer to of timer listeners since they may be deleted.
     // We don't activate update() or repaint() directly so listener widgets
@@ -420,9 +451,27 @@ void WaveformWidgetFactory::setFrameRate(int frameRate) {
     if (m_config) {
         m_config->set(ConfigKey("[Waveform]","FrameRate"), ConfigValue(m_frameRate));
     }
-    if (m_vsyncThread) {
-        m_vsyncThread->setSyncIntervalTimeMicros(static_cast<int>(1e6 / m_frameRate));
+    updateSyncInterval();
+}
+
+void WaveformWidgetFactory::updateSyncInterval() {
+    int frameRate = m_frameRate;
+    if (m_onBattery) {
+        frameRate = math_min(frameRate, math_max(frameRate / 2, kMinBatteryFrameRate));
     }
+    if (m_idle) {
+        frameRate = math_min(frameRate, kIdleFrameRate);
+    }
+    if (!m_vsyncThread || frameRate == m_syncFrameRate) {
+        return;
+    }
+    m_syncFrameRate = frameRate;
+    m_vsyncThread->setSyncIntervalTimeMicros(static_cast<int>(1e6 / m_syncFrameRate));
+}
+
+void WaveformWidgetFactory::slotBatteryStateChanged() {
+    m_onBattery = m_pBattery->getChargingState() == Battery::DISCHARGING;
+    updateSyncInterval();
 }
 
 void WaveformWidgetFactory::setEndOfTrackWarningTime(int endTime) {
@@ -637,37 +686,52 @@ void WaveformWidgetFactory::render() {
     if (!m_skipRender) {
         if (m_type) {   // no regular updates for an empty waveform
             // next rendered frame is displayed after next buffer swap and than after VSync
-            QVarLengthArray<bool, 10> shouldRenderWaveforms(
-                    static_cast<int>(m_waveformWidgetHolders.size()));
-            for (decltype(m_waveformWidgetHolders)::size_type i = 0;
-                    i < m_waveformWidgetHolders.size();
-                    i++) {
-                WaveformWidgetAbstract* pWaveformWidget = m_waveformWidgetHolders[i].m_waveformWidget;
-                // Don't bother doing the pre-render work if we aren't going to
-                // render this widget.
-                bool shouldRender = shouldRenderWaveform(pWaveformWidget);
-                shouldRenderWaveforms[static_cast<int>(i)] = shouldRender;
-                if (!shouldRender) {
+            int visibleWidgets = 0;
+            for (auto& holder : m_waveformWidgetHolders) {
+                WaveformWidgetAbstract* pWaveformWidget = holder.m_waveformWidget;
+                holder.m_rendered = false;
+                if (pWaveformWidget == nullptr) {
                     continue;
                 }
-                // Calculate play position for the new Frame in following run
+                // Calculate play position for the new Frame in following run.
+                // This is also done for hidden widgets, which tells whether
+                // their deck is active.
                 pWaveformWidget->preRender(m_vsyncThread);
+                const bool changed = pWaveformWidget->isFrameChanged();
+                if (changed) {
+                    m_lastChange.start();
+                }
+                if (!shouldRenderWaveform(pWaveformWidget)) {
+                    // Rendered from scratch when shown again
+                    pWaveformWidget->setFrameRendered();
+                    holder.m_visible = false;
+                    continue;
+                }
+                ++visibleWidgets;
+                // Unchanged widgets keep showing their last frame
+                holder.m_rendered = changed || !holder.m_visible ||
+                        holder.m_lastRendered.elapsed() > kHeartbeatInterval;
+                holder.m_visible = true;
             }
             //qDebug() << "prerender" << m_vsyncThread->elapsed();
 
             // It may happen that there is an artificially delayed due to
             // anti tearing driver settings
             // all render commands are delayed until the swap from the previous run is executed
-            for (decltype(m_waveformWidgetHolders)::size_type i = 0;
-                    i < m_waveformWidgetHolders.size();
-                    i++) {
-                WaveformWidgetAbstract* pWaveformWidget = m_waveformWidgetHolders[i].m_waveformWidget;
-                if (!shouldRenderWaveforms[static_cast<int>(i)]) {
+            for (auto& holder : m_waveformWidgetHolders) {
+                if (!holder.m_rendered) {
                     continue;
                 }
-                pWaveformWidget->render();
+                renderWaveformWidget(&holder, visibleWidgets);
                 //qDebug() << "render" << i << m_vsyncThread->elapsed();
             }
+
+            const bool idle = !m_waveformWidgetHolders.empty() &&
+                    m_lastChange.elapsed() > kIdleDelay;
+            if (idle != m_idle) {
+                m_idle = idle;
+                updateSyncInterval();
+            }
         }
 
         // WSpinnys are also double-buffered QGLWidgets, like all the waveform
@@ -697,6 +761,25 @@ void WaveformWidgetFactory::render() {
     m_vsyncThread->vsyncSlotFinished();
 }
 
+void WaveformWidgetFactory::renderWaveformWidget(
+        WaveformWidgetHolder* pHolder, int visibleWidgets) {
+    WaveformWidgetAbstract* pWaveformWidget = pHolder->m_waveformWidget;
+    ScopedTimer t(pHolder->m_renderTag);
+    pHolder->m_lastRendered.start();
+    pWaveformWidget->render();
+    pWaveformWidget->setFrameRendered();
+
+    if (CmdlineArgs::Instance().getDeveloper()) {
+        // The percentage of the widget's share of the frame interval, which
+        // is split among all visible widgets. Above 100 the widget is late.
+        const double budgetNanos = 1e9 / m_syncFrameRate / visibleWidgets;
+        Stat::track(pHolder->m_renderBudgetTag,
+                Stat::UNSPECIFIED,
+                kDefaultComputeFlags,
+                100.0 * pHolder->m_lastRendered.elapsed().toDoubleNanos() / budgetNanos);
+    }
+}
+
 void WaveformWidgetFactory::swap() {
     ScopedTimer t("WaveformWidgetFactory::swap() %1waveforms",
             static_cast<int>(m_waveformWidgetHolders.size()));
@@ -709,6 +792,11 @@ void WaveformWidgetFactory::swap() {
             for (const auto& holder : m_waveformWidgetHolders) {
                 WaveformWidgetAbstract* pWaveformWidget = holder.m_waveformWidget;
 
+                // The back buffer of widgets that have not been rendered
+                // does not contain a new frame
+                if (!holder.m_rendered) {
+                    continue;
+                }
                 // Don't swap invalid / invisible widgets or widgets with an
                 // unexposed window. Prevents continuous log spew of
                 // "QOpenGLContext::swapBuffers() called with non-exposed
@@ -1028,7 +1116,16 @@ void WaveformWidgetFactory::startVSync(GuiTick* pGuiTick, VisualsManager* pVisua
     m_vsyncThread = new VSyncThread(this);
     m_vsyncThread->setObjectName(QStringLiteral("VSync"));
     m_vsyncThread->setVSyncType(m_vSyncType);
-    m_vsyncThread->setSyncIntervalTimeMicros(static_cast<int>(1e6 / m_frameRate));
+    updateSyncInterval();
+
+    // Created here, because it is polled by the GuiTick
+    m_pBattery.reset(Battery::getBattery(this));
+    if (m_pBattery) {
+        connect(m_pBattery.data(),
+                &Battery::stateChanged,
+                this,
+                &WaveformWidgetFactory::slotBatteryStateChanged);
+    }
 
     connect(m_vsyncThread,
             &VSyncThread::vsyncRender,
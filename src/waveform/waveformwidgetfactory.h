@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QScopedPointer>
 #include <QVector>
 #include <vector>
 
@@ -8,9 +9,11 @@
 #include "skin/legacy/skincontext.h"
 #include "util/performancetimer.h"
 #include "util/singleton.h"
+#include "util/stat.h"
 #include "waveform/waveform.h"
 #include "waveform/widgets/waveformwidgettype.h"
 
+class Battery;
 class WVuMeter;
 class WWaveformViewer;
 class WaveformWidgetAbstract;
@@ -49,6 +52,17 @@ class WaveformWidgetHolder {
     QDomNode m_skinNodeCache;
     SkinContext m_skinContextCache;
 
+    // Whether the widget has been visible in the last frame
+    bool m_visible;
+    // Whether the widget has been rendered in the current frame and needs
+    // to be swapped
+    bool m_rendered;
+    // Restarted whenever the widget is rendered
+    PerformanceTimer m_lastRendered;
+    // Interned once for the group of the viewer
+    StatTag m_renderTag;
+    StatTag m_renderBudgetTag;
+
     friend class WaveformWidgetFactory;
 };
 
@@ -123,6 +137,10 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
     void destroyWidgets();
 
     void addTimerListener(WVuMeter* pWidget);
+    // Keeps the configured frame rate while widgets that follow the VSync
+    // tick are animated without a changed waveform, e.g. a spinning WSpinny
+    // or the WVuMeter of a sampler, the preview deck or a microphone.
+    void notifyVisualActivity();
 
     void startVSync(GuiTick* pGuiTick, VisualsManager* pVisualsManager);
     void setVSyncType(int vsType);
@@ -153,8 +171,14 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
   private slots:
     void render();
     void swap();
+    void slotBatteryStateChanged();
 
   private:
+    /// Runs the VSyncThread at the configured frame rate, or at a lower one
+    /// while the waveforms are idle or while running on battery
+    void updateSyncInterval();
+    void renderWaveformWidget(WaveformWidgetHolder* pHolder, int visibleWidgets);
+
     void evaluateWidgets();
     WaveformWidgetAbstract* createWaveformWidget(WaveformWidgetType::Type type, WWaveformViewer* viewer);
     int findIndexOf(WWaveformViewer* viewer) const;
@@ -175,6 +199,14 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
 
     bool m_skipRender;
     int m_frameRate;
+    // The frame rate the VSyncThread is running at
+    int m_syncFrameRate;
+    bool m_idle;
+    // Restarted whenever a waveform widget has changed or another widget
+    // has been animated, see notifyVisualActivity()
+    PerformanceTimer m_lastChange;
+    QScopedPointer<Battery> m_pBattery;
+    bool m_onBattery;
     int m_endOfTrackWarningTime;
     double m_defaultZoom;
     bool m_zoomSync;
@@ -5,6 +5,7 @@
 #include <QtDebug>
 
 #include "skin/legacy/imgloader.h"
+#include "skin/legacy/skincache.h"
 
 #include "util/math.h"
 #include "util/memory.h"
@@ -50,8 +51,28 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
         : m_drawMode(mode),
           m_source(source) {
     if (!source.isSVG()) {
-        m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
+        m_pPixmap.reset(new QPixmap(WPixmapStore::getPixmap(source.getPath(), scaleFactor)));
     } else {
+#ifdef __APPLE__
+        // Apple does Retina scaling behind the scenes, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+        const bool rasterize = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool rasterize = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        if (rasterize) {
+            // Skip loading and rendering the SVG if it has already been
+            // rasterized during a previous run.
+            const QImage cachedImage = SkinCache::loadRasterizedImage(source, scaleFactor);
+            if (!cachedImage.isNull()) {
+                m_pPixmap.reset(new QPixmap(QPixmap::fromImage(cachedImage)));
+                return;
+            }
+        }
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -68,23 +89,18 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the scenes, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        m_sourceId = source.getId();
+        m_svgViewBox = m_pSvg->viewBoxF();
+        if (rasterize) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
             QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
             copy_buffer.fill(0x00000000);  // Transparent black.
             QPainter painter(&copy_buffer);
             m_pSvg->render(&painter);
+            painter.end();
             WPixmapStore::correctImageColors(&copy_buffer);
+            SkinCache::storeRasterizedImage(source, scaleFactor, copy_buffer);
 
             m_pPixmap.reset(new QPixmap(copy_buffer.size()));
             m_pPixmap->convertFromImage(copy_buffer);
@@ -254,6 +270,36 @@ void Paintable::drawInternal(const QRectF& targetRect, QPainter* pPainter,
         if (m_drawMode == TILE) {
             qWarning() << "Tiled SVG should have been rendered to pixmap!";
         } else {
+            if (targetRect.isEmpty() || sourceRect.isEmpty()) {
+                return;
+            }
+            // Rendering the SVG on every paint event is expensive. Draw from
+            // a pixmap with the whole SVG rendered at the scale of this call
+            // instead, it is shared with all other widgets using the same
+            // image and size. Parts of the SVG, e.g. the bar of a VU meter
+            // at the current level, are cut from the same pixmap.
+            const qreal devicePixelRatio = pPainter->device()
+                    ? pPainter->device()->devicePixelRatioF()
+                    : 1.0;
+            const qreal scaleX = targetRect.width() * devicePixelRatio / sourceRect.width();
+            const qreal scaleY = targetRect.height() * devicePixelRatio / sourceRect.height();
+            const QSize pixelSize(qRound(m_svgViewBox.width() * scaleX),
+                    qRound(m_svgViewBox.height() * scaleY));
+            const QPixmap pixmap = WPixmapStore::getRasterizedSvg(
+                    m_sourceId,
+                    m_pSvg.data(),
+                    m_svgViewBox,
+                    pixelSize,
+                    devicePixelRatio);
+            if (!pixmap.isNull()) {
+                const QRectF pixmapSourceRect(
+                        (sourceRect.x() - m_svgViewBox.x()) * scaleX,
+                        (sourceRect.y() - m_svgViewBox.y()) * scaleY,
+                        sourceRect.width() * scaleX,
+                        sourceRect.height() * scaleY);
+                pPainter->drawPixmap(targetRect, pixmap, pixmapSourceRect);
+                return;
+            }
             // NOTE(rryan): QSvgRenderer render does not clip for us -- it
             // applies a world transformation using viewBox and renders the
             // entire SVG to the painter. We save/restore the QPainter in case
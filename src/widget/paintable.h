@@ -58,4 +58,9 @@ class Paintable {
     QScopedPointer<QSvgRenderer> m_pSvg;
     DrawMode m_drawMode;
     PixmapSource m_source;
+    // Identifies the rendered SVG in the raster cache of WPixmapStore
+    QString m_sourceId;
+    // The view box of the whole SVG, the renderer's one is changed for
+    // drawing parts of it
+    QRectF m_svgViewBox;
 };
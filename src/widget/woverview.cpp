@@ -19,6 +19,8 @@
 #include <QPainter>
 #include <QUrl>
 #include <QtDebug>
+#include <cmath>
+#include <vector>
 
 #include "analyzer/analyzerprogress.h"
 #include "control/controlobject.h"
@@ -66,6 +68,8 @@ WOverview::WOverview(
           m_iLabelFontSize(10),
           m_a(1.0),
           m_b(0.0),
+          m_firstUnscaledColumn(0),
+          m_endUnscaledColumn(0),
           m_analyzerProgress(kAnalyzerProgressUnknown),
           m_trackLoaded(false),
           m_scaleFactor(1.0) {
@@ -142,7 +146,7 @@ void WOverview::setup(const QDomNode& node, const SkinContext& context) {
     m_backgroundPixmap = QPixmap();
     m_backgroundPixmapPath = context.selectString(node, "BgPixmap");
     if (!m_backgroundPixmapPath.isEmpty()) {
-        m_backgroundPixmap = *WPixmapStore::getPixmapNoCache(
+        m_backgroundPixmap = WPixmapStore::getPixmap(
                 context.makeSkinPath(m_backgroundPixmapPath),
                 m_scaleFactor);
     }
@@ -268,33 +272,59 @@ void WOverview::slotWaveformSummaryUpdated() {
     if (!pTrack) {
         return;
     }
-    m_pWaveform = pTrack->getWaveformSummary();
+    ConstWaveformPointer pWaveform = pTrack->getWaveformSummary();
+    if (pWaveform != m_pWaveform) {
+        // The parts drawn so far belong to another waveform
+        resetWaveformImages();
+        m_pWaveform = pWaveform;
+    }
     if (m_pWaveform) {
-        // If the waveform is already complete, just draw it.
+        // If the waveform is already complete, draw what is missing. This
+        // is only the remainder when the analysis of this waveform finishes.
         if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
-            m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
+            if (drawNextWaveformPart()) {
                 update();
             }
         }
     } else {
         // Null waveform pointer means waveform was cleared.
-        m_waveformSourceImage = QImage();
         m_analyzerProgress = kAnalyzerProgressUnknown;
-        m_actualCompletion = 0;
-        m_waveformPeak = -1.0;
-        m_pixmapDone = false;
-
         update();
     }
 }
 
+bool WOverview::drawNextWaveformPart() {
+    const int firstColumn = m_actualCompletion / 2;
+    if (!drawNextPixmapPart()) {
+        return false;
+    }
+    const int endColumn = m_actualCompletion / 2;
+    if (m_firstUnscaledColumn < m_endUnscaledColumn) {
+        m_firstUnscaledColumn = math_min(m_firstUnscaledColumn, firstColumn);
+        m_endUnscaledColumn = math_max(m_endUnscaledColumn, endColumn);
+    } else {
+        m_firstUnscaledColumn = firstColumn;
+        m_endUnscaledColumn = endColumn;
+    }
+    return true;
+}
+
+void WOverview::resetWaveformImages() {
+    m_waveformSourceImage = QImage();
+    m_waveformImageScaled = QImage();
+    m_actualCompletion = 0;
+    m_waveformPeak = -1.0;
+    m_pixmapDone = false;
+    m_firstUnscaledColumn = 0;
+    m_endUnscaledColumn = 0;
+}
+
 void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     if (!m_pCurrentTrack || (m_pCurrentTrack->getId() != trackId)) {
         return;
     }
 
-    bool updateNeeded = drawNextPixmapPart();
+    bool updateNeeded = drawNextWaveformPart();
     if (updateNeeded || (m_analyzerProgress != analyzerProgress)) {
         m_analyzerProgress = analyzerProgress;
         update();
@@ -323,11 +353,8 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
                 &WOverview::slotWaveformSummaryUpdated);
     }
 
-    m_waveformSourceImage = QImage();
+    resetWaveformImages();
     m_analyzerProgress = kAnalyzerProgressUnknown;
-    m_actualCompletion = 0;
-    m_waveformPeak = -1.0;
-    m_pixmapDone = false;
     m_trackLoaded = false;
     m_endOfTrack = false;
 
@@ -664,26 +691,122 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
         }
 
         if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
-            QRect sourceRect(0,
-                    static_cast<int>(diffGain),
+            m_waveformImageScaled = QImage(size() * m_devicePixelRatio,
+                    QImage::Format_ARGB32_Premultiplied);
+            m_waveformImageScaled.fill(Qt::transparent);
+            scaleWaveformColumns(0,
                     m_waveformSourceImage.width(),
-                    m_waveformSourceImage.height() -
-                            2 * static_cast<int>(diffGain));
-            QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
-            if (m_orientation == Qt::Vertical) {
-                // Rotate pixmap
-                croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
-            }
-            m_waveformImageScaled = croppedImage.scaled(size() * m_devicePixelRatio,
-                    Qt::IgnoreAspectRatio,
-                    Qt::SmoothTransformation);
+                    static_cast<int>(diffGain));
             m_diffGain = diffGain;
+        } else if (m_firstUnscaledColumn < m_endUnscaledColumn) {
+            scaleWaveformColumns(m_firstUnscaledColumn,
+                    m_endUnscaledColumn,
+                    static_cast<int>(diffGain));
         }
+        m_firstUnscaledColumn = 0;
+        m_endUnscaledColumn = 0;
 
         pPainter->drawImage(rect(), m_waveformImageScaled);
     }
 }
 
+void WOverview::scaleWaveformColumns(int firstColumn, int endColumn, int diffGain) {
+    const int sourceWidth = m_waveformSourceImage.width();
+    const int sourceRows = m_waveformSourceImage.height() - 2 * diffGain;
+    const bool horizontal = m_orientation == Qt::Horizontal;
+    const int scaledLength = horizontal ? m_waveformImageScaled.width()
+                                        : m_waveformImageScaled.height();
+    const int scaledBreadth = horizontal ? m_waveformImageScaled.height()
+                                         : m_waveformImageScaled.width();
+    if (sourceWidth <= 0 || sourceRows <= 0 || scaledLength <= 0 || scaledBreadth <= 0) {
+        return;
+    }
+    const double columnsPerPixel = static_cast<double>(sourceWidth) / scaledLength;
+    const double rowsPerPixel = static_cast<double>(sourceRows) / scaledBreadth;
+
+    // Pixels at the border of the range also cover columns that have been
+    // drawn before, so the result does not depend on how the source image
+    // has been split into parts.
+    const int firstPixel = math_max(static_cast<int>(firstColumn / columnsPerPixel), 0);
+    const int endPixel = math_min(
+            static_cast<int>(std::ceil(endColumn / columnsPerPixel)), scaledLength);
+    const int numPixels = endPixel - firstPixel;
+    if (numPixels <= 0) {
+        return;
+    }
+
+    // Horizontal pass: the premultiplied ARGB components of each source row,
+    // averaged over the columns of each pixel
+    std::vector<float> rows(static_cast<size_t>(sourceRows) * numPixels * 4);
+    for (int row = 0; row < sourceRows; ++row) {
+        const int sourceLine = diffGain + row;
+        if (sourceLine < 0 || sourceLine >= m_waveformSourceImage.height()) {
+            // Cropped with a negative gain, these rows remain transparent
+            continue;
+        }
+        const auto* pSource = reinterpret_cast<const QRgb*>(
+                m_waveformSourceImage.constScanLine(sourceLine));
+        float* pRow = &rows[static_cast<size_t>(row) * numPixels * 4];
+        for (int pixel = 0; pixel < numPixels; ++pixel) {
+            const double left = (firstPixel + pixel) * columnsPerPixel;
+            const double right = left + columnsPerPixel;
+            float sum[4] = {0, 0, 0, 0};
+            float weightSum = 0;
+            for (auto column = static_cast<int>(left);
+                    column < right && column < sourceWidth;
+                    ++column) {
+                const auto weight = static_cast<float>(
+                        math_min(column + 1.0, right) - math_max<double>(column, left));
+                const QRgb rgb = pSource[column];
+                sum[0] += weight * qAlpha(rgb);
+                sum[1] += weight * qRed(rgb);
+                sum[2] += weight * qGreen(rgb);
+                sum[3] += weight * qBlue(rgb);
+                weightSum += weight;
+            }
+            for (int component = 0; component < 4; ++component) {
+                pRow[pixel * 4 + component] =
+                        weightSum > 0 ? sum[component] / weightSum : 0.0f;
+            }
+        }
+    }
+
+    // Vertical pass: the average of the rows of each pixel
+    for (int scaledRow = 0; scaledRow < scaledBreadth; ++scaledRow) {
+        const double top = scaledRow * rowsPerPixel;
+        const double bottom = top + rowsPerPixel;
+        for (int pixel = 0; pixel < numPixels; ++pixel) {
+            float sum[4] = {0, 0, 0, 0};
+            float weightSum = 0;
+            for (auto row = static_cast<int>(top); row < bottom && row < sourceRows; ++row) {
+                const auto weight = static_cast<float>(
+                        math_min(row + 1.0, bottom) - math_max<double>(row, top));
+                const float* pComponents =
+                        &rows[(static_cast<size_t>(row) * numPixels + pixel) * 4];
+                for (int component = 0; component < 4; ++component) {
+                    sum[component] += weight * pComponents[component];
+                }
+                weightSum += weight;
+            }
+            int components[4];
+            for (int component = 0; component < 4; ++component) {
+                components[component] = weightSum > 0
+                        ? math_clamp(static_cast<int>(sum[component] / weightSum + 0.5f), 0, 255)
+                        : 0;
+            }
+            const QRgb rgb = qRgba(components[1], components[2], components[3], components[0]);
+            // A vertical overview is the transposed horizontal one
+            if (horizontal) {
+                reinterpret_cast<QRgb*>(m_waveformImageScaled.scanLine(
+                        scaledRow))[firstPixel + pixel] = rgb;
+            } else {
+                reinterpret_cast<QRgb*>(m_waveformImageScaled.scanLine(
+                        firstPixel + pixel))[scaledRow] = rgb;
+            }
+        }
+    }
+}
+
 void WOverview::drawPlayedOverlay(QPainter* pPainter) {
     // Overlay the played part of the overview-waveform with a skin defined color
     if (!m_waveformSourceImage.isNull() && m_playedOverlayColor.alpha() > 0) {
@@ -79,6 +79,8 @@ class WOverview : public WWidget, public TrackDropTarget {
     }
 
     QImage m_waveformSourceImage;
+    // The source image scaled to the widget size and cropped by m_diffGain.
+    // New parts of the source image only update their columns.
     QImage m_waveformImageScaled;
 
     WaveformSignalColors m_signalColors;
@@ -108,6 +110,13 @@ class WOverview : public WWidget, public TrackDropTarget {
     // Append the waveform overview pixmap according to available data
     // in waveform
     virtual bool drawNextPixmapPart() = 0;
+    // Calls drawNextPixmapPart() and remembers the new columns for scaling
+    bool drawNextWaveformPart();
+    void resetWaveformImages();
+    // Averages the area of the source image that is covered by each pixel of
+    // m_waveformImageScaled, for the pixels that overlap the source columns
+    // [firstColumn, endColumn)
+    void scaleWaveformColumns(int firstColumn, int endColumn, int diffGain);
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
@@ -193,6 +202,11 @@ class WOverview : public WWidget, public TrackDropTarget {
     double m_a;
     double m_b;
 
+    // The columns of m_waveformSourceImage that have been drawn since
+    // m_waveformImageScaled has been updated
+    int m_firstUnscaledColumn;
+    int m_endUnscaledColumn;
+
     AnalyzerProgress m_analyzerProgress;
     bool m_trackLoaded;
     double m_scaleFactor;
@@ -124,8 +124,6 @@ bool WOverviewHSV::drawNextPixmapPart() {
     }
 
     m_actualCompletion = nextCompletion;
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
 
     // Test if the complete waveform is done
     if (m_actualCompletion >= dataSize - 2) {
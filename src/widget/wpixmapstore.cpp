@@ -4,8 +4,120 @@
 #include <QString>
 #include <QtDebug>
 
-#include "util/math.h"
+#include <list>
+
 #include "skin/legacy/imgloader.h"
+#include "util/counter.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("WPixmapStore");
+
+// Larger SVGs are rendered directly, e.g. when a small part of a large image
+// is stretched
+constexpr int kMaxRasterizedSvgSize = 4096;
+
+// A cost bounded LRU cache of rendered pixmaps
+class RasterCache {
+  public:
+    RasterCache()
+            : m_hitCounter(QStringLiteral("WPixmapStore raster cache hit")),
+              m_missCounter(QStringLiteral("WPixmapStore raster cache miss")),
+              m_limitBytes(static_cast<qint64>(WPixmapStore::kDefaultRasterCacheLimitKB) * 1024),
+              m_totalBytes(0),
+              m_hits(0),
+              m_misses(0) {
+    }
+
+    bool find(const QString& key, QPixmap* pPixmap) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            ++m_misses;
+            m_missCounter.increment();
+            return false;
+        }
+        // Move to the front of the LRU list
+        m_lru.splice(m_lru.begin(), m_lru, it->lruPosition);
+        *pPixmap = it->pixmap;
+        ++m_hits;
+        m_hitCounter.increment();
+        return true;
+    }
+
+    void insert(const QString& key, const QPixmap& pixmap) {
+        const qint64 bytes = static_cast<qint64>(pixmap.width()) *
+                pixmap.height() * pixmap.depth() / 8;
+        if (bytes > m_limitBytes) {
+            // Would evict everything else, just don't cache it
+            return;
+        }
+        remove(key);
+        m_lru.push_front(key);
+        m_entries.insert(key, Entry{pixmap, bytes, m_lru.begin()});
+        m_totalBytes += bytes;
+        evict();
+    }
+
+    void setLimit(qint64 limitBytes) {
+        m_limitBytes = limitBytes;
+        evict();
+    }
+
+    void clear() {
+        if (!m_entries.isEmpty()) {
+            kLogger.debug()
+                    << "Clearing raster cache:"
+                    << m_entries.size() << "pixmaps,"
+                    << m_totalBytes / 1024 << "KB,"
+                    << m_hits << "hits,"
+                    << m_misses << "misses";
+        }
+        m_entries.clear();
+        m_lru.clear();
+        m_totalBytes = 0;
+    }
+
+  private:
+    struct Entry {
+        QPixmap pixmap;
+        qint64 bytes;
+        std::list<QString>::iterator lruPosition;
+    };
+
+    void remove(const QString& key) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return;
+        }
+        m_totalBytes -= it->bytes;
+        m_lru.erase(it->lruPosition);
+        m_entries.erase(it);
+    }
+
+    void evict() {
+        while (m_totalBytes > m_limitBytes && !m_lru.empty()) {
+            // Copy the key, it is destroyed by remove()
+            const QString key = m_lru.back();
+            remove(key);
+        }
+    }
+
+    Counter m_hitCounter;
+    Counter m_missCounter;
+    QHash<QString, Entry> m_entries;
+    // Most recently used keys first
+    std::list<QString> m_lru;
+    qint64 m_limitBytes;
+    qint64 m_totalBytes;
+    qint64 m_hits;
+    qint64 m_misses;
+};
+
+RasterCache s_rasterCache;
+
+} // anonymous namespace
 
 // static
 QHash<QString, WeakPaintablePointer> WPixmapStore::m_paintableCache;
@@ -36,15 +148,70 @@ PaintablePointer WPixmapStore::getPaintable(const PixmapSource& source,
 }
 
 // static
-QPixmap* WPixmapStore::getPixmapNoCache(
+QPixmap WPixmapStore::getPixmap(
         const QString& fileName,
         double scaleFactor) {
-    QPixmap* pPixmap = nullptr;
+    const QString key = QStringLiteral("%1@%2").arg(fileName).arg(scaleFactor);
+    QPixmap pixmap;
+    if (s_rasterCache.find(key, &pixmap)) {
+        return pixmap;
+    }
+
     QImage* img = m_loader->getImage(fileName, scaleFactor);
-    pPixmap = new QPixmap();
-    pPixmap->convertFromImage(*img);
+    pixmap.convertFromImage(*img);
     delete img;
-    return pPixmap;
+    if (!pixmap.isNull()) {
+        s_rasterCache.insert(key, pixmap);
+    }
+    return pixmap;
+}
+
+// static
+QPixmap WPixmapStore::getRasterizedSvg(
+        const QString& sourceId,
+        QSvgRenderer* pSvg,
+        const QRectF& viewBox,
+        const QSize& pixelSize,
+        qreal devicePixelRatio) {
+    VERIFY_OR_DEBUG_ASSERT(pSvg) {
+        return QPixmap();
+    }
+    if (pixelSize.isEmpty() ||
+            pixelSize.width() > kMaxRasterizedSvgSize ||
+            pixelSize.height() > kMaxRasterizedSvgSize) {
+        return QPixmap();
+    }
+    const QString key = QStringLiteral("%1/%2x%3@%4")
+                                .arg(sourceId)
+                                .arg(pixelSize.width())
+                                .arg(pixelSize.height())
+                                .arg(devicePixelRatio);
+    QPixmap pixmap;
+    if (s_rasterCache.find(key, &pixmap)) {
+        return pixmap;
+    }
+
+    QImage image(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        pSvg->setViewBox(viewBox);
+        pSvg->render(&painter, QRectF(QPointF(0, 0), pixelSize));
+    }
+    pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    s_rasterCache.insert(key, pixmap);
+    return pixmap;
+}
+
+// static
+void WPixmapStore::setRasterCacheLimit(int limitKB) {
+    s_rasterCache.setLimit(static_cast<qint64>(math_max(limitKB, 0)) * 1024);
+}
+
+// static
+void WPixmapStore::clearRasterCache() {
+    s_rasterCache.clear();
 }
 
 // static
@@ -63,4 +230,6 @@ void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
     // loader has changed. The pixmaps will get freed once all the widgets
     // referring to them are destroyed.
     m_paintableCache.clear();
+    // The color scheme has changed
+    s_rasterCache.clear();
 }
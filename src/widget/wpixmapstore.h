@@ -20,15 +20,40 @@ typedef QWeakPointer<Paintable> WeakPaintablePointer;
 
 class WPixmapStore {
   public:
+    // Enough for the knobs, sliders and buttons of a 4 deck skin
+    static constexpr int kDefaultRasterCacheLimitKB = 64 * 1024;
+
     static PaintablePointer getPaintable(
             const PixmapSource& source,
             Paintable::DrawMode mode,
             double scaleFactor);
-    static QPixmap* getPixmapNoCache(const QString& fileName, double scaleFactor);
+    // Returns the decoded image file, with the filters of the color scheme
+    // applied. The pixmaps are shared through the same LRU cache as the
+    // rasterized SVGs, so each file is only decoded once per scale factor.
+    static QPixmap getPixmap(const QString& fileName, double scaleFactor);
     static void setLoader(QSharedPointer<ImgSource> ld);
     static void correctImageColors(QImage* p);
     static bool willCorrectColors();
 
+    // Returns the whole SVG, i.e. its viewBox, rendered to a pixmap with
+    // the given size in device pixels. The pixmaps are shared by all widgets
+    // drawing the same image at the same size and kept in a global LRU
+    // cache, so the SVG is only rendered again after the size has changed
+    // or the pixmap has been evicted. Callers drawing a part of the SVG cut
+    // it from the pixmap. sourceId must uniquely identify the SVG content,
+    // e.g. PixmapSource::getId(). Returns a null pixmap for sizes that are
+    // too large to be cached.
+    static QPixmap getRasterizedSvg(
+            const QString& sourceId,
+            QSvgRenderer* pSvg,
+            const QRectF& viewBox,
+            const QSize& pixelSize,
+            qreal devicePixelRatio);
+    // Limits the memory used by the cached pixmaps, least recently used
+    // pixmaps are evicted first.
+    static void setRasterCacheLimit(int limitKB);
+    static void clearRasterCache();
+
   private:
     static QHash<QString, WeakPaintablePointer> m_paintableCache;
     static QSharedPointer<ImgSource> m_loader;
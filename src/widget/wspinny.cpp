@@ -20,6 +20,7 @@
 #include "waveform/sharedglcontext.h"
 #include "waveform/visualplayposition.h"
 #include "waveform/vsyncthread.h"
+#include "waveform/waveformwidgetfactory.h"
 #include "wimagestore.h"
 
 // The SampleBuffers format enables antialiasing.
@@ -344,6 +345,13 @@ void WSpinny::render(VSyncThread* vSyncThread) {
                 &m_dGhostAngleCurrentPlaypos);
     }
 
+    // Keep the frame rate while spinning, also if there is no changed
+    // waveform, e.g. for a sampler without a waveform.
+    if (m_dAngleCurrentPlaypos != m_dAngleLastPlaypos ||
+            m_dGhostAngleCurrentPlaypos != m_dGhostAngleLastPlaypos) {
+        WaveformWidgetFactory::instance()->notifyVisualActivity();
+    }
+
     double scaleFactor = devicePixelRatioF();
 
     QPainter p(this);
@@ -368,6 +376,8 @@ void WSpinny::render(VSyncThread* vSyncThread) {
 #ifdef __VINYLCONTROL__
     // Overlay the signal quality drawing if vinyl is active
     if (m_bVinylActive && m_bSignalActive) {
+        // The signal quality is animated even if the deck is stopped
+        WaveformWidgetFactory::instance()->notifyVisualActivity();
         // draw the last good image
         p.drawImage(this->rect(), m_qImage);
     }
@@ -58,7 +58,8 @@ WTrackTableView::WTrackTableView(QWidget* parent,
           m_pFocusBorderColor(kDefaultFocusBorderColor),
           m_sorting(sorting),
           m_selectionChangedSinceLastGuiTick(true),
-          m_loadCachedOnly(false) {
+          m_loadCachedOnly(false),
+          m_visibleTracksChanged(false) {
     // Connect slots and signals to make the world go 'round.
     connect(this, &WTrackTableView::doubleClicked, this, &WTrackTableView::slotMouseDoubleClicked);
 
@@ -99,6 +100,38 @@ void WTrackTableView::enableCachedOnly() {
 
 void WTrackTableView::slotScrollValueChanged(int /*unused*/) {
     enableCachedOnly();
+    m_visibleTracksChanged = true;
+}
+
+void WTrackTableView::slotVisibleTracksChanged() {
+    m_visibleTracksChanged = true;
+}
+
+void WTrackTableView::resizeEvent(QResizeEvent* event) {
+    WLibraryTableView::resizeEvent(event);
+    m_visibleTracksChanged = true;
+}
+
+void WTrackTableView::updateVisibleTracks() {
+    TrackModel* trackModel = getTrackModel();
+    if (!trackModel) {
+        return;
+    }
+    const int firstRow = rowAt(0);
+    if (firstRow < 0) {
+        return;
+    }
+    int lastRow = rowAt(viewport()->height() - 1);
+    if (lastRow < 0) {
+        // The rows do not fill the viewport
+        lastRow = model()->rowCount() - 1;
+    }
+    QModelIndexList indices;
+    indices.reserve(lastRow - firstRow + 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        indices.append(model()->index(row, 0));
+    }
+    trackModel->setVisibleTracks(indices);
 }
 
 void WTrackTableView::selectionChanged(
@@ -109,6 +142,11 @@ void WTrackTableView::selectionChanged(
 }
 
 void WTrackTableView::slotGuiTick50ms(double /*unused*/) {
+    if (m_visibleTracksChanged) {
+        m_visibleTracksChanged = false;
+        updateVisibleTracks();
+    }
+
     // if the user is stopped in the same row for more than 0.1 s,
     // we load un-cached cover arts as well.
     mixxx::Duration timeDelta = mixxx::Time::elapsed() - m_lastUserAction;
@@ -210,6 +248,23 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
     setHorizontalHeader(tempHeader);
 
     setModel(model);
+    // Rows are inserted or reordered without scrolling the view
+    connect(model,
+            &QAbstractItemModel::rowsInserted,
+            this,
+            &WTrackTableView::slotVisibleTracksChanged,
+            Qt::UniqueConnection);
+    connect(model,
+            &QAbstractItemModel::layoutChanged,
+            this,
+            &WTrackTableView::slotVisibleTracksChanged,
+            Qt::UniqueConnection);
+    connect(model,
+            &QAbstractItemModel::modelReset,
+            this,
+            &WTrackTableView::slotVisibleTracksChanged,
+            Qt::UniqueConnection);
+    m_visibleTracksChanged = true;
     setHorizontalHeader(header);
     header->setSectionsMovable(true);
     header->setSectionsClickable(true);
@@ -84,6 +84,7 @@ class WTrackTableView : public WLibraryTableView {
     // Signalled 20 times per second (every 50ms) by GuiTick.
     void slotGuiTick50ms(double);
     void slotScrollValueChanged(int);
+    void slotVisibleTracksChanged();
 
     void slotSortingChanged(int headerSection, Qt::SortOrder order);
     void keyNotationChanged();
@@ -96,8 +97,11 @@ class WTrackTableView : public WLibraryTableView {
     void dragMoveEvent(QDragMoveEvent * event) override;
     void dragEnterEvent(QDragEnterEvent * event) override;
     void dropEvent(QDropEvent * event) override;
+    void resizeEvent(QResizeEvent* event) override;
 
     void enableCachedOnly();
+    // Passes the rows in the viewport to the track model
+    void updateVisibleTracks();
     void selectionChanged(const QItemSelection &selected,
                           const QItemSelection &deselected) override;
 
@@ -126,6 +130,7 @@ class WTrackTableView : public WLibraryTableView {
     mixxx::Duration m_lastUserAction;
     bool m_selectionChangedSinceLastGuiTick;
     bool m_loadCachedOnly;
+    bool m_visibleTracksChanged;
 
     ControlProxy* m_pCOTGuiTick;
     ControlProxy* m_pKeyNotation;
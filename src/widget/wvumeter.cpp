@@ -9,6 +9,7 @@
 #include "moc_wvumeter.cpp"
 #include "util/math.h"
 #include "util/timer.h"
+#include "waveform/waveformwidgetfactory.h"
 #include "widget/wpixmapstore.h"
 
 #define DEFAULT_FALLTIME 20
@@ -150,6 +151,9 @@ void WVuMeter::updateState(mixxx::Duration elapsed) {
 
 void WVuMeter::maybeUpdate() {
     if (m_dParameter != m_dLastParameter || m_dPeakParameter != m_dLastPeakParameter) {
+        // Keep the frame rate while audible, also without a changed waveform,
+        // e.g. for the microphone or a sampler
+        WaveformWidgetFactory::instance()->notifyVisualActivity();
         repaint();
     }
 }